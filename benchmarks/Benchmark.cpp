@@ -0,0 +1,391 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/Memory.h"
+#include "Core/Stopwatch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace alimer
+{
+    namespace
+    {
+        struct BenchmarkEntry
+        {
+            std::string name;
+            BenchmarkFunction function;
+            int64_t arg;
+        };
+
+        struct BenchmarkResult
+        {
+            std::string name;
+            uint64_t iterations;
+            uint32_t repetitions;
+            /// Nanoseconds per iteration.
+            double min;
+            double median;
+            double mean;
+            double stddev;
+            double max;
+            double bytesPerSecond;
+            double itemsPerSecond;
+            /// Engine allocations per iteration, the same in every run of a deterministic benchmark.
+            double allocations;
+        };
+
+        struct Options
+        {
+            std::string filter;
+            std::string jsonPath;
+            std::string comparePath;
+            uint32_t repetitions = 5;
+            uint32_t warmup = 1;
+            double minTime = 0.05;
+            bool list = false;
+        };
+
+        std::vector<BenchmarkEntry>& GetRegistry()
+        {
+            static std::vector<BenchmarkEntry> registry;
+            return registry;
+        }
+
+        double ToSeconds(uint64_t ticks) { return static_cast<double>(ticks) / static_cast<double>(Stopwatch::GetFrequency()); }
+
+        /// Per-iteration counters reported by one run.
+        struct RunCounters
+        {
+            uint64_t bytesPerIteration = 0;
+            uint64_t itemsPerIteration = 0;
+            uint64_t allocations = 0;
+        };
+
+        /// Run the benchmark once and return the elapsed seconds.
+        double RunOnce(const BenchmarkEntry& entry, uint64_t iterations, RunCounters& counters)
+        {
+            BenchmarkState state(iterations, entry.arg);
+            state.ResetTimer();
+            entry.function(state);
+            const uint64_t end = state.GetStopTime() != 0 ? state.GetStopTime() : Stopwatch::GetTimestamp();
+            const uint64_t endAllocations = state.GetStopTime() != 0 ? state.GetStopAllocations() : GetAllocationCount();
+            counters.bytesPerIteration = state.GetBytesPerIteration();
+            counters.itemsPerIteration = state.GetItemsPerIteration();
+            counters.allocations = endAllocations - state.GetStartAllocations();
+            return ToSeconds(end - state.GetStartTime());
+        }
+
+        /// Grow the iteration count until one run takes at least the minimum time.
+        uint64_t Calibrate(const BenchmarkEntry& entry, double minTime)
+        {
+            uint64_t iterations = 1;
+            RunCounters counters;
+            for (;;)
+            {
+                const double elapsed = RunOnce(entry, iterations, counters);
+                if (elapsed >= minTime || iterations >= 1000000000ull)
+                    return iterations;
+
+                const double predicted = static_cast<double>(iterations) * minTime * 1.4 / std::max(elapsed, 1e-9);
+                iterations = std::max(iterations + 1, static_cast<uint64_t>(std::min(predicted, static_cast<double>(iterations) * 100.0)));
+            }
+        }
+
+        BenchmarkResult Run(const BenchmarkEntry& entry, const Options& options)
+        {
+            const uint64_t iterations = Calibrate(entry, options.minTime);
+            RunCounters counters;
+            for (uint32_t i = 0; i < options.warmup; ++i)
+            {
+                RunOnce(entry, iterations, counters);
+            }
+
+            std::vector<double> samples;
+            for (uint32_t i = 0; i < options.repetitions; ++i)
+            {
+                samples.push_back(RunOnce(entry, iterations, counters) * 1e9 / static_cast<double>(iterations));
+            }
+            std::sort(samples.begin(), samples.end());
+
+            BenchmarkResult result{};
+            result.name = entry.name;
+            result.iterations = iterations;
+            result.repetitions = options.repetitions;
+            result.min = samples.front();
+            result.max = samples.back();
+            const size_t middle = samples.size() / 2;
+            result.median = samples.size() % 2 != 0 ? samples[middle] : 0.5 * (samples[middle - 1] + samples[middle]);
+
+            double sum = 0.0;
+            for (double sample : samples)
+                sum += sample;
+            result.mean = sum / static_cast<double>(samples.size());
+
+            double variance = 0.0;
+            for (double sample : samples)
+                variance += (sample - result.mean) * (sample - result.mean);
+            result.stddev = samples.size() > 1 ? std::sqrt(variance / static_cast<double>(samples.size() - 1)) : 0.0;
+
+            const uint64_t bytes = counters.bytesPerIteration;
+            const uint64_t items = counters.itemsPerIteration;
+            result.bytesPerSecond = bytes != 0 ? static_cast<double>(bytes) * 1e9 / result.median : 0.0;
+            result.itemsPerSecond = items != 0 ? static_cast<double>(items) * 1e9 / result.median : 0.0;
+            result.allocations = static_cast<double>(counters.allocations) / static_cast<double>(iterations);
+            return result;
+        }
+
+        std::string FormatTime(double nanoseconds)
+        {
+            char text[32];
+            if (nanoseconds < 1e3)
+                snprintf(text, sizeof(text), "%.2f ns", nanoseconds);
+            else if (nanoseconds < 1e6)
+                snprintf(text, sizeof(text), "%.2f us", nanoseconds / 1e3);
+            else
+                snprintf(text, sizeof(text), "%.2f ms", nanoseconds / 1e6);
+            return text;
+        }
+
+        std::string FormatThroughput(const BenchmarkResult& result)
+        {
+            char text[32] = "";
+            if (result.bytesPerSecond != 0.0)
+                snprintf(text, sizeof(text), "%.2f GB/s", result.bytesPerSecond / 1e9);
+            else if (result.itemsPerSecond != 0.0)
+                snprintf(text, sizeof(text), "%.2f M/s", result.itemsPerSecond / 1e6);
+            return text;
+        }
+
+        void WriteJson(const std::string& path, const std::vector<BenchmarkResult>& results)
+        {
+            FILE* file = fopen(path.c_str(), "w");
+            if (file == nullptr)
+            {
+                fprintf(stderr, "Failed to open '%s'\n", path.c_str());
+                return;
+            }
+
+            char date[32];
+            const time_t now = time(nullptr);
+            strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+#if defined(_DEBUG)
+            const char* buildType = "debug";
+#else
+            const char* buildType = "release";
+#endif
+
+#if defined(ALIMER_AVX2_INTRINSICS)
+            const char* simd = "avx2";
+#elif defined(ALIMER_SSE_INTRINSICS)
+            const char* simd = "sse";
+#else
+            const char* simd = "none";
+#endif
+
+            fprintf(file, "{\n  \"context\": {\"date\": \"%s\", \"build\": \"%s\", \"simd\": \"%s\"},\n  \"benchmarks\": [\n", date, buildType,
+                    simd);
+
+            // One benchmark per line, --compare relies on it.
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                const BenchmarkResult& result = results[i];
+                fprintf(file,
+                        "    {\"name\": \"%s\", \"iterations\": %llu, \"repetitions\": %u, \"min_ns\": %.4f, \"median_ns\": %.4f, "
+                        "\"mean_ns\": %.4f, \"stddev_ns\": %.4f, \"max_ns\": %.4f, \"bytes_per_second\": %.1f, \"items_per_second\": %.1f, "
+                        "\"allocations_per_iteration\": %.4f}%s\n",
+                        result.name.c_str(), static_cast<unsigned long long>(result.iterations), result.repetitions, result.min, result.median,
+                        result.mean, result.stddev, result.max, result.bytesPerSecond, result.itemsPerSecond, result.allocations,
+                        i + 1 < results.size() ? "," : "");
+            }
+
+            fprintf(file, "  ]\n}\n");
+            fclose(file);
+        }
+
+        /// Read name and median pairs from a file written by WriteJson.
+        bool ReadBaseline(const std::string& path, std::vector<std::pair<std::string, double>>& baseline)
+        {
+            FILE* file = fopen(path.c_str(), "r");
+            if (file == nullptr)
+                return false;
+
+            char line[1024];
+            while (fgets(line, sizeof(line), file) != nullptr)
+            {
+                const char* name = strstr(line, "\"name\": \"");
+                const char* median = strstr(line, "\"median_ns\": ");
+                if (name == nullptr || median == nullptr)
+                    continue;
+
+                name += strlen("\"name\": \"");
+                const char* nameEnd = strchr(name, '"');
+                if (nameEnd == nullptr)
+                    continue;
+
+                baseline.emplace_back(std::string(name, nameEnd), atof(median + strlen("\"median_ns\": ")));
+            }
+
+            fclose(file);
+            return true;
+        }
+
+        bool ParseOptions(int argc, char* argv[], Options& options)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                const char* arg = argv[i];
+                auto value = [arg](const char* prefix) -> const char* {
+                    const size_t length = strlen(prefix);
+                    return strncmp(arg, prefix, length) == 0 ? arg + length : nullptr;
+                };
+
+                if (const char* filter = value("--filter="))
+                    options.filter = filter;
+                else if (const char* json = value("--json="))
+                    options.jsonPath = json;
+                else if (const char* compare = value("--compare="))
+                    options.comparePath = compare;
+                else if (const char* repetitions = value("--repetitions="))
+                    options.repetitions = std::max(1, atoi(repetitions));
+                else if (const char* warmup = value("--warmup="))
+                    options.warmup = static_cast<uint32_t>(std::max(0, atoi(warmup)));
+                else if (const char* minTime = value("--min-time="))
+                    options.minTime = std::max(0.0, atof(minTime)) / 1000.0;
+                else if (strcmp(arg, "--list") == 0)
+                    options.list = true;
+                else
+                {
+                    printf("Usage: alimer_benchmarks [options]\n"
+                           "  --filter=<text>      Run benchmarks whose name contains text\n"
+                           "  --repetitions=<n>    Measured runs per benchmark (default 5)\n"
+                           "  --warmup=<n>         Unmeasured runs per benchmark (default 1)\n"
+                           "  --min-time=<ms>      Minimum duration of one run (default 50)\n"
+                           "  --json=<path>        Write results as JSON\n"
+                           "  --compare=<path>     Compare medians against a JSON baseline\n"
+                           "  --list               List benchmarks\n");
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    void BenchmarkState::ResetTimer()
+    {
+        startAllocations = GetAllocationCount();
+        startTime = Stopwatch::GetTimestamp();
+    }
+
+    void BenchmarkState::StopTimer()
+    {
+        stopTime = Stopwatch::GetTimestamp();
+        stopAllocations = GetAllocationCount();
+    }
+
+    uint64_t GetAllocationCount()
+    {
+        uint64_t count = 0;
+        for (uint32_t tag = 0; tag < static_cast<uint32_t>(MemoryTag::Count); ++tag)
+        {
+            count += MemoryStats::Get(static_cast<MemoryTag>(tag)).totalCount;
+        }
+        return count;
+    }
+
+    bool RegisterBenchmark(const char* name, BenchmarkFunction function, std::initializer_list<int64_t> args)
+    {
+        if (args.size() == 0)
+        {
+            GetRegistry().push_back({name, function, 0});
+            return true;
+        }
+
+        for (int64_t arg : args)
+        {
+            GetRegistry().push_back({std::string(name) + "/" + std::to_string(arg), function, arg});
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace alimer;
+
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+        return EXIT_FAILURE;
+
+    std::vector<std::pair<std::string, double>> baseline;
+    if (!options.comparePath.empty() && !ReadBaseline(options.comparePath, baseline))
+    {
+        fprintf(stderr, "Failed to read baseline '%s'\n", options.comparePath.c_str());
+        return EXIT_FAILURE;
+    }
+
+    std::vector<BenchmarkResult> results;
+    printf("%-48s %12s %12s %9s %12s %8s %10s\n", "Benchmark", "Median", "Min", "StdDev", "Throughput", "Allocs", baseline.empty() ? "" : "Change");
+    for (const BenchmarkEntry& entry : GetRegistry())
+    {
+        if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos)
+            continue;
+
+        if (options.list)
+        {
+            printf("%s\n", entry.name.c_str());
+            continue;
+        }
+
+        const BenchmarkResult result = Run(entry, options);
+        results.push_back(result);
+
+        char change[32] = "";
+        for (const auto& previous : baseline)
+        {
+            if (previous.first == result.name && previous.second > 0.0)
+            {
+                snprintf(change, sizeof(change), "%+.1f%%", (result.median / previous.second - 1.0) * 100.0);
+                break;
+            }
+        }
+
+        printf("%-48s %12s %12s %8.1f%% %12s %8.2f %10s\n", result.name.c_str(), FormatTime(result.median).c_str(), FormatTime(result.min).c_str(),
+               result.mean > 0.0 ? result.stddev * 100.0 / result.mean : 0.0, FormatThroughput(result).c_str(), result.allocations, change);
+        fflush(stdout);
+    }
+
+    if (!options.jsonPath.empty())
+    {
+        WriteJson(options.jsonPath, results);
+    }
+
+    return EXIT_SUCCESS;
+}
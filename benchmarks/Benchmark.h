@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "PlatformDef.h"
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+namespace alimer
+{
+    /// Passed to a benchmark function, which runs its body GetIterations() times.
+    class BenchmarkState final
+    {
+    public:
+        BenchmarkState(uint64_t iterations_, int64_t arg_)
+            : iterations(iterations_)
+            , arg(arg_)
+        {
+        }
+
+        uint64_t GetIterations() const { return iterations; }
+
+        /// Argument of benchmarks registered with ALIMER_BENCHMARK_ARGS.
+        int64_t GetArg() const { return arg; }
+
+        /// Bytes processed by one iteration, reported as throughput.
+        void SetBytesPerIteration(uint64_t bytes) { bytesPerIteration = bytes; }
+        /// Items processed by one iteration, reported as throughput.
+        void SetItemsPerIteration(uint64_t items) { itemsPerIteration = items; }
+
+        /// Exclude the setup done so far from the measurement.
+        void ResetTimer();
+        /// End the measurement before teardown, otherwise it ends when the benchmark function returns.
+        void StopTimer();
+
+        uint64_t GetBytesPerIteration() const { return bytesPerIteration; }
+        uint64_t GetItemsPerIteration() const { return itemsPerIteration; }
+        uint64_t GetStartTime() const { return startTime; }
+        uint64_t GetStopTime() const { return stopTime; }
+        uint64_t GetStartAllocations() const { return startAllocations; }
+        uint64_t GetStopAllocations() const { return stopAllocations; }
+
+    private:
+        uint64_t iterations;
+        int64_t arg;
+        uint64_t bytesPerIteration = 0;
+        uint64_t itemsPerIteration = 0;
+        uint64_t startTime = 0;
+        uint64_t stopTime = 0;
+        uint64_t startAllocations = 0;
+        uint64_t stopAllocations = 0;
+    };
+
+    /// Return the number of allocations made through the engine allocators since startup, over every MemoryTag.
+    uint64_t GetAllocationCount();
+
+    using BenchmarkFunction = void (*)(BenchmarkState&);
+
+    /// Register a benchmark, once per argument when arguments are given.
+    bool RegisterBenchmark(const char* name, BenchmarkFunction function, std::initializer_list<int64_t> args = {});
+
+    /// Keep the compiler from optimizing away a value computed by the benchmark.
+    template <typename T> inline void DoNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER)
+        static volatile const void* sink;
+        sink = &value;
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    /// Force pending memory writes to be treated as observable.
+    inline void ClobberMemory()
+    {
+#if defined(_MSC_VER)
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : : "memory");
+#endif
+    }
+}
+
+#define ALIMER_BENCHMARK(function) static const bool ALIMER_CONCAT(s_benchmark, __LINE__) = alimer::RegisterBenchmark(#function, function)
+#define ALIMER_BENCHMARK_ARGS(function, ...)                                                                                               \
+    static const bool ALIMER_CONCAT(s_benchmark, __LINE__) = alimer::RegisterBenchmark(#function, function, {__VA_ARGS__})
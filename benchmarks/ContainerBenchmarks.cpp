@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/Containers.h"
+#include "Core/HashMap.h"
+#include "Core/StringId.h"
+#include <string>
+#include <thread>
+
+using namespace alimer;
+
+namespace
+{
+    constexpr uint32_t kLookupMask = 4095;
+
+    template <typename Map, typename Key> void Lookup(BenchmarkState& state, const Map& map, const Vector<Key>& keys)
+    {
+        state.ResetTimer();
+        uint64_t found = 0;
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            found += map.find(keys[i & kLookupMask]) != map.end() ? 1 : 0;
+        }
+        state.StopTimer();
+        DoNotOptimize(found);
+    }
+
+    /// Keys in the map followed by the same number of keys that are not, so lookups alternate between hits and misses
+    /// when the mask walks the whole array.
+    Vector<StringId32> MakeStringIdKeys(uint32_t count)
+    {
+        Vector<StringId32> keys;
+        for (uint32_t i = 0; i < count * 2; ++i)
+        {
+            keys.push_back(StringId32(("Resource_" + std::to_string(i)).c_str()));
+        }
+        return keys;
+    }
+
+    Vector<const void*> MakePointerKeys(uint32_t count)
+    {
+        static Vector<uint64_t> storage(1 << 20);
+        Vector<const void*> keys;
+        for (uint32_t i = 0; i < count * 2; ++i)
+        {
+            keys.push_back(&storage[(i * 2654435761u) & ((1 << 20) - 1)]);
+        }
+        return keys;
+    }
+
+    template <typename Map, typename Key> Vector<Key> FillLookupKeys(Map& map, const Vector<Key>& keys, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            map[keys[i]] = i;
+        }
+
+        Vector<Key> lookups;
+        for (uint32_t i = 0; i <= kLookupMask; ++i)
+        {
+            // Even positions hit, odd positions miss.
+            lookups.push_back((i & 1) == 0 ? keys[(i >> 1) % count] : keys[count + (i >> 1) % count]);
+        }
+        return lookups;
+    }
+
+    void UnorderedMapStringIdLookup(BenchmarkState& state)
+    {
+        const uint32_t count = static_cast<uint32_t>(state.GetArg());
+        UnorderedMap<StringId32, uint32_t> map;
+        const Vector<StringId32> lookups = FillLookupKeys(map, MakeStringIdKeys(count), count);
+        Lookup(state, map, lookups);
+    }
+
+    void HashMapStringIdLookup(BenchmarkState& state)
+    {
+        const uint32_t count = static_cast<uint32_t>(state.GetArg());
+        HashMap<StringId32, uint32_t> map;
+        const Vector<StringId32> lookups = FillLookupKeys(map, MakeStringIdKeys(count), count);
+        Lookup(state, map, lookups);
+    }
+
+    void UnorderedMapPointerLookup(BenchmarkState& state)
+    {
+        const uint32_t count = static_cast<uint32_t>(state.GetArg());
+        UnorderedMap<const void*, uint32_t> map;
+        const Vector<const void*> lookups = FillLookupKeys(map, MakePointerKeys(count), count);
+        Lookup(state, map, lookups);
+    }
+
+    void HashMapPointerLookup(BenchmarkState& state)
+    {
+        const uint32_t count = static_cast<uint32_t>(state.GetArg());
+        HashMap<const void*, uint32_t> map;
+        const Vector<const void*> lookups = FillLookupKeys(map, MakePointerKeys(count), count);
+        Lookup(state, map, lookups);
+    }
+
+    template <typename Map> void Insert(BenchmarkState& state)
+    {
+        const uint32_t count = static_cast<uint32_t>(state.GetArg());
+        const Vector<StringId32> keys = MakeStringIdKeys(count);
+        state.SetItemsPerIteration(count);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            Map map;
+            for (uint32_t j = 0; j < count; ++j)
+            {
+                map[keys[j]] = j;
+            }
+            DoNotOptimize(map.size());
+        }
+    }
+
+    void UnorderedMapStringIdInsert(BenchmarkState& state) { Insert<UnorderedMap<StringId32, uint32_t>>(state); }
+    void HashMapStringIdInsert(BenchmarkState& state) { Insert<HashMap<StringId32, uint32_t>>(state); }
+
+    void MPMCQueuePushPop(BenchmarkState& state)
+    {
+        static MPMCQueue<uint64_t, 1024> queue;
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            uint64_t value;
+            queue.Push(i);
+            queue.Pop(value);
+            DoNotOptimize(value);
+        }
+    }
+
+    void SPSCQueuePushPop(BenchmarkState& state)
+    {
+        static SPSCQueue<uint64_t, 1024> queue;
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            uint64_t value;
+            queue.Push(i);
+            queue.Pop(value);
+            DoNotOptimize(value);
+        }
+    }
+
+    /// One producer thread and one consumer thread, GetIterations items cross the queue.
+    template <typename Queue> void Transfer(BenchmarkState& state)
+    {
+        static Queue queue;
+        const uint64_t count = state.GetIterations();
+        std::thread producer([count] {
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                while (!queue.Push(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        uint64_t sum = 0;
+        for (uint64_t received = 0; received < count;)
+        {
+            uint64_t value;
+            if (queue.Pop(value))
+            {
+                sum += value;
+                received++;
+            }
+        }
+
+        producer.join();
+        DoNotOptimize(sum);
+    }
+
+    void MPMCQueueTransfer(BenchmarkState& state) { Transfer<MPMCQueue<uint64_t, 4096>>(state); }
+    void SPSCQueueTransfer(BenchmarkState& state) { Transfer<SPSCQueue<uint64_t, 4096>>(state); }
+}
+
+ALIMER_BENCHMARK_ARGS(UnorderedMapStringIdLookup, 64, 4096, 262144);
+ALIMER_BENCHMARK_ARGS(HashMapStringIdLookup, 64, 4096, 262144);
+ALIMER_BENCHMARK_ARGS(UnorderedMapPointerLookup, 64, 4096, 262144);
+ALIMER_BENCHMARK_ARGS(HashMapPointerLookup, 64, 4096, 262144);
+ALIMER_BENCHMARK_ARGS(UnorderedMapStringIdInsert, 4096);
+ALIMER_BENCHMARK_ARGS(HashMapStringIdInsert, 4096);
+ALIMER_BENCHMARK(MPMCQueuePushPop);
+ALIMER_BENCHMARK(SPSCQueuePushPop);
+ALIMER_BENCHMARK(MPMCQueueTransfer);
+ALIMER_BENCHMARK(SPSCQueueTransfer);
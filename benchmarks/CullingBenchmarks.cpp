@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/Containers.h"
+#include "Math/BatchMath.h"
+
+using namespace alimer;
+
+namespace
+{
+    /// Random scene laid out as structure of arrays, roughly a third of it inside the test frustum.
+    struct SceneData
+    {
+        Vector<float> x, y, z;
+        Vector<float> extentX, extentY, extentZ;
+        Vector<float> radius;
+        Vector<float> outX, outY, outZ;
+        Vector<float> outExtentX, outExtentY, outExtentZ;
+        Vector<uint32_t> visibility;
+
+        explicit SceneData(size_t count)
+            : x(count)
+            , y(count)
+            , z(count)
+            , extentX(count)
+            , extentY(count)
+            , extentZ(count)
+            , radius(count)
+            , outX(count)
+            , outY(count)
+            , outZ(count)
+            , outExtentX(count)
+            , outExtentY(count)
+            , outExtentZ(count)
+            , visibility(BatchMath::GetVisibilityWordCount(count))
+        {
+            uint32_t seed = 1;
+            const auto next = [&seed](float scale) {
+                seed = seed * 1664525u + 1013904223u;
+                return (static_cast<float>(seed >> 8) / 16777216.0f) * scale;
+            };
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                x[i] = next(200.0f) - 100.0f;
+                y[i] = next(200.0f) - 100.0f;
+                z[i] = next(200.0f) - 100.0f;
+                extentX[i] = next(4.0f) + 0.1f;
+                extentY[i] = next(4.0f) + 0.1f;
+                extentZ[i] = next(4.0f) + 0.1f;
+                radius[i] = next(4.0f) + 0.1f;
+            }
+        }
+
+        ConstFloat3SoA GetPositions() const { return ConstFloat3SoA(x.data(), y.data(), z.data()); }
+        ConstBoundingBoxSoA GetBoxes() const { return ConstBoundingBoxSoA(GetPositions(), ConstFloat3SoA(extentX.data(), extentY.data(), extentZ.data())); }
+        BoundingSphereSoA GetSpheres() const { return BoundingSphereSoA{GetPositions(), radius.data()}; }
+    };
+
+    Matrix4x4 CreateWorld()
+    {
+        Matrix4x4 rotation;
+        Matrix4x4::CreateFromQuaternion(Quaternion::CreateFromYawPitchRoll(0.3f, 1.1f, -0.4f), &rotation);
+        rotation.m41 = 3.0f;
+        rotation.m42 = -2.0f;
+        rotation.m43 = 7.0f;
+        return rotation;
+    }
+
+    Frustum CreateFrustum()
+    {
+        Matrix4x4 view;
+        Matrix4x4 projection;
+        Matrix4x4::CreateLookAt(Float3(0.0f, 0.0f, 50.0f), Float3::Zero, Float3::UnitY, &view);
+        Matrix4x4::CreatePerspectiveFieldOfView(Pi / 3.0f, 1.777f, 0.1f, 200.0f, &projection);
+        return Frustum::CreateFromMatrix(view * projection);
+    }
+
+    void BatchTransformPoints(BenchmarkState& state)
+    {
+        SceneData scene(static_cast<size_t>(state.GetArg()));
+        const Matrix4x4 world = CreateWorld();
+        const Float3SoA output = {scene.outX.data(), scene.outY.data(), scene.outZ.data()};
+        state.SetItemsPerIteration(state.GetArg());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            BatchMath::TransformPoints(world, scene.GetPositions(), output, scene.x.size());
+            ClobberMemory();
+        }
+    }
+
+    void BatchTransformBoxes(BenchmarkState& state)
+    {
+        SceneData scene(static_cast<size_t>(state.GetArg()));
+        const Matrix4x4 world = CreateWorld();
+        const BoundingBoxSoA output = {{scene.outX.data(), scene.outY.data(), scene.outZ.data()},
+                                       {scene.outExtentX.data(), scene.outExtentY.data(), scene.outExtentZ.data()}};
+        state.SetItemsPerIteration(state.GetArg());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            BatchMath::TransformBoxes(world, scene.GetBoxes(), output, scene.x.size());
+            ClobberMemory();
+        }
+    }
+
+    /// One Frustum::IntersectsSphere call per object, the baseline for the batch kernels.
+    void FrustumCullSpheresSingle(BenchmarkState& state)
+    {
+        SceneData scene(static_cast<size_t>(state.GetArg()));
+        const Frustum frustum = CreateFrustum();
+        state.SetItemsPerIteration(state.GetArg());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            size_t visible = 0;
+            for (size_t j = 0; j < scene.x.size(); ++j)
+            {
+                visible += frustum.IntersectsSphere(Float3(scene.x[j], scene.y[j], scene.z[j]), scene.radius[j]) ? 1 : 0;
+            }
+            DoNotOptimize(visible);
+        }
+    }
+
+    void BatchCullSpheres(BenchmarkState& state)
+    {
+        SceneData scene(static_cast<size_t>(state.GetArg()));
+        const Frustum frustum = CreateFrustum();
+        state.SetItemsPerIteration(state.GetArg());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            const size_t visible = BatchMath::CullSpheres(frustum, scene.GetSpheres(), scene.x.size(), scene.visibility.data());
+            DoNotOptimize(visible);
+        }
+    }
+
+    void BatchCullBoxes(BenchmarkState& state)
+    {
+        SceneData scene(static_cast<size_t>(state.GetArg()));
+        const Frustum frustum = CreateFrustum();
+        state.SetItemsPerIteration(state.GetArg());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            const size_t visible = BatchMath::CullBoxes(frustum, scene.GetBoxes(), scene.x.size(), scene.visibility.data());
+            DoNotOptimize(visible);
+        }
+    }
+}
+
+ALIMER_BENCHMARK_ARGS(BatchTransformPoints, 4096, 65536);
+ALIMER_BENCHMARK_ARGS(BatchTransformBoxes, 4096, 65536);
+ALIMER_BENCHMARK_ARGS(FrustumCullSpheresSingle, 4096, 65536);
+ALIMER_BENCHMARK_ARGS(BatchCullSpheres, 4096, 65536);
+ALIMER_BENCHMARK_ARGS(BatchCullBoxes, 4096, 65536);
@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/Hash.h"
+#include <vector>
+
+using namespace alimer;
+
+namespace
+{
+    const uint8_t* GetInput(size_t size)
+    {
+        static std::vector<uint8_t> data;
+        if (data.size() < size)
+        {
+            data.resize(size);
+            uint32_t state = 0x9E3779B9u;
+            for (uint8_t& byte : data)
+            {
+                state = state * 1664525u + 1013904223u;
+                byte = static_cast<uint8_t>(state >> 24);
+            }
+        }
+        return data.data();
+    }
+
+    void Murmur32Bytes(BenchmarkState& state)
+    {
+        const uint32_t size = static_cast<uint32_t>(state.GetArg());
+        const uint8_t* data = GetInput(size);
+        state.SetBytesPerIteration(size);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            DoNotOptimize(Murmur32(data, size, static_cast<uint32_t>(i)));
+        }
+    }
+
+    void Murmur64Bytes(BenchmarkState& state)
+    {
+        const uint64_t size = static_cast<uint64_t>(state.GetArg());
+        const uint8_t* data = GetInput(size);
+        state.SetBytesPerIteration(size);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            DoNotOptimize(Murmur64(data, size, i));
+        }
+    }
+
+    void HashBytes64Bytes(BenchmarkState& state)
+    {
+        const size_t size = static_cast<size_t>(state.GetArg());
+        const uint8_t* data = GetInput(size);
+        state.SetBytesPerIteration(size);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            DoNotOptimize(HashBytes64(data, size, i));
+        }
+    }
+
+    void HashBytes128Bytes(BenchmarkState& state)
+    {
+        const size_t size = static_cast<size_t>(state.GetArg());
+        const uint8_t* data = GetInput(size);
+        state.SetBytesPerIteration(size);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            DoNotOptimize(HashBytes128(data, size, i));
+        }
+    }
+
+    void HasherStreaming(BenchmarkState& state)
+    {
+        const size_t size = static_cast<size_t>(state.GetArg());
+        const uint8_t* data = GetInput(size);
+        state.SetBytesPerIteration(size);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            // Feed in uneven pieces to exercise the internal buffering.
+            Hasher hasher(i);
+            for (size_t offset = 0; offset < size; offset += 100)
+            {
+                hasher.Update(data + offset, Min<size_t>(100, size - offset));
+            }
+            DoNotOptimize(hasher.Finalize64());
+        }
+    }
+
+    void StringHashLiteral(BenchmarkState& state)
+    {
+        const char* names[] = {"Position", "Normal", "TexCoord0", "ViewProjectionMatrix", "ShadowMapCascade3"};
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            const char* name = names[i % 5];
+            DoNotOptimize(name);
+            DoNotOptimize(StringHash(name));
+        }
+    }
+}
+
+#define ALIMER_HASH_SIZES 16, 64, 256, 1024, 4096, 65536, 1048576, 67108864
+
+ALIMER_BENCHMARK_ARGS(Murmur32Bytes, ALIMER_HASH_SIZES);
+ALIMER_BENCHMARK_ARGS(Murmur64Bytes, ALIMER_HASH_SIZES);
+ALIMER_BENCHMARK_ARGS(HashBytes64Bytes, ALIMER_HASH_SIZES);
+ALIMER_BENCHMARK_ARGS(HashBytes128Bytes, ALIMER_HASH_SIZES);
+ALIMER_BENCHMARK_ARGS(HasherStreaming, 4096, 1048576);
+ALIMER_BENCHMARK(StringHashLiteral);
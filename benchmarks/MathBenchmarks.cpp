@@ -0,0 +1,281 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/Containers.h"
+#include "Math/Matrix4x4.h"
+
+using namespace alimer;
+
+namespace
+{
+    constexpr uint32_t kMatrixCount = 1024;
+
+    Vector<Matrix4x4> MakeMatrices()
+    {
+        Vector<Matrix4x4> matrices(kMatrixCount);
+        for (uint32_t i = 0; i < kMatrixCount; ++i)
+        {
+            Matrix4x4::CreatePerspectiveFieldOfView(0.5f + i * 0.001f, 1.777f, 0.1f, 100.0f + i, &matrices[i]);
+            matrices[i].m41 = static_cast<float>(i);
+        }
+        return matrices;
+    }
+
+    /// Plain scalar row-major product, kept to measure Matrix4x4::Multiply against.
+    void MultiplyReference(const Matrix4x4& a, const Matrix4x4& b, Matrix4x4& result)
+    {
+        for (uint32_t row = 0; row < 4; ++row)
+        {
+            for (uint32_t column = 0; column < 4; ++column)
+            {
+                result.m[row][column] = a.m[row][0] * b.m[0][column] + a.m[row][1] * b.m[1][column] + a.m[row][2] * b.m[2][column] +
+                                        a.m[row][3] * b.m[3][column];
+            }
+        }
+    }
+
+    void Matrix4x4CreatePerspective(BenchmarkState& state)
+    {
+        Matrix4x4 result;
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            Matrix4x4::CreatePerspectiveFieldOfView(0.785f + static_cast<float>(i & 15) * 0.01f, 1.777f, 0.1f, 1000.0f, &result);
+            DoNotOptimize(result);
+        }
+    }
+
+    void Matrix4x4CreateOrthographic(BenchmarkState& state)
+    {
+        Matrix4x4 result;
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            Matrix4x4::CreateOrthographicOffCenter(0.0f, 1280.0f + static_cast<float>(i & 15), 720.0f, 0.0f, -1.0f, 1.0f, &result);
+            DoNotOptimize(result);
+        }
+    }
+
+    void Matrix4x4MultiplyReference(BenchmarkState& state)
+    {
+        const Vector<Matrix4x4> matrices = MakeMatrices();
+        Vector<Matrix4x4> results(kMatrixCount);
+        state.SetItemsPerIteration(kMatrixCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (uint32_t j = 0; j < kMatrixCount; ++j)
+            {
+                MultiplyReference(matrices[j], matrices[(j + 1) & (kMatrixCount - 1)], results[j]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    void Matrix4x4Multiply(BenchmarkState& state)
+    {
+        const Vector<Matrix4x4> matrices = MakeMatrices();
+        Vector<Matrix4x4> results(kMatrixCount);
+        state.SetItemsPerIteration(kMatrixCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (uint32_t j = 0; j < kMatrixCount; ++j)
+            {
+                Matrix4x4::Multiply(matrices[j], matrices[(j + 1) & (kMatrixCount - 1)], &results[j]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    void Matrix4x4Invert(BenchmarkState& state)
+    {
+        const Vector<Matrix4x4> matrices = MakeMatrices();
+        Vector<Matrix4x4> results(kMatrixCount);
+        state.SetItemsPerIteration(kMatrixCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (uint32_t j = 0; j < kMatrixCount; ++j)
+            {
+                Matrix4x4::Invert(matrices[j], &results[j]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    void Matrix4x4Decompose(BenchmarkState& state)
+    {
+        Vector<Matrix4x4> matrices(kMatrixCount);
+        for (uint32_t i = 0; i < kMatrixCount; ++i)
+        {
+            Matrix4x4 scale;
+            Matrix4x4 rotation;
+            Matrix4x4::CreateScale(Float3(1.0f + i * 0.01f, 2.0f, 0.5f), &scale);
+            Matrix4x4::CreateFromQuaternion(Quaternion::CreateFromYawPitchRoll(i * 0.01f, i * 0.02f, i * 0.03f), &rotation);
+            matrices[i] = scale * rotation;
+            matrices[i].m41 = static_cast<float>(i);
+        }
+
+        state.SetItemsPerIteration(kMatrixCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (uint32_t j = 0; j < kMatrixCount; ++j)
+            {
+                Float3 scale;
+                Quaternion rotation;
+                Float3 translation;
+                matrices[j].Decompose(&scale, &rotation, &translation);
+                DoNotOptimize(rotation);
+            }
+        }
+    }
+
+    void Matrix4x4TransformPoint(BenchmarkState& state)
+    {
+        const Vector<Matrix4x4> matrices = MakeMatrices();
+        Vector<Float3> points(kMatrixCount);
+        for (uint32_t i = 0; i < kMatrixCount; ++i)
+        {
+            points[i] = Float3(static_cast<float>(i), 1.0f, -static_cast<float>(i));
+        }
+
+        state.SetItemsPerIteration(kMatrixCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (uint32_t j = 0; j < kMatrixCount; ++j)
+            {
+                points[j] = Matrix4x4::TransformPoint(points[j], matrices[j]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    void QuaternionMultiply(BenchmarkState& state)
+    {
+        Vector<Quaternion> rotations(kMatrixCount);
+        for (uint32_t i = 0; i < kMatrixCount; ++i)
+        {
+            rotations[i] = Quaternion::CreateFromYawPitchRoll(i * 0.01f, i * 0.02f, i * 0.03f);
+        }
+
+        Vector<Quaternion> results(kMatrixCount);
+        state.SetItemsPerIteration(kMatrixCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (uint32_t j = 0; j < kMatrixCount; ++j)
+            {
+                results[j] = rotations[j] * rotations[(j + 1) & (kMatrixCount - 1)];
+            }
+            ClobberMemory();
+        }
+    }
+
+    void QuaternionSlerp(BenchmarkState& state)
+    {
+        Vector<Quaternion> rotations(kMatrixCount);
+        for (uint32_t i = 0; i < kMatrixCount; ++i)
+        {
+            rotations[i] = Quaternion::CreateFromYawPitchRoll(i * 0.01f, i * 0.02f, i * 0.03f);
+        }
+
+        Vector<Quaternion> results(kMatrixCount);
+        state.SetItemsPerIteration(kMatrixCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (uint32_t j = 0; j < kMatrixCount; ++j)
+            {
+                results[j] = Quaternion::Slerp(rotations[j], rotations[(j * 7) & (kMatrixCount - 1)], 0.25f);
+            }
+            ClobberMemory();
+        }
+    }
+
+    void Float3Normalize(BenchmarkState& state)
+    {
+        Vector<Float3> vectors(kMatrixCount);
+        for (uint32_t i = 0; i < kMatrixCount; ++i)
+        {
+            vectors[i] = Float3(static_cast<float>(i) + 1.0f, 2.0f, -3.0f);
+        }
+
+        Vector<Float3> results(kMatrixCount);
+        state.SetItemsPerIteration(kMatrixCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (uint32_t j = 0; j < kMatrixCount; ++j)
+            {
+                results[j] = Float3::Normalize(vectors[j]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    void Matrix4x4Compare(BenchmarkState& state)
+    {
+        const Vector<Matrix4x4> matrices = MakeMatrices();
+        state.SetItemsPerIteration(kMatrixCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            uint32_t equal = 0;
+            for (uint32_t j = 0; j < kMatrixCount; ++j)
+            {
+                equal += matrices[j] == matrices[(j * 3) & (kMatrixCount - 1)] ? 1 : 0;
+            }
+            DoNotOptimize(equal);
+        }
+    }
+
+    void Matrix4x4Transpose(BenchmarkState& state)
+    {
+        const Vector<Matrix4x4> matrices = MakeMatrices();
+        Vector<Matrix4x4> results(kMatrixCount);
+        state.SetItemsPerIteration(kMatrixCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (uint32_t j = 0; j < kMatrixCount; ++j)
+            {
+                Matrix4x4::Transpose(matrices[j], &results[j]);
+            }
+            ClobberMemory();
+        }
+    }
+}
+
+ALIMER_BENCHMARK(Matrix4x4CreatePerspective);
+ALIMER_BENCHMARK(Matrix4x4CreateOrthographic);
+ALIMER_BENCHMARK(Matrix4x4MultiplyReference);
+ALIMER_BENCHMARK(Matrix4x4Multiply);
+ALIMER_BENCHMARK(Matrix4x4Invert);
+ALIMER_BENCHMARK(Matrix4x4Decompose);
+ALIMER_BENCHMARK(Matrix4x4TransformPoint);
+ALIMER_BENCHMARK(Matrix4x4Compare);
+ALIMER_BENCHMARK(Matrix4x4Transpose);
+ALIMER_BENCHMARK(QuaternionMultiply);
+ALIMER_BENCHMARK(QuaternionSlerp);
+ALIMER_BENCHMARK(Float3Normalize);
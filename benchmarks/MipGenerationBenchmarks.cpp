@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Assets/MipGenerator.h"
+#include "Core/JobSystem.h"
+#include "Graphics/PixelFormatConversion.h"
+
+using namespace alimer;
+
+namespace
+{
+    /// Build the full mip chain of a 16:9 image whose width is the benchmark argument (3840 for 4K, 7680 for 8K). The
+    /// source is random RGBA8 converted to the format, with one texel in four opaque for the alpha coverage runs.
+    void RunMipGeneration(BenchmarkState& state, PixelFormat format, MipFilter filter, bool preserveAlphaCoverage)
+    {
+        JobSystem::Initialize();
+
+        const uint32_t width = static_cast<uint32_t>(state.GetArg());
+        const uint32_t height = width * 9 / 16;
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        Vector<uint8_t> seed(pixelCount * 4);
+        uint32_t random = 1;
+        for (size_t i = 0; i < seed.size(); ++i)
+        {
+            random = random * 1664525u + 1013904223u;
+            seed[i] = static_cast<uint8_t>(random >> 24);
+            if (i % 4 == 3)
+            {
+                seed[i] = (random >> 8) % 4 == 0 ? 255 : seed[i] / 4;
+            }
+        }
+
+        Vector<uint8_t> source(pixelCount * (GetFormatBitsPerPixel(format) / 8));
+        ConvertPixels(PixelFormat::RGBA8Unorm, seed.data(), 0, format, source.data(), 0, width, height);
+
+        MipGenerationOptions options;
+        options.filter = filter;
+        options.preserveAlphaCoverage = preserveAlphaCoverage;
+        MipChain chain;
+
+        state.SetItemsPerIteration(pixelCount);
+        state.SetBytesPerIteration(source.size());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            GenerateMipChain(format, source.data(), 0, width, height, options, chain);
+            ClobberMemory();
+        }
+    }
+
+    void MipChainSrgbBox(BenchmarkState& state) { RunMipGeneration(state, PixelFormat::RGBA8UnormSrgb, MipFilter::Box, false); }
+    void MipChainSrgbKaiser(BenchmarkState& state) { RunMipGeneration(state, PixelFormat::RGBA8UnormSrgb, MipFilter::Kaiser, false); }
+    void MipChainSrgbLanczos(BenchmarkState& state) { RunMipGeneration(state, PixelFormat::RGBA8UnormSrgb, MipFilter::Lanczos, false); }
+    void MipChainSrgbKaiserAlphaCoverage(BenchmarkState& state)
+    {
+        RunMipGeneration(state, PixelFormat::RGBA8UnormSrgb, MipFilter::Kaiser, true);
+    }
+    void MipChainRGBA16FloatKaiser(BenchmarkState& state) { RunMipGeneration(state, PixelFormat::RGBA16Float, MipFilter::Kaiser, false); }
+    void MipChainRGBA32FloatKaiser(BenchmarkState& state) { RunMipGeneration(state, PixelFormat::RGBA32Float, MipFilter::Kaiser, false); }
+}
+
+ALIMER_BENCHMARK_ARGS(MipChainSrgbBox, 3840, 7680);
+ALIMER_BENCHMARK_ARGS(MipChainSrgbKaiser, 3840, 7680);
+ALIMER_BENCHMARK_ARGS(MipChainSrgbLanczos, 3840, 7680);
+ALIMER_BENCHMARK_ARGS(MipChainSrgbKaiserAlphaCoverage, 3840, 7680);
+ALIMER_BENCHMARK_ARGS(MipChainRGBA16FloatKaiser, 3840, 7680);
+ALIMER_BENCHMARK_ARGS(MipChainRGBA32FloatKaiser, 3840, 7680);
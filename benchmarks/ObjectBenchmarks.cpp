@@ -0,0 +1,158 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Graphics/Graphics.h"
+#include "Graphics/Texture.h"
+#include "Scene/Entity.h"
+#include "Scene/EntityComponent.h"
+
+using namespace alimer;
+
+namespace
+{
+    /// Deep component chain, checks against the root and the leaf cost the same with the ancestor array.
+    class BenchComponent1 : public EntityComponent
+    {
+        ALIMER_OBJECT(BenchComponent1, EntityComponent);
+    };
+
+    class BenchComponent2 : public BenchComponent1
+    {
+        ALIMER_OBJECT(BenchComponent2, BenchComponent1);
+    };
+
+    class BenchComponent3 : public BenchComponent2
+    {
+        ALIMER_OBJECT(BenchComponent3, BenchComponent2);
+    };
+
+    class BenchComponent4 : public BenchComponent3
+    {
+        ALIMER_OBJECT(BenchComponent4, BenchComponent3);
+    };
+
+    class BenchComponent5 : public BenchComponent4
+    {
+        ALIMER_OBJECT(BenchComponent5, BenchComponent4);
+    };
+
+    class BenchComponent6 : public BenchComponent5
+    {
+        ALIMER_OBJECT(BenchComponent6, BenchComponent5);
+    };
+
+    constexpr uint32_t kObjectCount = 1024;
+
+    /// Entities and components of every depth mixed together, so the branch predictor can not learn the answer.
+    Vector<RefPtr<Object>> MakeObjects()
+    {
+        Vector<RefPtr<Object>> objects;
+        uint32_t state = 12345;
+        for (uint32_t i = 0; i < kObjectCount; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            switch ((state >> 16) % 8)
+            {
+                case 0: objects.push_back(MakeRefPtr<Entity>()); break;
+                case 1: objects.push_back(MakeRefPtr<EntityComponent>()); break;
+                case 2: objects.push_back(MakeRefPtr<BenchComponent1>()); break;
+                case 3: objects.push_back(MakeRefPtr<BenchComponent2>()); break;
+                case 4: objects.push_back(MakeRefPtr<BenchComponent3>()); break;
+                case 5: objects.push_back(MakeRefPtr<BenchComponent4>()); break;
+                case 6: objects.push_back(MakeRefPtr<BenchComponent5>()); break;
+                default: objects.push_back(MakeRefPtr<BenchComponent6>()); break;
+            }
+        }
+        return objects;
+    }
+
+    template <typename T> void CastObjects(BenchmarkState& state)
+    {
+        const Vector<RefPtr<Object>> objects = MakeObjects();
+        state.SetItemsPerIteration(kObjectCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            uint32_t matches = 0;
+            for (const RefPtr<Object>& object : objects)
+            {
+                matches += object->Cast<T>() != nullptr ? 1 : 0;
+            }
+            DoNotOptimize(matches);
+        }
+        state.StopTimer();
+    }
+
+    void CastToEntity(BenchmarkState& state) { CastObjects<Entity>(state); }
+    void CastToEntityComponent(BenchmarkState& state) { CastObjects<EntityComponent>(state); }
+    void CastToDeepComponent(BenchmarkState& state) { CastObjects<BenchComponent6>(state); }
+
+    void IsInstanceOfByName(BenchmarkState& state)
+    {
+        const Vector<RefPtr<Object>> objects = MakeObjects();
+        const StringId32 type = EntityComponent::GetTypeStatic();
+        state.SetItemsPerIteration(kObjectCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            uint32_t matches = 0;
+            for (const RefPtr<Object>& object : objects)
+            {
+                matches += object->IsInstanceOf(type) ? 1 : 0;
+            }
+            DoNotOptimize(matches);
+        }
+        state.StopTimer();
+    }
+
+    /// Static type checks across the scene and graphics hierarchies, no virtual call involved.
+    void TypeInfoIsTypeOf(BenchmarkState& state)
+    {
+        const TypeInfo* types[] = {Entity::GetTypeInfoStatic(),          EntityComponent::GetTypeInfoStatic(),
+                                   BenchComponent6::GetTypeInfoStatic(), BenchComponent3::GetTypeInfoStatic(),
+                                   Texture::GetTypeInfoStatic(),         Graphics::GetTypeInfoStatic()};
+        const TypeInfo* bases[] = {EntityComponent::GetTypeInfoStatic(), BenchComponent2::GetTypeInfoStatic(), Texture::GetTypeInfoStatic()};
+
+        state.SetItemsPerIteration(ALIMER_STATIC_ARRAY_SIZE(types) * ALIMER_STATIC_ARRAY_SIZE(bases));
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            uint32_t matches = 0;
+            for (const TypeInfo* type : types)
+            {
+                DoNotOptimize(type);
+                for (const TypeInfo* base : bases)
+                {
+                    matches += type->IsTypeOf(base) ? 1 : 0;
+                }
+            }
+            DoNotOptimize(matches);
+        }
+    }
+}
+
+ALIMER_BENCHMARK(CastToEntity);
+ALIMER_BENCHMARK(CastToEntityComponent);
+ALIMER_BENCHMARK(CastToDeepComponent);
+ALIMER_BENCHMARK(IsInstanceOfByName);
+ALIMER_BENCHMARK(TypeInfoIsTypeOf);
@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/Containers.h"
+#include "Math/PackedVector.h"
+
+using namespace alimer;
+
+namespace
+{
+    /// Components spread over [-1.25, 1.25) so the clamps and both signs are exercised, with a few halves in range.
+    Vector<float> MakeComponents(size_t count)
+    {
+        Vector<float> components(count);
+        uint32_t seed = 1;
+        for (size_t i = 0; i < count; ++i)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            components[i] = static_cast<float>(seed >> 8) / 16777216.0f * 2.5f - 1.25f;
+        }
+        return components;
+    }
+
+    /// Run a pack function over GetArg() components, componentsPerValue of them go into each packed value.
+    template <typename T, typename Function> void RunPack(BenchmarkState& state, Function function, size_t componentsPerValue = 1)
+    {
+        const size_t count = static_cast<size_t>(state.GetArg());
+        const Vector<float> source = MakeComponents(count);
+        Vector<T> destination(count / componentsPerValue);
+
+        state.SetItemsPerIteration(count);
+        state.SetBytesPerIteration(count * sizeof(float) + destination.size() * sizeof(T));
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            function(source.data(), destination.data(), count);
+            ClobberMemory();
+        }
+    }
+
+    template <typename T, typename PackFunction, typename UnpackFunction>
+    void RunUnpack(BenchmarkState& state, PackFunction pack, UnpackFunction unpack)
+    {
+        const size_t count = static_cast<size_t>(state.GetArg());
+        const Vector<float> components = MakeComponents(count);
+        Vector<T> source(count);
+        Vector<float> destination(count);
+        pack(components.data(), source.data(), count);
+
+        state.SetItemsPerIteration(count);
+        state.SetBytesPerIteration(count * (sizeof(float) + sizeof(T)));
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            unpack(source.data(), destination.data(), count);
+            ClobberMemory();
+        }
+    }
+
+    void FloatToHalfScalar(BenchmarkState& state)
+    {
+        RunPack<uint16_t>(state, [](const float* source, uint16_t* destination, size_t count) {
+            for (size_t i = 0; i < count; ++i)
+            {
+                destination[i] = PackedVector::FloatToHalf(source[i]);
+            }
+        });
+    }
+
+    void FloatToHalfBulk(BenchmarkState& state)
+    {
+        RunPack<uint16_t>(state, [](const float* source, uint16_t* destination, size_t count) {
+            PackedVector::FloatToHalf(source, destination, count);
+        });
+    }
+
+    void HalfToFloatBulk(BenchmarkState& state)
+    {
+        RunUnpack<uint16_t>(
+            state, [](const float* source, uint16_t* destination, size_t count) { PackedVector::FloatToHalf(source, destination, count); },
+            [](const uint16_t* source, float* destination, size_t count) { PackedVector::HalfToFloat(source, destination, count); });
+    }
+
+    void PackUNorm8Bulk(BenchmarkState& state) { RunPack<uint8_t>(state, PackedVector::PackUNorm8); }
+    void PackSNorm8Bulk(BenchmarkState& state) { RunPack<int8_t>(state, PackedVector::PackSNorm8); }
+    void PackUNorm16Bulk(BenchmarkState& state) { RunPack<uint16_t>(state, PackedVector::PackUNorm16); }
+    void PackSNorm16Bulk(BenchmarkState& state) { RunPack<int16_t>(state, PackedVector::PackSNorm16); }
+    void UnpackUNorm8Bulk(BenchmarkState& state) { RunUnpack<uint8_t>(state, PackedVector::PackUNorm8, PackedVector::UnpackUNorm8); }
+    void UnpackSNorm16Bulk(BenchmarkState& state) { RunUnpack<int16_t>(state, PackedVector::PackSNorm16, PackedVector::UnpackSNorm16); }
+
+    void PackRGB10A2Bulk(BenchmarkState& state)
+    {
+        const auto pack = [](const float* source, uint32_t* destination, size_t count) {
+            PackedVector::PackRGB10A2(source, destination, count / 4);
+        };
+        RunPack<uint32_t>(state, pack, 4);
+    }
+}
+
+ALIMER_BENCHMARK_ARGS(FloatToHalfScalar, 4096, 1048576);
+ALIMER_BENCHMARK_ARGS(FloatToHalfBulk, 4096, 1048576);
+ALIMER_BENCHMARK_ARGS(HalfToFloatBulk, 4096, 1048576);
+ALIMER_BENCHMARK_ARGS(PackUNorm8Bulk, 4096, 1048576);
+ALIMER_BENCHMARK_ARGS(PackSNorm8Bulk, 4096, 1048576);
+ALIMER_BENCHMARK_ARGS(PackUNorm16Bulk, 4096, 1048576);
+ALIMER_BENCHMARK_ARGS(PackSNorm16Bulk, 4096, 1048576);
+ALIMER_BENCHMARK_ARGS(UnpackUNorm8Bulk, 4096, 1048576);
+ALIMER_BENCHMARK_ARGS(UnpackSNorm16Bulk, 4096, 1048576);
+ALIMER_BENCHMARK_ARGS(PackRGB10A2Bulk, 4096, 1048576);
@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/Containers.h"
+#include "Graphics/PixelFormatConversion.h"
+
+using namespace alimer;
+
+namespace
+{
+    constexpr uint32_t kWidth = 1920;
+    constexpr uint32_t kHeight = 1080;
+
+    /// Convert a 1080p image between two formats. The source starts as random RGBA8 converted to the source format so
+    /// float formats hold values in [0, 1].
+    void RunConversion(BenchmarkState& state, PixelFormat sourceFormat, PixelFormat destinationFormat)
+    {
+        const size_t pixelCount = static_cast<size_t>(kWidth) * kHeight;
+        Vector<uint8_t> seed(pixelCount * 4);
+        uint32_t random = 1;
+        for (uint8_t& value : seed)
+        {
+            random = random * 1664525u + 1013904223u;
+            value = static_cast<uint8_t>(random >> 24);
+        }
+
+        const uint32_t sourceSize = GetFormatBitsPerPixel(sourceFormat) / 8;
+        const uint32_t destinationSize = GetFormatBitsPerPixel(destinationFormat) / 8;
+        Vector<uint8_t> source(pixelCount * sourceSize);
+        Vector<uint8_t> destination(pixelCount * destinationSize);
+        ConvertPixels(PixelFormat::RGBA8Unorm, seed.data(), 0, sourceFormat, source.data(), 0, kWidth, kHeight);
+
+        state.SetItemsPerIteration(pixelCount);
+        state.SetBytesPerIteration(pixelCount * (sourceSize + destinationSize));
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            ConvertPixels(sourceFormat, source.data(), 0, destinationFormat, destination.data(), 0, kWidth, kHeight);
+            ClobberMemory();
+        }
+    }
+
+#define ALIMER_CONVERSION_BENCHMARK(source, destination)                                                                                   \
+    void source##To##destination(BenchmarkState& state) { RunConversion(state, PixelFormat::source, PixelFormat::destination); }
+
+    ALIMER_CONVERSION_BENCHMARK(RGBA8Unorm, BGRA8Unorm)
+    ALIMER_CONVERSION_BENCHMARK(RGBA8Unorm, BGRA8UnormSrgb)
+    ALIMER_CONVERSION_BENCHMARK(RGBA8UnormSrgb, RGBA32Float)
+    ALIMER_CONVERSION_BENCHMARK(RGBA32Float, RGBA8UnormSrgb)
+    ALIMER_CONVERSION_BENCHMARK(RGBA8Unorm, RGBA16Float)
+    ALIMER_CONVERSION_BENCHMARK(RGBA16Float, RGBA8Unorm)
+    ALIMER_CONVERSION_BENCHMARK(RGBA16Float, RG11B10Float)
+    ALIMER_CONVERSION_BENCHMARK(RGB10A2Unorm, RGBA8Unorm)
+    ALIMER_CONVERSION_BENCHMARK(R8Unorm, RGBA8Unorm)
+
+#undef ALIMER_CONVERSION_BENCHMARK
+}
+
+ALIMER_BENCHMARK(RGBA8UnormToBGRA8Unorm);
+ALIMER_BENCHMARK(RGBA8UnormToBGRA8UnormSrgb);
+ALIMER_BENCHMARK(RGBA8UnormSrgbToRGBA32Float);
+ALIMER_BENCHMARK(RGBA32FloatToRGBA8UnormSrgb);
+ALIMER_BENCHMARK(RGBA8UnormToRGBA16Float);
+ALIMER_BENCHMARK(RGBA16FloatToRGBA8Unorm);
+ALIMER_BENCHMARK(RGBA16FloatToRG11B10Float);
+ALIMER_BENCHMARK(RGB10A2UnormToRGBA8Unorm);
+ALIMER_BENCHMARK(R8UnormToRGBA8Unorm);
@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/Ptr.h"
+#include <vector>
+
+using namespace alimer;
+
+namespace
+{
+    class BenchmarkObject : public RefCounted
+    {
+    public:
+        uint32_t value = 0;
+    };
+
+    /// One allocation per object in the Allocs column, the weak block only exists once a WeakPtr is taken.
+    void RefPtrCreateDestroy(BenchmarkState& state)
+    {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            RefPtr<BenchmarkObject> object(new BenchmarkObject());
+            DoNotOptimize(object.Get());
+        }
+    }
+
+    void RefPtrCopy(BenchmarkState& state)
+    {
+        RefPtr<BenchmarkObject> object(new BenchmarkObject());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            RefPtr<BenchmarkObject> copy(object);
+            DoNotOptimize(copy.Get());
+        }
+    }
+
+    void RefPtrMove(BenchmarkState& state)
+    {
+        RefPtr<BenchmarkObject> object(new BenchmarkObject());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            RefPtr<BenchmarkObject> moved(std::move(object));
+            DoNotOptimize(moved.Get());
+            object = std::move(moved);
+        }
+    }
+
+    /// Copies spread over many objects, closer to real use than hammering one counter.
+    void RefPtrChurn(BenchmarkState& state)
+    {
+        std::vector<RefPtr<BenchmarkObject>> objects;
+        for (uint32_t i = 0; i < 4096; ++i)
+        {
+            objects.emplace_back(new BenchmarkObject());
+        }
+
+        std::vector<RefPtr<BenchmarkObject>> copies(objects.size());
+        state.SetItemsPerIteration(objects.size());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (size_t j = 0; j < objects.size(); ++j)
+            {
+                copies[(j * 17) & 4095] = objects[j];
+            }
+            ClobberMemory();
+        }
+    }
+
+    void WeakPtrCreate(BenchmarkState& state)
+    {
+        RefPtr<BenchmarkObject> object(new BenchmarkObject());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            WeakPtr<BenchmarkObject> weak(object);
+            DoNotOptimize(weak.Get());
+        }
+    }
+
+    void WeakPtrLock(BenchmarkState& state)
+    {
+        RefPtr<BenchmarkObject> object(new BenchmarkObject());
+        WeakPtr<BenchmarkObject> weak(object);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            RefPtr<BenchmarkObject> locked = weak.Lock();
+            DoNotOptimize(locked.Get());
+        }
+    }
+
+    /// Objects that never get a weak reference must not pay for the weak block. Two allocations per object here.
+    void WeakPtrFirstReference(BenchmarkState& state)
+    {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            RefPtr<BenchmarkObject> object(new BenchmarkObject());
+            WeakPtr<BenchmarkObject> weak(object);
+            DoNotOptimize(weak.Get());
+        }
+    }
+}
+
+ALIMER_BENCHMARK(RefPtrCreateDestroy);
+ALIMER_BENCHMARK(RefPtrCopy);
+ALIMER_BENCHMARK(RefPtrMove);
+ALIMER_BENCHMARK(RefPtrChurn);
+ALIMER_BENCHMARK(WeakPtrCreate);
+ALIMER_BENCHMARK(WeakPtrLock);
+ALIMER_BENCHMARK(WeakPtrFirstReference);
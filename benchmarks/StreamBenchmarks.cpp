@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "IO/FileStream.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace alimer;
+
+namespace
+{
+    /// Read-only stream over a buffer, measures the Stream helpers without file system cost.
+    class BufferStream final : public Stream
+    {
+    public:
+        BufferStream(const uint8_t* data_, int64_t size_)
+            : data(data_)
+            , size(size_)
+        {
+        }
+
+        using Stream::Read;
+
+        void Close() override {}
+        int64_t Length() const override { return size; }
+        int64_t Position() const override { return position; }
+        bool CanSeek() const override { return true; }
+        bool CanRead() const override { return true; }
+        bool CanWrite() const override { return false; }
+
+        int64_t Seek(int64_t position_) override
+        {
+            position = Max<int64_t>(0, Min(position_, size));
+            return position;
+        }
+
+        int64_t Read(void* buffer, int64_t length) override
+        {
+            const int64_t count = Min(length, size - position);
+            memcpy(buffer, data + position, static_cast<size_t>(count));
+            position += count;
+            return count;
+        }
+
+        uint64_t Write(const void* buffer, uint64_t length) override
+        {
+            ALIMER_UNUSED(buffer);
+            ALIMER_UNUSED(length);
+            return 0;
+        }
+
+    private:
+        const uint8_t* data;
+        int64_t size;
+        int64_t position = 0;
+    };
+
+    constexpr uint32_t kStreamSize = 1 << 20;
+
+    const Vector<uint8_t>& GetStreamData()
+    {
+        static Vector<uint8_t> data;
+        if (data.empty())
+        {
+            data.resize(kStreamSize);
+            for (uint32_t i = 0; i < kStreamSize; ++i)
+            {
+                // Printable text with a line break every 64 bytes, valid input for every reader below.
+                data[i] = (i % 64) == 63 ? '\n' : static_cast<uint8_t>('a' + (i * 7) % 26);
+            }
+        }
+        return data;
+    }
+
+    void StreamReadUInt32(BenchmarkState& state)
+    {
+        const Vector<uint8_t>& data = GetStreamData();
+        BufferStream stream(data.data(), kStreamSize);
+        state.SetBytesPerIteration(kStreamSize);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            stream.Seek(0);
+            uint32_t sum = 0;
+            for (uint32_t j = 0; j < kStreamSize / sizeof(uint32_t); ++j)
+            {
+                sum += stream.Read<uint32_t>();
+            }
+            DoNotOptimize(sum);
+        }
+    }
+
+    void StreamReadVLE(BenchmarkState& state)
+    {
+        const Vector<uint8_t>& data = GetStreamData();
+        BufferStream stream(data.data(), kStreamSize);
+        state.SetBytesPerIteration(kStreamSize);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            // Text bytes are below 0x80, so each VLE value is one byte.
+            stream.Seek(0);
+            uint32_t sum = 0;
+            for (uint32_t j = 0; j < kStreamSize; ++j)
+            {
+                sum += stream.ReadVLE();
+            }
+            DoNotOptimize(sum);
+        }
+    }
+
+    void StreamReadLine(BenchmarkState& state)
+    {
+        const Vector<uint8_t>& data = GetStreamData();
+        BufferStream stream(data.data(), kStreamSize);
+        state.SetBytesPerIteration(kStreamSize);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            stream.Seek(0);
+            String line;
+            while (stream.Position() < stream.Length())
+            {
+                stream.ReadLine(line);
+            }
+            DoNotOptimize(line);
+        }
+    }
+
+    void FileStreamRead(BenchmarkState& state)
+    {
+        const size_t chunkSize = static_cast<size_t>(state.GetArg());
+        const char* path = "alimer_benchmark_stream.bin";
+        {
+            FileStream output(path, FileMode::Write);
+            output.Write(GetStreamData().data(), kStreamSize);
+        }
+
+        Vector<uint8_t> chunk(chunkSize);
+        FileStream stream(path, FileMode::Read);
+        state.SetBytesPerIteration(kStreamSize);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            stream.Seek(0);
+            while (stream.Read(chunk.data(), static_cast<int64_t>(chunkSize)) > 0)
+            {
+                ClobberMemory();
+            }
+        }
+
+        state.StopTimer();
+        stream.Close();
+        remove(path);
+    }
+}
+
+ALIMER_BENCHMARK(StreamReadUInt32);
+ALIMER_BENCHMARK(StreamReadVLE);
+ALIMER_BENCHMARK(StreamReadLine);
+ALIMER_BENCHMARK_ARGS(FileStreamRead, 64, 4096, 65536);
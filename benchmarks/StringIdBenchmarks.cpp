@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/StringId.h"
+#include <string>
+#include <vector>
+
+using namespace alimer;
+
+namespace
+{
+    const std::vector<std::string>& GetNames()
+    {
+        static std::vector<std::string> names;
+        if (names.empty())
+        {
+            for (uint32_t i = 0; i < 1024; ++i)
+            {
+                names.push_back("Material/Parameter_" + std::to_string(i * 7919u));
+            }
+        }
+        return names;
+    }
+
+    void StringIdFromLiteral(BenchmarkState& state)
+    {
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            constexpr StringId32 id = "ViewProjectionMatrix"_sid;
+            DoNotOptimize(id);
+        }
+    }
+
+    void StringIdFromCString(BenchmarkState& state)
+    {
+        const std::vector<std::string>& names = GetNames();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            DoNotOptimize(StringId32(names[i & 1023].c_str()));
+        }
+    }
+
+    void StringIdFromString(BenchmarkState& state)
+    {
+        const std::vector<std::string>& names = GetNames();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            DoNotOptimize(StringId32(names[i & 1023]));
+        }
+    }
+
+    void StringIdIntern(BenchmarkState& state)
+    {
+        const std::vector<std::string>& names = GetNames();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            DoNotOptimize(StringId32::Intern(names[i & 1023]));
+        }
+    }
+
+    void StringIdCompare(BenchmarkState& state)
+    {
+        std::vector<StringId32> ids;
+        for (const std::string& name : GetNames())
+        {
+            ids.push_back(StringId32(name.c_str()));
+        }
+
+        const StringId32 target = ids[512];
+        state.ResetTimer();
+        uint32_t matches = 0;
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            matches += ids[i & 1023] == target ? 1 : 0;
+        }
+        DoNotOptimize(matches);
+    }
+}
+
+ALIMER_BENCHMARK(StringIdFromLiteral);
+ALIMER_BENCHMARK(StringIdFromCString);
+ALIMER_BENCHMARK(StringIdFromString);
+ALIMER_BENCHMARK(StringIdIntern);
+ALIMER_BENCHMARK(StringIdCompare);
@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/Containers.h"
+#include "Math/MathHelper.h"
+
+using namespace alimer;
+
+namespace
+{
+    constexpr size_t kCount = 4096;
+
+    /// Inputs spread over [low, high), a second set for the two argument functions.
+    struct Inputs
+    {
+        Vector<float> x;
+        Vector<float> y;
+        Vector<float> output;
+
+        Inputs(float low, float high)
+            : x(kCount)
+            , y(kCount)
+            , output(kCount)
+        {
+            uint32_t seed = 1;
+            const auto next = [&seed]() {
+                seed = seed * 1664525u + 1013904223u;
+                return static_cast<float>(seed >> 8) / 16777216.0f;
+            };
+
+            for (size_t i = 0; i < kCount; ++i)
+            {
+                x[i] = low + (high - low) * next();
+                y[i] = low + (high - low) * next();
+            }
+        }
+    };
+
+    template <typename Function> void RunScalar(BenchmarkState& state, Inputs& inputs, Function function)
+    {
+        state.SetItemsPerIteration(kCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (size_t j = 0; j < kCount; ++j)
+            {
+                inputs.output[j] = function(inputs.x[j], inputs.y[j]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    template <typename V, typename Function> void RunVector(BenchmarkState& state, Inputs& inputs, Function function)
+    {
+        state.SetItemsPerIteration(kCount);
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (size_t j = 0; j < kCount; j += V::kWidth)
+            {
+                function(V::Load(&inputs.x[j]), V::Load(&inputs.y[j])).Store(&inputs.output[j]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    template <typename V> V Sin(const V& x, const V&, MathPrecision precision) { return VectorMath::Sin(x, precision); }
+    template <typename V> V Exp(const V& x, const V&, MathPrecision precision) { return VectorMath::Exp(x, precision); }
+    template <typename V> V Log(const V& x, const V&, MathPrecision precision) { return VectorMath::Log(x, precision); }
+    template <typename V> V Pow(const V& x, const V& y, MathPrecision precision) { return VectorMath::Pow(x, y, precision); }
+    template <typename V> V Atan2(const V& y, const V& x, MathPrecision precision) { return VectorMath::Atan2(y, x, precision); }
+
+#define ALIMER_TRANSCENDENTAL_BENCHMARKS(name, low, high, libm)                                                                           \
+    void name##Libm(BenchmarkState& state)                                                                                                \
+    {                                                                                                                                     \
+        Inputs inputs(low, high);                                                                                                         \
+        RunScalar(state, inputs, [](float x, float y) { return libm; });                                                                  \
+    }                                                                                                                                     \
+    void name##AccurateX4(BenchmarkState& state)                                                                                          \
+    {                                                                                                                                     \
+        Inputs inputs(low, high);                                                                                                         \
+        RunVector<Vector4>(state, inputs, [](const Vector4& x, const Vector4& y) { return name(x, y, MathPrecision::Accurate); });       \
+    }                                                                                                                                     \
+    void name##AccurateX8(BenchmarkState& state)                                                                                          \
+    {                                                                                                                                     \
+        Inputs inputs(low, high);                                                                                                         \
+        RunVector<Vector8>(state, inputs, [](const Vector8& x, const Vector8& y) { return name(x, y, MathPrecision::Accurate); });       \
+    }                                                                                                                                     \
+    void name##FastX8(BenchmarkState& state)                                                                                              \
+    {                                                                                                                                     \
+        Inputs inputs(low, high);                                                                                                         \
+        RunVector<Vector8>(state, inputs, [](const Vector8& x, const Vector8& y) { return name(x, y, MathPrecision::Fast); });           \
+    }
+
+    ALIMER_TRANSCENDENTAL_BENCHMARKS(Sin, -10.0f, 10.0f, std::sin(x))
+    ALIMER_TRANSCENDENTAL_BENCHMARKS(Exp, -20.0f, 20.0f, std::exp(x))
+    ALIMER_TRANSCENDENTAL_BENCHMARKS(Log, 0.001f, 1000.0f, std::log(x))
+    ALIMER_TRANSCENDENTAL_BENCHMARKS(Pow, 0.001f, 4.0f, std::pow(x, y))
+    ALIMER_TRANSCENDENTAL_BENCHMARKS(Atan2, -10.0f, 10.0f, std::atan2(x, y))
+
+#undef ALIMER_TRANSCENDENTAL_BENCHMARKS
+}
+
+ALIMER_BENCHMARK(SinLibm);
+ALIMER_BENCHMARK(SinAccurateX4);
+ALIMER_BENCHMARK(SinAccurateX8);
+ALIMER_BENCHMARK(SinFastX8);
+ALIMER_BENCHMARK(ExpLibm);
+ALIMER_BENCHMARK(ExpAccurateX4);
+ALIMER_BENCHMARK(ExpAccurateX8);
+ALIMER_BENCHMARK(ExpFastX8);
+ALIMER_BENCHMARK(LogLibm);
+ALIMER_BENCHMARK(LogAccurateX4);
+ALIMER_BENCHMARK(LogAccurateX8);
+ALIMER_BENCHMARK(LogFastX8);
+ALIMER_BENCHMARK(PowLibm);
+ALIMER_BENCHMARK(PowAccurateX4);
+ALIMER_BENCHMARK(PowAccurateX8);
+ALIMER_BENCHMARK(PowFastX8);
+ALIMER_BENCHMARK(Atan2Libm);
+ALIMER_BENCHMARK(Atan2AccurateX4);
+ALIMER_BENCHMARK(Atan2AccurateX8);
+ALIMER_BENCHMARK(Atan2FastX8);
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Benchmark.h"
+#include "Core/Containers.h"
+#include "Math/WideMath.h"
+
+using namespace alimer;
+
+namespace
+{
+    /// Random transforms in array of structures layout, the way components store them.
+    struct TransformData
+    {
+        Vector<Float3> positions;
+        Vector<Quaternion> rotations;
+        Vector<Quaternion> parents;
+        Vector<uint32_t> parentIndices;
+        Vector<Float3> outPositions;
+        Vector<Quaternion> outRotations;
+
+        explicit TransformData(size_t count)
+            : positions(count)
+            , rotations(count)
+            , parents(count)
+            , parentIndices(count)
+            , outPositions(count)
+            , outRotations(count)
+        {
+            uint32_t seed = 1;
+            const auto next = [&seed]() {
+                seed = seed * 1664525u + 1013904223u;
+                return (static_cast<float>(seed >> 8) / 16777216.0f) * 2.0f - 1.0f;
+            };
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                positions[i] = Float3(next(), next(), next()) * 100.0f;
+                rotations[i] = Quaternion::Normalize(Quaternion(next(), next(), next(), next()));
+                parents[i] = Quaternion::Normalize(Quaternion(next(), next(), next(), next()));
+                parentIndices[i] = static_cast<uint32_t>((i * 7919u) % count);
+            }
+        }
+    };
+
+    /// Rotate each position by its parent rotation and concatenate the rotations, one element at a time.
+    void TransformScalar(BenchmarkState& state)
+    {
+        TransformData data(static_cast<size_t>(state.GetArg()));
+        state.SetItemsPerIteration(state.GetArg());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (size_t j = 0; j < data.positions.size(); ++j)
+            {
+                const Quaternion& parent = data.parents[data.parentIndices[j]];
+                data.outPositions[j] = parent.Rotate(data.positions[j]);
+                data.outRotations[j] = parent * data.rotations[j];
+            }
+            ClobberMemory();
+        }
+    }
+
+    template <typename V> void TransformWide(BenchmarkState& state)
+    {
+        TransformData data(static_cast<size_t>(state.GetArg()));
+        state.SetItemsPerIteration(state.GetArg());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (size_t j = 0; j < data.positions.size(); j += V::kWidth)
+            {
+                const QuaternionWide<V> parent = QuaternionWide<V>::Gather(data.parents.data(), &data.parentIndices[j]);
+                parent.Rotate(Float3Wide<V>::Load(&data.positions[j])).Store(&data.outPositions[j]);
+                (parent * QuaternionWide<V>::Load(&data.rotations[j])).Store(&data.outRotations[j]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    void TransformWide4(BenchmarkState& state) { TransformWide<Vector4>(state); }
+    void TransformWide8(BenchmarkState& state) { TransformWide<Vector8>(state); }
+
+    template <typename V> void NormalizeWide(BenchmarkState& state, bool fast)
+    {
+        TransformData data(static_cast<size_t>(state.GetArg()));
+        state.SetItemsPerIteration(state.GetArg());
+        state.ResetTimer();
+        for (uint64_t i = 0; i < state.GetIterations(); ++i)
+        {
+            for (size_t j = 0; j < data.positions.size(); j += V::kWidth)
+            {
+                const Float3Wide<V> value = Float3Wide<V>::Load(&data.positions[j]);
+                (fast ? Float3Wide<V>::NormalizeFast(value) : Float3Wide<V>::Normalize(value)).Store(&data.outPositions[j]);
+            }
+            ClobberMemory();
+        }
+    }
+
+    void NormalizeWide8(BenchmarkState& state) { NormalizeWide<Vector8>(state, false); }
+    void NormalizeFastWide8(BenchmarkState& state) { NormalizeWide<Vector8>(state, true); }
+}
+
+ALIMER_BENCHMARK_ARGS(TransformScalar, 4096, 65536);
+ALIMER_BENCHMARK_ARGS(TransformWide4, 4096, 65536);
+ALIMER_BENCHMARK_ARGS(TransformWide8, 4096, 65536);
+ALIMER_BENCHMARK_ARGS(NormalizeWide8, 4096, 65536);
+ALIMER_BENCHMARK_ARGS(NormalizeFastWide8, 4096, 65536);
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "Core/HashMap.h"
 #include "Core/Object.h"
 
 namespace alimer
@@ -53,6 +54,6 @@ namespace alimer
 
     protected:
         std::string rootDirectory;
-        std::unordered_map<StringId32, std::unique_ptr<AssetLoader>> loaders;
+        HashMap<StringId32, std::unique_ptr<AssetLoader>> loaders;
     };
 }
@@ -0,0 +1,469 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Assets/MipGenerator.h"
+#include "Core/JobSystem.h"
+#include "Graphics/PixelFormatConversion.h"
+#include "Math/MathHelper.h"
+#include "Math/Vector4.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace alimer
+{
+    namespace
+    {
+        /// Destination rows resampled by one job. The source rows under the vertical filter footprint are filtered
+        /// horizontally by every band that reads them, larger bands amortize that overlap.
+        constexpr uint32_t kBandRows = 32;
+
+        constexpr float kKaiserRadius = 3.0f;
+        constexpr float kKaiserAlpha = 4.0f;
+        constexpr float kLanczosRadius = 3.0f;
+
+        float Sinc(float x)
+        {
+            if (std::fabs(x) < 1e-6f)
+                return 1.0f;
+
+            x *= Pi;
+            return std::sin(x) / x;
+        }
+
+        /// Modified Bessel function of the first kind, order zero.
+        float BesselI0(float x)
+        {
+            const float halfSquared = x * x * 0.25f;
+            float sum = 1.0f;
+            float term = 1.0f;
+            for (uint32_t k = 1; term > sum * 1e-8f; ++k)
+            {
+                term *= halfSquared / static_cast<float>(k * k);
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        float Kaiser(float x)
+        {
+            const float t = x / kKaiserRadius;
+            if (t * t >= 1.0f)
+                return 0.0f;
+
+            return Sinc(x) * BesselI0(kKaiserAlpha * std::sqrt(1.0f - t * t)) / BesselI0(kKaiserAlpha);
+        }
+
+        float Lanczos(float x)
+        {
+            if (std::fabs(x) >= kLanczosRadius)
+                return 0.0f;
+
+            return Sinc(x) * Sinc(x / kLanczosRadius);
+        }
+
+        /// Normalized weights resampling one axis, tapCount source texels per destination texel. Indices are clamped to
+        /// the edge, unused taps have zero weight.
+        struct FilterTaps
+        {
+            uint32_t tapCount = 0;
+            Vector<uint32_t> indices;
+            Vector<float> weights;
+        };
+
+        void ComputeTaps(MipFilter filter, uint32_t sourceSize, uint32_t destinationSize, FilterTaps& taps)
+        {
+            const float scale = static_cast<float>(sourceSize) / static_cast<float>(destinationSize);
+            float support = scale * 0.5f;
+            if (filter == MipFilter::Kaiser)
+                support = kKaiserRadius * scale;
+            else if (filter == MipFilter::Lanczos)
+                support = kLanczosRadius * scale;
+
+            // Evaluate every texel the footprint can touch, then keep the widest span of non zero weights.
+            const uint32_t maxTaps = static_cast<uint32_t>(std::ceil(support * 2.0f)) + 1;
+            Vector<int32_t> firsts(destinationSize);
+            Vector<float> samples(static_cast<size_t>(destinationSize) * maxTaps);
+            uint32_t tapCount = 1;
+            for (uint32_t x = 0; x < destinationSize; ++x)
+            {
+                const float center = (static_cast<float>(x) + 0.5f) * scale;
+                const int32_t first = static_cast<int32_t>(std::floor(center - support));
+                float* weights = samples.data() + static_cast<size_t>(x) * maxTaps;
+                uint32_t begin = maxTaps;
+                uint32_t end = 0;
+                for (uint32_t t = 0; t < maxTaps; ++t)
+                {
+                    const float position = static_cast<float>(first + static_cast<int32_t>(t));
+                    float weight;
+                    if (filter == MipFilter::Box)
+                    {
+                        weight = Max(0.0f, Min(position + 1.0f, center + support) - Max(position, center - support));
+                    }
+                    else
+                    {
+                        weight = filter == MipFilter::Kaiser ? Kaiser((position + 0.5f - center) / scale)
+                                                             : Lanczos((position + 0.5f - center) / scale);
+                    }
+
+                    weights[t] = weight;
+                    if (weight != 0.0f)
+                    {
+                        begin = Min(begin, t);
+                        end = t + 1;
+                    }
+                }
+
+                firsts[x] = first + static_cast<int32_t>(begin);
+                tapCount = Max(tapCount, end - begin);
+                for (uint32_t t = 0; begin > 0 && t < maxTaps; ++t)
+                {
+                    weights[t] = t + begin < maxTaps ? weights[t + begin] : 0.0f;
+                }
+            }
+
+            taps.tapCount = tapCount;
+            taps.indices.resize(static_cast<size_t>(destinationSize) * tapCount);
+            taps.weights.resize(static_cast<size_t>(destinationSize) * tapCount);
+            for (uint32_t x = 0; x < destinationSize; ++x)
+            {
+                const float* weights = samples.data() + static_cast<size_t>(x) * maxTaps;
+                float sum = 0.0f;
+                for (uint32_t t = 0; t < tapCount; ++t)
+                {
+                    sum += t < maxTaps ? weights[t] : 0.0f;
+                }
+
+                for (uint32_t t = 0; t < tapCount; ++t)
+                {
+                    const int32_t index = firsts[x] + static_cast<int32_t>(t);
+                    taps.indices[x * tapCount + t] = static_cast<uint32_t>(Clamp(index, 0, static_cast<int32_t>(sourceSize) - 1));
+                    taps.weights[x * tapCount + t] = t < maxTaps ? weights[t] / sum : 0.0f;
+                }
+            }
+        }
+
+        /// Rows of one level. The base level is decoded to linear RGBA floats on demand, later levels are stored that way.
+        struct LevelRows
+        {
+            PixelFormat format;
+            const uint8_t* data;
+            size_t rowPitch;
+            uint32_t width;
+            uint32_t height;
+
+            /// Return row y as RGBA floats, using scratch (width * 4 floats) when it needs decoding.
+            const float* GetRow(uint32_t y, float* scratch) const
+            {
+                const uint8_t* row = data + y * rowPitch;
+                if (format == PixelFormat::RGBA32Float)
+                    return reinterpret_cast<const float*>(row);
+
+                ConvertPixels(format, row, 0, PixelFormat::RGBA32Float, scratch, 0, width, 1);
+                return scratch;
+            }
+        };
+
+        /// Filter one row of RGBA floats horizontally. TapCount is zero for counts known only at run time, the others
+        /// let the compiler unroll the tap loop.
+        template <uint32_t TapCount> void FilterRow(const float* source, const FilterTaps& taps, uint32_t width, float* destination)
+        {
+            const uint32_t tapCount = TapCount != 0 ? TapCount : taps.tapCount;
+            const uint32_t* indices = taps.indices.data();
+            const float* weights = taps.weights.data();
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                Vector4 sum = Vector4::Zero();
+                for (uint32_t t = 0; t < tapCount; ++t)
+                {
+                    sum = Vector4::MultiplyAdd(Vector4::Load(source + indices[t] * 4), Vector4::Splat(weights[t]), sum);
+                }
+
+                sum.Store(destination + x * 4);
+                indices += tapCount;
+                weights += tapCount;
+            }
+        }
+
+        using FilterRowFunction = void (*)(const float* source, const FilterTaps& taps, uint32_t width, float* destination);
+
+        /// FilterRow indexed by tap count. Box filters use 2 to 4 taps, Kaiser and Lanczos 12 or 13 when halving.
+        constexpr uint32_t kMaxUnrolledTaps = 14;
+        constexpr FilterRowFunction kFilterRow[kMaxUnrolledTaps + 1] = {
+            FilterRow<0>, FilterRow<1>, FilterRow<2>,  FilterRow<3>,  FilterRow<4>,  FilterRow<5>,  FilterRow<6>,  FilterRow<7>,
+            FilterRow<8>, FilterRow<9>, FilterRow<10>, FilterRow<11>, FilterRow<12>, FilterRow<13>, FilterRow<14>,
+        };
+
+        FilterRowFunction GetFilterRow(uint32_t tapCount)
+        {
+            return tapCount <= kMaxUnrolledTaps ? kFilterRow[tapCount] : kFilterRow[0];
+        }
+
+        /// Scale alpha by alphaScale, saturating, then store the rows in the chain format.
+        void WriteRows(const float* rows, uint32_t width, uint32_t rowCount, float alphaScale, PixelFormat format, uint8_t* destination,
+                       uint32_t destinationRowPitch, float* scratch)
+        {
+            for (uint32_t y = 0; y < rowCount; ++y)
+            {
+                const float* row = rows + static_cast<size_t>(y) * width * 4;
+                if (alphaScale != 1.0f)
+                {
+                    for (uint32_t x = 0; x < width; ++x)
+                    {
+                        scratch[x * 4] = row[x * 4];
+                        scratch[x * 4 + 1] = row[x * 4 + 1];
+                        scratch[x * 4 + 2] = row[x * 4 + 2];
+                        scratch[x * 4 + 3] = Min(row[x * 4 + 3] * alphaScale, 1.0f);
+                    }
+                    row = scratch;
+                }
+
+                uint8_t* destinationRow = destination + static_cast<size_t>(y) * destinationRowPitch;
+                ConvertPixels(PixelFormat::RGBA32Float, row, 0, format, destinationRow, 0, width, 1);
+            }
+        }
+
+        /// Resample source into the width x height float level destination, one job per band of rows. When output is
+        /// not null the rows are also stored in the chain format.
+        void ResampleLevel(const LevelRows& source, MipFilter filter, uint32_t width, uint32_t height, float* destination,
+                           PixelFormat format, uint8_t* output, uint32_t outputRowPitch)
+        {
+            FilterTaps horizontal;
+            FilterTaps vertical;
+            ComputeTaps(filter, source.width, width, horizontal);
+            ComputeTaps(filter, source.height, height, vertical);
+
+            const FilterRowFunction filterRow = GetFilterRow(horizontal.tapCount);
+            const size_t rowFloats = static_cast<size_t>(width) * 4;
+            const uint32_t bandCount = (height + kBandRows - 1) / kBandRows;
+            ParallelFor(0, bandCount, 1, [&](uint32_t band) {
+                const uint32_t rowBegin = band * kBandRows;
+                const uint32_t rowEnd = Min(rowBegin + kBandRows, height);
+
+                const uint32_t* firstTap = vertical.indices.data() + static_cast<size_t>(rowBegin) * vertical.tapCount;
+                const uint32_t* lastTap = vertical.indices.data() + static_cast<size_t>(rowEnd) * vertical.tapCount;
+                const uint32_t sourceBegin = *std::min_element(firstTap, lastTap);
+                const uint32_t sourceEnd = *std::max_element(firstTap, lastTap) + 1;
+
+                Vector<float> decoded(static_cast<size_t>(Max(source.width, width)) * 4);
+                Vector<float> filtered((sourceEnd - sourceBegin) * rowFloats);
+                for (uint32_t y = sourceBegin; y < sourceEnd; ++y)
+                {
+                    filterRow(source.GetRow(y, decoded.data()), horizontal, width, filtered.data() + (y - sourceBegin) * rowFloats);
+                }
+
+                for (uint32_t y = rowBegin; y < rowEnd; ++y)
+                {
+                    const uint32_t* indices = vertical.indices.data() + static_cast<size_t>(y) * vertical.tapCount;
+                    const float* weights = vertical.weights.data() + static_cast<size_t>(y) * vertical.tapCount;
+                    float* row = destination + y * rowFloats;
+
+                    // Accumulate whole rows one tap at a time so every pass streams through contiguous memory.
+                    const float* taps = filtered.data() + (indices[0] - sourceBegin) * rowFloats;
+                    const Vector4 firstWeight = Vector4::Splat(weights[0]);
+                    for (size_t i = 0; i < rowFloats; i += 4)
+                    {
+                        Vector4::Multiply(Vector4::Load(taps + i), firstWeight).Store(row + i);
+                    }
+
+                    for (uint32_t t = 1; t < vertical.tapCount; ++t)
+                    {
+                        taps = filtered.data() + (indices[t] - sourceBegin) * rowFloats;
+                        const Vector4 weight = Vector4::Splat(weights[t]);
+                        for (size_t i = 0; i < rowFloats; i += 4)
+                        {
+                            Vector4::MultiplyAdd(Vector4::Load(taps + i), weight, Vector4::Load(row + i)).Store(row + i);
+                        }
+                    }
+                }
+
+                if (output != nullptr)
+                {
+                    WriteRows(destination + rowBegin * rowFloats, width, rowEnd - rowBegin, 1.0f, format,
+                              output + static_cast<size_t>(rowBegin) * outputRowPitch, outputRowPitch, decoded.data());
+                }
+            });
+        }
+
+        /// Return the fraction of texels whose alpha times alphaScale is above alphaReference.
+        float MeasureAlphaCoverage(const LevelRows& level, float alphaReference, float alphaScale)
+        {
+            const uint32_t bandCount = (level.height + kBandRows - 1) / kBandRows;
+            const uint64_t covered = ParallelReduce(
+                0, bandCount, 1, uint64_t(0),
+                [&](uint32_t band) {
+                    Vector<float> decoded(static_cast<size_t>(level.width) * 4);
+                    uint64_t count = 0;
+                    for (uint32_t y = band * kBandRows; y < Min((band + 1) * kBandRows, level.height); ++y)
+                    {
+                        const float* row = level.GetRow(y, decoded.data());
+                        for (uint32_t x = 0; x < level.width; ++x)
+                        {
+                            count += row[x * 4 + 3] * alphaScale > alphaReference ? 1 : 0;
+                        }
+                    }
+                    return count;
+                },
+                [](uint64_t a, uint64_t b) { return a + b; });
+
+            return static_cast<float>(static_cast<double>(covered) / (static_cast<double>(level.width) * level.height));
+        }
+
+        /// Bisect the alpha scale that brings the coverage of level closest to targetCoverage.
+        float FindAlphaScale(const LevelRows& level, float alphaReference, float targetCoverage)
+        {
+            float bestScale = 1.0f;
+            float bestError = std::fabs(MeasureAlphaCoverage(level, alphaReference, 1.0f) - targetCoverage);
+            float low = 0.0f;
+            float high = 4.0f;
+            for (uint32_t i = 0; i < 10 && bestError > 0.0f; ++i)
+            {
+                const float scale = (low + high) * 0.5f;
+                const float coverage = MeasureAlphaCoverage(level, alphaReference, scale);
+                const float error = std::fabs(coverage - targetCoverage);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestScale = scale;
+                }
+
+                if (coverage < targetCoverage)
+                    low = scale;
+                else
+                    high = scale;
+            }
+
+            return bestScale;
+        }
+    }
+
+    uint32_t GetMipLevelCount(uint32_t width, uint32_t height)
+    {
+        uint32_t count = 1;
+        while (width > 1 || height > 1)
+        {
+            width = Max(width / 2, 1u);
+            height = Max(height / 2, 1u);
+            ++count;
+        }
+
+        return count;
+    }
+
+    bool IsMipGenerationSupported(PixelFormat format)
+    {
+        switch (format)
+        {
+            case PixelFormat::RGBA8Unorm:
+            case PixelFormat::RGBA8UnormSrgb:
+            case PixelFormat::BGRA8Unorm:
+            case PixelFormat::BGRA8UnormSrgb:
+            case PixelFormat::RGBA16Float:
+            case PixelFormat::RGBA32Float:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool GenerateMipChain(PixelFormat format, const void* source, uint32_t rowPitch, uint32_t width, uint32_t height,
+                          const MipGenerationOptions& options, MipChain& chain)
+    {
+        if (!IsMipGenerationSupported(format) || source == nullptr || width == 0 || height == 0)
+            return false;
+
+        const uint32_t bytesPerPixel = GetFormatBitsPerPixel(format) / 8;
+        if (rowPitch == 0)
+        {
+            rowPitch = width * bytesPerPixel;
+        }
+
+        uint32_t levelCount = GetMipLevelCount(width, height);
+        if (options.mipLevels != 0)
+        {
+            levelCount = Min(levelCount, options.mipLevels);
+        }
+
+        chain.format = format;
+        chain.levels.resize(levelCount);
+        size_t size = 0;
+        for (uint32_t level = 0; level < levelCount; ++level)
+        {
+            MipLevel& mip = chain.levels[level];
+            mip.width = Max(width >> level, 1u);
+            mip.height = Max(height >> level, 1u);
+            mip.rowPitch = mip.width * bytesPerPixel;
+            mip.offset = size;
+            size += static_cast<size_t>(mip.rowPitch) * mip.height;
+        }
+        chain.data.resize(size);
+
+        const uint8_t* sourceBytes = static_cast<const uint8_t*>(source);
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            memcpy(chain.data.data() + static_cast<size_t>(y) * chain.levels[0].rowPitch, sourceBytes + static_cast<size_t>(y) * rowPitch,
+                   chain.levels[0].rowPitch);
+        }
+
+        LevelRows previous = {format, sourceBytes, rowPitch, width, height};
+        float targetCoverage = 0.0f;
+        if (options.preserveAlphaCoverage)
+        {
+            targetCoverage = MeasureAlphaCoverage(previous, options.alphaReference, 1.0f);
+        }
+
+        // Levels are resampled from the unscaled float data of the previous level, so coverage scaling and quantization
+        // do not accumulate down the chain. Only two float levels are alive at a time.
+        Vector<float> previousLevel;
+        Vector<float> currentLevel;
+        for (uint32_t level = 1; level < levelCount; ++level)
+        {
+            const MipLevel& mip = chain.levels[level];
+            uint8_t* output = chain.data.data() + mip.offset;
+            currentLevel.resize(static_cast<size_t>(mip.width) * mip.height * 4);
+            ResampleLevel(previous, options.filter, mip.width, mip.height, currentLevel.data(), format,
+                          options.preserveAlphaCoverage ? nullptr : output, mip.rowPitch);
+
+            const LevelRows current = {PixelFormat::RGBA32Float, reinterpret_cast<const uint8_t*>(currentLevel.data()),
+                                       static_cast<size_t>(mip.width) * 4 * sizeof(float), mip.width, mip.height};
+            if (options.preserveAlphaCoverage)
+            {
+                const float alphaScale = FindAlphaScale(current, options.alphaReference, targetCoverage);
+                const uint32_t bandCount = (mip.height + kBandRows - 1) / kBandRows;
+                ParallelFor(0, bandCount, 1, [&](uint32_t band) {
+                    const uint32_t rowBegin = band * kBandRows;
+                    const uint32_t rowCount = Min(kBandRows, mip.height - rowBegin);
+                    Vector<float> scratch(static_cast<size_t>(mip.width) * 4);
+                    WriteRows(currentLevel.data() + static_cast<size_t>(rowBegin) * mip.width * 4, mip.width, rowCount, alphaScale, format,
+                              output + static_cast<size_t>(rowBegin) * mip.rowPitch, mip.rowPitch, scratch.data());
+                });
+            }
+
+            previousLevel.swap(currentLevel);
+            previous = current;
+            previous.data = reinterpret_cast<const uint8_t*>(previousLevel.data());
+        }
+
+        return true;
+    }
+}
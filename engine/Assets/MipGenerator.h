@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Core/Containers.h"
+#include "Graphics/PixelFormat.h"
+#include "Graphics/Types.h"
+
+namespace alimer
+{
+    /// Filter used to downsample one mip level into the next.
+    enum class MipFilter : uint32_t
+    {
+        /// Area weighted average of the covered texels.
+        Box,
+        /// Kaiser windowed sinc, sharper than box with little ringing.
+        Kaiser,
+        /// Three lobe Lanczos windowed sinc, the sharpest with some ringing.
+        Lanczos,
+    };
+
+    struct MipGenerationOptions
+    {
+        MipFilter filter = MipFilter::Kaiser;
+        /// Number of levels including the base level, zero builds the full chain down to 1x1.
+        uint32_t mipLevels = 0;
+        /// Scale the alpha of every generated level so the fraction of texels with alpha above alphaReference matches
+        /// the base level. Keeps alpha tested foliage and fences from thinning out in the distance.
+        bool preserveAlphaCoverage = false;
+        float alphaReference = 0.5f;
+    };
+
+    struct MipLevel
+    {
+        uint32_t width;
+        uint32_t height;
+        uint32_t rowPitch;
+        /// Offset of the first row inside MipChain::data.
+        size_t offset;
+    };
+
+    /// Levels produced by GenerateMipChain, tightly packed one after another.
+    struct MipChain
+    {
+        PixelFormat format = PixelFormat::Undefined;
+        Vector<MipLevel> levels;
+        Vector<uint8_t> data;
+
+        /// Return the initial data of a level, ready to pass to Graphics::CreateTexture.
+        SubresourceData GetSubresourceData(uint32_t level) const
+        {
+            const MipLevel& mip = levels[level];
+            SubresourceData result;
+            result.pSysMem = data.data() + mip.offset;
+            result.SysMemPitch = mip.rowPitch;
+            result.SysMemSlicePitch = mip.rowPitch * mip.height;
+            return result;
+        }
+    };
+
+    /// Return the number of levels of a full chain, halving (rounding down) until both sizes reach one.
+    ALIMER_API uint32_t GetMipLevelCount(uint32_t width, uint32_t height);
+
+    /// Return true if GenerateMipChain accepts the format: RGBA8 and BGRA8 (UNorm and sRGB), RGBA16Float and RGBA32Float.
+    ALIMER_API bool IsMipGenerationSupported(PixelFormat format);
+
+    /**
+     * Build a mip chain from a width x height image, copying it as level zero. Any size is accepted, each level is
+     * resampled from the previous one kept in linear float, so odd sizes get fractional filter footprints instead of
+     * dropping texels. sRGB formats are filtered in linear space, other formats as stored. Edges clamp. Float formats
+     * keep the filter's overshoot, normalized formats saturate.
+     *
+     * The work is split by rows across the job system, running inline when it is not initialized. A zero row pitch
+     * means tightly packed rows. Returns false if the format is not supported or the image is empty.
+     */
+    ALIMER_API bool GenerateMipChain(PixelFormat format, const void* source, uint32_t rowPitch, uint32_t width, uint32_t height,
+                                     const MipGenerationOptions& options, MipChain& chain);
+}
@@ -41,19 +41,8 @@ namespace alimer
     {
         const uint64_t BufferSize = 2048;
         char buffer[BufferSize];
-        snprintf(buffer, BufferSize, "%s(%d): Assert Failure: ", file, line);
-
-        if (condition != nullptr)
-        {
-            snprintf(buffer, BufferSize, "%s'%s' ", buffer, condition);
-        }
-
-        if (msg != nullptr)
-        {
-            snprintf(buffer, BufferSize, "%s%s", buffer, msg);
-        }
-
-        snprintf(buffer, BufferSize, "%s\n", buffer);
+        snprintf(buffer, BufferSize, "%s(%d): Assert Failure: %s%s%s%s\n", file, line, condition != nullptr ? "'" : "",
+                 condition != nullptr ? condition : "", condition != nullptr ? "' " : "", msg != nullptr ? msg : "");
 
 #if defined(_WIN32) || defined(_WIN64)
         OutputDebugStringA(buffer);
@@ -78,15 +67,13 @@ namespace alimer
                                            ...)
     {
         const char* message = nullptr;
+        char messageBuffer[1024];
         if (msg != nullptr)
         {
-            char messageBuffer[1024];
-            {
-                va_list args;
-                va_start(args, msg);
-                vsnprintf(messageBuffer, 1024, msg, args);
-                va_end(args);
-            }
+            va_list args;
+            va_start(args, msg);
+            vsnprintf(messageBuffer, 1024, msg, args);
+            va_end(args);
 
             message = messageBuffer;
         }
@@ -66,7 +66,7 @@ namespace alimer
         {                                                                                                              \
             if (!(cond))                                                                                               \
             {                                                                                                          \
-                if (alimer::ReportAssertFailure(#cond, __FILE__, __LINE__, (msg), __VA_ARGS__) ==                      \
+                if (alimer::ReportAssertFailure(#cond, __FILE__, __LINE__, (msg), ##__VA_ARGS__) ==                    \
                     alimer::AssertFailBehavior::Halt)                                                                  \
                     ALIMER_DEBUG_BREAK();                                                                              \
             }                                                                                                          \
@@ -75,7 +75,7 @@ namespace alimer
     #define ALIMER_ASSERT_FAIL(msg, ...)                                                                               \
         do                                                                                                             \
         {                                                                                                              \
-            if (alimer::ReportAssertFailure(0, __FILE__, __LINE__, (msg), __VA_ARGS__) ==                              \
+            if (alimer::ReportAssertFailure(0, __FILE__, __LINE__, (msg), ##__VA_ARGS__) ==                            \
                 alimer::AssertFailBehavior::Halt)                                                                      \
                 ALIMER_DEBUG_BREAK();                                                                                  \
         } while (0)
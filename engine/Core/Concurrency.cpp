@@ -21,100 +21,310 @@
 //
 
 #include "Core/Concurrency.h"
+#include <thread>
 
-#ifndef _WIN32
-    #include <pthread.h>
+#if ALIMER_FUTEX
+#    include <climits>
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#elif defined(_WIN32)
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <windows.h>
 #endif
 
 namespace alimer
 {
-    int32_t AtomicIncrement(volatile int32_t* value)
+    namespace
     {
-#if defined(_WIN32)
-        return _InterlockedIncrement((volatile long*)value);
-#else
-        return __sync_fetch_and_add(value, 1) + 1;
+        /// Spin iterations with pause hints before SpinLock starts yielding the thread.
+        constexpr uint32_t kSpinBackoffLimit = 64;
+        /// Spin iterations Mutex tries before sleeping in the kernel.
+        constexpr uint32_t kMutexSpinCount = 40;
+
+#if ALIMER_FUTEX
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex word must be a plain 32-bit integer");
+
+        void FutexWait(std::atomic<uint32_t>& word, uint32_t expected)
+        {
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+        }
+
+        void FutexWake(std::atomic<uint32_t>& word, int count)
+        {
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+        }
 #endif
     }
 
-    int64_t AtomicIncrement(volatile int64_t* value)
+    void ThreadYield() { std::this_thread::yield(); }
+
+    /* SpinLock */
+    void SpinLock::LockSlow()
     {
-#if defined(_WIN32)
-        return _InterlockedIncrement64((volatile long long*)value);
-#else
-        return __sync_fetch_and_add(value, 1) + 1;
-#endif
+        uint32_t backoff = 1;
+        for (;;)
+        {
+            // Spin on a load so waiters share the cache line until the owner releases it.
+            while (locked.load(std::memory_order_relaxed))
+            {
+                if (backoff <= kSpinBackoffLimit)
+                {
+                    for (uint32_t i = 0; i < backoff; ++i)
+                    {
+                        CpuPause();
+                    }
+
+                    backoff <<= 1;
+                }
+                else
+                {
+                    ThreadYield();
+                }
+            }
+
+            if (!locked.exchange(true, std::memory_order_acquire))
+                return;
+        }
     }
 
-    int32_t AtomicDecrement(volatile int32_t* value)
+    /* TicketLock */
+    void TicketLock::lock()
     {
-#if defined(_WIN32)
-        return _InterlockedDecrement((volatile long*)value);
-#else
-        return __sync_fetch_and_sub(value, 1) - 1;
-#endif
+        const uint32_t ticket = next.fetch_add(1, std::memory_order_relaxed);
+        uint32_t spins = 0;
+        for (;;)
+        {
+            const uint32_t current = serving.load(std::memory_order_acquire);
+            if (current == ticket)
+                return;
+
+            // Pause proportionally to the number of threads ahead in the queue. The holder or a thread ahead may have been
+            // preempted, so stop burning the time slice after a while.
+            if (spins < kSpinBackoffLimit)
+            {
+                const uint32_t distance = ticket - current;
+                for (uint32_t i = 0; i < distance * 8; ++i)
+                {
+                    CpuPause();
+                }
+
+                spins++;
+            }
+            else
+            {
+                ThreadYield();
+            }
+        }
     }
 
-    int64_t AtomicDecrement(volatile int64_t* value)
+    /* Mutex */
+#if ALIMER_FUTEX
+    void Mutex::lock()
     {
-#if defined(_WIN32)
-        return _InterlockedDecrement64((volatile long long*)value);
-#else
-        return __sync_fetch_and_sub(value, 1) - 1;
-#endif
+        uint32_t expected = 0;
+        if (state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return;
+
+        // Short spin, most critical sections are shorter than a context switch.
+        for (uint32_t i = 0; i < kMutexSpinCount; ++i)
+        {
+            CpuPause();
+            expected = 0;
+            if (state.load(std::memory_order_relaxed) == 0 &&
+                state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+        }
+
+        // Mark the mutex as contended and sleep until it is released.
+        while (state.exchange(2, std::memory_order_acquire) != 0)
+        {
+            FutexWait(state, 2);
+        }
     }
 
-    int32_t AtomicAdd(volatile int32_t* addend, int32_t value)
+    bool Mutex::try_lock()
     {
-#if defined(_WIN32)
-        return _InterlockedExchangeAdd((volatile long*)addend, value);
-#else
-        return __sync_fetch_and_add(addend, value);
-#endif
+        uint32_t expected = 0;
+        return state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
     }
 
-    int64_t AtomicAdd(volatile int64_t* addend, int64_t value)
+    void Mutex::unlock()
     {
-#if defined(_WIN32)
-        return _InterlockedExchangeAdd64((volatile long long*)addend, value);
+        if (state.exchange(0, std::memory_order_release) == 2)
+        {
+            FutexWake(state, 1);
+        }
+    }
+#elif defined(_WIN32)
+    void Mutex::lock() { AcquireSRWLockExclusive(reinterpret_cast<PSRWLOCK>(&srwLock)); }
+
+    bool Mutex::try_lock() { return TryAcquireSRWLockExclusive(reinterpret_cast<PSRWLOCK>(&srwLock)) != FALSE; }
+
+    void Mutex::unlock() { ReleaseSRWLockExclusive(reinterpret_cast<PSRWLOCK>(&srwLock)); }
 #else
-        return __sync_fetch_and_add(addend, value);
+    void Mutex::lock() { mutex.lock(); }
+
+    bool Mutex::try_lock() { return mutex.try_lock(); }
+
+    void Mutex::unlock() { mutex.unlock(); }
 #endif
+
+    /* ThreadEvent */
+    ThreadEvent::ThreadEvent(bool manualReset_, bool initialState)
+        : manualReset(manualReset_)
+        , state(initialState ? 1 : 0)
+    {
     }
 
-    int32_t AtomicSubtract(volatile int32_t* addend, int32_t value)
+#if ALIMER_FUTEX
+    void ThreadEvent::Set()
     {
-#if defined(_WIN32)
-        return _InterlockedExchangeAdd((volatile long*)addend, -value);
-#else
-        return __sync_fetch_and_sub(addend, value);
-#endif
+        state.store(1, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) != 0)
+        {
+            FutexWake(state, manualReset ? INT_MAX : 1);
+        }
     }
 
-    int64_t AtomicSubtract(volatile int64_t* addend, int64_t value)
+    void ThreadEvent::Reset() { state.store(0, std::memory_order_relaxed); }
+
+    void ThreadEvent::Wait()
     {
-#if defined(_WIN32)
-        return _InterlockedExchangeAdd64((volatile long long*)addend, -value);
-#else
-        return __sync_fetch_and_sub(addend, value);
-#endif
+        while (!TryWait())
+        {
+            waiters.fetch_add(1, std::memory_order_seq_cst);
+            FutexWait(state, 0);
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
     }
 
-    bool CompareAndExchange(volatile int32_t* dest, int32_t exchange, int32_t comperand)
+    bool ThreadEvent::TryWait()
     {
-#if defined(_WIN32)
-        return _InterlockedCompareExchange((volatile long*)dest, exchange, comperand) == comperand;
+        if (manualReset)
+            return state.load(std::memory_order_acquire) != 0;
+
+        uint32_t expected = 1;
+        return state.compare_exchange_strong(expected, 0, std::memory_order_acquire, std::memory_order_relaxed);
+    }
 #else
-        return __sync_bool_compare_and_swap(dest, comperand, exchange);
+    void ThreadEvent::Set()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            state = true;
+        }
+
+        if (manualReset)
+        {
+            condition.notify_all();
+        }
+        else
+        {
+            condition.notify_one();
+        }
+    }
+
+    void ThreadEvent::Reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        state = false;
+    }
+
+    void ThreadEvent::Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return state; });
+        if (!manualReset)
+        {
+            state = false;
+        }
+    }
+
+    bool ThreadEvent::TryWait()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const bool result = state;
+        if (!manualReset)
+        {
+            state = false;
+        }
+        return result;
+    }
 #endif
+
+    /* Semaphore */
+    Semaphore::Semaphore(uint32_t initialCount)
+        : count(initialCount)
+    {
+    }
+
+#if ALIMER_FUTEX
+    void Semaphore::Signal(uint32_t signalCount)
+    {
+        count.fetch_add(signalCount, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) != 0)
+        {
+            FutexWake(count, static_cast<int>(Min<uint32_t>(signalCount, INT_MAX)));
+        }
     }
 
-    bool CompareAndExchange64(volatile int64_t* dest, int64_t exchange, int64_t comperand)
+    void Semaphore::Wait()
     {
-#if defined(_WIN32)
-        return _InterlockedCompareExchange64(dest, exchange, comperand) == comperand;
+        while (!TryWait())
+        {
+            waiters.fetch_add(1, std::memory_order_seq_cst);
+            FutexWait(count, 0);
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool Semaphore::TryWait()
+    {
+        uint32_t current = count.load(std::memory_order_relaxed);
+        while (current != 0)
+        {
+            if (count.compare_exchange_weak(current, current - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+
+        return false;
+    }
 #else
-        return __sync_bool_compare_and_swap(dest, comperand, exchange);
-#endif
+    void Semaphore::Signal(uint32_t signalCount)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            count += signalCount;
+        }
+
+        if (signalCount == 1)
+        {
+            condition.notify_one();
+        }
+        else
+        {
+            condition.notify_all();
+        }
     }
+
+    void Semaphore::Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return count != 0; });
+        count--;
+    }
+
+    bool Semaphore::TryWait()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == 0)
+            return false;
+
+        count--;
+        return true;
+    }
+#endif
 }
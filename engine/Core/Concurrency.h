@@ -19,22 +19,375 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 //
+
 #pragma once
 
 #include "PlatformDef.h"
+#include <atomic>
+
+#if defined(_WIN32)
+#    include <intrin.h>
+#elif ALIMER_SSE_INTRINSICS
+#    include <emmintrin.h>
+#endif
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#    define ALIMER_FUTEX 1
+#else
+#    define ALIMER_FUTEX 0
+#    include <condition_variable>
+#    include <mutex>
+#endif
 
 namespace alimer
 {
-    ALIMER_API int32_t AtomicIncrement(volatile int32_t* value);
-    ALIMER_API int64_t AtomicIncrement(volatile int64_t* value);
-    ALIMER_API int32_t AtomicDecrement(volatile int32_t* value);
-    ALIMER_API int64_t AtomicDecrement(volatile int64_t* value);
-
-    ALIMER_API int32_t AtomicAdd(volatile int32_t* addend, int32_t value);
-    ALIMER_API int64_t AtomicAdd(volatile int64_t* addend, int64_t value);
-    ALIMER_API int32_t AtomicSubtract(volatile int32_t* addend, int32_t value);
-    ALIMER_API int64_t AtomicSubtract(volatile int64_t* addend, int64_t value);
-
-    ALIMER_API bool CompareAndExchange(volatile int32_t* dest, int32_t exchange, int32_t comperand);
-    ALIMER_API bool CompareAndExchange64(volatile int64_t* dest, int64_t exchange, int64_t comperand);
+    /// Memory ordering of an atomic operation, same semantics as std::memory_order.
+    enum class MemoryOrder : uint32_t
+    {
+        Relaxed,
+        Acquire,
+        Release,
+        AcqRel,
+        SeqCst
+    };
+
+    namespace details
+    {
+#if !defined(_WIN32)
+        constexpr int ToBuiltinOrder(MemoryOrder order)
+        {
+            return order == MemoryOrder::Relaxed   ? __ATOMIC_RELAXED
+                   : order == MemoryOrder::Acquire ? __ATOMIC_ACQUIRE
+                   : order == MemoryOrder::Release ? __ATOMIC_RELEASE
+                   : order == MemoryOrder::AcqRel  ? __ATOMIC_ACQ_REL
+                                                   : __ATOMIC_SEQ_CST;
+        }
+
+        /// Stores can't be acquire, loads can't be release.
+        constexpr int ToBuiltinLoadOrder(MemoryOrder order)
+        {
+            return order == MemoryOrder::Relaxed ? __ATOMIC_RELAXED : order == MemoryOrder::SeqCst ? __ATOMIC_SEQ_CST : __ATOMIC_ACQUIRE;
+        }
+
+        constexpr int ToBuiltinStoreOrder(MemoryOrder order)
+        {
+            return order == MemoryOrder::Relaxed ? __ATOMIC_RELAXED : order == MemoryOrder::SeqCst ? __ATOMIC_SEQ_CST : __ATOMIC_RELEASE;
+        }
+
+        constexpr int ToBuiltinFailureOrder(MemoryOrder order)
+        {
+            return order == MemoryOrder::Relaxed || order == MemoryOrder::Release ? __ATOMIC_RELAXED
+                   : order == MemoryOrder::SeqCst                                 ? __ATOMIC_SEQ_CST
+                                                                                  : __ATOMIC_ACQUIRE;
+        }
+#endif
+    }
+
+    /*
+     * Atomic operations on plain integers. Every operation defaults to sequential consistency, pass a weaker order where
+     * the algorithm allows it. On x86 every read-modify-write is a locked instruction regardless of the order, weaker
+     * orders still let the compiler reorder around them and avoid fences on ARM.
+     */
+
+    /// Increment and return the new value.
+    inline int32_t AtomicIncrement(volatile int32_t* value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedIncrement((volatile long*)value);
+#else
+        return __atomic_add_fetch(value, 1, details::ToBuiltinOrder(order));
+#endif
+    }
+
+    /// Increment and return the new value.
+    inline int64_t AtomicIncrement(volatile int64_t* value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedIncrement64((volatile long long*)value);
+#else
+        return __atomic_add_fetch(value, 1, details::ToBuiltinOrder(order));
+#endif
+    }
+
+    /// Decrement and return the new value.
+    inline int32_t AtomicDecrement(volatile int32_t* value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedDecrement((volatile long*)value);
+#else
+        return __atomic_sub_fetch(value, 1, details::ToBuiltinOrder(order));
+#endif
+    }
+
+    /// Decrement and return the new value.
+    inline int64_t AtomicDecrement(volatile int64_t* value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedDecrement64((volatile long long*)value);
+#else
+        return __atomic_sub_fetch(value, 1, details::ToBuiltinOrder(order));
+#endif
+    }
+
+    /// Add and return the previous value.
+    inline int32_t AtomicAdd(volatile int32_t* addend, int32_t value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedExchangeAdd((volatile long*)addend, value);
+#else
+        return __atomic_fetch_add(addend, value, details::ToBuiltinOrder(order));
+#endif
+    }
+
+    /// Add and return the previous value.
+    inline int64_t AtomicAdd(volatile int64_t* addend, int64_t value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedExchangeAdd64((volatile long long*)addend, value);
+#else
+        return __atomic_fetch_add(addend, value, details::ToBuiltinOrder(order));
+#endif
+    }
+
+    /// Subtract and return the previous value.
+    inline int32_t AtomicSubtract(volatile int32_t* addend, int32_t value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedExchangeAdd((volatile long*)addend, -value);
+#else
+        return __atomic_fetch_sub(addend, value, details::ToBuiltinOrder(order));
+#endif
+    }
+
+    /// Subtract and return the previous value.
+    inline int64_t AtomicSubtract(volatile int64_t* addend, int64_t value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedExchangeAdd64((volatile long long*)addend, -value);
+#else
+        return __atomic_fetch_sub(addend, value, details::ToBuiltinOrder(order));
+#endif
+    }
+
+    /// Load a value.
+    inline int32_t AtomicLoad(const volatile int32_t* value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        // Aligned 32-bit loads are atomic, the barrier keeps the compiler from moving accesses across the load.
+        ALIMER_UNUSED(order);
+        const int32_t result = *value;
+        _ReadWriteBarrier();
+        return result;
+#else
+        return __atomic_load_n(value, details::ToBuiltinLoadOrder(order));
+#endif
+    }
+
+    /// Load a value.
+    inline int64_t AtomicLoad(const volatile int64_t* value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedOr64((volatile long long*)value, 0);
+#else
+        return __atomic_load_n(value, details::ToBuiltinLoadOrder(order));
+#endif
+    }
+
+    /// Store a value.
+    inline void AtomicStore(volatile int32_t* dest, int32_t value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        _InterlockedExchange((volatile long*)dest, value);
+#else
+        __atomic_store_n(dest, value, details::ToBuiltinStoreOrder(order));
+#endif
+    }
+
+    /// Store a value.
+    inline void AtomicStore(volatile int64_t* dest, int64_t value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        _InterlockedExchange64((volatile long long*)dest, value);
+#else
+        __atomic_store_n(dest, value, details::ToBuiltinStoreOrder(order));
+#endif
+    }
+
+    /// Replace dest with exchange if it equals comperand. Returns true on success.
+    inline bool CompareAndExchange(volatile int32_t* dest, int32_t exchange, int32_t comperand, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedCompareExchange((volatile long*)dest, exchange, comperand) == comperand;
+#else
+        return __atomic_compare_exchange_n(dest, &comperand, exchange, false, details::ToBuiltinOrder(order),
+                                           details::ToBuiltinFailureOrder(order));
+#endif
+    }
+
+    /// Replace dest with exchange if it equals comperand. Returns true on success.
+    inline bool CompareAndExchange64(volatile int64_t* dest, int64_t exchange, int64_t comperand, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+#if defined(_WIN32)
+        ALIMER_UNUSED(order);
+        return _InterlockedCompareExchange64(dest, exchange, comperand) == comperand;
+#else
+        return __atomic_compare_exchange_n(dest, &comperand, exchange, false, details::ToBuiltinOrder(order),
+                                           details::ToBuiltinFailureOrder(order));
+#endif
+    }
+
+    /// Hint the CPU that the calling thread is spinning.
+    inline void CpuPause()
+    {
+#if defined(_WIN32) && (ALIMER_ARCH_X64 || ALIMER_ARCH_X86)
+        _mm_pause();
+#elif defined(_WIN32)
+        __yield();
+#elif ALIMER_SSE_INTRINSICS
+        _mm_pause();
+#elif ALIMER_ARCH_A64 || ALIMER_ARCH_ARM
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    /// Give the rest of the time slice to another thread.
+    ALIMER_API void ThreadYield();
+
+    /**
+     * Test-and-test-and-set spin lock with exponential backoff. Waiters spin on a plain load with pause hints and fall
+     * back to yielding the thread after a while. Use for critical sections of a few instructions.
+     */
+    class ALIMER_API SpinLock final
+    {
+    public:
+        SpinLock() = default;
+        SpinLock(const SpinLock&) = delete;
+        SpinLock& operator=(const SpinLock&) = delete;
+
+        void lock()
+        {
+            if (!locked.exchange(true, std::memory_order_acquire))
+                return;
+
+            LockSlow();
+        }
+
+        bool try_lock() { return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire); }
+
+        void unlock() { locked.store(false, std::memory_order_release); }
+
+    private:
+        void LockSlow();
+
+        std::atomic<bool> locked{false};
+    };
+
+    /// FIFO spin lock: threads acquire the lock in the order they asked for it, which bounds waiting under contention.
+    class ALIMER_API TicketLock final
+    {
+    public:
+        TicketLock() = default;
+        TicketLock(const TicketLock&) = delete;
+        TicketLock& operator=(const TicketLock&) = delete;
+
+        void lock();
+
+        bool try_lock()
+        {
+            uint32_t ticket = serving.load(std::memory_order_relaxed);
+            return next.compare_exchange_strong(ticket, ticket + 1, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
+        void unlock() { serving.store(serving.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    private:
+        std::atomic<uint32_t> next{0};
+        std::atomic<uint32_t> serving{0};
+    };
+
+    /// Mutex that sleeps in the kernel only when contended. Futex based on Linux, SRW lock on Windows, std::mutex elsewhere.
+    class ALIMER_API Mutex final
+    {
+    public:
+        Mutex() = default;
+        Mutex(const Mutex&) = delete;
+        Mutex& operator=(const Mutex&) = delete;
+
+        void lock();
+        bool try_lock();
+        void unlock();
+
+    private:
+#if ALIMER_FUTEX
+        /// 0: unlocked, 1: locked, 2: locked with waiters.
+        std::atomic<uint32_t> state{0};
+#elif defined(_WIN32)
+        /// SRWLOCK storage, SRWLOCK_INIT is zero.
+        void* srwLock = nullptr;
+#else
+        std::mutex mutex;
+#endif
+    };
+
+    /// Binary event threads can wait on. Auto reset events release a single waiter and reset, manual reset events stay set.
+    class ALIMER_API ThreadEvent final
+    {
+    public:
+        explicit ThreadEvent(bool manualReset = false, bool initialState = false);
+        ThreadEvent(const ThreadEvent&) = delete;
+        ThreadEvent& operator=(const ThreadEvent&) = delete;
+
+        void Set();
+        void Reset();
+        void Wait();
+        /// Return true if the event was set, consuming it for auto reset events.
+        bool TryWait();
+
+    private:
+        bool manualReset;
+#if ALIMER_FUTEX
+        std::atomic<uint32_t> state;
+        std::atomic<uint32_t> waiters{0};
+#else
+        bool state;
+        std::mutex mutex;
+        std::condition_variable condition;
+#endif
+    };
+
+    /// Counting semaphore.
+    class ALIMER_API Semaphore final
+    {
+    public:
+        explicit Semaphore(uint32_t initialCount = 0);
+        Semaphore(const Semaphore&) = delete;
+        Semaphore& operator=(const Semaphore&) = delete;
+
+        void Signal(uint32_t count = 1);
+        void Wait();
+        /// Decrement the count if positive. Returns false instead of blocking.
+        bool TryWait();
+
+    private:
+#if ALIMER_FUTEX
+        std::atomic<uint32_t> count;
+        std::atomic<uint32_t> waiters{0};
+#else
+        uint32_t count;
+        std::mutex mutex;
+        std::condition_variable condition;
+#endif
+    };
 }
@@ -22,9 +22,14 @@
 
 #pragma once
 
+#include "Core/Assert.h"
 #include "Core/Hash.h"
 #include "Core/Memory.h"
+#include <atomic>
+#include <cstdlib>
+#include <initializer_list>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace alimer
@@ -42,4 +47,652 @@ namespace alimer
     /** An associative container containing an ordered set of key-value pairs. Usually faster than Map for larger data sets. */
     template <typename K, typename V, typename H = HashType<K>, typename C = std::equal_to<K>, typename A = StdAlloc<std::pair<const K, V>>>
     using UnorderedMap = std::unordered_map<K, V, H, C, A>;
+
+    namespace details
+    {
+        /**
+         * Shared implementation of SmallVector and FixedVector over a pointer/size/capacity triple. Derived classes own
+         * the storage and implement Grow(minCapacity), which must relocate the elements and update the triple.
+         */
+        template <typename T, typename Derived> class VectorBase
+        {
+        public:
+            using value_type = T;
+            using size_type = size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
+            using iterator = T*;
+            using const_iterator = const T*;
+
+            iterator begin() { return first; }
+            iterator end() { return first + count; }
+            const_iterator begin() const { return first; }
+            const_iterator end() const { return first + count; }
+            const_iterator cbegin() const { return first; }
+            const_iterator cend() const { return first + count; }
+
+            T* data() { return first; }
+            const T* data() const { return first; }
+            size_type size() const { return count; }
+            size_type capacity() const { return reserved; }
+            bool empty() const { return count == 0; }
+
+            T& operator[](size_type index)
+            {
+                ALIMER_ASSERT(index < count);
+                return first[index];
+            }
+
+            const T& operator[](size_type index) const
+            {
+                ALIMER_ASSERT(index < count);
+                return first[index];
+            }
+
+            T& front() { return (*this)[0]; }
+            const T& front() const { return (*this)[0]; }
+            T& back() { return (*this)[count - 1]; }
+            const T& back() const { return (*this)[count - 1]; }
+
+            void push_back(const T& value) { emplace_back(value); }
+            void push_back(T&& value) { emplace_back(std::move(value)); }
+
+            template <typename... Args> T& emplace_back(Args&&... args)
+            {
+                if (count == reserved)
+                {
+                    // The argument may alias an element, construct it before relocating.
+                    T value(std::forward<Args>(args)...);
+                    static_cast<Derived*>(this)->Grow(count + 1);
+                    new (first + count) T(std::move(value));
+                }
+                else
+                {
+                    new (first + count) T(std::forward<Args>(args)...);
+                }
+
+                return first[count++];
+            }
+
+            void pop_back()
+            {
+                ALIMER_ASSERT(count > 0);
+                first[--count].~T();
+            }
+
+            iterator erase(const_iterator position)
+            {
+                T* target = first + (position - first);
+                std::move(target + 1, end(), target);
+                pop_back();
+                return target;
+            }
+
+            void clear()
+            {
+                DestroyRange(first, first + count);
+                count = 0;
+            }
+
+            void reserve(size_type newCapacity)
+            {
+                if (newCapacity > reserved)
+                {
+                    static_cast<Derived*>(this)->Grow(newCapacity);
+                }
+            }
+
+            void resize(size_type newSize) { ResizeWith(newSize, [](T* ptr) { new (ptr) T(); }); }
+            void resize(size_type newSize, const T& value) { ResizeWith(newSize, [&value](T* ptr) { new (ptr) T(value); }); }
+
+            void assign(const T* values, size_type valueCount)
+            {
+                clear();
+                reserve(valueCount);
+                std::uninitialized_copy(values, values + valueCount, first);
+                count = valueCount;
+            }
+
+        protected:
+            VectorBase(T* first_, size_type reserved_)
+                : first(first_)
+                , reserved(reserved_)
+            {
+            }
+
+            ~VectorBase() = default;
+
+            static void DestroyRange(T* begin_, T* end_)
+            {
+                for (; begin_ != end_; ++begin_)
+                {
+                    begin_->~T();
+                }
+            }
+
+            /// Move-construct the elements into uninitialized storage and destroy the originals.
+            void Relocate(T* destination)
+            {
+                std::uninitialized_move(first, first + count, destination);
+                DestroyRange(first, first + count);
+            }
+
+            template <typename Construct> void ResizeWith(size_type newSize, Construct&& construct)
+            {
+                if (newSize < count)
+                {
+                    DestroyRange(first + newSize, first + count);
+                }
+                else
+                {
+                    reserve(newSize);
+                    for (size_type i = count; i < newSize; ++i)
+                    {
+                        construct(first + i);
+                    }
+                }
+
+                count = newSize;
+            }
+
+            T* first;
+            size_type count = 0;
+            size_type reserved;
+        };
+    }
+
+    /**
+     * Vector that keeps up to N elements in inline storage and moves to the heap (through the allocator A) only when it
+     * grows past N. Meant for short per-call lists on hot paths. Exposes the commonly used std::vector interface.
+     */
+    template <typename T, size_t N, typename A = StdAlloc<T>>
+    class SmallVector final : public details::VectorBase<T, SmallVector<T, N, A>>
+    {
+        using Base = details::VectorBase<T, SmallVector<T, N, A>>;
+        friend Base;
+
+    public:
+        SmallVector()
+            : Base(InlineData(), N)
+        {
+        }
+
+        SmallVector(std::initializer_list<T> values)
+            : SmallVector()
+        {
+            this->assign(values.begin(), values.size());
+        }
+
+        SmallVector(const SmallVector& rhs)
+            : SmallVector()
+        {
+            this->assign(rhs.data(), rhs.size());
+        }
+
+        SmallVector(SmallVector&& rhs) noexcept
+            : SmallVector()
+        {
+            MoveFrom(rhs);
+        }
+
+        ~SmallVector()
+        {
+            this->clear();
+            FreeHeap();
+        }
+
+        SmallVector& operator=(const SmallVector& rhs)
+        {
+            if (this != &rhs)
+            {
+                this->assign(rhs.data(), rhs.size());
+            }
+
+            return *this;
+        }
+
+        SmallVector& operator=(SmallVector&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                this->clear();
+                MoveFrom(rhs);
+            }
+
+            return *this;
+        }
+
+        /// Return true if the elements live in the inline storage.
+        bool IsInline() const { return this->first == InlineData(); }
+
+    private:
+        T* InlineData() { return reinterpret_cast<T*>(storage); }
+        const T* InlineData() const { return reinterpret_cast<const T*>(storage); }
+
+        void Grow(size_t minCapacity)
+        {
+            const size_t newCapacity = Max(minCapacity, this->reserved * 2);
+            T* newData = std::allocator_traits<A>::allocate(allocator, newCapacity);
+            this->Relocate(newData);
+            FreeHeap();
+            this->first = newData;
+            this->reserved = newCapacity;
+        }
+
+        void FreeHeap()
+        {
+            if (!IsInline())
+            {
+                std::allocator_traits<A>::deallocate(allocator, this->first, this->reserved);
+                this->first = InlineData();
+                this->reserved = N;
+            }
+        }
+
+        void MoveFrom(SmallVector& rhs)
+        {
+            if (rhs.IsInline())
+            {
+                this->reserve(rhs.count);
+                rhs.Relocate(this->first);
+                this->count = rhs.count;
+                rhs.count = 0;
+            }
+            else
+            {
+                // Steal the heap block.
+                FreeHeap();
+                this->first = rhs.first;
+                this->reserved = rhs.reserved;
+                this->count = rhs.count;
+                rhs.first = rhs.InlineData();
+                rhs.reserved = N;
+                rhs.count = 0;
+            }
+        }
+
+        A allocator;
+        alignas(T) unsigned char storage[N * sizeof(T)];
+    };
+
+    /**
+     * Vector with a fixed capacity of N elements in inline storage that never allocates. Growing past N is a programming
+     * error and aborts in every build configuration. Exposes the commonly used std::vector interface.
+     */
+    template <typename T, size_t N> class FixedVector final : public details::VectorBase<T, FixedVector<T, N>>
+    {
+        static_assert(N > 0, "FixedVector capacity must not be zero");
+
+        using Base = details::VectorBase<T, FixedVector<T, N>>;
+        friend Base;
+
+    public:
+        FixedVector()
+            : Base(reinterpret_cast<T*>(storage), N)
+        {
+        }
+
+        FixedVector(std::initializer_list<T> values)
+            : FixedVector()
+        {
+            this->assign(values.begin(), values.size());
+        }
+
+        FixedVector(const FixedVector& rhs)
+            : FixedVector()
+        {
+            this->assign(rhs.data(), rhs.size());
+        }
+
+        FixedVector(FixedVector&& rhs) noexcept
+            : FixedVector()
+        {
+            rhs.Relocate(this->first);
+            this->count = rhs.count;
+            rhs.count = 0;
+        }
+
+        ~FixedVector() { this->clear(); }
+
+        FixedVector& operator=(const FixedVector& rhs)
+        {
+            if (this != &rhs)
+            {
+                this->assign(rhs.data(), rhs.size());
+            }
+
+            return *this;
+        }
+
+        FixedVector& operator=(FixedVector&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                this->clear();
+                rhs.Relocate(this->first);
+                this->count = rhs.count;
+                rhs.count = 0;
+            }
+
+            return *this;
+        }
+
+        /// Return true if no more elements can be added.
+        bool full() const { return this->count == N; }
+
+    private:
+        void Grow(size_t minCapacity)
+        {
+            // Checked in release builds too, the caller writes past the storage right after.
+            if (minCapacity > N)
+            {
+                ReportAssertFailure("minCapacity <= N", __FILE__, __LINE__, "FixedVector capacity of %zu exceeded", N);
+                std::abort();
+            }
+        }
+
+        alignas(T) unsigned char storage[N * sizeof(T)];
+    };
+
+    /// Size of a cache line, used to pad data written by different threads.
+    static constexpr size_t kCacheLineSize = 64;
+
+    /**
+     * Bounded lock-free multi-producer multi-consumer queue (Dmitry Vyukov's design). Every cell carries a sequence
+     * number that tells producers and consumers whether it is free for the current lap, so a push or pop is a single CAS
+     * on the shared index in the common case. Capacity must be a power of two.
+     */
+    template <typename T, size_t Capacity> class MPMCQueue final
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MPMCQueue capacity must be a power of two");
+
+    public:
+        MPMCQueue()
+        {
+            for (size_t i = 0; i < Capacity; ++i)
+            {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MPMCQueue(const MPMCQueue&) = delete;
+        MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+        /// Push an item. Returns false if the queue is full.
+        bool Push(const T& item) { return Emplace(item); }
+        /// Push an item. Returns false if the queue is full.
+        bool Push(T&& item) { return Emplace(std::move(item)); }
+
+        /// Pop an item. Returns false if the queue is empty.
+        bool Pop(T& item)
+        {
+            size_t pos = dequeuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = cells[pos & kMask];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        item = std::move(cell.data);
+                        cell.sequence.store(pos + Capacity, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /// Push up to count items with a single claim on the shared index. Returns the number of items pushed.
+        size_t PushBatch(const T* items, size_t count)
+        {
+            size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                // Count the consecutive cells that are free for this lap.
+                size_t available = 0;
+                while (available < count && available < Capacity &&
+                       cells[(pos + available) & kMask].sequence.load(std::memory_order_acquire) == pos + available)
+                {
+                    available++;
+                }
+
+                if (available == 0)
+                {
+                    const size_t current = enqueuePos.load(std::memory_order_relaxed);
+                    if (current == pos)
+                        return 0;
+
+                    pos = current;
+                    continue;
+                }
+
+                if (enqueuePos.compare_exchange_weak(pos, pos + available, std::memory_order_relaxed))
+                {
+                    for (size_t i = 0; i < available; ++i)
+                    {
+                        Cell& cell = cells[(pos + i) & kMask];
+                        cell.data = items[i];
+                        cell.sequence.store(pos + i + 1, std::memory_order_release);
+                    }
+
+                    return available;
+                }
+            }
+        }
+
+        /// Pop up to maxCount items with a single claim on the shared index. Returns the number of items popped.
+        size_t PopBatch(T* items, size_t maxCount)
+        {
+            size_t pos = dequeuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                size_t available = 0;
+                while (available < maxCount && available < Capacity &&
+                       cells[(pos + available) & kMask].sequence.load(std::memory_order_acquire) == pos + available + 1)
+                {
+                    available++;
+                }
+
+                if (available == 0)
+                {
+                    const size_t current = dequeuePos.load(std::memory_order_relaxed);
+                    if (current == pos)
+                        return 0;
+
+                    pos = current;
+                    continue;
+                }
+
+                if (dequeuePos.compare_exchange_weak(pos, pos + available, std::memory_order_relaxed))
+                {
+                    for (size_t i = 0; i < available; ++i)
+                    {
+                        Cell& cell = cells[(pos + i) & kMask];
+                        items[i] = std::move(cell.data);
+                        cell.sequence.store(pos + i + Capacity, std::memory_order_release);
+                    }
+
+                    return available;
+                }
+            }
+        }
+
+        /// Return the number of items in the queue. Only a hint while other threads push or pop.
+        size_t GetSizeApprox() const
+        {
+            const size_t dequeue = dequeuePos.load(std::memory_order_relaxed);
+            const size_t enqueue = enqueuePos.load(std::memory_order_relaxed);
+            return enqueue > dequeue ? enqueue - dequeue : 0;
+        }
+
+        static constexpr size_t GetCapacity() { return Capacity; }
+
+    private:
+        static constexpr size_t kMask = Capacity - 1;
+
+        template <typename U> bool Emplace(U&& item)
+        {
+            size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = cells[pos & kMask];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.data = std::forward<U>(item);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        alignas(kCacheLineSize) Cell cells[Capacity];
+        alignas(kCacheLineSize) std::atomic<size_t> enqueuePos{0};
+        alignas(kCacheLineSize) std::atomic<size_t> dequeuePos{0};
+    };
+
+    /**
+     * Bounded lock-free single-producer single-consumer ring buffer. Each side keeps a cached copy of the other side's
+     * index and only reloads it when the queue looks full or empty, so the indices rarely bounce between cores.
+     * Capacity must be a power of two.
+     */
+    template <typename T, size_t Capacity> class SPSCQueue final
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SPSCQueue capacity must be a power of two");
+
+    public:
+        SPSCQueue() = default;
+        SPSCQueue(const SPSCQueue&) = delete;
+        SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+        /// Push an item, producer thread only. Returns false if the queue is full.
+        bool Push(const T& item) { return PushBatch(&item, 1) == 1; }
+
+        /// Push an item, producer thread only. Returns false if the queue is full.
+        bool Push(T&& item)
+        {
+            const size_t tail = producer.tail.load(std::memory_order_relaxed);
+            if (tail - producer.cachedHead == Capacity)
+            {
+                producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+                if (tail - producer.cachedHead == Capacity)
+                    return false;
+            }
+
+            data[tail & kMask] = std::move(item);
+            producer.tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// Pop an item, consumer thread only. Returns false if the queue is empty.
+        bool Pop(T& item) { return PopBatch(&item, 1) == 1; }
+
+        /// Push up to count items, producer thread only. Returns the number of items pushed.
+        size_t PushBatch(const T* items, size_t count)
+        {
+            const size_t tail = producer.tail.load(std::memory_order_relaxed);
+            size_t freeSlots = Capacity - (tail - producer.cachedHead);
+            if (freeSlots < count)
+            {
+                producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+                freeSlots = Capacity - (tail - producer.cachedHead);
+            }
+
+            const size_t pushCount = Min(count, freeSlots);
+            for (size_t i = 0; i < pushCount; ++i)
+            {
+                data[(tail + i) & kMask] = items[i];
+            }
+
+            if (pushCount != 0)
+            {
+                producer.tail.store(tail + pushCount, std::memory_order_release);
+            }
+
+            return pushCount;
+        }
+
+        /// Pop up to maxCount items, consumer thread only. Returns the number of items popped.
+        size_t PopBatch(T* items, size_t maxCount)
+        {
+            const size_t head = consumer.head.load(std::memory_order_relaxed);
+            size_t availableItems = consumer.cachedTail - head;
+            if (availableItems < maxCount)
+            {
+                consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+                availableItems = consumer.cachedTail - head;
+            }
+
+            const size_t popCount = Min(maxCount, availableItems);
+            for (size_t i = 0; i < popCount; ++i)
+            {
+                items[i] = std::move(data[(head + i) & kMask]);
+            }
+
+            if (popCount != 0)
+            {
+                consumer.head.store(head + popCount, std::memory_order_release);
+            }
+
+            return popCount;
+        }
+
+        /// Return the number of items in the queue. Only a hint while the other side is active.
+        size_t GetSizeApprox() const
+        {
+            return producer.tail.load(std::memory_order_relaxed) - consumer.head.load(std::memory_order_relaxed);
+        }
+
+        static constexpr size_t GetCapacity() { return Capacity; }
+
+    private:
+        static constexpr size_t kMask = Capacity - 1;
+
+        struct alignas(kCacheLineSize) ProducerState
+        {
+            std::atomic<size_t> tail{0};
+            size_t cachedHead = 0;
+        };
+
+        struct alignas(kCacheLineSize) ConsumerState
+        {
+            std::atomic<size_t> head{0};
+            size_t cachedTail = 0;
+        };
+
+        ProducerState producer;
+        ConsumerState consumer;
+        alignas(kCacheLineSize) T data[Capacity];
+    };
 }
@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Core/FrameStats.h"
+#include <algorithm>
+
+namespace alimer
+{
+    namespace
+    {
+        double TicksToMilliseconds(uint64_t ticks) { return static_cast<double>(ticks) * 1000.0 / static_cast<double>(Stopwatch::GetFrequency()); }
+
+        /// Nearest-rank percentile of sorted samples.
+        double Percentile(const Vector<double>& sorted, double percentile)
+        {
+            const size_t rank = static_cast<size_t>(percentile * static_cast<double>(sorted.size()) + 0.999999);
+            return sorted[Min(Max(rank, size_t(1)), sorted.size()) - 1];
+        }
+    }
+
+    FrameStats::FrameStats(uint32_t windowSize_)
+        : windowSize(Max(windowSize_, 1u))
+    {
+        frameTimes.resize(windowSize);
+        for (Vector<double>& times : phaseTimes)
+        {
+            times.resize(windowSize);
+        }
+        scratch.reserve(windowSize);
+    }
+
+    void FrameStats::BeginFrame()
+    {
+        frameBegin = Stopwatch::GetTimestamp();
+        for (uint64_t& ticks : currentPhaseTicks)
+        {
+            ticks = 0;
+        }
+    }
+
+    void FrameStats::EndFrame()
+    {
+        lastFrameTime = TicksToMilliseconds(Stopwatch::GetTimestamp() - frameBegin);
+
+        // Compare against the frames before this one so a spike does not raise its own baseline.
+        if (sampleCount >= kMedianWindowSize / 2)
+        {
+            const double median = GetMovingMedian();
+            if (lastFrameTime > median * stutterFactor && lastFrameTime - median >= stutterMinExcess)
+            {
+                stutterCount++;
+                if (stutterCallback)
+                {
+                    stutterCallback({frameCount, lastFrameTime, median});
+                }
+            }
+        }
+
+        frameTimes[writeIndex] = lastFrameTime;
+        for (uint32_t i = 0; i < kPhaseCount; ++i)
+        {
+            phaseTimes[i][writeIndex] = TicksToMilliseconds(currentPhaseTicks[i]);
+        }
+
+        writeIndex = (writeIndex + 1) % windowSize;
+        sampleCount = Min(sampleCount + 1, windowSize);
+        frameCount++;
+
+        if (exportCallback && exportInterval != 0 && frameCount % exportInterval == 0)
+        {
+            exportCallback(*this);
+        }
+    }
+
+    FrameTimeSummary FrameStats::GetFrameSummary() const { return Summarize(frameTimes); }
+
+    FrameTimeSummary FrameStats::GetPhaseSummary(FramePhase phase) const { return Summarize(phaseTimes[static_cast<uint32_t>(phase)]); }
+
+    void FrameStats::GetFrameTimes(Vector<double>& result) const
+    {
+        result.clear();
+        const uint32_t first = (writeIndex + windowSize - sampleCount) % windowSize;
+        for (uint32_t i = 0; i < sampleCount; ++i)
+        {
+            result.push_back(frameTimes[(first + i) % windowSize]);
+        }
+    }
+
+    void FrameStats::SetStutterThreshold(double factor, double minExcess)
+    {
+        stutterFactor = factor;
+        stutterMinExcess = minExcess;
+    }
+
+    void FrameStats::SetExportCallback(const ExportCallback& callback, uint32_t interval)
+    {
+        exportCallback = callback;
+        exportInterval = interval;
+    }
+
+    void FrameStats::Reset()
+    {
+        writeIndex = 0;
+        sampleCount = 0;
+        frameCount = 0;
+        stutterCount = 0;
+        lastFrameTime = 0.0;
+    }
+
+    FrameTimeSummary FrameStats::Summarize(const Vector<double>& samples) const
+    {
+        FrameTimeSummary summary;
+        if (sampleCount == 0)
+            return summary;
+
+        // Order does not matter, the first sampleCount slots are the filled ones until the window wraps.
+        scratch.assign(samples.begin(), samples.begin() + sampleCount);
+        std::sort(scratch.begin(), scratch.end());
+
+        double total = 0.0;
+        for (double sample : scratch)
+        {
+            total += sample;
+        }
+
+        summary.sampleCount = sampleCount;
+        summary.average = total / static_cast<double>(sampleCount);
+        summary.p50 = Percentile(scratch, 0.50);
+        summary.p95 = Percentile(scratch, 0.95);
+        summary.p99 = Percentile(scratch, 0.99);
+        summary.max = scratch.back();
+        return summary;
+    }
+
+    double FrameStats::GetMovingMedian() const
+    {
+        const uint32_t count = Min(sampleCount, kMedianWindowSize);
+        double recent[kMedianWindowSize];
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            recent[i] = frameTimes[(writeIndex + windowSize - 1 - i) % windowSize];
+        }
+
+        std::nth_element(recent, recent + count / 2, recent + count);
+        return recent[count / 2];
+    }
+}
@@ -0,0 +1,153 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Core/Containers.h"
+#include "Core/Stopwatch.h"
+#include <functional>
+
+namespace alimer
+{
+    /// Parts of a frame timed by FrameStats.
+    enum class FramePhase : uint32_t
+    {
+        PollEvents,
+        BeginCommandBuffer,
+        Draw,
+        /// Command buffer submission and waiting for the swap chain.
+        Present,
+        Count
+    };
+
+    /// Distribution of samples in the window, in milliseconds.
+    struct FrameTimeSummary
+    {
+        uint32_t sampleCount = 0;
+        double average = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    /// A frame much slower than the frames right before it.
+    struct FrameStutter
+    {
+        uint64_t frameIndex;
+        double frameTime;
+        double movingMedian;
+    };
+
+    /// Rolling window of CPU frame and phase times. Percentiles and the maximum show the hitches an average hides,
+    /// frames slower than a multiple of the moving median are reported as stutters.
+    class ALIMER_API FrameStats final
+    {
+    public:
+        static constexpr uint32_t kDefaultWindowSize = 512;
+        static constexpr uint32_t kMedianWindowSize = 31;
+
+        using StutterCallback = std::function<void(const FrameStutter&)>;
+        using ExportCallback = std::function<void(const FrameStats&)>;
+
+        /// Times a phase of the current frame, a phase may be entered several times per frame.
+        class PhaseScope final
+        {
+        public:
+            PhaseScope(FrameStats& stats_, FramePhase phase_)
+                : stats(stats_)
+                , phase(phase_)
+                , begin(Stopwatch::GetTimestamp())
+            {
+            }
+
+            ~PhaseScope() { stats.AddPhaseTime(phase, Stopwatch::GetTimestamp() - begin); }
+
+            PhaseScope(const PhaseScope&) = delete;
+            PhaseScope& operator=(const PhaseScope&) = delete;
+
+        private:
+            FrameStats& stats;
+            FramePhase phase;
+            uint64_t begin;
+        };
+
+        explicit FrameStats(uint32_t windowSize = kDefaultWindowSize);
+
+        void BeginFrame();
+        void EndFrame();
+
+        /// Add ticks to a phase of the current frame.
+        void AddPhaseTime(FramePhase phase, uint64_t ticks) { currentPhaseTicks[static_cast<uint32_t>(phase)] += ticks; }
+
+        /// Return the distribution of frame times in the window.
+        FrameTimeSummary GetFrameSummary() const;
+        /// Return the distribution of a phase in the window.
+        FrameTimeSummary GetPhaseSummary(FramePhase phase) const;
+
+        /// Copy the frame times of the window, oldest first, in milliseconds.
+        void GetFrameTimes(Vector<double>& result) const;
+
+        double GetLastFrameTime() const { return lastFrameTime; }
+        uint64_t GetFrameCount() const { return frameCount; }
+        uint64_t GetStutterCount() const { return stutterCount; }
+        uint32_t GetWindowSize() const { return windowSize; }
+
+        /// Frames slower than factor times the moving median and at least minExcess milliseconds above it are stutters.
+        void SetStutterThreshold(double factor, double minExcess);
+
+        void SetStutterCallback(const StutterCallback& callback) { stutterCallback = callback; }
+
+        /// Call the export callback every interval frames, for example to write the summaries to a HUD or a file.
+        void SetExportCallback(const ExportCallback& callback, uint32_t interval);
+
+        void Reset();
+
+    private:
+        static constexpr uint32_t kPhaseCount = static_cast<uint32_t>(FramePhase::Count);
+
+        FrameTimeSummary Summarize(const Vector<double>& samples) const;
+        double GetMovingMedian() const;
+
+        uint32_t windowSize;
+        /// Samples are stored as ring buffers, frames first then one window per phase.
+        Vector<double> frameTimes;
+        Vector<double> phaseTimes[kPhaseCount];
+        uint32_t writeIndex = 0;
+        uint32_t sampleCount = 0;
+
+        uint64_t frameBegin = 0;
+        uint64_t currentPhaseTicks[kPhaseCount] = {};
+        double lastFrameTime = 0.0;
+        uint64_t frameCount = 0;
+
+        double stutterFactor = 2.0;
+        double stutterMinExcess = 4.0;
+        uint64_t stutterCount = 0;
+        StutterCallback stutterCallback;
+
+        ExportCallback exportCallback;
+        uint32_t exportInterval = 0;
+
+        mutable Vector<double> scratch;
+    };
+}
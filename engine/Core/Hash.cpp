@@ -21,6 +21,17 @@
 //
 /// MurmurHash2, by Austin Appleby
 #include "Core/Hash.h"
+#include <cstring>
+
+#if ALIMER_AVX2_INTRINSICS
+#    include <immintrin.h>
+#elif ALIMER_SSE_INTRINSICS
+#    include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#    include <intrin.h>
+#endif
 
 namespace alimer
 {
@@ -122,4 +133,492 @@ namespace alimer
 
         return h;
     }
+
+    /* HashBytes64 / HashBytes128 / Hasher */
+    namespace
+    {
+        constexpr uint32 kPrime32_1 = 0x9E3779B1u;
+        constexpr uint32 kPrime32_2 = 0x85EBCA77u;
+        constexpr uint32 kPrime32_3 = 0xC2B2AE3Du;
+        constexpr uint64 kPrime64_1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64 kPrime64_2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64 kPrime64_3 = 0x165667B19E3779F9ull;
+        constexpr uint64 kPrime64_4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64 kPrime64_5 = 0x27D4EB2F165667C5ull;
+        constexpr uint64 kPrimeMx1 = 0x165667919E3779F9ull;
+        constexpr uint64 kPrimeMx2 = 0x9FB21C651E98DF25ull;
+
+        constexpr size_t kSecretSize = Hasher::kSecretSize;
+        constexpr size_t kStripeSize = Hasher::kStripeSize;
+        constexpr size_t kSecretConsumeRate = 8;
+        constexpr size_t kStripesPerBlock = (kSecretSize - kStripeSize) / kSecretConsumeRate;
+        constexpr size_t kBlockSize = kStripeSize * kStripesPerBlock;
+        constexpr size_t kMidSizeMax = 240;
+        constexpr size_t kSecretLastAccStart = 7;
+        constexpr size_t kSecretMergeAccsStart = 11;
+
+        /// Pseudo random key material (splitmix64 output), mixed with the input.
+        alignas(64) const uint8 kDefaultSecret[kSecretSize] = {
+            0xfb, 0xa2, 0xf9, 0xc2, 0xa8, 0xee, 0x62, 0x7d, 0x5c, 0xa3, 0x97, 0xfe, 0x57, 0x41, 0x08, 0x7f,
+            0xd3, 0xba, 0x2a, 0x85, 0x88, 0xa8, 0xef, 0xd4, 0x12, 0xdb, 0xc5, 0x2c, 0x41, 0x9b, 0x1f, 0xba,
+            0x43, 0x27, 0x48, 0xdc, 0xbe, 0x86, 0xa3, 0xa5, 0x73, 0xe2, 0x2b, 0x09, 0xa0, 0x1b, 0x9b, 0x17,
+            0x0f, 0xf1, 0x00, 0x10, 0x79, 0xf3, 0x4f, 0xd6, 0xa9, 0x27, 0x19, 0x4d, 0x05, 0xaa, 0x86, 0x32,
+            0x68, 0x93, 0xc7, 0x08, 0x93, 0x07, 0x12, 0x47, 0xb5, 0x35, 0x6f, 0xda, 0xed, 0x89, 0x63, 0x36,
+            0x29, 0x2c, 0x48, 0xf1, 0x45, 0xf0, 0xbe, 0x76, 0x70, 0xab, 0x34, 0x12, 0xc9, 0x9c, 0x3d, 0xcd,
+            0x5e, 0x09, 0x6d, 0x83, 0xbc, 0xb6, 0x2a, 0x32, 0x60, 0x4a, 0x43, 0xbe, 0xd0, 0xb4, 0x51, 0x51,
+            0xf5, 0x37, 0x3f, 0xc9, 0x96, 0x83, 0x59, 0x44, 0xdc, 0x4a, 0x4a, 0x09, 0x1c, 0x50, 0x58, 0xe7,
+            0x25, 0xdc, 0xca, 0x22, 0xaf, 0xab, 0x35, 0x07, 0x62, 0xe5, 0xe6, 0x86, 0x07, 0xc2, 0xb8, 0x34,
+            0x75, 0x26, 0x41, 0xdd, 0x42, 0x99, 0xa6, 0xf7, 0x53, 0x59, 0xe5, 0x7e, 0x19, 0x4e, 0x8d, 0x24,
+            0x64, 0x1b, 0xf0, 0x67, 0x3f, 0x5c, 0x3b, 0x01, 0x85, 0xd1, 0xbf, 0x55, 0x4e, 0xca, 0x00, 0xa5,
+            0xcb, 0x88, 0xdd, 0x60, 0xbf, 0xed, 0xbb, 0xb6, 0x45, 0xfc, 0x3c, 0x22, 0xbd, 0xc4, 0x53, 0x04,
+        };
+
+        // Inputs are read as little endian, like Murmur32.
+        inline uint32 Read32(const uint8* ptr)
+        {
+            uint32 value;
+            memcpy(&value, ptr, sizeof(value));
+            return value;
+        }
+
+        inline uint64 Read64(const uint8* ptr)
+        {
+            uint64 value;
+            memcpy(&value, ptr, sizeof(value));
+            return value;
+        }
+
+        inline void Write64(uint8* ptr, uint64 value) { memcpy(ptr, &value, sizeof(value)); }
+
+        inline uint32 Swap32(uint32 x)
+        {
+            return ((x << 24) & 0xff000000u) | ((x << 8) & 0x00ff0000u) | ((x >> 8) & 0x0000ff00u) | ((x >> 24) & 0x000000ffu);
+        }
+
+        inline uint64 Swap64(uint64 x) { return (uint64(Swap32(uint32(x))) << 32) | uint64(Swap32(uint32(x >> 32))); }
+
+        inline uint64 Rotl64(uint64 x, int r) { return (x << r) | (x >> (64 - r)); }
+
+        /// 64x64->128 multiply, folded to 64 bits by xoring the halves.
+        inline uint64 Mul128Fold64(uint64 lhs, uint64 rhs)
+        {
+#if defined(__SIZEOF_INT128__)
+            const __uint128_t product = static_cast<__uint128_t>(lhs) * rhs;
+            return static_cast<uint64>(product) ^ static_cast<uint64>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            uint64 high;
+            const uint64 low = _umul128(lhs, rhs, &high);
+            return low ^ high;
+#else
+            const uint64 loLo = (lhs & 0xFFFFFFFFull) * (rhs & 0xFFFFFFFFull);
+            const uint64 hiLo = (lhs >> 32) * (rhs & 0xFFFFFFFFull);
+            const uint64 loHi = (lhs & 0xFFFFFFFFull) * (rhs >> 32);
+            const uint64 hiHi = (lhs >> 32) * (rhs >> 32);
+            const uint64 cross = (loLo >> 32) + (hiLo & 0xFFFFFFFFull) + loHi;
+            const uint64 upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+            const uint64 lower = (cross << 32) | (loLo & 0xFFFFFFFFull);
+            return lower ^ upper;
+#endif
+        }
+
+        inline uint64 Avalanche(uint64 h)
+        {
+            h ^= h >> 37;
+            h *= kPrimeMx1;
+            h ^= h >> 32;
+            return h;
+        }
+
+        inline uint64 Avalanche64(uint64 h)
+        {
+            h ^= h >> 33;
+            h *= kPrime64_2;
+            h ^= h >> 29;
+            h *= kPrime64_3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        inline uint64 Rrmxmx(uint64 h, uint64 len)
+        {
+            h ^= Rotl64(h, 49) ^ Rotl64(h, 24);
+            h *= kPrimeMx2;
+            h ^= (h >> 35) + len;
+            h *= kPrimeMx2;
+            return h ^ (h >> 28);
+        }
+
+        inline uint64 Mix16(const uint8* input, const uint8* secret, uint64 seed)
+        {
+            return Mul128Fold64(Read64(input) ^ (Read64(secret) + seed), Read64(input + 8) ^ (Read64(secret + 8) - seed));
+        }
+
+        uint64 HashSmall(const uint8* input, size_t len, const uint8* secret, uint64 seed)
+        {
+            if (len > 8)
+            {
+                const uint64 bitflip1 = (Read64(secret + 24) ^ Read64(secret + 32)) + seed;
+                const uint64 bitflip2 = (Read64(secret + 40) ^ Read64(secret + 48)) - seed;
+                const uint64 low = Read64(input) ^ bitflip1;
+                const uint64 high = Read64(input + len - 8) ^ bitflip2;
+                const uint64 acc = len + Swap64(low) + high + Mul128Fold64(low, high);
+                return Avalanche(acc);
+            }
+
+            if (len >= 4)
+            {
+                seed ^= uint64(Swap32(uint32(seed))) << 32;
+                const uint64 input1 = Read32(input);
+                const uint64 input2 = Read32(input + len - 4);
+                const uint64 bitflip = (Read64(secret + 8) ^ Read64(secret + 16)) - seed;
+                return Rrmxmx((input2 + (input1 << 32)) ^ bitflip, len);
+            }
+
+            if (len > 0)
+            {
+                const uint32 c1 = input[0];
+                const uint32 c2 = input[len >> 1];
+                const uint32 c3 = input[len - 1];
+                const uint32 combined = (c1 << 16) | (c2 << 24) | c3 | (uint32(len) << 8);
+                const uint64 bitflip = (Read32(secret) ^ Read32(secret + 4)) + seed;
+                return Avalanche64(uint64(combined) ^ bitflip);
+            }
+
+            return Avalanche64(seed ^ (Read64(secret + 56) ^ Read64(secret + 64)));
+        }
+
+        uint64 HashMedium(const uint8* input, size_t len, const uint8* secret, uint64 seed)
+        {
+            uint64 acc = len * kPrime64_1;
+            if (len <= 128)
+            {
+                if (len > 32)
+                {
+                    if (len > 64)
+                    {
+                        if (len > 96)
+                        {
+                            acc += Mix16(input + 48, secret + 96, seed);
+                            acc += Mix16(input + len - 64, secret + 112, seed);
+                        }
+                        acc += Mix16(input + 32, secret + 64, seed);
+                        acc += Mix16(input + len - 48, secret + 80, seed);
+                    }
+                    acc += Mix16(input + 16, secret + 32, seed);
+                    acc += Mix16(input + len - 32, secret + 48, seed);
+                }
+                acc += Mix16(input, secret, seed);
+                acc += Mix16(input + len - 16, secret + 16, seed);
+                return Avalanche(acc);
+            }
+
+            const size_t roundCount = len / 16;
+            for (size_t i = 0; i < 8; ++i)
+            {
+                acc += Mix16(input + 16 * i, secret + 16 * i, seed);
+            }
+            acc = Avalanche(acc);
+
+            for (size_t i = 8; i < roundCount; ++i)
+            {
+                acc += Mix16(input + 16 * i, secret + 16 * (i - 8) + 3, seed);
+            }
+            acc += Mix16(input + len - 16, secret + 136 - 17, seed);
+            return Avalanche(acc);
+        }
+
+        /// Hash inputs of up to kMidSizeMax bytes.
+        uint64 HashShort(const uint8* input, size_t len, const uint8* secret, uint64 seed)
+        {
+            return len <= 16 ? HashSmall(input, len, secret, seed) : HashMedium(input, len, secret, seed);
+        }
+
+        /// Mix one 64 byte stripe into the eight accumulators.
+        inline void Accumulate512(uint64* acc, const uint8* input, const uint8* secret)
+        {
+#if ALIMER_AVX2_INTRINSICS
+            for (size_t i = 0; i < 2; ++i)
+            {
+                __m256i* accVector = reinterpret_cast<__m256i*>(acc) + i;
+                const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input) + i);
+                const __m256i key = _mm256_xor_si256(data, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+                const __m256i product = _mm256_mul_epu32(key, _mm256_srli_epi64(key, 32));
+                const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                _mm256_store_si256(accVector, _mm256_add_epi64(_mm256_load_si256(accVector), _mm256_add_epi64(product, swapped)));
+            }
+#elif ALIMER_SSE_INTRINSICS
+            for (size_t i = 0; i < 4; ++i)
+            {
+                __m128i* accVector = reinterpret_cast<__m128i*>(acc) + i;
+                const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input) + i);
+                const __m128i key = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+                const __m128i product = _mm_mul_epu32(key, _mm_srli_epi64(key, 32));
+                const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                _mm_store_si128(accVector, _mm_add_epi64(_mm_load_si128(accVector), _mm_add_epi64(product, swapped)));
+            }
+#else
+            for (size_t i = 0; i < 8; ++i)
+            {
+                const uint64 data = Read64(input + 8 * i);
+                const uint64 key = data ^ Read64(secret + 8 * i);
+                acc[i ^ 1] += data;
+                acc[i] += (key & 0xFFFFFFFFull) * (key >> 32);
+            }
+#endif
+        }
+
+        /// Scramble the accumulators at the end of every block.
+        inline void Scramble(uint64* acc, const uint8* secret)
+        {
+#if ALIMER_AVX2_INTRINSICS
+            const __m256i prime = _mm256_set1_epi32(static_cast<int>(kPrime32_1));
+            for (size_t i = 0; i < 2; ++i)
+            {
+                __m256i* accVector = reinterpret_cast<__m256i*>(acc) + i;
+                __m256i value = _mm256_load_si256(accVector);
+                value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+                value = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+                const __m256i low = _mm256_mul_epu32(value, prime);
+                const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+                _mm256_store_si256(accVector, _mm256_add_epi64(low, _mm256_slli_epi64(high, 32)));
+            }
+#elif ALIMER_SSE_INTRINSICS
+            const __m128i prime = _mm_set1_epi32(static_cast<int>(kPrime32_1));
+            for (size_t i = 0; i < 4; ++i)
+            {
+                __m128i* accVector = reinterpret_cast<__m128i*>(acc) + i;
+                __m128i value = _mm_load_si128(accVector);
+                value = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+                value = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+                const __m128i low = _mm_mul_epu32(value, prime);
+                const __m128i high = _mm_mul_epu32(_mm_srli_epi64(value, 32), prime);
+                _mm_store_si128(accVector, _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+            }
+#else
+            for (size_t i = 0; i < 8; ++i)
+            {
+                uint64 value = acc[i];
+                value ^= value >> 47;
+                value ^= Read64(secret + 8 * i);
+                acc[i] = value * kPrime32_1;
+            }
+#endif
+        }
+
+        inline void InitAccumulators(uint64* acc)
+        {
+            acc[0] = kPrime32_3;
+            acc[1] = kPrime64_1;
+            acc[2] = kPrime64_2;
+            acc[3] = kPrime64_3;
+            acc[4] = kPrime64_4;
+            acc[5] = kPrime32_2;
+            acc[6] = kPrime64_5;
+            acc[7] = kPrime32_1;
+        }
+
+        uint64 MergeAccumulators(const uint64* acc, const uint8* secret, uint64 start)
+        {
+            uint64 result = start;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                result += Mul128Fold64(acc[2 * i] ^ Read64(secret + 16 * i), acc[2 * i + 1] ^ Read64(secret + 16 * i + 8));
+            }
+
+            return Avalanche(result);
+        }
+
+        /// Accumulate every stripe of an input longer than kMidSizeMax, the last stripe overlaps the previous one.
+        void HashLong(uint64* acc, const uint8* input, size_t len, const uint8* secret)
+        {
+            InitAccumulators(acc);
+
+            const size_t blockCount = (len - 1) / kBlockSize;
+            for (size_t block = 0; block < blockCount; ++block)
+            {
+                for (size_t stripe = 0; stripe < kStripesPerBlock; ++stripe)
+                {
+                    Accumulate512(acc, input + block * kBlockSize + stripe * kStripeSize, secret + stripe * kSecretConsumeRate);
+                }
+                Scramble(acc, secret + kSecretSize - kStripeSize);
+            }
+
+            const size_t stripeCount = ((len - 1) - blockCount * kBlockSize) / kStripeSize;
+            for (size_t stripe = 0; stripe < stripeCount; ++stripe)
+            {
+                Accumulate512(acc, input + blockCount * kBlockSize + stripe * kStripeSize, secret + stripe * kSecretConsumeRate);
+            }
+
+            Accumulate512(acc, input + len - kStripeSize, secret + kSecretSize - kStripeSize - kSecretLastAccStart);
+        }
+
+        /// Derive the key material for a seed, every 16 bytes get +seed on the first half and -seed on the second.
+        void InitSecret(uint8* secret, uint64 seed)
+        {
+            for (size_t i = 0; i < kSecretSize / 16; ++i)
+            {
+                Write64(secret + 16 * i, Read64(kDefaultSecret + 16 * i) + seed);
+                Write64(secret + 16 * i + 8, Read64(kDefaultSecret + 16 * i + 8) - seed);
+            }
+        }
+
+        inline uint64 FinalizeLong64(const uint64* acc, const uint8* secret, uint64 len)
+        {
+            return MergeAccumulators(acc, secret + kSecretMergeAccsStart, len * kPrime64_1);
+        }
+
+        inline Hash128 FinalizeLong128(const uint64* acc, const uint8* secret, uint64 len)
+        {
+            Hash128 result;
+            result.low = MergeAccumulators(acc, secret + kSecretMergeAccsStart, len * kPrime64_1);
+            result.high = MergeAccumulators(acc, secret + kSecretSize - kStripeSize - kSecretMergeAccsStart, ~(len * kPrime64_2));
+            return result;
+        }
+
+        /// Second seed of the 128-bit hash of short inputs.
+        inline uint64 HighSeed(uint64 seed) { return seed ^ kPrime64_4; }
+    }
+
+    uint64 HashBytes64(const void* data, size_t size, uint64 seed)
+    {
+        const uint8* input = static_cast<const uint8*>(data);
+        if (size <= kMidSizeMax)
+            return HashShort(input, size, kDefaultSecret, seed);
+
+        alignas(64) uint64 acc[8];
+        if (seed == 0)
+        {
+            HashLong(acc, input, size, kDefaultSecret);
+            return FinalizeLong64(acc, kDefaultSecret, size);
+        }
+
+        alignas(64) uint8 secret[kSecretSize];
+        InitSecret(secret, seed);
+        HashLong(acc, input, size, secret);
+        return FinalizeLong64(acc, secret, size);
+    }
+
+    Hash128 HashBytes128(const void* data, size_t size, uint64 seed)
+    {
+        const uint8* input = static_cast<const uint8*>(data);
+        if (size <= kMidSizeMax)
+        {
+            Hash128 result;
+            result.low = HashShort(input, size, kDefaultSecret, seed);
+            result.high = HashShort(input, size, kDefaultSecret, HighSeed(seed));
+            return result;
+        }
+
+        alignas(64) uint64 acc[8];
+        alignas(64) uint8 secret[kSecretSize];
+        InitSecret(secret, seed);
+        HashLong(acc, input, size, secret);
+        return FinalizeLong128(acc, secret, size);
+    }
+
+    Hasher::Hasher(uint64 seed_) { Reset(seed_); }
+
+    void Hasher::Reset(uint64 seed_)
+    {
+        seed = seed_;
+        InitSecret(secret, seed);
+        InitAccumulators(accumulators);
+        bufferSize = 0;
+        stripesInBlock = 0;
+        totalSize = 0;
+    }
+
+    void Hasher::ConsumeStripes(uint64* acc, size_t& stripeIndex, const uint8* data, size_t stripeCount) const
+    {
+        for (size_t i = 0; i < stripeCount; ++i)
+        {
+            Accumulate512(acc, data + i * kStripeSize, secret + stripeIndex * kSecretConsumeRate);
+            if (++stripeIndex == kStripesPerBlock)
+            {
+                Scramble(acc, secret + kSecretSize - kStripeSize);
+                stripeIndex = 0;
+            }
+        }
+    }
+
+    void Hasher::Update(const void* data, size_t size)
+    {
+        const uint8* input = static_cast<const uint8*>(data);
+        totalSize += size;
+
+        // Data is only consumed when more follows, so the buffer always keeps the tail for Finalize.
+        if (bufferSize + size <= kBufferSize)
+        {
+            memcpy(buffer + bufferSize, input, size);
+            bufferSize += size;
+            return;
+        }
+
+        if (bufferSize > 0)
+        {
+            const size_t fill = kBufferSize - bufferSize;
+            memcpy(buffer + bufferSize, input, fill);
+            input += fill;
+            size -= fill;
+            ConsumeStripes(accumulators, stripesInBlock, buffer, kBufferSize / kStripeSize);
+            memcpy(lastStripe, buffer + kBufferSize - kStripeSize, kStripeSize);
+        }
+
+        if (size > kBufferSize)
+        {
+            const size_t consumed = ((size - 1) / kBufferSize) * kBufferSize;
+            ConsumeStripes(accumulators, stripesInBlock, input, consumed / kStripeSize);
+            memcpy(lastStripe, input + consumed - kStripeSize, kStripeSize);
+            input += consumed;
+            size -= consumed;
+        }
+
+        memcpy(buffer, input, size);
+        bufferSize = size;
+    }
+
+    void Hasher::FinalizeLong(uint64* acc) const
+    {
+        memcpy(acc, accumulators, sizeof(accumulators));
+        size_t stripeIndex = stripesInBlock;
+        ConsumeStripes(acc, stripeIndex, buffer, (bufferSize - 1) / kStripeSize);
+
+        const uint8* last = buffer + bufferSize - kStripeSize;
+        uint8 joined[kStripeSize];
+        if (bufferSize < kStripeSize)
+        {
+            // Complete the final stripe with the tail of the previously consumed data.
+            const size_t missing = kStripeSize - bufferSize;
+            memcpy(joined, lastStripe + kStripeSize - missing, missing);
+            memcpy(joined + missing, buffer, bufferSize);
+            last = joined;
+        }
+
+        Accumulate512(acc, last, secret + kSecretSize - kStripeSize - kSecretLastAccStart);
+    }
+
+    uint64 Hasher::Finalize64() const
+    {
+        if (totalSize <= kMidSizeMax)
+            return HashShort(buffer, static_cast<size_t>(totalSize), kDefaultSecret, seed);
+
+        alignas(64) uint64 acc[8];
+        FinalizeLong(acc);
+        return FinalizeLong64(acc, secret, totalSize);
+    }
+
+    Hash128 Hasher::Finalize128() const
+    {
+        if (totalSize <= kMidSizeMax)
+        {
+            Hash128 result;
+            result.low = HashShort(buffer, static_cast<size_t>(totalSize), kDefaultSecret, seed);
+            result.high = HashShort(buffer, static_cast<size_t>(totalSize), kDefaultSecret, HighSeed(seed));
+            return result;
+        }
+
+        alignas(64) uint64 acc[8];
+        FinalizeLong(acc);
+        return FinalizeLong128(acc, secret, totalSize);
+    }
 }
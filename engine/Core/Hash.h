@@ -23,6 +23,8 @@
 #pragma once
 
 #include "PlatformDef.h"
+#include <cstddef>
+#include <functional>
 #include <type_traits>
 #include <utility>
 
@@ -64,22 +66,133 @@ namespace alimer
         return hasher(v);
     }
 
-    constexpr size_t StringHash(const char* input)
+    /// Return the length of a null terminated string, usable in constant expressions.
+    constexpr uint32 StringLength(const char* str)
     {
-        // https://stackoverflow.com/questions/2111667/compile-time-string-hashing
-        size_t hash = sizeof(size_t) == 8 ? 0xcbf29ce484222325 : 0x811c9dc5;
-        const size_t prime = sizeof(size_t) == 8 ? 0x00000100000001b3 : 0x01000193;
+        uint32 length = 0;
+        while (str[length] != '\0')
+        {
+            ++length;
+        }
+
+        return length;
+    }
+
+    /// MurmurHash2 usable in constant expressions. Returns the same value as Murmur32 on little endian targets.
+    constexpr uint32 Murmur32Const(const char* str, uint32 len, uint32 seed)
+    {
+        const uint32 m = 0x5bd1e995;
+        const int r = 24;
+
+        uint32 h = seed ^ len;
+        uint32 offset = 0;
+
+        while (len >= 4)
+        {
+            uint32 k = static_cast<uint32>(static_cast<uint8>(str[offset])) |
+                       (static_cast<uint32>(static_cast<uint8>(str[offset + 1])) << 8) |
+                       (static_cast<uint32>(static_cast<uint8>(str[offset + 2])) << 16) |
+                       (static_cast<uint32>(static_cast<uint8>(str[offset + 3])) << 24);
 
-        while (*input)
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+
+            h *= m;
+            h ^= k;
+
+            offset += 4;
+            len -= 4;
+        }
+
+        switch (len)
         {
-            hash ^= static_cast<size_t>(*input);
-            hash *= prime;
-            ++input;
+        case 3:
+            h ^= static_cast<uint32>(static_cast<uint8>(str[offset + 2])) << 16; // Fallthrough
+        case 2:
+            h ^= static_cast<uint32>(static_cast<uint8>(str[offset + 1])) << 8; // Fallthrough
+        case 1:
+            h ^= static_cast<uint32>(static_cast<uint8>(str[offset]));
+            h *= m;
         }
 
-        return hash;
+        h ^= h >> 13;
+        h *= m;
+        h ^= h >> 15;
+
+        return h;
     }
 
+    /// Hash a null terminated string at compile time, same algorithm and value as StringId32.
+    constexpr size_t StringHash(const char* input) { return Murmur32Const(input, StringLength(input), 0); }
+
     ALIMER_API uint32 Murmur32(const void* key, uint32 len, uint32 seed);
     ALIMER_API uint64 Murmur64(const void* key, uint64 len, uint64 seed);
+
+    /// 128-bit hash value.
+    struct Hash128
+    {
+        uint64 low;
+        uint64 high;
+
+        bool operator==(const Hash128& rhs) const { return low == rhs.low && high == rhs.high; }
+        bool operator!=(const Hash128& rhs) const { return !(*this == rhs); }
+    };
+
+    /**
+     * Hash a block of memory to 64 bits. Uses the XXH3 construction (stripes of 64 bytes accumulated into eight 64-bit
+     * lanes with a keyed 32x32->64 multiply) and runs with AVX2 or SSE2 when the build enables them. The result is the
+     * same on every code path but is not compatible with the reference xxHash implementation. Meant for content
+     * addressing (shader blobs, texture data, pipeline descriptions), not for cryptographic use.
+     */
+    ALIMER_API uint64 HashBytes64(const void* data, size_t size, uint64 seed = 0);
+
+    /// Hash a block of memory to 128 bits, see HashBytes64.
+    ALIMER_API Hash128 HashBytes128(const void* data, size_t size, uint64 seed = 0);
+
+    /// Streaming version of HashBytes64/HashBytes128. Feeding the data in any number of pieces gives the same result as
+    /// hashing it in one call.
+    class ALIMER_API Hasher final
+    {
+    public:
+        static constexpr size_t kSecretSize = 192;
+        static constexpr size_t kBufferSize = 256;
+        static constexpr size_t kStripeSize = 64;
+
+        /// Construct and start a new hash.
+        explicit Hasher(uint64 seed = 0);
+
+        /// Start a new hash.
+        void Reset(uint64 seed = 0);
+
+        /// Add data to the hash.
+        void Update(const void* data, size_t size);
+
+        /// Add the bytes of a trivially copyable value to the hash.
+        template <typename T> void UpdateValue(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be hashed as bytes");
+            Update(&value, sizeof(T));
+        }
+
+        /// Return the 64-bit hash of the data added so far. More data can still be added afterwards.
+        uint64 Finalize64() const;
+
+        /// Return the 128-bit hash of the data added so far. More data can still be added afterwards.
+        Hash128 Finalize128() const;
+
+    private:
+        void ConsumeStripes(uint64* acc, size_t& stripeIndex, const uint8* data, size_t stripeCount) const;
+        void FinalizeLong(uint64* acc) const;
+
+        alignas(64) uint64 accumulators[8];
+        alignas(64) uint8 secret[kSecretSize];
+        uint8 buffer[kBufferSize];
+        /// The last consumed stripe, used when the buffer holds less than a stripe at finalize time.
+        uint8 lastStripe[kStripeSize];
+        size_t bufferSize;
+        size_t stripesInBlock;
+        uint64 totalSize;
+        uint64 seed;
+    };
 }
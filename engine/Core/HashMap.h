@@ -0,0 +1,642 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Core/Hash.h"
+#include "Core/Memory.h"
+#include <cstring>
+#include <iterator>
+#include <memory>
+
+#if ALIMER_SSE_INTRINSICS
+#    include <emmintrin.h>
+#endif
+
+namespace alimer
+{
+    namespace details
+    {
+        /// Spread the bits of a possibly weak hash (identity hashes of integers and pointers) over the whole word.
+        inline uint64_t MixHash(uint64_t hash)
+        {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        inline uint32_t CountTrailingZeros(uint32_t value)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, value);
+            return static_cast<uint32_t>(index);
+#else
+            return static_cast<uint32_t>(__builtin_ctz(value));
+#endif
+        }
+
+        struct MapKeyOf
+        {
+            template <typename Pair> static const auto& Get(const Pair& pair) { return pair.first; }
+        };
+
+        struct SetKeyOf
+        {
+            template <typename Key> static const Key& Get(const Key& key) { return key; }
+        };
+
+        /**
+         * Open addressing hash table with Robin Hood probing. Entries live in one flat array, a parallel metadata array
+         * stores for every slot its probe distance plus one (zero meaning empty) and a byte of the hash. Lookups compare
+         * 16 metadata bytes at a time and stop at the first slot closer to its home than the searched key would be.
+         * Erasing shifts the following entries back, so there are no tombstones and probe lengths never degrade.
+         * Probes never wrap: the arrays have maxDistance extra slots after the last home slot.
+         */
+        template <typename Entry, typename Key, typename KeyOf, typename Hasher, typename KeyEqual, typename Allocator> class RobinHoodTable
+        {
+        protected:
+            using EntryAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
+            using ByteAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<uint8_t>;
+
+            static constexpr size_t kGroupSize = 16;
+            /// Upper bound of the probe distance, keeps distance + group offset inside a signed byte.
+            static constexpr size_t kMaxDistance = 96;
+            static constexpr size_t kMinCapacity = 8;
+            /// Load factor in percent that triggers a grow.
+            static constexpr size_t kMaxLoadPercent = 80;
+            static constexpr size_t npos = ~size_t(0);
+
+        public:
+            using key_type = Key;
+            using value_type = Entry;
+            using size_type = size_t;
+            using hasher = Hasher;
+            using key_equal = KeyEqual;
+            using allocator_type = Allocator;
+
+            template <bool IsConst> class Iterator
+            {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = Entry;
+                using difference_type = std::ptrdiff_t;
+                using pointer = typename std::conditional<IsConst, const Entry*, Entry*>::type;
+                using reference = typename std::conditional<IsConst, const Entry&, Entry&>::type;
+
+                Iterator() = default;
+                Iterator(pointer entry_, const uint8_t* info_, const uint8_t* infoEnd_)
+                    : entry(entry_)
+                    , info(info_)
+                    , infoEnd(infoEnd_)
+                {
+                    SkipEmpty();
+                }
+
+                /// Allow conversion from iterator to const_iterator.
+                template <bool OtherConst, typename = typename std::enable_if<IsConst && !OtherConst>::type>
+                Iterator(const Iterator<OtherConst>& rhs)
+                    : entry(rhs.entry)
+                    , info(rhs.info)
+                    , infoEnd(rhs.infoEnd)
+                {
+                }
+
+                reference operator*() const { return *entry; }
+                pointer operator->() const { return entry; }
+
+                Iterator& operator++()
+                {
+                    ++entry;
+                    ++info;
+                    SkipEmpty();
+                    return *this;
+                }
+
+                Iterator operator++(int)
+                {
+                    Iterator result = *this;
+                    ++*this;
+                    return result;
+                }
+
+                bool operator==(const Iterator& rhs) const { return info == rhs.info; }
+                bool operator!=(const Iterator& rhs) const { return info != rhs.info; }
+
+            private:
+                template <bool> friend class Iterator;
+                friend class RobinHoodTable;
+
+                void SkipEmpty()
+                {
+                    while (info != infoEnd && *info == 0)
+                    {
+                        ++entry;
+                        ++info;
+                    }
+                }
+
+                pointer entry = nullptr;
+                const uint8_t* info = nullptr;
+                const uint8_t* infoEnd = nullptr;
+            };
+
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            RobinHoodTable() = default;
+
+            explicit RobinHoodTable(const Allocator& allocator)
+                : entryAllocator(allocator)
+                , byteAllocator(allocator)
+            {
+            }
+
+            RobinHoodTable(const RobinHoodTable& rhs)
+                : hashFunction(rhs.hashFunction)
+                , keyEqual(rhs.keyEqual)
+                , entryAllocator(rhs.entryAllocator)
+                , byteAllocator(rhs.byteAllocator)
+            {
+                reserve(rhs.entryCount);
+                for (const Entry& entry : rhs)
+                {
+                    InsertNew(Entry(entry));
+                }
+            }
+
+            RobinHoodTable(RobinHoodTable&& rhs) noexcept
+                : hashFunction(std::move(rhs.hashFunction))
+                , keyEqual(std::move(rhs.keyEqual))
+                , entryAllocator(std::move(rhs.entryAllocator))
+                , byteAllocator(std::move(rhs.byteAllocator))
+            {
+                TakeStorage(rhs);
+            }
+
+            ~RobinHoodTable() { Release(); }
+
+            RobinHoodTable& operator=(const RobinHoodTable& rhs)
+            {
+                if (this != &rhs)
+                {
+                    RobinHoodTable copy(rhs);
+                    *this = std::move(copy);
+                }
+
+                return *this;
+            }
+
+            RobinHoodTable& operator=(RobinHoodTable&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    Release();
+                    hashFunction = std::move(rhs.hashFunction);
+                    keyEqual = std::move(rhs.keyEqual);
+                    entryAllocator = std::move(rhs.entryAllocator);
+                    byteAllocator = std::move(rhs.byteAllocator);
+                    TakeStorage(rhs);
+                }
+
+                return *this;
+            }
+
+            iterator begin() { return iterator(entries, infos, infos + GetSlotCount()); }
+            iterator end() { return iterator(entries + GetSlotCount(), infos + GetSlotCount(), infos + GetSlotCount()); }
+            const_iterator begin() const { return const_iterator(entries, infos, infos + GetSlotCount()); }
+            const_iterator end() const
+            {
+                return const_iterator(entries + GetSlotCount(), infos + GetSlotCount(), infos + GetSlotCount());
+            }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+
+            bool empty() const { return entryCount == 0; }
+            size_type size() const { return entryCount; }
+            /// Return the number of home slots.
+            size_type bucket_count() const { return capacity; }
+            float load_factor() const { return capacity != 0 ? static_cast<float>(entryCount) / static_cast<float>(capacity) : 0.0f; }
+
+            iterator find(const Key& key)
+            {
+                const size_t index = FindIndex(key);
+                return index != npos ? MakeIterator(index) : end();
+            }
+
+            const_iterator find(const Key& key) const
+            {
+                const size_t index = FindIndex(key);
+                return index != npos ? const_iterator(entries + index, infos + index, infos + GetSlotCount()) : end();
+            }
+
+            bool contains(const Key& key) const { return FindIndex(key) != npos; }
+            size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+            std::pair<iterator, bool> insert(const Entry& entry) { return EmplaceEntry(Entry(entry)); }
+            std::pair<iterator, bool> insert(Entry&& entry) { return EmplaceEntry(std::move(entry)); }
+
+            template <typename... Args> std::pair<iterator, bool> emplace(Args&&... args) { return EmplaceEntry(Entry(std::forward<Args>(args)...)); }
+
+            /// Erase the entry with the given key. Returns the number of erased entries.
+            size_type erase(const Key& key)
+            {
+                const size_t index = FindIndex(key);
+                if (index == npos)
+                    return 0;
+
+                EraseIndex(index);
+                return 1;
+            }
+
+            /// Erase the entry at the iterator position. Returns an iterator to the following entry.
+            iterator erase(const_iterator position)
+            {
+                const size_t index = static_cast<size_t>(position.info - infos);
+                EraseIndex(index);
+
+                // The following entry, if any, was shifted into the erased slot.
+                return MakeIterator(index);
+            }
+
+            void clear()
+            {
+                if (entryCount == 0)
+                    return;
+
+                const size_t slotCount = GetSlotCount();
+                for (size_t i = 0; i < slotCount; ++i)
+                {
+                    if (infos[i] != 0)
+                    {
+                        entries[i].~Entry();
+                    }
+                }
+
+                memset(infos, 0, slotCount);
+                entryCount = 0;
+            }
+
+            /// Make room for the given number of entries without growing.
+            void reserve(size_type entryCount)
+            {
+                size_t newCapacity = kMinCapacity;
+                while (newCapacity * kMaxLoadPercent / 100 < entryCount)
+                {
+                    newCapacity *= 2;
+                }
+
+                if (newCapacity > capacity)
+                {
+                    Rehash(newCapacity);
+                }
+            }
+
+            hasher hash_function() const { return hashFunction; }
+            key_equal key_eq() const { return keyEqual; }
+
+        protected:
+            struct HashInfo
+            {
+                size_t home;
+                uint8_t tag;
+            };
+
+            HashInfo GetHashInfo(const Key& key) const
+            {
+                const uint64_t hash = MixHash(static_cast<uint64_t>(hashFunction(key)));
+                HashInfo result;
+                // Top bits select the home slot, the low byte is the tag compared before the keys.
+                result.home = capacity != 0 ? static_cast<size_t>(hash >> (64 - capacityBits)) : 0;
+                result.tag = static_cast<uint8_t>(hash);
+                return result;
+            }
+
+            size_t GetSlotCount() const { return capacity != 0 ? capacity + maxDistance : 0; }
+
+            iterator MakeIterator(size_t index) { return iterator(entries + index, infos + index, infos + GetSlotCount()); }
+
+            size_t FindIndex(const Key& key) const
+            {
+                if (entryCount == 0)
+                    return npos;
+
+                const HashInfo hashInfo = GetHashInfo(key);
+                size_t index = hashInfo.home;
+                uint32_t expected = 1;
+
+#if ALIMER_SSE_INTRINSICS
+                const __m128i offsets = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+                const __m128i tagVector = _mm_set1_epi8(static_cast<char>(hashInfo.tag));
+                for (;;)
+                {
+                    const __m128i infoVector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(infos + index));
+                    const __m128i tagsVector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags + index));
+                    const __m128i expectedVector = _mm_add_epi8(_mm_set1_epi8(static_cast<char>(expected)), offsets);
+
+                    // A slot nearer to its home than the key would be ends the probe sequence.
+                    const uint32_t stop = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(infoVector, expectedVector)));
+                    uint32_t match = static_cast<uint32_t>(_mm_movemask_epi8(
+                        _mm_and_si128(_mm_cmpeq_epi8(infoVector, expectedVector), _mm_cmpeq_epi8(tagsVector, tagVector))));
+                    if (stop != 0)
+                    {
+                        match &= (stop & (0u - stop)) - 1u;
+                    }
+
+                    while (match != 0)
+                    {
+                        const size_t candidate = index + CountTrailingZeros(match);
+                        if (keyEqual(KeyOf::Get(entries[candidate]), key))
+                            return candidate;
+
+                        match &= match - 1;
+                    }
+
+                    if (stop != 0)
+                        return npos;
+
+                    index += kGroupSize;
+                    expected += kGroupSize;
+                }
+#else
+                for (;;)
+                {
+                    const uint32_t info = infos[index];
+                    if (info < expected)
+                        return npos;
+
+                    if (info == expected && tags[index] == hashInfo.tag && keyEqual(KeyOf::Get(entries[index]), key))
+                        return index;
+
+                    index++;
+                    expected++;
+                }
+#endif
+            }
+
+            std::pair<iterator, bool> EmplaceEntry(Entry&& entry)
+            {
+                const size_t existing = FindIndex(KeyOf::Get(entry));
+                if (existing != npos)
+                    return {MakeIterator(existing), false};
+
+                return {MakeIterator(InsertNew(std::move(entry))), true};
+            }
+
+            /// Insert an entry whose key is known to be absent. Returns its slot index.
+            size_t InsertNew(Entry&& entry)
+            {
+                if ((entryCount + 1) * 100 > capacity * kMaxLoadPercent)
+                {
+                    Rehash(capacity != 0 ? capacity * 2 : kMinCapacity);
+                }
+
+                size_t insertedIndex = npos;
+                if (TryInsert(entry, insertedIndex))
+                    return insertedIndex;
+
+                // A probe exceeded the distance limit. The new entry may already sit in the table while 'entry' holds the
+                // displaced one, so remember the key, grow and finish the insertion.
+                const Key key = insertedIndex != npos ? KeyOf::Get(entries[insertedIndex]) : KeyOf::Get(entry);
+                do
+                {
+                    Rehash(capacity * 2);
+                    insertedIndex = npos;
+                } while (!TryInsert(entry, insertedIndex));
+
+                return FindIndex(key);
+            }
+
+            /// Robin Hood insertion of an absent key. On failure the entry that could not be placed is left in 'entry'.
+            bool TryInsert(Entry& entry, size_t& insertedIndex)
+            {
+                const HashInfo hashInfo = GetHashInfo(KeyOf::Get(entry));
+                size_t index = hashInfo.home;
+                uint8_t info = 1;
+                uint8_t tag = hashInfo.tag;
+
+                for (;;)
+                {
+                    if (infos[index] == 0)
+                    {
+                        new (entries + index) Entry(std::move(entry));
+                        infos[index] = info;
+                        tags[index] = tag;
+                        entryCount++;
+                        if (insertedIndex == npos)
+                        {
+                            insertedIndex = index;
+                        }
+                        return true;
+                    }
+
+                    if (infos[index] < info)
+                    {
+                        // Take the slot from the entry closer to its home and continue inserting that one.
+                        using std::swap;
+                        swap(entry, entries[index]);
+                        std::swap(info, infos[index]);
+                        std::swap(tag, tags[index]);
+                        if (insertedIndex == npos)
+                        {
+                            insertedIndex = index;
+                        }
+                    }
+
+                    index++;
+                    info++;
+                    if (info > maxDistance)
+                        return false;
+                }
+            }
+
+            void EraseIndex(size_t index)
+            {
+                entries[index].~Entry();
+
+                // Shift the following entries of the cluster back by one slot.
+                size_t next = index + 1;
+                while (infos[next] > 1)
+                {
+                    new (entries + index) Entry(std::move(entries[next]));
+                    entries[next].~Entry();
+                    infos[index] = static_cast<uint8_t>(infos[next] - 1);
+                    tags[index] = tags[next];
+                    index = next;
+                    next++;
+                }
+
+                infos[index] = 0;
+                entryCount--;
+            }
+
+            void Rehash(size_t newCapacity)
+            {
+                Entry* oldEntries = entries;
+                uint8_t* oldInfos = infos;
+                const size_t oldSlotCount = GetSlotCount();
+                const size_t oldCapacity = capacity;
+                const size_t oldMaxDistance = maxDistance;
+
+                capacity = newCapacity;
+                capacityBits = 0;
+                while ((size_t(1) << capacityBits) < newCapacity)
+                {
+                    capacityBits++;
+                }
+                maxDistance = Min(newCapacity, kMaxDistance);
+
+                const size_t slotCount = GetSlotCount();
+                entries = std::allocator_traits<EntryAllocator>::allocate(entryAllocator, slotCount);
+                // Infos and tags share one allocation, infos have a group of padding for the vector loads.
+                infos = std::allocator_traits<ByteAllocator>::allocate(byteAllocator, (slotCount + kGroupSize) * 2);
+                tags = infos + slotCount + kGroupSize;
+                memset(infos, 0, (slotCount + kGroupSize) * 2);
+                entryCount = 0;
+
+                for (size_t i = 0; i < oldSlotCount; ++i)
+                {
+                    if (oldInfos[i] != 0)
+                    {
+                        Entry entry(std::move(oldEntries[i]));
+                        oldEntries[i].~Entry();
+                        size_t ignored = npos;
+                        while (!TryInsert(entry, ignored))
+                        {
+                            // Only reachable with a very poor hash function, grow the new storage again.
+                            Rehash(capacity * 2);
+                        }
+                    }
+                }
+
+                ReleaseStorage(oldEntries, oldInfos, oldCapacity, oldMaxDistance);
+            }
+
+            void ReleaseStorage(Entry* storageEntries, uint8_t* storageInfos, size_t storageCapacity, size_t storageMaxDistance)
+            {
+                if (storageEntries == nullptr)
+                    return;
+
+                const size_t slotCount = storageCapacity + storageMaxDistance;
+                std::allocator_traits<EntryAllocator>::deallocate(entryAllocator, storageEntries, slotCount);
+                std::allocator_traits<ByteAllocator>::deallocate(byteAllocator, storageInfos, (slotCount + kGroupSize) * 2);
+            }
+
+            void Release()
+            {
+                clear();
+                ReleaseStorage(entries, infos, capacity, maxDistance);
+                entries = nullptr;
+                infos = nullptr;
+                tags = nullptr;
+                capacity = 0;
+                capacityBits = 0;
+                maxDistance = 0;
+            }
+
+            void TakeStorage(RobinHoodTable& rhs)
+            {
+                entries = rhs.entries;
+                infos = rhs.infos;
+                tags = rhs.tags;
+                capacity = rhs.capacity;
+                capacityBits = rhs.capacityBits;
+                maxDistance = rhs.maxDistance;
+                entryCount = rhs.entryCount;
+                rhs.entries = nullptr;
+                rhs.infos = nullptr;
+                rhs.tags = nullptr;
+                rhs.capacity = 0;
+                rhs.capacityBits = 0;
+                rhs.maxDistance = 0;
+                rhs.entryCount = 0;
+            }
+
+            Hasher hashFunction;
+            KeyEqual keyEqual;
+            EntryAllocator entryAllocator;
+            ByteAllocator byteAllocator;
+            Entry* entries = nullptr;
+            uint8_t* infos = nullptr;
+            uint8_t* tags = nullptr;
+            size_t capacity = 0;
+            size_t capacityBits = 0;
+            size_t maxDistance = 0;
+            size_t entryCount = 0;
+        };
+    }
+
+    /**
+     * Flat hash map with Robin Hood probing and backward shift deletion, see details::RobinHoodTable. Follows the
+     * std::unordered_map interface for the common operations. Iterators and references are invalidated by any insert
+     * or erase. Keys are stored as non-const to allow moving entries, they must not be modified through iterators.
+     */
+    template <typename K, typename V, typename H = HashType<K>, typename E = std::equal_to<K>, typename A = StdAlloc<std::pair<K, V>>>
+    class HashMap : public details::RobinHoodTable<std::pair<K, V>, K, details::MapKeyOf, H, E, A>
+    {
+        using Base = details::RobinHoodTable<std::pair<K, V>, K, details::MapKeyOf, H, E, A>;
+
+    public:
+        using mapped_type = V;
+        using Base::Base;
+
+        /// Insert the entry if the key is absent, constructing the value from args.
+        template <typename... Args> std::pair<typename Base::iterator, bool> try_emplace(const K& key, Args&&... args)
+        {
+            const size_t existing = this->FindIndex(key);
+            if (existing != Base::npos)
+                return {this->MakeIterator(existing), false};
+
+            const size_t index = this->InsertNew(std::pair<K, V>(std::piecewise_construct, std::forward_as_tuple(key),
+                                                                 std::forward_as_tuple(std::forward<Args>(args)...)));
+            return {this->MakeIterator(index), true};
+        }
+
+        /// Return the value for the key, inserting a default constructed one if absent.
+        V& operator[](const K& key) { return try_emplace(key).first->second; }
+
+        /// Return a pointer to the value for the key, or null if absent.
+        V* TryGet(const K& key)
+        {
+            const size_t index = this->FindIndex(key);
+            return index != Base::npos ? &this->entries[index].second : nullptr;
+        }
+
+        /// Return a pointer to the value for the key, or null if absent.
+        const V* TryGet(const K& key) const
+        {
+            const size_t index = this->FindIndex(key);
+            return index != Base::npos ? &this->entries[index].second : nullptr;
+        }
+    };
+
+    /// Flat hash set with Robin Hood probing and backward shift deletion, see HashMap.
+    template <typename K, typename H = HashType<K>, typename E = std::equal_to<K>, typename A = StdAlloc<K>>
+    class HashSet : public details::RobinHoodTable<K, K, details::SetKeyOf, H, E, A>
+    {
+        using Base = details::RobinHoodTable<K, K, details::SetKeyOf, H, E, A>;
+
+    public:
+        using Base::Base;
+    };
+}
@@ -0,0 +1,532 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+#include "AlimerConfig.h"
+#include "Core/Log.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace alimer
+{
+    namespace
+    {
+        /// Capacity of the queue receiving jobs from threads that are not part of the job system.
+        constexpr size_t kGlobalQueueCapacity = 4096;
+
+        struct DispatchData;
+
+        struct Job
+        {
+            DispatchData* data;
+            JobCounter* counter;
+            uint32 groupId;
+            uint32 groupJobOffset;
+            uint32 groupJobEnd;
+        };
+
+        /// Task shared by all the groups of one dispatch. The jobs of the groups follow it in the same block, which comes
+        /// from the small-object allocator and is released by the last group that finishes.
+        struct DispatchData
+        {
+            JobFunction task;
+            std::atomic<uint32> refs;
+
+            Job* GetJobs() { return reinterpret_cast<Job*>(this + 1); }
+
+            static DispatchData* Allocate(const JobFunction& task, uint32 groupCount)
+            {
+                void* memory = alimer_alloc<SmallAlloc>(sizeof(DispatchData) + groupCount * sizeof(Job));
+                DispatchData* data = new (memory) DispatchData();
+                data->task = task;
+                data->refs.store(groupCount, std::memory_order_relaxed);
+                return data;
+            }
+
+            static void Release(DispatchData* data) { alimer_delete<DispatchData, SmallAlloc>(data); }
+        };
+
+        static_assert(sizeof(DispatchData) % alignof(Job) == 0, "Jobs must be aligned after the dispatch data");
+        static_assert(std::is_trivially_destructible<Job>::value, "Jobs are released with their dispatch without destruction");
+
+        /// Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli: "Correct and Efficient Work-Stealing for Weak
+        /// Memory Models"). Push and Pop are called by the owner thread only, Steal by any other thread.
+        class WorkStealingQueue final
+        {
+        public:
+            WorkStealingQueue()
+                : top(0)
+                , bottom(0)
+                , array(new Array(kInitialCapacity))
+            {
+            }
+
+            ~WorkStealingQueue()
+            {
+                delete array.load(std::memory_order_relaxed);
+                for (Array* retiredArray : retired)
+                {
+                    delete retiredArray;
+                }
+            }
+
+            WorkStealingQueue(const WorkStealingQueue&) = delete;
+            WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+            void Push(Job* job)
+            {
+                int64 b = bottom.load(std::memory_order_relaxed);
+                int64 t = top.load(std::memory_order_acquire);
+                Array* a = array.load(std::memory_order_relaxed);
+
+                if (b - t > a->capacity - 1)
+                {
+                    a = Grow(a, b, t);
+                }
+
+                a->Put(b, job);
+                bottom.store(b + 1, std::memory_order_release);
+            }
+
+            Job* Pop()
+            {
+                int64 b = bottom.load(std::memory_order_relaxed) - 1;
+                Array* a = array.load(std::memory_order_relaxed);
+                bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64 t = top.load(std::memory_order_relaxed);
+
+                Job* job = nullptr;
+                if (t <= b)
+                {
+                    job = a->Get(b);
+                    if (t == b)
+                    {
+                        // Last item, race against thieves.
+                        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                        {
+                            job = nullptr;
+                        }
+
+                        bottom.store(b + 1, std::memory_order_relaxed);
+                    }
+                }
+                else
+                {
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                }
+
+                return job;
+            }
+
+            Job* Steal()
+            {
+                int64 t = top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64 b = bottom.load(std::memory_order_acquire);
+
+                if (t < b)
+                {
+                    Array* a = array.load(std::memory_order_acquire);
+                    Job* job = a->Get(t);
+                    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    {
+                        return nullptr;
+                    }
+
+                    return job;
+                }
+
+                return nullptr;
+            }
+
+        private:
+            static constexpr int64 kInitialCapacity = 1024;
+
+            struct Array
+            {
+                explicit Array(int64 capacity_)
+                    : capacity(capacity_)
+                    , mask(capacity_ - 1)
+                    , buffer(new std::atomic<Job*>[static_cast<size_t>(capacity_)])
+                {
+                }
+
+                ~Array() { delete[] buffer; }
+
+                void Put(int64 index, Job* job) { buffer[index & mask].store(job, std::memory_order_relaxed); }
+                Job* Get(int64 index) const { return buffer[index & mask].load(std::memory_order_relaxed); }
+
+                int64 capacity;
+                int64 mask;
+                std::atomic<Job*>* buffer;
+            };
+
+            Array* Grow(Array* a, int64 b, int64 t)
+            {
+                Array* newArray = new Array(a->capacity * 2);
+                for (int64 i = t; i != b; ++i)
+                {
+                    newArray->Put(i, a->Get(i));
+                }
+
+                // Thieves may still read from the old array, keep it alive until the queue is destroyed.
+                retired.push_back(a);
+                array.store(newArray, std::memory_order_release);
+                return newArray;
+            }
+
+            alignas(kCacheLineSize) std::atomic<int64> top;
+            alignas(kCacheLineSize) std::atomic<int64> bottom;
+            std::atomic<Array*> array;
+            Vector<Array*> retired;
+        };
+
+        struct JobSystemState
+        {
+            /// Queue per thread, index zero belongs to the thread that called Initialize.
+            Vector<WorkStealingQueue*> queues;
+            Vector<std::thread> workers;
+
+            /// Jobs submitted from threads that don't own a queue.
+            MPMCQueue<Job*, kGlobalQueueCapacity> globalQueue;
+
+            /// Number of jobs pushed but not yet taken by any thread.
+            std::atomic<uint32> queuedJobs{0};
+            std::atomic<uint32> sleepingWorkers{0};
+            std::atomic<bool> shuttingDown{false};
+            std::mutex wakeMutex;
+            std::condition_variable wakeCondition;
+
+            bool initialized = false;
+        };
+
+        JobSystemState s_state;
+
+        /// Index of the queue owned by the current thread, -1 for foreign threads.
+        thread_local int32 t_threadIndex = -1;
+        thread_local uint32 t_randomState = 0;
+
+        uint32 NextRandom()
+        {
+            // xorshift32
+            uint32 x = t_randomState != 0 ? t_randomState : 0x9E3779B9u ^ static_cast<uint32>(t_threadIndex + 2);
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            t_randomState = x;
+            return x;
+        }
+
+        void WakeWorkers(uint32 jobCount)
+        {
+            if (s_state.sleepingWorkers.load(std::memory_order_seq_cst) == 0)
+                return;
+
+            std::lock_guard<std::mutex> lock(s_state.wakeMutex);
+            if (jobCount == 1)
+            {
+                s_state.wakeCondition.notify_one();
+            }
+            else
+            {
+                s_state.wakeCondition.notify_all();
+            }
+        }
+
+        Job* FindJob()
+        {
+            Job* job = nullptr;
+            if (t_threadIndex >= 0)
+            {
+                job = s_state.queues[t_threadIndex]->Pop();
+            }
+
+            if (job == nullptr)
+            {
+                s_state.globalQueue.Pop(job);
+            }
+
+            if (job == nullptr && !s_state.queues.empty())
+            {
+                const uint32 queueCount = static_cast<uint32>(s_state.queues.size());
+                const uint32 start = NextRandom() % queueCount;
+                for (uint32 i = 0; i < queueCount && job == nullptr; ++i)
+                {
+                    const uint32 victim = (start + i) % queueCount;
+                    if (static_cast<int32>(victim) != t_threadIndex)
+                    {
+                        job = s_state.queues[victim]->Steal();
+                    }
+                }
+            }
+
+            if (job != nullptr)
+            {
+                s_state.queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            return job;
+        }
+
+        void RunJob(const DispatchData& data, uint32 groupId, uint32 groupJobOffset, uint32 groupJobEnd)
+        {
+            JobArgs args;
+            args.groupId = groupId;
+
+            for (uint32 jobIndex = groupJobOffset; jobIndex < groupJobEnd; ++jobIndex)
+            {
+                args.jobIndex = jobIndex;
+                args.groupIndex = jobIndex - groupJobOffset;
+                args.isFirstJobInGroup = (jobIndex == groupJobOffset);
+                args.isLastJobInGroup = (jobIndex == groupJobEnd - 1);
+                data.task(args);
+            }
+        }
+
+        void ExecuteJob(Job* job)
+        {
+            ALIMER_PROFILE_SCOPE("Job");
+            DispatchData* data = job->data;
+            JobCounter* counter = job->counter;
+            RunJob(*data, job->groupId, job->groupJobOffset, job->groupJobEnd);
+
+            // The job lives in the dispatch block, it must not be touched once the reference is dropped.
+            if (data->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                DispatchData::Release(data);
+            }
+
+            // Signal completion last, the waiting thread may release anything the task referenced.
+            counter->pending.fetch_sub(1, std::memory_order_release);
+        }
+
+        void PushJob(Job* job)
+        {
+            if (t_threadIndex >= 0)
+            {
+                s_state.queues[t_threadIndex]->Push(job);
+                return;
+            }
+
+            // The global queue is bounded, when it is full the submitting thread helps draining it.
+            while (!s_state.globalQueue.Push(job))
+            {
+                if (Job* other = FindJob())
+                {
+                    ExecuteJob(other);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        void WorkerMain(int32 threadIndex)
+        {
+            t_threadIndex = threadIndex;
+            t_randomState = 0;
+            ALIMER_PROFILE_THREAD(fmt::format("Job Worker {}", threadIndex).c_str());
+
+            static constexpr uint32 kSpinCount = 64;
+            uint32 idleSpins = 0;
+
+            while (!s_state.shuttingDown.load(std::memory_order_acquire))
+            {
+                if (Job* job = FindJob())
+                {
+                    ExecuteJob(job);
+                    idleSpins = 0;
+                    continue;
+                }
+
+                if (++idleSpins < kSpinCount)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                // Go to sleep until new jobs are pushed. The sleeping counter and the queued counter are both sequentially
+                // consistent so either the submitter sees us sleeping or we see its job.
+                std::unique_lock<std::mutex> lock(s_state.wakeMutex);
+                s_state.sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+                s_state.wakeCondition.wait(lock, [] {
+                    return s_state.queuedJobs.load(std::memory_order_seq_cst) > 0 ||
+                           s_state.shuttingDown.load(std::memory_order_acquire);
+                });
+                s_state.sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+                idleSpins = 0;
+            }
+
+            t_threadIndex = -1;
+        }
+
+        void Submit(JobCounter& counter, uint32 jobCount, uint32 groupSize, const JobFunction& task)
+        {
+            const uint32 groupCount = JobSystem::DispatchGroupCount(jobCount, groupSize);
+            if (groupCount == 0)
+                return;
+
+            if (!s_state.initialized)
+            {
+                // Run inline, still honour the group layout so callers indexing by group id behave the same.
+                DispatchData data;
+                data.task = task;
+                for (uint32 groupId = 0; groupId < groupCount; ++groupId)
+                {
+                    const uint32 offset = groupId * groupSize;
+                    RunJob(data, groupId, offset, Min(offset + groupSize, jobCount));
+                }
+                return;
+            }
+
+            // One allocation per dispatch instead of one per group.
+            DispatchData* data = DispatchData::Allocate(task, groupCount);
+            Job* jobs = data->GetJobs();
+
+            counter.pending.fetch_add(groupCount, std::memory_order_relaxed);
+            s_state.queuedJobs.fetch_add(groupCount, std::memory_order_seq_cst);
+
+            for (uint32 groupId = 0; groupId < groupCount; ++groupId)
+            {
+                Job* job = new (jobs + groupId) Job();
+                job->data = data;
+                job->counter = &counter;
+                job->groupId = groupId;
+                job->groupJobOffset = groupId * groupSize;
+                job->groupJobEnd = Min(job->groupJobOffset + groupSize, jobCount);
+                PushJob(job);
+            }
+
+            WakeWorkers(groupCount);
+        }
+    }
+
+    namespace JobSystem
+    {
+        void Initialize(uint32 maxThreadCount)
+        {
+            if (s_state.initialized)
+                return;
+
+#if defined(ALIMER_THREADING)
+            uint32 threadCount = Max(1u, std::thread::hardware_concurrency());
+            if (maxThreadCount > 0)
+            {
+                threadCount = Min(threadCount, maxThreadCount);
+            }
+
+            s_state.shuttingDown.store(false, std::memory_order_relaxed);
+            s_state.queues.resize(threadCount);
+            for (uint32 i = 0; i < threadCount; ++i)
+            {
+                s_state.queues[i] = new WorkStealingQueue();
+            }
+
+            // The calling thread owns queue zero and helps executing jobs while waiting.
+            t_threadIndex = 0;
+            s_state.initialized = true;
+
+            for (uint32 i = 1; i < threadCount; ++i)
+            {
+                s_state.workers.emplace_back(WorkerMain, static_cast<int32>(i));
+            }
+
+            LOGI("JobSystem initialized with {} threads", threadCount);
+#else
+            ALIMER_UNUSED(maxThreadCount);
+#endif
+        }
+
+        void Shutdown()
+        {
+            if (!s_state.initialized)
+                return;
+
+            // Drain everything that is still queued.
+            while (s_state.queuedJobs.load(std::memory_order_acquire) > 0)
+            {
+                if (Job* job = FindJob())
+                {
+                    ExecuteJob(job);
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(s_state.wakeMutex);
+                s_state.shuttingDown.store(true, std::memory_order_release);
+                s_state.wakeCondition.notify_all();
+            }
+
+            for (std::thread& worker : s_state.workers)
+            {
+                worker.join();
+            }
+
+            for (WorkStealingQueue* queue : s_state.queues)
+            {
+                delete queue;
+            }
+
+            s_state.workers.clear();
+            s_state.queues.clear();
+            s_state.initialized = false;
+            t_threadIndex = -1;
+        }
+
+        uint32 GetThreadCount() { return s_state.initialized ? static_cast<uint32>(s_state.queues.size()) : 1u; }
+
+        void Execute(JobCounter& counter, const JobFunction& job) { Submit(counter, 1, 1, job); }
+
+        void Dispatch(JobCounter& counter, uint32 jobCount, uint32 groupSize, const JobFunction& job)
+        {
+            Submit(counter, jobCount, Max(groupSize, 1u), job);
+        }
+
+        uint32 DispatchGroupCount(uint32 jobCount, uint32 groupSize)
+        {
+            groupSize = Max(groupSize, 1u);
+            return (jobCount + groupSize - 1) / groupSize;
+        }
+
+        bool IsBusy(const JobCounter& counter) { return counter.pending.load(std::memory_order_acquire) > 0; }
+
+        void Wait(const JobCounter& counter)
+        {
+            while (IsBusy(counter))
+            {
+                if (Job* job = FindJob())
+                {
+                    ExecuteJob(job);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Core/Containers.h"
+#include <atomic>
+#include <functional>
+
+namespace alimer
+{
+    /// Arguments passed to a job function.
+    struct JobArgs
+    {
+        /// Index of the job inside the whole dispatch.
+        uint32 jobIndex;
+        /// Index of the group the job belongs to.
+        uint32 groupId;
+        /// Index of the job inside its group.
+        uint32 groupIndex;
+        /// True if this is the first job executed inside the group.
+        bool isFirstJobInGroup;
+        /// True if this is the last job executed inside the group.
+        bool isLastJobInGroup;
+    };
+
+    /// Tracks completion of submitted jobs. Can be waited on and reused once it reaches zero.
+    struct JobCounter
+    {
+        /// Number of job groups that have not finished yet.
+        std::atomic<uint32> pending{0};
+    };
+
+    using JobFunction = std::function<void(JobArgs)>;
+
+    /// Work-stealing job scheduler. Every worker thread owns a Chase-Lev deque, idle workers steal from the others.
+    /// When ALIMER_THREADING is disabled or the system is not initialized, jobs are executed inline on the calling thread.
+    namespace JobSystem
+    {
+        /// Create the worker threads. Zero thread count uses one worker per hardware thread minus the calling thread.
+        ALIMER_API void Initialize(uint32 maxThreadCount = 0);
+
+        /// Wait for pending work and destroy the worker threads.
+        ALIMER_API void Shutdown();
+
+        /// Return the number of threads executing jobs, including the thread that called Initialize.
+        ALIMER_API uint32 GetThreadCount();
+
+        /// Submit a single job.
+        ALIMER_API void Execute(JobCounter& counter, const JobFunction& job);
+
+        /// Divide a job into jobCount invocations split in groups of groupSize. Each group runs sequentially on one thread.
+        ALIMER_API void Dispatch(JobCounter& counter, uint32 jobCount, uint32 groupSize, const JobFunction& job);
+
+        /// Return the number of groups created by Dispatch for the given job count and group size.
+        ALIMER_API uint32 DispatchGroupCount(uint32 jobCount, uint32 groupSize);
+
+        /// Check whether the counter still has work in flight.
+        ALIMER_API bool IsBusy(const JobCounter& counter);
+
+        /// Wait until the counter reaches zero. The calling thread executes pending jobs while waiting.
+        ALIMER_API void Wait(const JobCounter& counter);
+    }
+
+    /// Invoke func(index) for every index in [begin, end) across the job system and wait for completion.
+    template <typename Func> void ParallelFor(uint32 begin, uint32 end, uint32 grainSize, Func&& func)
+    {
+        if (end <= begin)
+            return;
+
+        JobCounter counter;
+        JobSystem::Dispatch(counter, end - begin, Max(grainSize, 1u), [begin, &func](JobArgs args) { func(begin + args.jobIndex); });
+        JobSystem::Wait(counter);
+    }
+
+    /// Map every index in [begin, end) to a value and combine the values with reduce. Each group of grainSize indices
+    /// accumulates a partial result starting from identity in a local and stores it once, into a slot of its own cache
+    /// line. The partial results are then reduced on the calling thread in group order.
+    template <typename T, typename MapFunc, typename ReduceFunc>
+    T ParallelReduce(uint32 begin, uint32 end, uint32 grainSize, T identity, MapFunc&& map, ReduceFunc&& reduce)
+    {
+        if (end <= begin)
+            return identity;
+
+        struct alignas(kCacheLineSize) Partial
+        {
+            T value;
+        };
+
+        grainSize = Max(grainSize, 1u);
+        const uint32 groupCount = JobSystem::DispatchGroupCount(end - begin, grainSize);
+        Vector<Partial> partials(groupCount, Partial{identity});
+
+        JobCounter counter;
+        JobSystem::Dispatch(counter, groupCount, 1, [begin, end, grainSize, &identity, &partials, &map, &reduce](JobArgs args) {
+            const uint32 groupBegin = begin + args.jobIndex * grainSize;
+            const uint32 groupEnd = groupBegin + Min(grainSize, end - groupBegin);
+            T partial = identity;
+            for (uint32 index = groupBegin; index < groupEnd; ++index)
+            {
+                partial = reduce(partial, map(index));
+            }
+            partials[args.jobIndex].value = partial;
+        });
+        JobSystem::Wait(counter);
+
+        T result = identity;
+        for (const Partial& partial : partials)
+        {
+            result = reduce(result, partial.value);
+        }
+
+        return result;
+    }
+}
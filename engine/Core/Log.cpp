@@ -0,0 +1,735 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Core/Log.h"
+#include "Core/Concurrency.h"
+#include "Core/Containers.h"
+#include "Core/HashMap.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <thread>
+
+namespace alimer
+{
+    namespace
+    {
+        /// Size of the per-thread ring, must be a power of two.
+        constexpr uint32_t kRingSize = 64 * 1024;
+        constexpr uint32_t kRingMask = kRingSize - 1;
+        /// Larger records are written synchronously so one message can not stall the ring.
+        constexpr uint32_t kMaxRecordSize = kRingSize / 4;
+        constexpr uint32_t kRecordAlignment = 8;
+        constexpr uint32_t kMaxArgs = 32;
+        /// Payload size marking the unused tail of the ring, only the first 8 bytes of a padding record are valid.
+        constexpr uint32_t kPaddingRecord = 0xFFFFFFFFu;
+
+        constexpr char kBinaryMagic[4] = {'A', 'L', 'O', 'G'};
+        constexpr uint32_t kBinaryVersion = 1;
+        constexpr uint8_t kBinarySiteTag = 'S';
+        constexpr uint8_t kBinaryMessageTag = 'M';
+
+        struct RecordHeader
+        {
+            uint32_t size;
+            uint32_t payloadSize;
+            const LogSite* site;
+            int64_t timestamp;
+        };
+
+        static_assert(sizeof(RecordHeader) % kRecordAlignment == 0, "Record header must keep records aligned");
+
+        /// Single producer, single consumer byte ring. The owning thread writes records, the log thread reads them.
+        /// Positions grow monotonically and are masked on access.
+        struct LogRing
+        {
+            alignas(64) std::atomic<uint64_t> head{0};
+            alignas(64) std::atomic<uint64_t> tail{0};
+            alignas(64) uint64_t cachedTail = 0;
+            uint64_t pendingHead = 0;
+            /// Set when the owning thread exits, the ring is handed to the next thread that needs one.
+            std::atomic<bool> abandoned{false};
+            alignas(64) uint8_t data[kRingSize];
+        };
+
+        /// Plain data so it stays usable while thread_local destructors run.
+        struct ThreadLog
+        {
+            LogRing* ring;
+            bool isWorker;
+            bool destroyed;
+        };
+
+        ALIMER_THREADLOCAL ThreadLog t_log;
+
+        struct LogState
+        {
+            std::atomic<bool> running{false};
+            std::atomic<bool> stopRequested{false};
+            std::atomic<bool> sleeping{false};
+            std::atomic<uint8_t> level{static_cast<uint8_t>(ALIMER_LOG_LEVEL)};
+            ThreadEvent wakeEvent;
+            std::thread worker;
+
+            /// Guards the ring list. Rings are never freed so the log thread and Flush can hold on to them.
+            Mutex ringsLock;
+            Vector<LogRing*> rings;
+
+            /// Guards the binary output, which Flush and synchronous writes share with the log thread.
+            Mutex fileLock;
+            LogMode mode = LogMode::Text;
+            FILE* binaryFile = nullptr;
+            HashMap<const LogSite*, uint32_t> siteIds;
+        };
+
+        /// Never destroyed so messages logged during static teardown still have a home.
+        LogState& GetState()
+        {
+            alignas(LogState) static unsigned char storage[sizeof(LogState)];
+            static LogState* state = new (storage) LogState();
+            return *state;
+        }
+
+        int64_t GetTimestamp()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        void WakeWorker(LogState& state)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (state.sleeping.load(std::memory_order_relaxed))
+            {
+                state.wakeEvent.Set();
+            }
+        }
+
+        /// Returns rings to the pool when the thread exits.
+        struct ThreadLogReleaser
+        {
+            ~ThreadLogReleaser()
+            {
+                if (t_log.ring != nullptr)
+                {
+                    t_log.ring->abandoned.store(true, std::memory_order_release);
+                    t_log.ring = nullptr;
+                }
+                t_log.destroyed = true;
+            }
+        };
+
+        LogRing* AcquireRing(LogState& state)
+        {
+            static thread_local ThreadLogReleaser releaser;
+            ALIMER_UNUSED(releaser);
+
+            std::lock_guard<Mutex> guard(state.ringsLock);
+            for (LogRing* ring : state.rings)
+            {
+                // An abandoned ring gets no more writes, once the log thread drained it it can be reused.
+                if (ring->abandoned.load(std::memory_order_acquire) &&
+                    ring->tail.load(std::memory_order_acquire) == ring->head.load(std::memory_order_relaxed))
+                {
+                    ring->abandoned.store(false, std::memory_order_relaxed);
+                    return ring;
+                }
+            }
+
+            LogRing* ring = new LogRing();
+            state.rings.push_back(ring);
+            return ring;
+        }
+
+        template <typename T> void WriteValue(FILE* file, const T& value) { fwrite(&value, sizeof(T), 1, file); }
+
+        template <typename T> bool ReadValue(FILE* file, T& value) { return fread(&value, sizeof(T), 1, file) == 1; }
+
+        bool DecodeArgs(const uint8_t* data, uint32_t size, details::LogArg* args, uint32_t& argCount)
+        {
+            using details::LogArgType;
+
+            const uint8_t* end = data + size;
+            argCount = 0;
+            while (data < end)
+            {
+                if (argCount == kMaxArgs)
+                    return false;
+
+                details::LogArg& arg = args[argCount++];
+                arg.type = static_cast<LogArgType>(*data++);
+                switch (arg.type)
+                {
+                    case LogArgType::Bool:
+                    case LogArgType::Char:
+                        if (data + 1 > end)
+                            return false;
+                        if (arg.type == LogArgType::Bool)
+                            arg.b = *data != 0;
+                        else
+                            arg.c = static_cast<char>(*data);
+                        data++;
+                        break;
+
+                    case LogArgType::String:
+                        if (data + sizeof(uint32_t) > end)
+                            return false;
+                        memcpy(&arg.size, data, sizeof(uint32_t));
+                        data += sizeof(uint32_t);
+                        if (arg.size > static_cast<size_t>(end - data))
+                            return false;
+                        arg.s = reinterpret_cast<const char*>(data);
+                        data += arg.size;
+                        break;
+
+                    case LogArgType::Int:
+                    case LogArgType::UInt:
+                    case LogArgType::Double:
+                    case LogArgType::Pointer:
+                        if (data + sizeof(uint64_t) > end)
+                            return false;
+                        memcpy(&arg.u, data, sizeof(uint64_t));
+                        data += sizeof(uint64_t);
+                        break;
+
+                    default:
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        void FormatMessage(const char* file, uint32_t line, LogLevel level, const char* format, const details::LogArg* args,
+                           uint32_t argCount, fmt::memory_buffer& buffer)
+        {
+            using details::LogArgType;
+
+            if (level >= LogLevel::Error)
+            {
+                fmt::format_to(buffer, "[{}:{}] ", file, line);
+            }
+
+            fmt::dynamic_format_arg_store<fmt::format_context> store;
+            for (uint32_t i = 0; i < argCount; ++i)
+            {
+                const details::LogArg& arg = args[i];
+                switch (arg.type)
+                {
+                    case LogArgType::Int:
+                        store.push_back(arg.i);
+                        break;
+                    case LogArgType::UInt:
+                        store.push_back(arg.u);
+                        break;
+                    case LogArgType::Double:
+                        store.push_back(arg.d);
+                        break;
+                    case LogArgType::Bool:
+                        store.push_back(arg.b);
+                        break;
+                    case LogArgType::Char:
+                        store.push_back(arg.c);
+                        break;
+                    case LogArgType::String:
+                        store.push_back(fmt::string_view(arg.s, arg.size));
+                        break;
+                    case LogArgType::Formatted:
+                        store.push_back(fmt::string_view(*arg.formatted));
+                        break;
+                    case LogArgType::Pointer:
+                        store.push_back(arg.p);
+                        break;
+                }
+            }
+
+            const size_t prefixSize = buffer.size();
+            try
+            {
+                fmt::vformat_to(buffer, fmt::string_view(format), store);
+            }
+            catch (const fmt::format_error& error)
+            {
+                buffer.resize(prefixSize);
+                fmt::format_to(buffer, "{} [format error: {}]", format, error.what());
+            }
+        }
+
+        void WriteText(const LogSite& site, int64_t timestamp, const details::LogArg* args, uint32_t argCount)
+        {
+            fmt::memory_buffer buffer;
+            FormatMessage(site.file, site.line, site.level, site.format, args, argCount, buffer);
+
+            const auto time = spdlog::log_clock::time_point(
+                std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(timestamp)));
+            spdlog::default_logger_raw()->log(time, spdlog::source_loc{site.file, static_cast<int>(site.line), ""},
+                                              static_cast<spdlog::level::level_enum>(site.level),
+                                              spdlog::string_view_t(buffer.data(), buffer.size()));
+        }
+
+        /// Append a message to the binary output, describing the site the first time it is seen. Called with fileLock held.
+        void WriteBinary(LogState& state, const LogSite& site, int64_t timestamp, const uint8_t* payload, uint32_t payloadSize)
+        {
+            auto it = state.siteIds.find(&site);
+            uint32_t siteId;
+            if (it == state.siteIds.end())
+            {
+                siteId = static_cast<uint32_t>(state.siteIds.size());
+                state.siteIds.insert({&site, siteId});
+
+                const uint32_t fileLength = static_cast<uint32_t>(strlen(site.file));
+                const uint32_t formatLength = static_cast<uint32_t>(strlen(site.format));
+                WriteValue(state.binaryFile, kBinarySiteTag);
+                WriteValue(state.binaryFile, siteId);
+                WriteValue(state.binaryFile, static_cast<uint8_t>(site.level));
+                WriteValue(state.binaryFile, site.line);
+                WriteValue(state.binaryFile, fileLength);
+                fwrite(site.file, 1, fileLength, state.binaryFile);
+                WriteValue(state.binaryFile, formatLength);
+                fwrite(site.format, 1, formatLength, state.binaryFile);
+            }
+            else
+            {
+                siteId = it->second;
+            }
+
+            WriteValue(state.binaryFile, kBinaryMessageTag);
+            WriteValue(state.binaryFile, siteId);
+            WriteValue(state.binaryFile, timestamp);
+            WriteValue(state.binaryFile, payloadSize);
+            fwrite(payload, 1, payloadSize, state.binaryFile);
+        }
+
+        void WriteRecord(LogState& state, const RecordHeader& header)
+        {
+            const uint8_t* payload = reinterpret_cast<const uint8_t*>(&header + 1);
+            if (state.mode == LogMode::Binary)
+            {
+                std::lock_guard<Mutex> guard(state.fileLock);
+                WriteBinary(state, *header.site, header.timestamp, payload, header.payloadSize);
+                return;
+            }
+
+            details::LogArg args[kMaxArgs];
+            uint32_t argCount;
+            if (DecodeArgs(payload, header.payloadSize, args, argCount))
+            {
+                WriteText(*header.site, header.timestamp, args, argCount);
+            }
+        }
+
+        /// Return the oldest unread record of the ring, skipping padding, or nullptr if the ring is empty.
+        const RecordHeader* PeekRecord(LogRing* ring)
+        {
+            const uint64_t head = ring->head.load(std::memory_order_acquire);
+            uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            while (tail != head)
+            {
+                const RecordHeader* header = reinterpret_cast<const RecordHeader*>(ring->data + (tail & kRingMask));
+                if (header->payloadSize != kPaddingRecord)
+                    return header;
+
+                tail += header->size;
+                ring->tail.store(tail, std::memory_order_release);
+            }
+
+            return nullptr;
+        }
+
+        /// Write every pending record, merging the rings by timestamp. Returns the number of records written.
+        uint32_t DrainRings(LogState& state, Vector<LogRing*>& rings)
+        {
+            {
+                std::lock_guard<Mutex> guard(state.ringsLock);
+                rings = state.rings;
+            }
+
+            uint32_t written = 0;
+            for (;;)
+            {
+                LogRing* oldestRing = nullptr;
+                const RecordHeader* oldest = nullptr;
+                for (LogRing* ring : rings)
+                {
+                    const RecordHeader* header = PeekRecord(ring);
+                    if (header != nullptr && (oldest == nullptr || header->timestamp < oldest->timestamp))
+                    {
+                        oldestRing = ring;
+                        oldest = header;
+                    }
+                }
+
+                if (oldest == nullptr)
+                    return written;
+
+                WriteRecord(state, *oldest);
+                oldestRing->tail.store(oldestRing->tail.load(std::memory_order_relaxed) + oldest->size, std::memory_order_release);
+                written++;
+            }
+        }
+
+        bool HasPendingRecords(LogState& state, const Vector<LogRing*>& rings)
+        {
+            for (LogRing* ring : rings)
+            {
+                if (ring->head.load(std::memory_order_relaxed) != ring->tail.load(std::memory_order_relaxed))
+                    return true;
+            }
+
+            // Rings registered since the last drain.
+            std::lock_guard<Mutex> guard(state.ringsLock);
+            return state.rings.size() != rings.size();
+        }
+
+        void WorkerMain(LogState* state)
+        {
+            t_log.isWorker = true;
+
+            Vector<LogRing*> rings;
+            for (;;)
+            {
+                const bool stop = state->stopRequested.load(std::memory_order_acquire);
+                if (DrainRings(*state, rings) != 0)
+                    continue;
+
+                if (stop)
+                    break;
+
+                // Pairs with the fence in WakeWorker: either the producer sees the flag or we see its record.
+                state->sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!HasPendingRecords(*state, rings) && !state->stopRequested.load(std::memory_order_relaxed))
+                {
+                    state->wakeEvent.Wait();
+                }
+                state->sleeping.store(false, std::memory_order_relaxed);
+            }
+
+            if (state->mode == LogMode::Text)
+            {
+                spdlog::default_logger_raw()->flush();
+            }
+        }
+    }
+
+    namespace details
+    {
+        uint8_t* BeginRecord(const LogSite& site, uint32_t payloadSize)
+        {
+            LogState& state = GetState();
+            if (!state.running.load(std::memory_order_acquire) || t_log.isWorker || t_log.destroyed)
+                return nullptr;
+
+            const uint32_t size = (sizeof(RecordHeader) + payloadSize + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+            if (size > kMaxRecordSize)
+                return nullptr;
+
+            LogRing* ring = t_log.ring;
+            if (ring == nullptr)
+            {
+                ring = AcquireRing(state);
+                t_log.ring = ring;
+            }
+
+            const uint64_t head = ring->head.load(std::memory_order_relaxed);
+            const uint32_t offset = static_cast<uint32_t>(head & kRingMask);
+            const uint32_t contiguous = kRingSize - offset;
+            // Records never wrap, the end of the ring is skipped with a padding record instead.
+            const uint32_t required = contiguous < size ? contiguous + size : size;
+
+            while (head + required - ring->cachedTail > kRingSize)
+            {
+                ring->cachedTail = ring->tail.load(std::memory_order_acquire);
+                if (head + required - ring->cachedTail <= kRingSize)
+                    break;
+
+                WakeWorker(state);
+                ThreadYield();
+            }
+
+            uint8_t* dest = ring->data + offset;
+            if (contiguous < size)
+            {
+                RecordHeader* padding = reinterpret_cast<RecordHeader*>(dest);
+                padding->size = contiguous;
+                padding->payloadSize = kPaddingRecord;
+                dest = ring->data;
+            }
+
+            RecordHeader* header = reinterpret_cast<RecordHeader*>(dest);
+            header->size = size;
+            header->payloadSize = payloadSize;
+            header->site = &site;
+            header->timestamp = GetTimestamp();
+            ring->pendingHead = head + required;
+            return reinterpret_cast<uint8_t*>(header + 1);
+        }
+
+        void CommitRecord()
+        {
+            LogRing* ring = t_log.ring;
+            ring->head.store(ring->pendingHead, std::memory_order_release);
+            WakeWorker(GetState());
+        }
+
+        void WriteSync(const LogSite& site, LogArg* args, uint32_t argCount)
+        {
+            LogState& state = GetState();
+            const int64_t timestamp = GetTimestamp();
+
+            // Keep the order with messages already queued by this thread.
+            if (state.running.load(std::memory_order_acquire) && !t_log.isWorker)
+            {
+                Log::Flush();
+            }
+
+            std::unique_lock<Mutex> fileGuard(state.fileLock);
+            if (state.binaryFile != nullptr)
+            {
+                Vector<uint8_t> payload;
+                for (uint32_t i = 0; i < argCount; ++i)
+                {
+                    payload.resize(payload.size() + GetEncodedSize(args[i]));
+                }
+
+                uint8_t* dest = payload.data();
+                for (uint32_t i = 0; i < argCount; ++i)
+                {
+                    dest = Encode(dest, args[i]);
+                }
+
+                WriteBinary(state, site, timestamp, payload.data(), static_cast<uint32_t>(payload.size()));
+                return;
+            }
+            fileGuard.unlock();
+
+            WriteText(site, timestamp, args, argCount);
+            for (uint32_t i = 0; i < argCount; ++i)
+            {
+                if (args[i].type == LogArgType::Formatted)
+                {
+                    delete args[i].formatted;
+                }
+            }
+        }
+    }
+
+    namespace Log
+    {
+        void Initialize(LogMode mode, const char* binaryPath)
+        {
+            LogState& state = GetState();
+            if (state.running.load(std::memory_order_acquire))
+                return;
+
+            if (mode == LogMode::Binary)
+            {
+                std::lock_guard<Mutex> guard(state.fileLock);
+                state.binaryFile = fopen(binaryPath, "wb");
+                if (state.binaryFile == nullptr)
+                {
+                    spdlog::error("Failed to open binary log '{}', falling back to text", binaryPath);
+                    mode = LogMode::Text;
+                }
+                else
+                {
+                    fwrite(kBinaryMagic, 1, sizeof(kBinaryMagic), state.binaryFile);
+                    WriteValue(state.binaryFile, kBinaryVersion);
+                    state.siteIds.clear();
+                }
+            }
+
+            state.mode = mode;
+
+#if defined(ALIMER_THREADING)
+            state.stopRequested.store(false, std::memory_order_relaxed);
+            state.worker = std::thread(WorkerMain, &state);
+            state.running.store(true, std::memory_order_release);
+#endif
+        }
+
+        void Shutdown()
+        {
+            LogState& state = GetState();
+            if (state.running.exchange(false, std::memory_order_acq_rel))
+            {
+                state.stopRequested.store(true, std::memory_order_release);
+                state.wakeEvent.Set();
+                state.worker.join();
+            }
+
+            std::lock_guard<Mutex> guard(state.fileLock);
+            if (state.binaryFile != nullptr)
+            {
+                fclose(state.binaryFile);
+                state.binaryFile = nullptr;
+            }
+            state.mode = LogMode::Text;
+        }
+
+        void Flush()
+        {
+            LogState& state = GetState();
+            if (state.running.load(std::memory_order_acquire) && !t_log.isWorker)
+            {
+                SmallVector<std::pair<LogRing*, uint64_t>, 32> targets;
+                {
+                    std::lock_guard<Mutex> guard(state.ringsLock);
+                    for (LogRing* ring : state.rings)
+                    {
+                        targets.push_back({ring, ring->head.load(std::memory_order_acquire)});
+                    }
+                }
+
+                for (const auto& target : targets)
+                {
+                    while (target.first->tail.load(std::memory_order_acquire) < target.second)
+                    {
+                        state.wakeEvent.Set();
+                        ThreadYield();
+                    }
+                }
+            }
+
+            std::lock_guard<Mutex> guard(state.fileLock);
+            if (state.binaryFile != nullptr)
+            {
+                fflush(state.binaryFile);
+            }
+            else if (spdlog::default_logger_raw() != nullptr)
+            {
+                spdlog::default_logger_raw()->flush();
+            }
+        }
+
+        void SetLevel(LogLevel level) { GetState().level.store(static_cast<uint8_t>(level), std::memory_order_relaxed); }
+
+        LogLevel GetLevel() { return static_cast<LogLevel>(GetState().level.load(std::memory_order_relaxed)); }
+
+        bool IsEnabled(LogLevel level) { return static_cast<uint8_t>(level) >= GetState().level.load(std::memory_order_relaxed); }
+
+        bool DecodeBinary(const char* inputPath, const char* outputPath)
+        {
+            struct FileCloser
+            {
+                FILE* file;
+                ~FileCloser()
+                {
+                    if (file != nullptr && file != stdout)
+                        fclose(file);
+                }
+            };
+
+            FileCloser input{fopen(inputPath, "rb")};
+            if (input.file == nullptr)
+                return false;
+
+            char magic[sizeof(kBinaryMagic)];
+            uint32_t version;
+            if (fread(magic, 1, sizeof(magic), input.file) != sizeof(magic) || memcmp(magic, kBinaryMagic, sizeof(magic)) != 0 ||
+                !ReadValue(input.file, version) || version != kBinaryVersion)
+            {
+                return false;
+            }
+
+            FileCloser output{outputPath != nullptr ? fopen(outputPath, "w") : stdout};
+            if (output.file == nullptr)
+                return false;
+
+            struct DecodedSite
+            {
+                std::string file;
+                std::string format;
+                uint32_t line;
+                LogLevel level;
+            };
+
+            Vector<DecodedSite> sites;
+            Vector<uint8_t> payload;
+            fmt::memory_buffer buffer;
+            uint8_t tag;
+            while (ReadValue(input.file, tag))
+            {
+                if (tag == kBinarySiteTag)
+                {
+                    uint32_t siteId;
+                    uint8_t level;
+                    uint32_t line;
+                    uint32_t length;
+                    DecodedSite site;
+                    if (!ReadValue(input.file, siteId) || siteId != sites.size() || !ReadValue(input.file, level) ||
+                        !ReadValue(input.file, line) || !ReadValue(input.file, length))
+                        return false;
+
+                    site.file.resize(length);
+                    if (fread(&site.file[0], 1, length, input.file) != length || !ReadValue(input.file, length))
+                        return false;
+
+                    site.format.resize(length);
+                    if (fread(&site.format[0], 1, length, input.file) != length)
+                        return false;
+
+                    site.line = line;
+                    site.level = static_cast<LogLevel>(level);
+                    sites.push_back(std::move(site));
+                }
+                else if (tag == kBinaryMessageTag)
+                {
+                    uint32_t siteId;
+                    int64_t timestamp;
+                    uint32_t payloadSize;
+                    if (!ReadValue(input.file, siteId) || siteId >= sites.size() || !ReadValue(input.file, timestamp) ||
+                        !ReadValue(input.file, payloadSize))
+                        return false;
+
+                    payload.resize(payloadSize);
+                    if (payloadSize != 0 && fread(payload.data(), 1, payloadSize, input.file) != payloadSize)
+                        return false;
+
+                    details::LogArg args[kMaxArgs];
+                    uint32_t argCount;
+                    if (!DecodeArgs(payload.data(), payloadSize, args, argCount))
+                        return false;
+
+                    const DecodedSite& site = sites[siteId];
+                    const time_t seconds = static_cast<time_t>(timestamp / 1000000000);
+                    char timeText[32];
+                    strftime(timeText, sizeof(timeText), "%Y-%m-%d %H:%M:%S", localtime(&seconds));
+
+                    buffer.clear();
+                    fmt::format_to(buffer, "[{}.{:06}] [{}] ", timeText, (timestamp % 1000000000) / 1000,
+                                   spdlog::level::to_string_view(static_cast<spdlog::level::level_enum>(site.level)));
+                    FormatMessage(site.file.c_str(), site.line, site.level, site.format.c_str(), args, argCount, buffer);
+                    buffer.push_back('\n');
+                    fwrite(buffer.data(), 1, buffer.size(), output.file);
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+}
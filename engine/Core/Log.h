@@ -22,18 +22,346 @@
 
 #pragma once
 
+#include "PlatformDef.h"
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#define ALIMER_LOG_LEVEL_TRACE 0
+#define ALIMER_LOG_LEVEL_DEBUG 1
+#define ALIMER_LOG_LEVEL_INFO 2
+#define ALIMER_LOG_LEVEL_WARN 3
+#define ALIMER_LOG_LEVEL_ERROR 4
+#define ALIMER_LOG_LEVEL_CRITICAL 5
+#define ALIMER_LOG_LEVEL_OFF 6
+
+/// Messages below this level are compiled out, arguments included. Can be overridden from the build.
+#ifndef ALIMER_LOG_LEVEL
+#    if defined(_DEBUG)
+#        define ALIMER_LOG_LEVEL ALIMER_LOG_LEVEL_DEBUG
+#    else
+#        define ALIMER_LOG_LEVEL ALIMER_LOG_LEVEL_INFO
+#    endif
+#endif
+
+namespace alimer
+{
+    /// Log severity, values match the spdlog levels.
+    enum class LogLevel : uint8_t
+    {
+        Trace = ALIMER_LOG_LEVEL_TRACE,
+        Debug = ALIMER_LOG_LEVEL_DEBUG,
+        Info = ALIMER_LOG_LEVEL_INFO,
+        Warn = ALIMER_LOG_LEVEL_WARN,
+        Error = ALIMER_LOG_LEVEL_ERROR,
+        Critical = ALIMER_LOG_LEVEL_CRITICAL,
+        Off = ALIMER_LOG_LEVEL_OFF
+    };
+
+    /// How the background thread writes messages.
+    enum class LogMode : uint32_t
+    {
+        /// Format messages and write them to the default spdlog logger.
+        Text,
+        /// Write unformatted records to a file, to be decoded offline with Log::DecodeBinary.
+        Binary
+    };
+
+    /// Static description of a log call site. The format must be a string literal, only its pointer is captured.
+    struct LogSite
+    {
+        const char* file;
+        const char* format;
+        uint32_t line;
+        LogLevel level;
+    };
+
+    namespace details
+    {
+        enum class LogArgType : uint8_t
+        {
+            Int,
+            UInt,
+            Double,
+            Bool,
+            Char,
+            String,
+            Pointer,
+            /// String formatted on the calling thread for types without a raw encoding, owned by the argument.
+            Formatted
+        };
+
+        /// Argument captured without formatting.
+        struct LogArg
+        {
+            LogArgType type;
+            uint32_t size;
+            union
+            {
+                int64_t i;
+                uint64_t u;
+                double d;
+                bool b;
+                char c;
+                const char* s;
+                const void* p;
+                std::string* formatted;
+            };
+        };
+
+        inline LogArg MakeLogArg(bool value) { LogArg arg; arg.type = LogArgType::Bool; arg.b = value; return arg; }
+        inline LogArg MakeLogArg(char value) { LogArg arg; arg.type = LogArgType::Char; arg.c = value; return arg; }
+
+        inline LogArg MakeLogArg(const char* value)
+        {
+            if (value == nullptr)
+                value = "(null)";
+
+            LogArg arg;
+            arg.type = LogArgType::String;
+            arg.size = static_cast<uint32_t>(strlen(value));
+            arg.s = value;
+            return arg;
+        }
+
+        inline LogArg MakeLogArg(char* value) { return MakeLogArg(static_cast<const char*>(value)); }
+
+        inline LogArg MakeLogArg(const std::string& value)
+        {
+            LogArg arg;
+            arg.type = LogArgType::String;
+            arg.size = static_cast<uint32_t>(value.size());
+            arg.s = value.data();
+            return arg;
+        }
+
+        inline LogArg MakeLogArg(std::string_view value)
+        {
+            LogArg arg;
+            arg.type = LogArgType::String;
+            arg.size = static_cast<uint32_t>(value.size());
+            arg.s = value.data();
+            return arg;
+        }
+
+        template <typename T> LogArg MakeLogArg(const T& value)
+        {
+            LogArg arg;
+            if constexpr (std::is_enum<T>::value)
+            {
+                return MakeLogArg(static_cast<typename std::underlying_type<T>::type>(value));
+            }
+            else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value)
+            {
+                arg.type = LogArgType::Int;
+                arg.i = static_cast<int64_t>(value);
+            }
+            else if constexpr (std::is_integral<T>::value)
+            {
+                arg.type = LogArgType::UInt;
+                arg.u = static_cast<uint64_t>(value);
+            }
+            else if constexpr (std::is_floating_point<T>::value)
+            {
+                arg.type = LogArgType::Double;
+                arg.d = static_cast<double>(value);
+            }
+            else if constexpr (std::is_pointer<T>::value)
+            {
+                arg.type = LogArgType::Pointer;
+                arg.p = static_cast<const void*>(value);
+            }
+            else
+            {
+                arg.type = LogArgType::Formatted;
+                arg.formatted = new std::string(fmt::format("{}", value));
+                arg.size = static_cast<uint32_t>(arg.formatted->size());
+            }
+            return arg;
+        }
+
+        /// Number of bytes the argument takes in a record.
+        inline uint32_t GetEncodedSize(const LogArg& arg)
+        {
+            switch (arg.type)
+            {
+                case LogArgType::Bool:
+                case LogArgType::Char:
+                    return 2;
+                case LogArgType::String:
+                case LogArgType::Formatted:
+                    return 1 + sizeof(uint32_t) + arg.size;
+                default:
+                    return 1 + sizeof(uint64_t);
+            }
+        }
+
+        /// Append the argument to a record and release the formatted string, if any.
+        inline uint8_t* Encode(uint8_t* dest, LogArg& arg)
+        {
+            *dest++ = static_cast<uint8_t>(arg.type == LogArgType::Formatted ? LogArgType::String : arg.type);
+            switch (arg.type)
+            {
+                case LogArgType::Bool:
+                    *dest++ = arg.b ? 1 : 0;
+                    break;
+                case LogArgType::Char:
+                    *dest++ = static_cast<uint8_t>(arg.c);
+                    break;
+                case LogArgType::String:
+                    memcpy(dest, &arg.size, sizeof(uint32_t));
+                    memcpy(dest + sizeof(uint32_t), arg.s, arg.size);
+                    dest += sizeof(uint32_t) + arg.size;
+                    break;
+                case LogArgType::Formatted:
+                    memcpy(dest, &arg.size, sizeof(uint32_t));
+                    memcpy(dest + sizeof(uint32_t), arg.formatted->data(), arg.size);
+                    dest += sizeof(uint32_t) + arg.size;
+                    delete arg.formatted;
+                    break;
+                default:
+                    memcpy(dest, &arg.u, sizeof(uint64_t));
+                    dest += sizeof(uint64_t);
+                    break;
+            }
+            return dest;
+        }
+
+        /// Reserve a record in the ring of the calling thread. Returns nullptr when the background thread is not running
+        /// or the record can never fit, the caller then logs synchronously.
+        ALIMER_API uint8_t* BeginRecord(const LogSite& site, uint32_t payloadSize);
+
+        /// Publish the record reserved by BeginRecord.
+        ALIMER_API void CommitRecord();
+
+        /// Format and write the message on the calling thread.
+        ALIMER_API void WriteSync(const LogSite& site, LogArg* args, uint32_t argCount);
+
+        template <typename... Args> void Write(const LogSite& site, const Args&... args)
+        {
+            if constexpr (sizeof...(Args) == 0)
+            {
+                if (uint8_t* dest = BeginRecord(site, 0))
+                {
+                    ALIMER_UNUSED(dest);
+                    CommitRecord();
+                }
+                else
+                {
+                    WriteSync(site, nullptr, 0);
+                }
+            }
+            else
+            {
+                LogArg captured[] = {MakeLogArg(args)...};
+
+                uint32_t payloadSize = 0;
+                for (const LogArg& arg : captured)
+                {
+                    payloadSize += GetEncodedSize(arg);
+                }
+
+                if (uint8_t* dest = BeginRecord(site, payloadSize))
+                {
+                    for (LogArg& arg : captured)
+                    {
+                        dest = Encode(dest, arg);
+                    }
+                    CommitRecord();
+                }
+                else
+                {
+                    WriteSync(site, captured, sizeof...(Args));
+                }
+            }
+        }
+    }
+
+    /// Asynchronous logger behind the LOG* macros. Call sites copy the raw arguments into a lock-free ring owned by the
+    /// calling thread, a background thread formats and writes them in timestamp order.
+    namespace Log
+    {
+        /// Start the background thread. Before this call and after Shutdown messages are written synchronously.
+        ALIMER_API void Initialize(LogMode mode = LogMode::Text, const char* binaryPath = "Log.bin");
+
+        /// Write pending messages and stop the background thread.
+        ALIMER_API void Shutdown();
+
+        /// Block until every message logged so far has been written.
+        ALIMER_API void Flush();
+
+        /// Set the runtime level, messages below it are discarded at the call site.
+        ALIMER_API void SetLevel(LogLevel level);
+        ALIMER_API LogLevel GetLevel();
+
+        /// Check whether messages of the level are written.
+        ALIMER_API bool IsEnabled(LogLevel level);
+
+        /// Decode a file written in binary mode into text. Returns false if the input can not be read or is malformed.
+        ALIMER_API bool DecodeBinary(const char* inputPath, const char* outputPath);
+
+        template <typename... Args> void Write(const LogSite& site, const Args&... args)
+        {
+            if (IsEnabled(site.level))
+            {
+                details::Write(site, args...);
+            }
+        }
+    }
+}
 
 #define LOGGER_FORMAT "[%^%l%$] %v"
-#define LOGD(...) spdlog::debug(__VA_ARGS__);
-#define LOGI(...) spdlog::info(__VA_ARGS__);
-#define LOGW(...) spdlog::warn(__VA_ARGS__);
-#define LOGE(...) spdlog::error("[{}:{}] {}", __FILE__, __LINE__, fmt::format(__VA_ARGS__));
 
-#define ALIMER_FATAL(...)                                                                                                                  \
+#define ALIMER_LOG(level, format, ...)                                                                                                     \
+    do                                                                                                                                     \
+    {                                                                                                                                      \
+        static constexpr alimer::LogSite alimerLogSite{__FILE__, format, __LINE__, level};                                                 \
+        alimer::Log::Write(alimerLogSite, ##__VA_ARGS__);                                                                                  \
+    } while (0)
+
+#define ALIMER_LOG_DISCARD(...)                                                                                                            \
+    do                                                                                                                                     \
+    {                                                                                                                                      \
+    } while (0)
+
+#if ALIMER_LOG_LEVEL <= ALIMER_LOG_LEVEL_TRACE
+#    define LOGT(format, ...) ALIMER_LOG(alimer::LogLevel::Trace, format, ##__VA_ARGS__);
+#else
+#    define LOGT(...) ALIMER_LOG_DISCARD(__VA_ARGS__);
+#endif
+
+#if ALIMER_LOG_LEVEL <= ALIMER_LOG_LEVEL_DEBUG
+#    define LOGD(format, ...) ALIMER_LOG(alimer::LogLevel::Debug, format, ##__VA_ARGS__);
+#else
+#    define LOGD(...) ALIMER_LOG_DISCARD(__VA_ARGS__);
+#endif
+
+#if ALIMER_LOG_LEVEL <= ALIMER_LOG_LEVEL_INFO
+#    define LOGI(format, ...) ALIMER_LOG(alimer::LogLevel::Info, format, ##__VA_ARGS__);
+#else
+#    define LOGI(...) ALIMER_LOG_DISCARD(__VA_ARGS__);
+#endif
+
+#if ALIMER_LOG_LEVEL <= ALIMER_LOG_LEVEL_WARN
+#    define LOGW(format, ...) ALIMER_LOG(alimer::LogLevel::Warn, format, ##__VA_ARGS__);
+#else
+#    define LOGW(...) ALIMER_LOG_DISCARD(__VA_ARGS__);
+#endif
+
+#if ALIMER_LOG_LEVEL <= ALIMER_LOG_LEVEL_ERROR
+#    define LOGE(format, ...) ALIMER_LOG(alimer::LogLevel::Error, format, ##__VA_ARGS__);
+#else
+#    define LOGE(...) ALIMER_LOG_DISCARD(__VA_ARGS__);
+#endif
+
+/// Fatal errors are never compiled out. The queue is flushed so the message is visible before breaking.
+#define ALIMER_FATAL(format, ...)                                                                                                          \
     do                                                                                                                                     \
     {                                                                                                                                      \
-        spdlog::critical("[{}:{}] {}", __FILE__, __LINE__, fmt::format(__VA_ARGS__));                                                      \
+        ALIMER_LOG(alimer::LogLevel::Critical, format, ##__VA_ARGS__);                                                                     \
+        alimer::Log::Flush();                                                                                                              \
         ALIMER_DEBUG_BREAK();                                                                                                              \
     } while (0)
@@ -24,6 +24,7 @@
 
 #include "Core/String.h"
 #include "Math/MathHelper.h"
+#include "Math/Vector4.h"
 
 namespace alimer
 {
@@ -209,6 +210,7 @@ namespace alimer
             , z(z_)
         {
         }
+        explicit Float3(const Vector4& vector) noexcept { vector.Store3(&x); }
 
         Float3(const Float3&) = default;
         Float3& operator=(const Float3&) = default;
@@ -226,6 +228,29 @@ namespace alimer
             return x != rhs.x || y != rhs.y || z != rhs.z;
         }
 
+        // Arithmetic operators
+        Float3 operator-() const { return Float3(-ToVector()); }
+        Float3 operator+(const Float3& rhs) const { return Float3(ToVector() + rhs.ToVector()); }
+        Float3 operator-(const Float3& rhs) const { return Float3(ToVector() - rhs.ToVector()); }
+        Float3 operator*(const Float3& rhs) const { return Float3(ToVector() * rhs.ToVector()); }
+        Float3 operator*(float rhs) const { return Float3(ToVector() * rhs); }
+        Float3 operator/(const Float3& rhs) const { return Float3(ToVector() / rhs.ToVector()); }
+        Float3 operator/(float rhs) const { return Float3(ToVector() / rhs); }
+
+        Float3& operator+=(const Float3& rhs) { return *this = *this + rhs; }
+        Float3& operator-=(const Float3& rhs) { return *this = *this - rhs; }
+        Float3& operator*=(float rhs) { return *this = *this * rhs; }
+        Float3& operator/=(float rhs) { return *this = *this / rhs; }
+
+        /// Load into a SIMD vector, w is zero.
+        Vector4 ToVector() const { return Vector4::Load3(&x); }
+
+        /// Return length.
+        float Length() const { return Vector4::Length3(ToVector()).GetX(); }
+
+        /// Return squared length.
+        float LengthSquared() const { return Vector4::Dot3(ToVector(), ToVector()).GetX(); }
+
         /// Return float data.
         const float* Data() const
         {
@@ -235,6 +260,17 @@ namespace alimer
         /// Return as string.
         std::string ToString() const;
 
+        static float Dot(const Float3& lhs, const Float3& rhs) { return Vector4::Dot3(lhs.ToVector(), rhs.ToVector()).GetX(); }
+        static Float3 Cross(const Float3& lhs, const Float3& rhs) { return Float3(Vector4::Cross3(lhs.ToVector(), rhs.ToVector())); }
+        static float Distance(const Float3& lhs, const Float3& rhs) { return (rhs - lhs).Length(); }
+
+        /// Return the unit vector in the same direction, zero for a zero vector.
+        static Float3 Normalize(const Float3& value) { return Float3(Vector4::Normalize3(value.ToVector())); }
+
+        static Float3 Lerp(const Float3& lhs, const Float3& rhs, float t) { return Float3(Vector4::Lerp(lhs.ToVector(), rhs.ToVector(), t)); }
+        static Float3 Min(const Float3& lhs, const Float3& rhs) { return Float3(Vector4::Min(lhs.ToVector(), rhs.ToVector())); }
+        static Float3 Max(const Float3& lhs, const Float3& rhs) { return Float3(Vector4::Max(lhs.ToVector(), rhs.ToVector())); }
+
         // Constants
         static const Float3 Zero;
         static const Float3 One;
@@ -304,6 +340,7 @@ namespace alimer
             , w(w_)
         {
         }
+        explicit Float4(const Vector4& vector) noexcept { vector.Store(&x); }
 
         Float4(const Float4&) = default;
         Float4& operator=(const Float4&) = default;
@@ -321,6 +358,29 @@ namespace alimer
             return x != rhs.x || y != rhs.y || z != rhs.z || w != rhs.w;
         }
 
+        // Arithmetic operators
+        Float4 operator-() const { return Float4(-ToVector()); }
+        Float4 operator+(const Float4& rhs) const { return Float4(ToVector() + rhs.ToVector()); }
+        Float4 operator-(const Float4& rhs) const { return Float4(ToVector() - rhs.ToVector()); }
+        Float4 operator*(const Float4& rhs) const { return Float4(ToVector() * rhs.ToVector()); }
+        Float4 operator*(float rhs) const { return Float4(ToVector() * rhs); }
+        Float4 operator/(const Float4& rhs) const { return Float4(ToVector() / rhs.ToVector()); }
+        Float4 operator/(float rhs) const { return Float4(ToVector() / rhs); }
+
+        Float4& operator+=(const Float4& rhs) { return *this = *this + rhs; }
+        Float4& operator-=(const Float4& rhs) { return *this = *this - rhs; }
+        Float4& operator*=(float rhs) { return *this = *this * rhs; }
+        Float4& operator/=(float rhs) { return *this = *this / rhs; }
+
+        /// Load into a SIMD vector.
+        Vector4 ToVector() const { return Vector4::Load(&x); }
+
+        /// Return length.
+        float Length() const { return Vector4::Length4(ToVector()).GetX(); }
+
+        /// Return squared length.
+        float LengthSquared() const { return Vector4::Dot4(ToVector(), ToVector()).GetX(); }
+
         /// Return float data.
         const float* Data() const
         {
@@ -330,6 +390,16 @@ namespace alimer
         /// Return as string.
         std::string ToString() const;
 
+        static float Dot(const Float4& lhs, const Float4& rhs) { return Vector4::Dot4(lhs.ToVector(), rhs.ToVector()).GetX(); }
+        static float Distance(const Float4& lhs, const Float4& rhs) { return (rhs - lhs).Length(); }
+
+        /// Return the unit vector in the same direction, zero for a zero vector.
+        static Float4 Normalize(const Float4& value) { return Float4(Vector4::Normalize4(value.ToVector())); }
+
+        static Float4 Lerp(const Float4& lhs, const Float4& rhs, float t) { return Float4(Vector4::Lerp(lhs.ToVector(), rhs.ToVector(), t)); }
+        static Float4 Min(const Float4& lhs, const Float4& rhs) { return Float4(Vector4::Min(lhs.ToVector(), rhs.ToVector())); }
+        static Float4 Max(const Float4& lhs, const Float4& rhs) { return Float4(Vector4::Max(lhs.ToVector(), rhs.ToVector())); }
+
         // Constants
         static const Float4 Zero;
         static const Float4 One;
@@ -21,9 +21,364 @@
 //
 
 #include "Core/Memory.h"
+#include "Core/Assert.h"
+#include "Core/SmallObjectAllocator.h"
+#include "IO/FileStream.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif !defined(_WIN32)
+#include <malloc.h>
+#endif
 
 namespace alimer
 {
-    uint64_t ALIMER_THREADLOCAL MemoryCounter::Allocs = 0;
-    uint64_t ALIMER_THREADLOCAL MemoryCounter::Frees = 0;
+    namespace
+    {
+        constexpr uint32_t kStatsShardCount = 32;
+        constexpr uint32_t kTagCount = static_cast<uint32_t>(MemoryTag::Count);
+
+        /// Counters of one tag in one shard. Live values can go negative in a shard when memory is freed by another thread.
+        struct TagCounters
+        {
+            std::atomic<int64_t> liveBytes{0};
+            std::atomic<int64_t> liveCount{0};
+            std::atomic<uint64_t> totalBytes{0};
+            std::atomic<uint64_t> totalCount{0};
+        };
+
+        struct alignas(64) StatsShard
+        {
+            TagCounters tags[kTagCount];
+        };
+
+        struct FrameState
+        {
+            std::atomic<uint64_t> peakBytes{0};
+            uint64_t lastTotalBytes = 0;
+            uint64_t lastTotalCount = 0;
+            uint64_t frameBytes = 0;
+            uint64_t frameCount = 0;
+        };
+
+        StatsShard s_statsShards[kStatsShardCount];
+        FrameState s_frameStates[kTagCount];
+        std::mutex s_frameStateMutex;
+        std::atomic<uint32_t> s_nextShard{0};
+        ALIMER_THREADLOCAL uint32_t t_shardIndex = UINT32_MAX;
+
+        TagCounters& GetThreadCounters(MemoryTag tag)
+        {
+            if (ALIMER_UNLIKELY(t_shardIndex == UINT32_MAX))
+            {
+                t_shardIndex = s_nextShard.fetch_add(1, std::memory_order_relaxed) % kStatsShardCount;
+            }
+
+            return s_statsShards[t_shardIndex].tags[static_cast<uint32_t>(tag)];
+        }
+
+        /// Sum every shard and raise the recorded peak if needed.
+        MemoryTagStats Collect(MemoryTag tag)
+        {
+            const uint32_t tagIndex = static_cast<uint32_t>(tag);
+            int64_t liveBytes = 0;
+            int64_t liveCount = 0;
+
+            MemoryTagStats result;
+            for (const StatsShard& shard : s_statsShards)
+            {
+                const TagCounters& counters = shard.tags[tagIndex];
+                liveBytes += counters.liveBytes.load(std::memory_order_relaxed);
+                liveCount += counters.liveCount.load(std::memory_order_relaxed);
+                result.totalBytes += counters.totalBytes.load(std::memory_order_relaxed);
+                result.totalCount += counters.totalCount.load(std::memory_order_relaxed);
+            }
+
+            // Shards are read one after the other, a concurrent free can make the sum briefly negative.
+            result.liveBytes = static_cast<uint64_t>(Max<int64_t>(liveBytes, 0));
+            result.liveCount = static_cast<uint64_t>(Max<int64_t>(liveCount, 0));
+
+            std::atomic<uint64_t>& peak = s_frameStates[tagIndex].peakBytes;
+            uint64_t currentPeak = peak.load(std::memory_order_relaxed);
+            while (currentPeak < result.liveBytes && !peak.compare_exchange_weak(currentPeak, result.liveBytes, std::memory_order_relaxed))
+            {
+            }
+            result.peakBytes = Max(currentPeak, result.liveBytes);
+            return result;
+        }
+
+        /// Incremented at every frame boundary, thread allocators compare against it to know when to clear.
+        std::atomic<uint64_t> s_frameIndex{0};
+
+        constexpr uintptr_t AlignUp(uintptr_t value, size_t alignment) { return (value + alignment - 1) & ~(uintptr_t(alignment) - 1); }
+    }
+
+    /* FrameAllocator */
+    FrameAllocator::FrameAllocator(size_t pageSize_)
+        : pageSize(pageSize_)
+    {
+    }
+
+    FrameAllocator::~FrameAllocator()
+    {
+        ReleaseStats();
+
+        Page* page = firstPage;
+        while (page != nullptr)
+        {
+            Page* next = page->next;
+            ::free(page);
+            page = next;
+        }
+    }
+
+    FrameAllocator::Page* FrameAllocator::AllocatePage(size_t minSize)
+    {
+        const size_t size = Max(pageSize, minSize);
+        Page* page = static_cast<Page*>(malloc(sizeof(Page) + size));
+        ALIMER_ASSERT(page != nullptr);
+        page->next = nullptr;
+        page->size = size;
+        page->used = 0;
+        return page;
+    }
+
+    void* FrameAllocator::Allocate(size_t size, size_t alignment)
+    {
+        ALIMER_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+        if (currentPage == nullptr)
+        {
+            firstPage = AllocatePage(size + alignment);
+            currentPage = firstPage;
+        }
+
+        for (;;)
+        {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(GetPageData(currentPage));
+            const uintptr_t start = AlignUp(base + currentPage->used, alignment);
+            if (start + size <= base + currentPage->size)
+            {
+                currentPage->used = (start + size) - base;
+                trackedBytes += size;
+                trackedCount++;
+                MemoryStats::RecordAlloc(MemoryTag::Frame, size);
+                return reinterpret_cast<void*>(start);
+            }
+
+            // Move to the next page kept from a previous frame, or append an overflow page.
+            if (currentPage->next == nullptr)
+            {
+                currentPage->next = AllocatePage(size + alignment);
+            }
+
+            currentPage = currentPage->next;
+        }
+    }
+
+    void FrameAllocator::Clear()
+    {
+        for (Page* page = firstPage; page != nullptr; page = page->next)
+        {
+#if defined(_DEBUG)
+            memset(GetPageData(page), kPoisonByte, page->used);
+#endif
+            page->used = 0;
+        }
+
+        currentPage = firstPage;
+        ReleaseStats();
+    }
+
+    void FrameAllocator::ReleaseStats()
+    {
+        if (trackedCount != 0)
+        {
+            MemoryStats::RecordFree(MemoryTag::Frame, trackedBytes, trackedCount);
+            trackedBytes = 0;
+            trackedCount = 0;
+        }
+    }
+
+    size_t FrameAllocator::GetUsedBytes() const
+    {
+        size_t result = 0;
+        for (Page* page = firstPage; page != nullptr; page = page->next)
+        {
+            result += page->used;
+        }
+
+        return result;
+    }
+
+    size_t FrameAllocator::GetReservedBytes() const
+    {
+        size_t result = 0;
+        for (Page* page = firstPage; page != nullptr; page = page->next)
+        {
+            result += page->size;
+        }
+
+        return result;
+    }
+
+    FrameAllocator& FrameAllocator::GetThreadAllocator()
+    {
+        static thread_local FrameAllocator allocator;
+
+        const uint64_t frameIndex = s_frameIndex.load(std::memory_order_acquire);
+        if (allocator.frameIndex != frameIndex)
+        {
+            allocator.Clear();
+            allocator.frameIndex = frameIndex;
+        }
+
+        return allocator;
+    }
+
+    void* alimer_frame_alloc(size_t count) { return FrameAllocator::GetThreadAllocator().Allocate(count); }
+
+    void* alimer_frame_alloc_aligned(size_t alignment, size_t count)
+    {
+        return FrameAllocator::GetThreadAllocator().Allocate(count, Max(alignment, FrameAllocator::kDefaultAlignment));
+    }
+
+    void alimer_frame_clear() { s_frameIndex.fetch_add(1, std::memory_order_release); }
+
+    /* MemoryAllocator<FrameAlloc> */
+    void* MemoryAllocator<FrameAlloc>::allocate(size_t size) { return alimer_frame_alloc(size); }
+
+    void MemoryAllocator<FrameAlloc>::free(void* ptr) { alimer_frame_free(ptr); }
+
+    void* MemoryAllocator<FrameAlloc>::allocate_aligned(size_t alignment, size_t size) { return alimer_frame_alloc_aligned(alignment, size); }
+
+    void MemoryAllocator<FrameAlloc>::free_aligned(void* ptr) { alimer_frame_free(ptr); }
+
+    /* MemoryStats */
+    void MemoryStats::RecordAlloc(MemoryTag tag, size_t size)
+    {
+        TagCounters& counters = GetThreadCounters(tag);
+        counters.liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+        counters.liveCount.fetch_add(1, std::memory_order_relaxed);
+        counters.totalBytes.fetch_add(size, std::memory_order_relaxed);
+        counters.totalCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void MemoryStats::RecordFree(MemoryTag tag, size_t size) { RecordFree(tag, size, 1); }
+
+    void MemoryStats::RecordFree(MemoryTag tag, size_t size, uint64_t count)
+    {
+        TagCounters& counters = GetThreadCounters(tag);
+        counters.liveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+        counters.liveCount.fetch_sub(static_cast<int64_t>(count), std::memory_order_relaxed);
+    }
+
+    MemoryTagStats MemoryStats::Get(MemoryTag tag)
+    {
+        ALIMER_ASSERT(tag < MemoryTag::Count);
+
+        MemoryTagStats result = Collect(tag);
+
+        std::lock_guard<std::mutex> lock(s_frameStateMutex);
+        const FrameState& state = s_frameStates[static_cast<uint32_t>(tag)];
+        result.frameBytes = state.frameBytes;
+        result.frameCount = state.frameCount;
+        return result;
+    }
+
+    const char* MemoryStats::GetTagName(MemoryTag tag)
+    {
+        switch (tag)
+        {
+            case MemoryTag::General:
+                return "General";
+            case MemoryTag::Small:
+                return "Small";
+            case MemoryTag::Frame:
+                return "Frame";
+            case MemoryTag::GpuStaging:
+                return "GpuStaging";
+            default:
+                return "Unknown";
+        }
+    }
+
+    void MemoryStats::EndFrame()
+    {
+        std::lock_guard<std::mutex> lock(s_frameStateMutex);
+        for (uint32_t i = 0; i < kTagCount; ++i)
+        {
+            const MemoryTagStats stats = Collect(static_cast<MemoryTag>(i));
+
+            FrameState& state = s_frameStates[i];
+            state.frameBytes = stats.totalBytes - state.lastTotalBytes;
+            state.frameCount = stats.totalCount - state.lastTotalCount;
+            state.lastTotalBytes = stats.totalBytes;
+            state.lastTotalCount = stats.totalCount;
+        }
+    }
+
+    std::string MemoryStats::ToJson()
+    {
+        std::string json = "{";
+        char buffer[512];
+        for (uint32_t i = 0; i < kTagCount; ++i)
+        {
+            const MemoryTag tag = static_cast<MemoryTag>(i);
+            const MemoryTagStats stats = Get(tag);
+            snprintf(buffer, sizeof(buffer),
+                     "%s\"%s\":{\"liveBytes\":%llu,\"peakBytes\":%llu,\"liveCount\":%llu,\"totalCount\":%llu,\"totalBytes\":%llu,"
+                     "\"frameCount\":%llu,\"frameBytes\":%llu}",
+                     i != 0 ? "," : "", GetTagName(tag), (unsigned long long)stats.liveBytes, (unsigned long long)stats.peakBytes,
+                     (unsigned long long)stats.liveCount, (unsigned long long)stats.totalCount, (unsigned long long)stats.totalBytes,
+                     (unsigned long long)stats.frameCount, (unsigned long long)stats.frameBytes);
+            json += buffer;
+        }
+
+        json += "}";
+        return json;
+    }
+
+    bool MemoryStats::DumpJson(const std::string& path)
+    {
+        FileStream stream(path, FileMode::Write);
+        if (!stream.CanWrite())
+            return false;
+
+        const std::string json = ToJson();
+        return stream.Write(json.data(), json.size()) == json.size();
+    }
+
+    /* MemoryAllocatorBase */
+    size_t MemoryAllocatorBase::GetAllocationSize(void* ptr)
+    {
+        const size_t blockSize = SmallObjectAllocator::GetBlockSize(ptr);
+        if (blockSize != 0)
+            return blockSize;
+
+#if defined(_WIN32)
+        return _msize(ptr);
+#elif defined(__APPLE__)
+        return malloc_size(ptr);
+#else
+        return malloc_usable_size(ptr);
+#endif
+    }
+
+    size_t MemoryAllocatorBase::GetAlignedAllocationSize(void* ptr)
+    {
+#if defined(_WIN32)
+        // _aligned_msize needs the alignment, which free_aligned doesn't know. Only the count is tracked.
+        ALIMER_UNUSED(ptr);
+        return 0;
+#elif defined(__APPLE__)
+        return malloc_size(ptr);
+#else
+        return malloc_usable_size(ptr);
+#endif
+    }
 }
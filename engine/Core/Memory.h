@@ -23,8 +23,12 @@
 
 #pragma once
 
+#include "AlimerConfig.h"
 #include "PlatformDef.h"
+#include <cstddef>
+#include <cstdlib>
 #include <memory>
+#include <string>
 
 #if (ALIMER_PLATFORM_WINDOWS || ALIMER_PLATFORM_UWP || ALIMER_PLATFORM_XBOXONE)
 #include <malloc.h>
@@ -96,26 +100,118 @@ namespace alimer
     {
     };
 
-    /// Thread safe class used for storing total number of memory allocations and deallocations, primarily for statistic purposes.
-    class ALIMER_API MemoryCounter
+    /**
+     * Size-class allocator with thread-local caches, see SmallObjectAllocator. Use for small objects that are created
+     * and destroyed often. Allocations larger than SmallObjectAllocator::kMaxSize fall back to the general allocator.
+     */
+    class SmallAlloc
     {
-    private:
-        friend class MemoryAllocatorBase;
+    };
+
+    /**
+     * Per-thread linear allocator that is cleared in bulk at the end of every frame. Use for transient allocations that
+     * don't outlive the frame they were made in, freeing is a no-op.
+     */
+    class FrameAlloc
+    {
+    };
+
+    /// Category used to account memory in MemoryStats.
+    enum class MemoryTag : uint32_t
+    {
+        /// GenAlloc and allocators without a dedicated tag.
+        General,
+        /// SmallAlloc pool allocations.
+        Small,
+        /// FrameAlloc transient allocations.
+        Frame,
+        /// CPU visible GPU staging buffers.
+        GpuStaging,
+        Count
+    };
+
+    /// Snapshot of the memory statistics of one tag.
+    struct MemoryTagStats
+    {
+        /// Bytes currently allocated.
+        uint64_t liveBytes = 0;
+        /// Highest value of liveBytes seen at a frame boundary or query.
+        uint64_t peakBytes = 0;
+        /// Number of allocations currently alive.
+        uint64_t liveCount = 0;
+        /// Number of allocations since startup.
+        uint64_t totalCount = 0;
+        /// Number of bytes allocated since startup.
+        uint64_t totalBytes = 0;
+        /// Number of allocations made during the last completed frame.
+        uint64_t frameCount = 0;
+        /// Number of bytes allocated during the last completed frame.
+        uint64_t frameBytes = 0;
+    };
+
+    /**
+     * Thread safe memory accounting per MemoryTag, enabled in every build configuration. Counters are sharded across
+     * cache lines and updated with relaxed atomics, so recording is a few uncontended adds. Sizes are the usable size
+     * of the allocation as reported by the allocator, so allocs and frees of the same pointer always balance.
+     */
+    class ALIMER_API MemoryStats final
+    {
+    public:
+        /// Record an allocation of the given size.
+        static void RecordAlloc(MemoryTag tag, size_t size);
+        /// Record a free of the given size.
+        static void RecordFree(MemoryTag tag, size_t size);
+        /// Record the release of several allocations at once.
+        static void RecordFree(MemoryTag tag, size_t size, uint64_t count);
 
-        // Threadlocal data can't be exported, so some magic to make it accessible from MemoryAllocator
-        static void incAllocCount() { ++Allocs; }
-        static void incFreeCount() { ++Frees; }
+        /// Return the statistics of the given tag.
+        static MemoryTagStats Get(MemoryTag tag);
 
-        static ALIMER_THREADLOCAL uint64_t Allocs;
-        static ALIMER_THREADLOCAL uint64_t Frees;
+        /// Return the display name of the given tag.
+        static const char* GetTagName(MemoryTag tag);
+
+        /// Close the current frame: update peaks and the per-frame allocation rate.
+        static void EndFrame();
+
+        /// Return the statistics of every tag as a JSON object.
+        static std::string ToJson();
+
+        /// Write ToJson() to the given file. Returns false if the file can't be written.
+        static bool DumpJson(const std::string& path);
     };
 
-    /** Base class all memory allocators need to inherit. Provides allocation and free counting. */
-    class MemoryAllocatorBase
+    /** Base class all memory allocators need to inherit. Provides allocation and free accounting. */
+    class ALIMER_API MemoryAllocatorBase
     {
     protected:
-        static void IncreaseAllocCount() { MemoryCounter::incAllocCount(); }
-        static void IncreaseFreeCount() { MemoryCounter::incFreeCount(); }
+        /// Return the usable size of a block returned by malloc or the small-object allocator.
+        static size_t GetAllocationSize(void* ptr);
+        /// Return the usable size of a block returned by alimer_aligned_alloc, zero where the platform can't tell.
+        static size_t GetAlignedAllocationSize(void* ptr);
+
+        static void TrackAlloc(MemoryTag tag, void* ptr)
+        {
+            if (ptr != nullptr)
+                MemoryStats::RecordAlloc(tag, GetAllocationSize(ptr));
+        }
+
+        static void TrackFree(MemoryTag tag, void* ptr)
+        {
+            if (ptr != nullptr)
+                MemoryStats::RecordFree(tag, GetAllocationSize(ptr));
+        }
+
+        static void TrackAlignedAlloc(MemoryTag tag, void* ptr)
+        {
+            if (ptr != nullptr)
+                MemoryStats::RecordAlloc(tag, GetAlignedAllocationSize(ptr));
+        }
+
+        static void TrackAlignedFree(MemoryTag tag, void* ptr)
+        {
+            if (ptr != nullptr)
+                MemoryStats::RecordFree(tag, GetAlignedAllocationSize(ptr));
+        }
     };
 
     template <class T> class MemoryAllocator : public MemoryAllocatorBase
@@ -123,41 +219,131 @@ namespace alimer
     public:
         static void* allocate(size_t size)
         {
-#if defined(_DEBUG)
-            IncreaseAllocCount();
-#endif
-            return malloc(size);
+            void* ptr = malloc(size);
+            TrackAlloc(MemoryTag::General, ptr);
+            return ptr;
         }
 
         static void free(void* ptr)
         {
-#if defined(_DEBUG)
-            IncreaseFreeCount();
-#endif
-
+            TrackFree(MemoryTag::General, ptr);
             ::free(ptr);
         }
 
         static void* allocate_aligned(size_t alignment, size_t size)
         {
-#if defined(_DEBUG)
-            IncreaseAllocCount();
-#endif
-
-            return alimer_aligned_alloc(alignment, size);
+            void* ptr = alimer_aligned_alloc(alignment, size);
+            TrackAlignedAlloc(MemoryTag::General, ptr);
+            return ptr;
         }
 
         /** Frees memory allocated with allocateAligned() */
         static void free_aligned(void* ptr)
         {
-#if defined(_DEBUG)
-            IncreaseFreeCount();
-#endif
-
+            TrackAlignedFree(MemoryTag::General, ptr);
             alimer_aligned_free(ptr);
         }
     };
 
+    /** Memory allocator specialization for small objects, see SmallObjectAllocator. */
+    template <> class ALIMER_API MemoryAllocator<SmallAlloc> : public MemoryAllocatorBase
+    {
+    public:
+        static void* allocate(size_t size);
+        static void free(void* ptr);
+        static void* allocate_aligned(size_t alignment, size_t size);
+        static void free_aligned(void* ptr);
+    };
+
+#if defined(ALIMER_SMALL_OBJECT_ALLOCATOR)
+    /** General allocations are served by the small-object allocator, which falls back to malloc for large sizes. */
+    template <> class ALIMER_API MemoryAllocator<GenAlloc> : public MemoryAllocatorBase
+    {
+    public:
+        static void* allocate(size_t size);
+        static void free(void* ptr);
+        static void* allocate_aligned(size_t alignment, size_t size);
+        static void free_aligned(void* ptr);
+    };
+#endif
+
+    /** Memory allocator specialization for transient per-frame allocations, see FrameAllocator. */
+    template <> class ALIMER_API MemoryAllocator<FrameAlloc> : public MemoryAllocatorBase
+    {
+    public:
+        static void* allocate(size_t size);
+        static void free(void* ptr);
+        static void* allocate_aligned(size_t alignment, size_t size);
+        static void free_aligned(void* ptr);
+    };
+
+    /**
+     * Linear allocator that hands out memory by bumping a pointer inside a list of pages. When the current page is full
+     * an overflow page is appended, pages are kept and reused after Clear(). In debug builds cleared memory is filled
+     * with kPoisonByte to catch use of memory from a previous frame.
+     */
+    class ALIMER_API FrameAllocator final
+    {
+    public:
+        static constexpr size_t kDefaultPageSize = 64 * 1024;
+        static constexpr size_t kDefaultAlignment = 16;
+        static constexpr uint8_t kPoisonByte = 0xDD;
+
+        /// Constructor.
+        explicit FrameAllocator(size_t pageSize = kDefaultPageSize);
+        /// Destructor. Releases all pages.
+        ~FrameAllocator();
+
+        FrameAllocator(const FrameAllocator&) = delete;
+        FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+        /// Allocate memory aligned to the given power of two boundary.
+        void* Allocate(size_t size, size_t alignment = kDefaultAlignment);
+
+        /// Release every allocation at once. Pages are kept for the next frame.
+        void Clear();
+
+        /// Return the number of bytes handed out since the last Clear, including alignment padding.
+        size_t GetUsedBytes() const;
+        /// Return the number of bytes reserved by all pages.
+        size_t GetReservedBytes() const;
+
+        /// Return the allocator of the calling thread, cleared lazily if a frame boundary happened since its last use.
+        static FrameAllocator& GetThreadAllocator();
+
+    private:
+        struct Page
+        {
+            Page* next;
+            size_t size;
+            size_t used;
+        };
+
+        Page* AllocatePage(size_t minSize);
+        void ReleaseStats();
+        static uint8_t* GetPageData(Page* page) { return reinterpret_cast<uint8_t*>(page) + sizeof(Page); }
+
+        size_t pageSize;
+        Page* firstPage = nullptr;
+        Page* currentPage = nullptr;
+        uint64_t frameIndex = 0;
+        /// Requested bytes and allocation count since the last Clear, reported to MemoryStats.
+        uint64_t trackedBytes = 0;
+        uint64_t trackedCount = 0;
+    };
+
+    /** Allocates the specified number of bytes from the calling thread's frame allocator. */
+    ALIMER_API void* alimer_frame_alloc(size_t count);
+
+    /** Allocates the specified number of bytes aligned to the provided boundary from the calling thread's frame allocator. */
+    ALIMER_API void* alimer_frame_alloc_aligned(size_t alignment, size_t count);
+
+    /** Frees memory allocated with alimer_frame_alloc(). Does nothing, frame memory is released by alimer_frame_clear(). */
+    inline void alimer_frame_free(void*) {}
+
+    /** Marks the end of the frame. Every thread's frame allocator is cleared before its next allocation. */
+    ALIMER_API void alimer_frame_clear();
+
     /** Allocates the specified number of bytes. */
     template <class Alloc> constexpr void* alimer_alloc(size_t count) { return MemoryAllocator<Alloc>::allocate(count); }
 
@@ -267,20 +453,43 @@ namespace alimer
         constexpr StdAlloc() noexcept {}
 
         constexpr StdAlloc(const StdAlloc&) noexcept = default;
-        template <class U> constexpr StdAlloc(const StdAlloc<U>&) noexcept {}
+        template <class U> constexpr StdAlloc(const StdAlloc<U, Alloc>&) noexcept {}
 
         [[nodiscard]] T* allocate(const size_type count)
         {
             if (count == 0)
                 return nullptr;
 
-            void* const ptr = alimer_alloc<Alloc>(count * sizeof(T));
+            // Over-aligned types, such as cache line padded slots, need the aligned allocation path.
+            void* ptr;
+            if constexpr (alignof(T) > alignof(std::max_align_t))
+                ptr = MemoryAllocator<Alloc>::allocate_aligned(alignof(T), count * sizeof(T));
+            else
+                ptr = alimer_alloc<Alloc>(count * sizeof(T));
+
             if (!ptr)
                 return nullptr; // Error
 
             return static_cast<T*>(ptr);
         }
 
-        void deallocate(T* ptr, const size_type) { alimer_free<Alloc>(ptr); }
+        void deallocate(T* ptr, const size_type)
+        {
+            if constexpr (alignof(T) > alignof(std::max_align_t))
+                MemoryAllocator<Alloc>::free_aligned(ptr);
+            else
+                alimer_free<Alloc>(ptr);
+        }
     };
+
+    /** All allocators with the same tag are interchangeable. */
+    template <class T, class U, class Alloc> constexpr bool operator==(const StdAlloc<T, Alloc>&, const StdAlloc<U, Alloc>&) noexcept
+    {
+        return true;
+    }
+
+    template <class T, class U, class Alloc> constexpr bool operator!=(const StdAlloc<T, Alloc>&, const StdAlloc<U, Alloc>&) noexcept
+    {
+        return false;
+    }
 }
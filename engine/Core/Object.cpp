@@ -21,40 +21,194 @@
 //
 
 #include "Core/Object.h"
+#include "Core/Assert.h"
+#include "Core/Concurrency.h"
+#include "Core/Containers.h"
+#include "Core/HashMap.h"
 #include "Graphics/Graphics.h"
 #include "Platform/Input.h"
+#include <atomic>
+#include <cstdlib>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
 
 namespace alimer
 {
+    namespace
+    {
+        /// Next free type slot, constant initialized so it is ready before any static TypeInfo.
+        std::atomic<uint32_t> nextTypeSlot{0};
+    }
+
     namespace details
     {
+        /// Immutable view of the registry. Readers load the current snapshot without locking, writers publish a new one.
+        struct RegistrySnapshot
+        {
+            Vector<Object*> subsystemsBySlot;
+            HashMap<StringId32, Object*> subsystems;
+            HashMap<StringId32, ObjectFactory*> factories;
+            Input* input = nullptr;
+            Graphics* graphics = nullptr;
+        };
+
         struct Context
         {
-            /// Object factories.
-            std::unordered_map<StringId32, RefPtr<Object>> subsystems;
-            std::unordered_map<StringId32, std::unique_ptr<ObjectFactory>> factories;
+            /// Guards the owning containers below and serializes publishing.
+            Mutex writeLock;
+            HashMap<StringId32, RefPtr<Object>> subsystems;
+            HashMap<StringId32, std::unique_ptr<ObjectFactory>> factories;
+            Input* input = nullptr;
+            Graphics* graphics = nullptr;
+
+            /// Replaced snapshots and factories may still be in use by readers. Registration happens a handful of times
+            /// per run, so they are kept alive until the context is destroyed instead of tracking reader epochs.
+            Vector<std::unique_ptr<const RegistrySnapshot>> retiredSnapshots;
+            Vector<std::unique_ptr<ObjectFactory>> retiredFactories;
+
+            std::atomic<const RegistrySnapshot*> snapshot{nullptr};
+
+            ~Context() { delete snapshot.load(std::memory_order_relaxed); }
 
-            WeakPtr<Input> input;
-            WeakPtr<Graphics> graphics;
+            const RegistrySnapshot* GetSnapshot() const { return snapshot.load(std::memory_order_acquire); }
 
-            void RegisterSubsystem(Object* subsystem) { subsystems[subsystem->GetType()] = subsystem; }
+            void RegisterSubsystem(Object* subsystem)
+            {
+                std::lock_guard<Mutex> guard(writeLock);
+                ReplaceSubsystem(subsystem);
+            }
+
+            void RegisterSubsystem(Input* subsystem)
+            {
+                std::lock_guard<Mutex> guard(writeLock);
+                input = subsystem;
+                ReplaceSubsystem(subsystem);
+            }
+
+            void RegisterSubsystem(Graphics* subsystem)
+            {
+                std::lock_guard<Mutex> guard(writeLock);
+                graphics = subsystem;
+                ReplaceSubsystem(subsystem);
+            }
+
+            void RemoveSubsystem(StringId32 subsystemType)
+            {
+                std::lock_guard<Mutex> guard(writeLock);
+                auto it = subsystems.find(subsystemType);
+                if (it == subsystems.end())
+                    return;
+
+                if (it->second.Get() == input)
+                    input = nullptr;
+                if (it->second.Get() == graphics)
+                    graphics = nullptr;
+
+                // Publish before releasing the reference so new readers cannot observe a dead object. Readers still holding
+                // the previous snapshot can, which is why removal requires them to be quiescent. Retiring the reference
+                // instead would defer destroying Graphics past the application's shutdown sequence.
+                RefPtr<Object> removed = std::move(it->second);
+                subsystems.erase(it);
+                Publish();
+            }
+
+            Object* GetSubsystem(StringId32 type) const
+            {
+                const RegistrySnapshot* current = GetSnapshot();
+                if (current == nullptr)
+                    return nullptr;
+
+                Object* const* subsystem = current->subsystems.TryGet(type);
+                return subsystem != nullptr ? *subsystem : nullptr;
+            }
+
+            Object* GetSubsystem(const TypeInfo* typeInfo) const
+            {
+                const RegistrySnapshot* current = GetSnapshot();
+                if (current == nullptr || typeInfo->GetSlot() >= current->subsystemsBySlot.size())
+                    return nullptr;
+
+                return current->subsystemsBySlot[typeInfo->GetSlot()];
+            }
+
+            void RegisterFactory(ObjectFactory* factory)
+            {
+                std::lock_guard<Mutex> guard(writeLock);
+                std::unique_ptr<ObjectFactory>& slot = factories[factory->GetType()];
+                if (slot)
+                {
+                    retiredFactories.push_back(std::move(slot));
+                }
+                slot.reset(factory);
+                Publish();
+            }
+
+            RefPtr<Object> CreateObject(StringId32 type) const
+            {
+                const RegistrySnapshot* current = GetSnapshot();
+                if (current == nullptr)
+                    return nullptr;
 
-            void RemoveSubsystem(StringId32 subsystemType) { subsystems.erase(subsystemType); }
+                ObjectFactory* const* factory = current->factories.TryGet(type);
+                return factory != nullptr ? (*factory)->Create() : nullptr;
+            }
 
-            Object* GetSubsystem(StringId32 type)
+            bool CreateObjects(StringId32 type, uint32_t count, Vector<RefPtr<Object>>& result) const
             {
-                auto it = subsystems.find(type);
-                return it != subsystems.end() ? it->second.Get() : nullptr;
+                const RegistrySnapshot* current = GetSnapshot();
+                if (current == nullptr)
+                    return false;
+
+                ObjectFactory* const* factory = current->factories.TryGet(type);
+                if (factory == nullptr)
+                    return false;
+
+                (*factory)->Create(count, result);
+                return true;
             }
 
-            void RegisterFactory(ObjectFactory* factory) { factories[factory->GetType()].reset(factory); }
+        private:
+            /// Store a subsystem and publish it, releasing any previous one of the same type only afterwards.
+            void ReplaceSubsystem(Object* subsystem)
+            {
+                RefPtr<Object>& slot = subsystems[subsystem->GetType()];
+                RefPtr<Object> replaced = std::move(slot);
+                slot = subsystem;
+                Publish();
+            }
 
-            RefPtr<Object> CreateObject(StringId32 type)
+            /// Build a new snapshot from the owning containers and swap it in. Must be called with writeLock held.
+            void Publish()
             {
-                auto it = factories.find(type);
-                return it != factories.end() ? it->second->Create() : nullptr;
+                std::unique_ptr<RegistrySnapshot> next(new RegistrySnapshot());
+                next->subsystems.reserve(subsystems.size());
+                for (const auto& entry : subsystems)
+                {
+                    Object* subsystem = entry.second.Get();
+                    next->subsystems[entry.first] = subsystem;
+
+                    const uint32_t slot = subsystem->GetTypeInfo()->GetSlot();
+                    if (slot >= next->subsystemsBySlot.size())
+                    {
+                        next->subsystemsBySlot.resize(slot + 1, nullptr);
+                    }
+                    next->subsystemsBySlot[slot] = subsystem;
+                }
+
+                next->factories.reserve(factories.size());
+                for (const auto& entry : factories)
+                {
+                    next->factories[entry.first] = entry.second.get();
+                }
+
+                next->input = input;
+                next->graphics = graphics;
+
+                const RegistrySnapshot* previous = snapshot.exchange(next.release(), std::memory_order_acq_rel);
+                if (previous != nullptr)
+                {
+                    retiredSnapshots.emplace_back(previous);
+                }
             }
         };
 
@@ -66,38 +220,32 @@ namespace alimer
     }
 
     TypeInfo::TypeInfo(const char* typeName_, const TypeInfo* baseTypeInfo_)
-        : type(typeName_)
+        : type(StringId32::Intern(typeName_))
         , typeName(typeName_)
         , baseTypeInfo(baseTypeInfo_)
+        , depth(baseTypeInfo_ != nullptr ? baseTypeInfo_->depth + 1 : 0)
+        , slot(nextTypeSlot.fetch_add(1, std::memory_order_relaxed))
     {
-    }
-
-    bool TypeInfo::IsTypeOf(StringId32 type) const
-    {
-        const TypeInfo* current = this;
-        while (current)
+        // Checked in every configuration since ancestors would overflow. ALIMER_OBJECT types fail at compile time already.
+        if (depth >= kMaxDepth)
         {
-            if (current->GetType() == type)
-                return true;
-
-            current = current->GetBaseTypeInfo();
+            ReportAssertFailure("depth < kMaxDepth", __FILE__, __LINE__, "Type hierarchy of %s is too deep", typeName_);
+            std::abort();
         }
 
-        return false;
+        for (uint32_t i = 0; i < depth; ++i)
+        {
+            ancestors[i] = baseTypeInfo->ancestors[i];
+        }
+        ancestors[depth] = type;
     }
 
-    bool TypeInfo::IsTypeOf(const TypeInfo* typeInfo) const
+    bool TypeInfo::IsTypeOf(StringId32 type_) const
     {
-        if (typeInfo == nullptr)
-            return false;
-
-        const TypeInfo* current = this;
-        while (current)
+        for (uint32_t i = 0; i <= depth; ++i)
         {
-            if (current == typeInfo || current->GetType() == typeInfo->GetType())
+            if (ancestors[i] == type_)
                 return true;
-
-            current = current->GetBaseTypeInfo();
         }
 
         return false;
@@ -118,13 +266,17 @@ namespace alimer
 
     void Object::RegisterSubsystem(Input* subsystem)
     {
-        details::context().input = subsystem;
+        if (!subsystem)
+            return;
+
         details::context().RegisterSubsystem(subsystem);
     }
 
     void Object::RegisterSubsystem(Graphics* subsystem)
     {
-        details::context().graphics = subsystem;
+        if (!subsystem)
+            return;
+
         details::context().RegisterSubsystem(subsystem);
     }
 
@@ -140,9 +292,25 @@ namespace alimer
 
     Object* Object::GetSubsystem(StringId32 type) { return details::context().GetSubsystem(type); }
 
-    template <> Input* Object::GetSubsystem<Input>() { return details::context().input; }
+    Object* Object::GetSubsystem(const TypeInfo* typeInfo)
+    {
+        if (!typeInfo)
+            return nullptr;
+
+        return details::context().GetSubsystem(typeInfo);
+    }
+
+    template <> Input* Object::GetSubsystem<Input>()
+    {
+        const details::RegistrySnapshot* snapshot = details::context().GetSnapshot();
+        return snapshot != nullptr ? snapshot->input : nullptr;
+    }
 
-    template <> Graphics* Object::GetSubsystem<Graphics>() { return details::context().graphics; }
+    template <> Graphics* Object::GetSubsystem<Graphics>()
+    {
+        const details::RegistrySnapshot* snapshot = details::context().GetSnapshot();
+        return snapshot != nullptr ? snapshot->graphics : nullptr;
+    }
 
     void Object::RegisterFactory(ObjectFactory* factory)
     {
@@ -153,4 +321,9 @@ namespace alimer
     }
 
     RefPtr<Object> Object::CreateObject(StringId32 objectType) { return details::context().CreateObject(objectType); }
+
+    bool Object::CreateObjects(StringId32 objectType, uint32_t count, Vector<RefPtr<Object>>& result)
+    {
+        return details::context().CreateObjects(objectType, count, result);
+    }
 }
@@ -22,15 +22,21 @@
 
 #pragma once
 
+#include "Core/Containers.h"
+#include "Core/ObjectPool.h"
 #include "Core/Ptr.h"
 #include "Core/StringId.h"
 
 namespace alimer
 {
-    /// Type info.
+    /// Type info. Every type stores the ids of its ancestors indexed by depth, so checking against a TypeInfo is a
+    /// single compare.
     class ALIMER_API TypeInfo final
     {
     public:
+        /// Maximum depth of the type hierarchy.
+        static constexpr uint32_t kMaxDepth = 16;
+
         /// Construct.
         TypeInfo(const char* typeName_, const TypeInfo* baseTypeInfo_);
         /// Destruct.
@@ -39,7 +45,10 @@ namespace alimer
         /// Check current type is type of specified type.
         bool IsTypeOf(StringId32 type) const;
         /// Check current type is type of specified type.
-        bool IsTypeOf(const TypeInfo* typeInfo) const;
+        bool IsTypeOf(const TypeInfo* typeInfo) const
+        {
+            return typeInfo != nullptr && typeInfo->depth <= depth && ancestors[typeInfo->depth] == typeInfo->type;
+        }
         /// Check current type is type of specified class type.
         template <typename T> bool IsTypeOf() const { return IsTypeOf(T::GetTypeInfoStatic()); }
 
@@ -49,6 +58,10 @@ namespace alimer
         const std::string& GetTypeName() const { return typeName; }
         /// Return base type info.
         const TypeInfo* GetBaseTypeInfo() const { return baseTypeInfo; }
+        /// Return the number of base types.
+        uint32_t GetDepth() const { return depth; }
+        /// Return the unique index assigned to the type when its TypeInfo was created, used for O(1) registry lookups.
+        uint32_t GetSlot() const { return slot; }
 
     private:
         /// Type.
@@ -57,6 +70,12 @@ namespace alimer
         std::string typeName;
         /// Base class type info.
         const TypeInfo* baseTypeInfo;
+        /// Number of base types.
+        uint32_t depth;
+        /// Registry slot index.
+        uint32_t slot;
+        /// Type ids from the root type down to this type.
+        StringId32 ancestors[kMaxDepth];
     };
 
     class ObjectFactory;
@@ -83,6 +102,8 @@ namespace alimer
 
         /// Return type info static.
         static const TypeInfo* GetTypeInfoStatic() { return nullptr; }
+        /// Number of ALIMER_OBJECT types from the root down to this class, used to bound the hierarchy at compile time.
+        static constexpr uint32_t kTypeChainLength = 0;
         /// Check current instance is type of specified type.
         bool IsInstanceOf(StringId32 type) const;
         /// Check current instance is type of specified type.
@@ -97,27 +118,34 @@ namespace alimer
             return IsInstanceOf<T>() ? static_cast<const T*>(this) : nullptr;
         }
 
-        /// Register an object as a subsystem that can be accessed globally. Note that the subsystems container does not
-        /// own the objects.
+        /// Register an object as a subsystem that can be accessed globally. The registry holds a reference to it.
+        /// Replacing a subsystem of the same type releases the previous one, see RemoveSubsystem.
         static void RegisterSubsystem(Object* subsystem);
         static void RegisterSubsystem(Input* subsystem);
         static void RegisterSubsystem(Graphics* subsystem);
 
-        /// Remove a subsystem by object pointer.
+        /// Remove a subsystem by object pointer. The registry's reference is released as soon as the removal is
+        /// published, so no other thread may be inside GetSubsystem or still using a pointer it returned. Application
+        /// removes its subsystems during shutdown, once the frame loop has stopped.
         static void RemoveSubsystem(Object* subsystem);
         /// Remove a subsystem by type.
         static void RemoveSubsystem(StringId32 type);
         /// Template version of removing a subsystem.
         template <class T> static void RemoveSubsystem() { RemoveSubsystem(T::GetTypeStatic()); }
-        /// Return a subsystem by type, or null if not registered.
+        /// Return a subsystem by type, or null if not registered. Lock free, safe to call from any thread.
         static Object* GetSubsystem(StringId32 type);
+        /// Return a subsystem by type info, or null if not registered. Lock free, safe to call from any thread.
+        static Object* GetSubsystem(const TypeInfo* typeInfo);
         /// Register an object factory.
         static void RegisterFactory(ObjectFactory* factory);
-        /// Create an object by type hash. Return pointer to it or null if no factory found.
+        /// Create an object by type hash. Return pointer to it or null if no factory found. Safe to call from any thread.
         static RefPtr<Object> CreateObject(StringId32 objectType);
+        /// Create count objects by type hash and append them to result. Pooled types are placed contiguously. Return false
+        /// if no factory found.
+        static bool CreateObjects(StringId32 objectType, uint32_t count, Vector<RefPtr<Object>>& result);
 
         /// Return a subsystem, template version.
-        template <class T> static T* GetSubsystem() { return static_cast<T*>(GetSubsystem(T::GetTypeStatic())); }
+        template <class T> static T* GetSubsystem() { return static_cast<T*>(GetSubsystem(T::GetTypeInfoStatic())); }
 
         /// Register an object factory, template version.
         template <class T> static void RegisterFactory() { RegisterFactory(new ObjectFactoryImpl<T>()); }
@@ -127,6 +155,21 @@ namespace alimer
         {
             return StaticCast<T>(CreateObject(T::GetTypeStatic()));
         }
+
+        /// Create count objects through a factory, template version.
+        template <class T> static Vector<RefPtr<T>> CreateObjects(uint32_t count)
+        {
+            Vector<RefPtr<Object>> objects;
+            CreateObjects(T::GetTypeStatic(), count, objects);
+
+            Vector<RefPtr<T>> result;
+            result.reserve(objects.size());
+            for (RefPtr<Object>& object : objects)
+            {
+                result.push_back(StaticCast<T>(object));
+            }
+            return result;
+        }
     };
 
     template <> ALIMER_API Input* Object::GetSubsystem<Input>();
@@ -142,6 +185,16 @@ namespace alimer
         /// /// Create an object.
         virtual RefPtr<Object> Create() = 0;
 
+        /// Create count objects and append them to result.
+        virtual void Create(uint32_t count, Vector<RefPtr<Object>>& result)
+        {
+            result.reserve(result.size() + count);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                result.push_back(Create());
+            }
+        }
+
         /// Return type info of objects created by this factory.
         const TypeInfo* GetTypeInfo() const { return typeInfo; }
 
@@ -165,6 +218,17 @@ namespace alimer
 
         /// Create an object of the specific type.
         RefPtr<Object> Create() override { return RefPtr<Object>(new T()); }
+
+        /// Create count objects of the specific type, pooled types get one contiguous run of slots.
+        void Create(uint32_t count, Vector<RefPtr<Object>>& result) override
+        {
+            ReservePool(count, IsPooledObject<T>());
+            ObjectFactory::Create(count, result);
+        }
+
+    private:
+        static void ReservePool(uint32_t count, std::true_type) { ObjectPool<T>::Get().Reserve(count); }
+        static void ReservePool(uint32_t, std::false_type) {}
     };
 }
 
@@ -172,13 +236,26 @@ namespace alimer
 public:                                                                                                                \
     using ClassName = typeName;                                                                                        \
     using Parent = baseTypeName;                                                                                       \
-    virtual alimer::StringId32 GetType() const override { return GetTypeInfoStatic()->GetType(); }                     \
+    virtual alimer::StringId32 GetType() const override { return GetTypeStatic(); }                                    \
     virtual const std::string& GetTypeName() const override { return GetTypeInfoStatic()->GetTypeName(); }             \
     virtual const alimer::TypeInfo* GetTypeInfo() const override { return GetTypeInfoStatic(); }                       \
-    static alimer::StringId32 GetTypeStatic() { return GetTypeInfoStatic()->GetType(); }                               \
+    static constexpr alimer::StringId32 kTypeId{#typeName};                                                            \
+    static constexpr alimer::StringId32 GetTypeStatic() { return kTypeId; }                                            \
+    static constexpr uint32_t kTypeChainLength = Parent::kTypeChainLength + 1;                                         \
+    static_assert(kTypeChainLength <= alimer::TypeInfo::kMaxDepth, "Type hierarchy of " #typeName " is too deep");     \
     static const std::string& GetTypeNameStatic() { return GetTypeInfoStatic()->GetTypeName(); }                       \
     static const alimer::TypeInfo* GetTypeInfoStatic()                                                                 \
     {                                                                                                                  \
         static const alimer::TypeInfo typeInfoStatic(#typeName, Parent::GetTypeInfoStatic());                          \
         return &typeInfoStatic;                                                                                        \
-    }\
+    }
+
+/// Same as ALIMER_OBJECT, and allocate instances of the class from an ObjectPool. Classes deriving from it use the
+/// general allocator unless they are declared pooled as well.
+#define ALIMER_POOLED_OBJECT(typeName, baseTypeName)                                                                   \
+    ALIMER_OBJECT(typeName, baseTypeName)                                                                              \
+    using PooledClass = typeName;                                                                                      \
+    static void* operator new(size_t size) { return alimer::ObjectPool<typeName>::Allocate(size); }                   \
+    static void* operator new(size_t, void* place) noexcept { return place; }                                         \
+    static void operator delete(void* ptr, size_t size) { alimer::ObjectPool<typeName>::Free(ptr, size); }            \
+    static void operator delete(void*, void*) noexcept {}
@@ -0,0 +1,285 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Core/Concurrency.h"
+#include "Core/Memory.h"
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace alimer
+{
+    /**
+     * Free-list pool holding objects of type T in contiguous chunks. Only memory is managed, construction is left to
+     * the caller (see ALIMER_POOLED_OBJECT). Chunks grow geometrically and are never returned while the program runs,
+     * so objects of one type stay packed together. Thread safe.
+     */
+    template <typename T> class ObjectPool final
+    {
+    public:
+        static constexpr size_t kMinChunkSlots = 32;
+        static constexpr size_t kMaxChunkSlots = 4096;
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        /// Return the pool of the type. The instance is never destroyed so objects can be freed during static teardown.
+        static ObjectPool& Get()
+        {
+            alignas(ObjectPool) static unsigned char storage[sizeof(ObjectPool)];
+            static ObjectPool* instance = new (storage) ObjectPool();
+            return *instance;
+        }
+
+        /// Allocate memory for an object of the given size. Sizes other than sizeof(T), for example from a derived class
+        /// without its own pool, go to the general allocator.
+        static void* Allocate(size_t size)
+        {
+            if (size != sizeof(T))
+                return alimer_alloc(size);
+
+            return Get().AllocateSlot();
+        }
+
+        /// Free memory returned by Allocate, the size must be the one passed to Allocate.
+        static void Free(void* ptr, size_t size)
+        {
+            if (ptr == nullptr)
+                return;
+
+            if (size != sizeof(T))
+            {
+                alimer_free(ptr);
+                return;
+            }
+
+            Get().FreeSlot(ptr);
+        }
+
+        /// Make sure the next count allocations are served from one contiguous run of slots, in address order. Free
+        /// slots left scattered by earlier frees are sorted to look for such a run, a new chunk of count slots is
+        /// allocated only when there is none. Allocations from other threads in between can take slots from the run.
+        void Reserve(size_t count)
+        {
+            std::lock_guard<SpinLock> guard(lock);
+            if (contiguousCount >= count || (count <= 1 && freeList != nullptr))
+                return;
+
+            if (freeCount >= count)
+            {
+                SortFreeList();
+                if (MoveRunToFront(count))
+                    return;
+            }
+
+            AllocateChunk(count);
+        }
+
+        /// Return the number of live objects.
+        size_t GetLiveCount() const
+        {
+            std::lock_guard<SpinLock> guard(lock);
+            return liveCount;
+        }
+
+        /// Return the number of chunks allocated so far.
+        size_t GetChunkCount() const
+        {
+            std::lock_guard<SpinLock> guard(lock);
+            return chunkCount;
+        }
+
+    private:
+        union Slot
+        {
+            Slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        struct ChunkHeader
+        {
+            ChunkHeader* next;
+        };
+
+        static constexpr size_t kSlotAlignment = alignof(Slot) > 16 ? alignof(Slot) : 16;
+        static constexpr size_t kHeaderSize = (sizeof(ChunkHeader) + kSlotAlignment - 1) & ~(kSlotAlignment - 1);
+
+        ObjectPool() = default;
+        ~ObjectPool() = default;
+
+        void* AllocateSlot()
+        {
+            std::lock_guard<SpinLock> guard(lock);
+            if (freeList == nullptr)
+            {
+                AllocateChunk(nextChunkSlots);
+                nextChunkSlots = Min(nextChunkSlots * 2, kMaxChunkSlots);
+            }
+
+            Slot* slot = freeList;
+            freeList = slot->next;
+            freeCount--;
+            liveCount++;
+            if (contiguousCount > 0)
+            {
+                contiguousCount--;
+            }
+            return slot;
+        }
+
+        void FreeSlot(void* ptr)
+        {
+            Slot* slot = static_cast<Slot*>(ptr);
+            std::lock_guard<SpinLock> guard(lock);
+            slot->next = freeList;
+            freeList = slot;
+            freeCount++;
+            liveCount--;
+            contiguousCount = 0;
+        }
+
+        /// Sort the free list by address with a bottom up merge sort, which needs no memory. Called with the lock held.
+        void SortFreeList()
+        {
+            for (size_t width = 1; width < freeCount; width *= 2)
+            {
+                Slot* remaining = freeList;
+                Slot* head = nullptr;
+                Slot** tail = &head;
+                while (remaining != nullptr)
+                {
+                    Slot* left = remaining;
+                    Slot* right = Split(left, width);
+                    remaining = Split(right, width);
+                    while (left != nullptr || right != nullptr)
+                    {
+                        Slot** smallest = right == nullptr || (left != nullptr && left < right) ? &left : &right;
+                        *tail = *smallest;
+                        tail = &(*smallest)->next;
+                        *smallest = (*smallest)->next;
+                    }
+                }
+
+                *tail = nullptr;
+                freeList = head;
+            }
+
+            contiguousCount = 0;
+        }
+
+        /// Cut the list after count slots and return the rest.
+        static Slot* Split(Slot* list, size_t count)
+        {
+            for (; list != nullptr && count > 1; --count)
+            {
+                list = list->next;
+            }
+
+            if (list == nullptr)
+                return nullptr;
+
+            Slot* rest = list->next;
+            list->next = nullptr;
+            return rest;
+        }
+
+        /// Find a run of at least count adjacent slots in the sorted free list and move it to the head. Called with
+        /// the lock held.
+        bool MoveRunToFront(size_t count)
+        {
+            Slot* beforeRun = nullptr;
+            Slot* runBegin = freeList;
+            size_t runLength = 1;
+            for (Slot* slot = freeList; slot != nullptr; slot = slot->next)
+            {
+                Slot* next = slot->next;
+                if (next == slot + 1)
+                {
+                    runLength++;
+                    continue;
+                }
+
+                if (runLength >= count)
+                {
+                    if (beforeRun != nullptr)
+                    {
+                        beforeRun->next = next;
+                        slot->next = freeList;
+                        freeList = runBegin;
+                    }
+
+                    contiguousCount = runLength;
+                    return true;
+                }
+
+                beforeRun = slot;
+                runBegin = next;
+                runLength = 1;
+            }
+
+            return false;
+        }
+
+        /// Allocate a chunk and put its slots at the head of the free list in address order. Called with the lock held.
+        void AllocateChunk(size_t slotCount)
+        {
+            uint8_t* memory = static_cast<uint8_t*>(alimer_alloc_aligned(kSlotAlignment, kHeaderSize + slotCount * sizeof(Slot)));
+            ChunkHeader* header = reinterpret_cast<ChunkHeader*>(memory);
+            header->next = chunks;
+            chunks = header;
+            chunkCount++;
+
+            Slot* slots = reinterpret_cast<Slot*>(memory + kHeaderSize);
+            for (size_t i = slotCount; i-- > 0;)
+            {
+                slots[i].next = freeList;
+                freeList = &slots[i];
+            }
+
+            freeCount += slotCount;
+            contiguousCount = slotCount;
+        }
+
+        mutable SpinLock lock;
+        Slot* freeList = nullptr;
+        ChunkHeader* chunks = nullptr;
+        size_t nextChunkSlots = kMinChunkSlots;
+        size_t freeCount = 0;
+        /// Number of slots at the head of the free list known to be adjacent and in address order.
+        size_t contiguousCount = 0;
+        size_t liveCount = 0;
+        size_t chunkCount = 0;
+    };
+
+    /// True if T declares its own pool with ALIMER_POOLED_OBJECT. Classes deriving from a pooled class without
+    /// declaring their own pool are not pooled.
+    template <typename T, typename = void> struct IsPooledObject : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct IsPooledObject<T, typename std::enable_if<std::is_same<typename T::PooledClass, T>::value>::type> : std::true_type
+    {
+    };
+}
@@ -0,0 +1,404 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Core/Profiler.h"
+
+#if defined(ALIMER_PROFILING)
+#    include "Core/Concurrency.h"
+#    include "Core/Containers.h"
+#    include "Core/Log.h"
+#    include <atomic>
+#    include <cstdio>
+#    include <mutex>
+#    include <string>
+#endif
+
+namespace alimer
+{
+#if defined(ALIMER_PROFILING)
+    namespace
+    {
+        struct ProfileEvent
+        {
+            const ProfileZone* zone;
+            uint64_t begin;
+            uint64_t end;
+        };
+
+        struct EventChunk
+        {
+            static constexpr uint32_t kCapacity = 4096;
+
+            std::atomic<EventChunk*> next{nullptr};
+            ProfileEvent events[kCapacity];
+        };
+
+        /// Events of one thread. Only the owning thread appends, publishing the count with release so the exporter
+        /// can read the buffer while the thread keeps recording. Chunks are kept and reused by the next capture.
+        struct ThreadBuffer
+        {
+            uint32_t threadId = 0;
+            std::string name;
+            EventChunk* first = nullptr;
+            EventChunk* current = nullptr;
+            uint32_t currentCount = 0;
+            std::atomic<uint64_t> eventCount{0};
+            /// Capture the events belong to, the owner resets the buffer when a new capture starts.
+            std::atomic<uint32_t> generation{0};
+            std::atomic<bool> abandoned{false};
+        };
+
+        /// Plain data so it stays usable while thread_local destructors run.
+        struct ThreadProfile
+        {
+            ThreadBuffer* buffer;
+            bool destroyed;
+        };
+
+        ALIMER_THREADLOCAL ThreadProfile t_profile;
+
+        constexpr ProfileZone kFrameZone = {"Frame", __FILE__, __LINE__};
+
+        struct ProfilerState
+        {
+            std::atomic<bool> capturing{false};
+            std::atomic<uint32_t> generation{1};
+
+            /// Guards the buffer list, thread names and capture control.
+            Mutex lock;
+            Vector<ThreadBuffer*> buffers;
+
+            uint64_t captureStart = 0;
+            uint64_t lastFrameTime = 0;
+            uint32_t remainingFrames = 0;
+            bool frameCaptureRequested = false;
+            std::string frameCapturePath;
+        };
+
+        /// Never destroyed so zones recorded during static teardown have a home.
+        ProfilerState& GetState()
+        {
+            alignas(ProfilerState) static unsigned char storage[sizeof(ProfilerState)];
+            static ProfilerState* state = new (storage) ProfilerState();
+            return *state;
+        }
+
+        /// Hands the buffer to the next thread when the owner exits.
+        struct ThreadBufferReleaser
+        {
+            ~ThreadBufferReleaser()
+            {
+                if (t_profile.buffer != nullptr)
+                {
+                    t_profile.buffer->abandoned.store(true, std::memory_order_release);
+                    t_profile.buffer = nullptr;
+                }
+                t_profile.destroyed = true;
+            }
+        };
+
+        ThreadBuffer* AcquireBuffer(ProfilerState& state)
+        {
+            static thread_local ThreadBufferReleaser releaser;
+            ALIMER_UNUSED(releaser);
+
+            // The exporter holds the lock, so a reused buffer is never reset under it.
+            std::lock_guard<Mutex> guard(state.lock);
+            for (ThreadBuffer* buffer : state.buffers)
+            {
+                if (buffer->abandoned.load(std::memory_order_acquire))
+                {
+                    buffer->abandoned.store(false, std::memory_order_relaxed);
+                    buffer->name.clear();
+                    buffer->eventCount.store(0, std::memory_order_relaxed);
+                    buffer->generation.store(0, std::memory_order_release);
+                    return buffer;
+                }
+            }
+
+            ThreadBuffer* buffer = new ThreadBuffer();
+            buffer->threadId = static_cast<uint32_t>(state.buffers.size()) + 1;
+            buffer->first = new EventChunk();
+            state.buffers.push_back(buffer);
+            return buffer;
+        }
+
+        ThreadBuffer* GetThreadBuffer(ProfilerState& state)
+        {
+            if (t_profile.buffer == nullptr && !t_profile.destroyed)
+            {
+                t_profile.buffer = AcquireBuffer(state);
+            }
+            return t_profile.buffer;
+        }
+
+        void AppendEvent(ProfilerState& state, const ProfileZone& zone, uint64_t begin, uint64_t end)
+        {
+            ThreadBuffer* buffer = GetThreadBuffer(state);
+            if (buffer == nullptr)
+                return;
+
+            const uint32_t generation = state.generation.load(std::memory_order_acquire);
+            if (buffer->generation.load(std::memory_order_relaxed) != generation)
+            {
+                buffer->current = buffer->first;
+                buffer->currentCount = 0;
+                buffer->eventCount.store(0, std::memory_order_relaxed);
+                buffer->generation.store(generation, std::memory_order_release);
+            }
+
+            if (buffer->currentCount == EventChunk::kCapacity)
+            {
+                EventChunk* next = buffer->current->next.load(std::memory_order_relaxed);
+                if (next == nullptr)
+                {
+                    next = new EventChunk();
+                    buffer->current->next.store(next, std::memory_order_release);
+                }
+                buffer->current = next;
+                buffer->currentCount = 0;
+            }
+
+            buffer->current->events[buffer->currentCount++] = {&zone, begin, end};
+            buffer->eventCount.store(buffer->eventCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        void AppendText(fmt::memory_buffer& out, const char* text) { out.append(text, text + strlen(text)); }
+
+        void AppendEscaped(fmt::memory_buffer& out, const char* text)
+        {
+            for (; *text != '\0'; ++text)
+            {
+                const char c = *text;
+                if (c == '"' || c == '\\')
+                {
+                    out.push_back('\\');
+                    out.push_back(c);
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    fmt::format_to(out, "\\u{:04x}", static_cast<uint32_t>(c));
+                }
+                else
+                {
+                    out.push_back(c);
+                }
+            }
+        }
+
+        /// Write the current capture as Chrome trace-event JSON. Called with the lock held.
+        bool WriteTrace(ProfilerState& state, const char* path)
+        {
+            const uint32_t generation = state.generation.load(std::memory_order_relaxed);
+            const double microsecondsPerTick = 1000000.0 / static_cast<double>(Stopwatch::GetFrequency());
+            // Timestamps are made relative to the capture start to keep the numbers short.
+            const double origin = static_cast<double>(state.captureStart);
+
+            bool hasEvents = false;
+            for (ThreadBuffer* buffer : state.buffers)
+            {
+                hasEvents |= buffer->generation.load(std::memory_order_acquire) == generation &&
+                             buffer->eventCount.load(std::memory_order_acquire) != 0;
+            }
+
+            if (!hasEvents)
+                return false;
+
+            FILE* file = fopen(path, "wb");
+            if (file == nullptr)
+            {
+                LOGE("Failed to open profiler capture '{}'", path);
+                return false;
+            }
+
+            fmt::memory_buffer out;
+            AppendText(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+            bool firstEvent = true;
+            for (ThreadBuffer* buffer : state.buffers)
+            {
+                if (buffer->generation.load(std::memory_order_acquire) != generation)
+                    continue;
+
+                uint64_t remaining = buffer->eventCount.load(std::memory_order_acquire);
+                if (remaining == 0)
+                    continue;
+
+                if (!buffer->name.empty())
+                {
+                    fmt::format_to(out, "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"",
+                                   firstEvent ? "" : ",\n", buffer->threadId);
+                    AppendEscaped(out, buffer->name.c_str());
+                    AppendText(out, "\"}}");
+                    firstEvent = false;
+                }
+
+                for (const EventChunk* chunk = buffer->first; chunk != nullptr && remaining != 0;
+                     chunk = chunk->next.load(std::memory_order_acquire))
+                {
+                    const uint32_t count = static_cast<uint32_t>(Min<uint64_t>(remaining, EventChunk::kCapacity));
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        const ProfileEvent& event = chunk->events[i];
+                        AppendText(out, firstEvent ? "{\"name\":\"" : ",\n{\"name\":\"");
+                        AppendEscaped(out, event.zone->name);
+                        fmt::format_to(out, "\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{\"file\":\"",
+                                       buffer->threadId, (static_cast<double>(event.begin) - origin) * microsecondsPerTick,
+                                       static_cast<double>(event.end - event.begin) * microsecondsPerTick);
+                        AppendEscaped(out, event.zone->file);
+                        fmt::format_to(out, "\",\"line\":{}}}}}", event.zone->line);
+                        firstEvent = false;
+                    }
+
+                    remaining -= count;
+                    if (out.size() > 1024 * 1024)
+                    {
+                        fwrite(out.data(), 1, out.size(), file);
+                        out.clear();
+                    }
+                }
+            }
+
+            AppendText(out, "\n]}\n");
+            const bool written = fwrite(out.data(), 1, out.size(), file) == out.size();
+            fclose(file);
+            return written;
+        }
+
+        void BeginCaptureLocked(ProfilerState& state)
+        {
+            state.generation.fetch_add(1, std::memory_order_acq_rel);
+            state.captureStart = Stopwatch::GetTimestamp();
+            state.capturing.store(true, std::memory_order_release);
+        }
+
+        bool EndCaptureLocked(ProfilerState& state, const char* path)
+        {
+            if (!state.capturing.exchange(false, std::memory_order_acq_rel))
+                return false;
+
+            const bool written = WriteTrace(state, path);
+            if (written)
+            {
+                LOGI("Profiler capture written to '{}'", path);
+            }
+            return written;
+        }
+    }
+
+    namespace Profiler
+    {
+        void BeginCapture()
+        {
+            ProfilerState& state = GetState();
+            std::lock_guard<Mutex> guard(state.lock);
+            BeginCaptureLocked(state);
+        }
+
+        bool EndCapture(const char* path)
+        {
+            ProfilerState& state = GetState();
+            std::lock_guard<Mutex> guard(state.lock);
+            return EndCaptureLocked(state, path);
+        }
+
+        void CaptureFrames(uint32_t frameCount, const char* path)
+        {
+            ProfilerState& state = GetState();
+            std::lock_guard<Mutex> guard(state.lock);
+            state.frameCaptureRequested = frameCount != 0;
+            state.remainingFrames = frameCount;
+            state.frameCapturePath = path;
+        }
+
+        bool IsCapturing() { return GetState().capturing.load(std::memory_order_relaxed); }
+
+        void MarkFrame()
+        {
+            ProfilerState& state = GetState();
+            const uint64_t now = Stopwatch::GetTimestamp();
+            if (state.lastFrameTime != 0 && IsCapturing())
+            {
+                AppendEvent(state, kFrameZone, state.lastFrameTime, now);
+            }
+            state.lastFrameTime = now;
+
+            std::lock_guard<Mutex> guard(state.lock);
+            if (!state.frameCaptureRequested)
+                return;
+
+            // Requested captures start and stop on frame boundaries.
+            if (!state.capturing.load(std::memory_order_relaxed))
+            {
+                BeginCaptureLocked(state);
+            }
+            else if (--state.remainingFrames == 0)
+            {
+                state.frameCaptureRequested = false;
+                EndCaptureLocked(state, state.frameCapturePath.c_str());
+            }
+        }
+
+        void SetThreadName(const char* name)
+        {
+            ProfilerState& state = GetState();
+            ThreadBuffer* buffer = GetThreadBuffer(state);
+            if (buffer == nullptr)
+                return;
+
+            std::lock_guard<Mutex> guard(state.lock);
+            buffer->name = name;
+        }
+
+        void RecordZone(const ProfileZone& zone, uint64_t begin, uint64_t end) { AppendEvent(GetState(), zone, begin, end); }
+    }
+#else
+    namespace Profiler
+    {
+        void BeginCapture() {}
+
+        bool EndCapture(const char* path)
+        {
+            ALIMER_UNUSED(path);
+            return false;
+        }
+
+        void CaptureFrames(uint32_t frameCount, const char* path)
+        {
+            ALIMER_UNUSED(frameCount);
+            ALIMER_UNUSED(path);
+        }
+
+        bool IsCapturing() { return false; }
+
+        void MarkFrame() {}
+
+        void SetThreadName(const char* name) { ALIMER_UNUSED(name); }
+
+        void RecordZone(const ProfileZone& zone, uint64_t begin, uint64_t end)
+        {
+            ALIMER_UNUSED(zone);
+            ALIMER_UNUSED(begin);
+            ALIMER_UNUSED(end);
+        }
+    }
+#endif
+}
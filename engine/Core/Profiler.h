@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "AlimerConfig.h"
+#include "Core/Stopwatch.h"
+
+namespace alimer
+{
+    /// Static description of a profiled scope, the name must be a string literal.
+    struct ProfileZone
+    {
+        const char* name;
+        const char* file;
+        uint32_t line;
+    };
+
+    /// CPU profiler. Zones are recorded into per-thread buffers while a capture is running and exported as Chrome
+    /// trace-event JSON, which chrome://tracing and ui.perfetto.dev open directly. Without ALIMER_PROFILING the
+    /// functions do nothing and the macros compile to nothing.
+    namespace Profiler
+    {
+        /// Start recording zones, discarding the previous capture.
+        ALIMER_API void BeginCapture();
+
+        /// Stop recording and write the capture to a trace file. Returns false if nothing was captured or the file can
+        /// not be written.
+        ALIMER_API bool EndCapture(const char* path);
+
+        /// Capture the next frameCount frames and write them to path once done.
+        ALIMER_API void CaptureFrames(uint32_t frameCount, const char* path);
+
+        ALIMER_API bool IsCapturing();
+
+        /// Mark the end of a frame. Frames show up as zones on the thread calling it.
+        ALIMER_API void MarkFrame();
+
+        /// Name the calling thread in captures.
+        ALIMER_API void SetThreadName(const char* name);
+
+        /// Record a finished zone on the calling thread, timestamps come from Stopwatch::GetTimestamp.
+        ALIMER_API void RecordZone(const ProfileZone& zone, uint64_t begin, uint64_t end);
+    }
+
+#if defined(ALIMER_PROFILING)
+    /// Records the enclosing scope as a zone when a capture is running.
+    class ProfileScope final
+    {
+    public:
+        explicit ProfileScope(const ProfileZone& zone_)
+            : zone(Profiler::IsCapturing() ? &zone_ : nullptr)
+            , begin(zone != nullptr ? Stopwatch::GetTimestamp() : 0)
+        {
+        }
+
+        ~ProfileScope()
+        {
+            if (zone != nullptr)
+            {
+                Profiler::RecordZone(*zone, begin, Stopwatch::GetTimestamp());
+            }
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const ProfileZone* zone;
+        uint64_t begin;
+    };
+#endif
+}
+
+#if defined(ALIMER_PROFILING)
+#    define ALIMER_PROFILE_SCOPE(zoneName)                                                                                                  \
+        static constexpr alimer::ProfileZone ALIMER_CONCAT(alimerProfileZone, __LINE__){zoneName, __FILE__, __LINE__};                    \
+        alimer::ProfileScope ALIMER_CONCAT(alimerProfileScope, __LINE__)(ALIMER_CONCAT(alimerProfileZone, __LINE__))
+#    define ALIMER_PROFILE_FRAME() alimer::Profiler::MarkFrame()
+#    define ALIMER_PROFILE_THREAD(threadName) alimer::Profiler::SetThreadName(threadName)
+#else
+#    define ALIMER_PROFILE_SCOPE(zoneName)
+#    define ALIMER_PROFILE_FRAME()
+#    define ALIMER_PROFILE_THREAD(threadName)
+#endif
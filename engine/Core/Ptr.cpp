@@ -24,54 +24,68 @@
 
 namespace alimer
 {
-    RefCounted::RefCounted()
-        : refCount(new RefCount())
-    {
-        // Hold a weak ref to self to avoid possible double delete of the refcount
-        refCount->weakRefs++;
-    }
-
     RefCounted::~RefCounted()
     {
-        ALIMER_ASSERT(refCount);
-        ALIMER_ASSERT(refCount->refs == 0);
-        ALIMER_ASSERT(refCount->weakRefs > 0);
+        ALIMER_ASSERT(refs == 0);
 
-        // Mark object as expired, release the self weak ref and delete the refcount if no other weak refs exist
-        refCount->refs = -1;
-        if (AtomicDecrement(&refCount->weakRefs) == 0)
+        // Mark weak references as expired, release the self weak ref and delete the block if no other weak refs exist
+        RefCount* block = refCount.load(std::memory_order_acquire);
+        if (block != nullptr)
         {
-            delete refCount;
+            AtomicStore(&block->expired, 1, MemoryOrder::Release);
+            if (AtomicDecrement(&block->weakRefs, MemoryOrder::AcqRel) == 0)
+            {
+                alimer_delete<RefCount, SmallAlloc>(block);
+            }
+
+            refCount.store(nullptr, std::memory_order_relaxed);
         }
 
-        refCount = nullptr;
+        // Set reference count below zero to fire asserts if this object is still accessed
+        refs = -1;
     }
 
     int32_t RefCounted::AddRef()
     {
-        int32_t refs = AtomicIncrement(&refCount->refs);
-        ALIMER_ASSERT(refs > 0);
-        return refs;
+        int32_t newRefs = AtomicIncrement(&refs, MemoryOrder::Relaxed);
+        ALIMER_ASSERT(newRefs > 0);
+        return newRefs;
     }
 
     int32_t RefCounted::Release()
     {
-        int32_t refs = AtomicDecrement(&refCount->refs);
-        ALIMER_ASSERT(refs >= 0);
+        int32_t newRefs = AtomicDecrement(&refs, MemoryOrder::AcqRel);
+        ALIMER_ASSERT(newRefs >= 0);
 
-        if (refs == 0)
+        if (newRefs == 0)
         {
             delete this;
         }
 
-        return refs;
+        return newRefs;
     }
 
-    int32_t RefCounted::Refs() const { return refCount->refs; }
+    int32_t RefCounted::Refs() const { return refs; }
 
     int32_t RefCounted::WeakRefs() const
     {
         // Subtract one to not return the internally held reference
-        return refCount->weakRefs - 1;
+        RefCount* block = refCount.load(std::memory_order_acquire);
+        return block != nullptr ? block->weakRefs - 1 : 0;
+    }
+
+    RefCount* RefCounted::RefCountPtr()
+    {
+        RefCount* block = refCount.load(std::memory_order_acquire);
+        if (block != nullptr)
+            return block;
+
+        // Several threads may race to create the block, the losers delete theirs
+        RefCount* newBlock = alimer_new<RefCount, SmallAlloc>();
+        if (refCount.compare_exchange_strong(block, newBlock, std::memory_order_acq_rel, std::memory_order_acquire))
+            return newBlock;
+
+        alimer_delete<RefCount, SmallAlloc>(newBlock);
+        return block;
     }
 }
@@ -24,11 +24,14 @@
 
 #include "Core/Assert.h"
 #include "Core/Concurrency.h"
+#include "Core/Memory.h"
+#include <atomic>
 #include <utility>
 
 namespace alimer
 {
-    /// Reference count structure.
+    /// Weak reference control block. Allocated on demand when the first weak reference to an object is taken, and outlives the
+    /// object until the last weak reference is released.
     struct RefCount
     {
         /// Construct.
@@ -37,24 +40,23 @@ namespace alimer
         /// Destruct.
         ~RefCount()
         {
-            // Set reference counts below zero to fire asserts if this object is still accessed
-            refs = -1;
+            // Set the weak reference count below zero to fire asserts if this block is still accessed
             weakRefs = -1;
         }
 
-        /// Reference count. If below zero, the object has been destroyed.
-        int32_t refs = 0;
-        /// Weak reference count.
-        int32_t weakRefs = 0;
+        /// Weak reference count, including the reference held by the object while it is alive.
+        volatile int32_t weakRefs = 1;
+        /// Nonzero once the object has been destroyed.
+        volatile int32_t expired = 0;
     };
 
     /// Base class for intrusively reference counted objects that can be pointed to with RefPtr. These are noncopyable and non-assignable.
     class ALIMER_API RefCounted
     {
     public:
-        /// Construct. Allocate the reference count structure and set an initial self weak reference.
-        RefCounted();
-        /// Destruct. Mark as expired and also delete the reference count structure if no outside weak references exist.
+        /// Construct.
+        RefCounted() = default;
+        /// Destruct. Mark the weak reference block as expired and delete it if no outside weak references exist.
         virtual ~RefCounted();
 
         /// Prevent copy construction.
@@ -62,6 +64,23 @@ namespace alimer
         /// Prevent assignment.
         RefCounted& operator=(const RefCounted& rhs) = delete;
 
+        /// Allocate from the general allocator, so small objects are served by the size-class allocator when enabled.
+        static void* operator new(size_t size) { return alimer_alloc(size); }
+        /// Allocate over-aligned objects.
+        static void* operator new(size_t size, std::align_val_t alignment)
+        {
+            const size_t align = static_cast<size_t>(alignment);
+            return alimer_alloc_aligned(align, (size + align - 1) & ~(align - 1));
+        }
+        /// Placement new.
+        static void* operator new(size_t, void* place) noexcept { return place; }
+        /// Free memory allocated with operator new.
+        static void operator delete(void* ptr) { alimer_free(ptr); }
+        /// Free over-aligned objects.
+        static void operator delete(void* ptr, std::align_val_t) { alimer_free_aligned(ptr); }
+        /// Placement delete.
+        static void operator delete(void*, void*) noexcept {}
+
         /// Increment reference count. Can also be called outside of a RefPtr for traditional reference counting. Returns new reference
         /// count value. Operation is atomic.
         int32_t AddRef();
@@ -75,12 +94,14 @@ namespace alimer
         /// Return weak reference count.
         int32_t WeakRefs() const;
 
-        /// Return pointer to the reference count structure.
-        RefCount* RefCountPtr() { return refCount; }
+        /// Return pointer to the weak reference block, allocating it on first use. Thread safe.
+        RefCount* RefCountPtr();
 
     private:
-        /// Pointer to the reference count structure.
-        RefCount* refCount;
+        /// Reference count, stored inline to share the cache line with the object.
+        volatile int32_t refs = 0;
+        /// Weak reference block, null until the first weak reference is taken.
+        std::atomic<RefCount*> refCount{nullptr};
     };
 
     // Type alias for intrusive_ptr template
@@ -291,7 +312,7 @@ namespace alimer
             if (refCount_)
             {
                 ALIMER_ASSERT(refCount_->weakRefs >= 0);
-                AtomicIncrement(&refCount_->weakRefs);
+                AtomicIncrement(&refCount_->weakRefs, MemoryOrder::Relaxed);
             }
         }
 
@@ -301,10 +322,10 @@ namespace alimer
             if (refCount_)
             {
                 ALIMER_ASSERT(refCount_->weakRefs > 0);
-                int32_t weakRefs = AtomicDecrement(&refCount_->weakRefs);
+                int32_t weakRefs = AtomicDecrement(&refCount_->weakRefs, MemoryOrder::AcqRel);
 
                 if (IsExpired() && weakRefs == 0)
-                    delete refCount_;
+                    alimer_delete<RefCount, SmallAlloc>(refCount_);
             }
 
             ptr_ = nullptr;
@@ -355,7 +376,7 @@ namespace alimer
         /// Construct from a shared pointer.
         WeakPtr(const RefPtr<T>& rhs) noexcept
             : ptr_(rhs.Get())
-            , refCount_(rhs.RefCountPtr())
+            , refCount_(ptr_ ? ptr_->RefCountPtr() : nullptr)
         {
             AddRef();
         }
@@ -374,7 +395,7 @@ namespace alimer
         /// Assign from a shared pointer.
         WeakPtr<T>& operator=(const RefPtr<T>& rhs)
         {
-            if (ptr_ == rhs.Get() && refCount_ == rhs.RefCountPtr())
+            if (ptr_ == rhs.Get() && !IsExpired())
                 return *this;
 
             WeakPtr<T> copy(rhs);
@@ -529,7 +550,7 @@ namespace alimer
         bool IsNotNull() const { return refCount_ != nullptr; }
 
         /// Return the object's reference count, or 0 if null pointer or if object has expired.
-        int32_t Refs() const { return (refCount_ && refCount_->refs >= 0) ? refCount_->refs : 0; }
+        int32_t Refs() const { return IsExpired() ? 0 : ptr_->Refs(); }
 
         /// Return the object's weak reference count.
         int32_t WeakRefs() const
@@ -541,7 +562,7 @@ namespace alimer
         }
 
         /// Return whether the object has expired. If null pointer, always return true.
-        bool IsExpired() const { return refCount_ ? refCount_->refs < 0 : true; }
+        bool IsExpired() const { return refCount_ ? AtomicLoad(&refCount_->expired, MemoryOrder::Acquire) != 0 : true; }
 
         /// Return pointer to the RefCount structure.
         RefCount* RefCountPtr() const { return refCount_; }
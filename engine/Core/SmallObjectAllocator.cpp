@@ -0,0 +1,374 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Core/SmallObjectAllocator.h"
+#include "Core/Assert.h"
+#include "Core/Concurrency.h"
+#include <mutex>
+
+namespace alimer
+{
+    namespace
+    {
+        constexpr uint32_t kPageShift = 16;
+        static_assert((size_t(1) << kPageShift) == SmallObjectAllocator::kPageSize, "Page shift mismatch");
+
+        /// Block sizes: 16 byte steps up to 128, then 32 byte steps up to 256.
+        constexpr uint16_t kClassSizes[SmallObjectAllocator::kSizeClassCount] = {16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256};
+
+        /// Maps (size + 15) / 16 to a size class index.
+        constexpr uint8_t kClassLookup[SmallObjectAllocator::kMaxSize / 16 + 1] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11};
+
+        constexpr uint32_t GetBatchSize(uint32_t sizeClass)
+        {
+            return Clamp(uint32_t(SmallObjectAllocator::kPageSize / kClassSizes[sizeClass] / 16), 8u, 64u);
+        }
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        /**
+         * Two level radix map from page number to size class index + 1, zero for pages not owned by the allocator.
+         * Covers 48 bit addresses on 64-bit targets, pages outside that range are never handed out.
+         */
+        class PageMap
+        {
+        public:
+            static constexpr uint32_t kLeafBits = 16;
+            static constexpr uintptr_t kLeafSize = uintptr_t(1) << kLeafBits;
+            static constexpr uintptr_t kRootSize = uintptr_t(1) << 16;
+
+            bool CanMap(uintptr_t address) const { return (address >> kPageShift) < kRootSize * kLeafSize; }
+
+            uint8_t Get(uintptr_t address) const
+            {
+                const uintptr_t page = address >> kPageShift;
+                if (page >= kRootSize * kLeafSize)
+                    return 0;
+
+                const uint8_t* leaf = root[page >> kLeafBits].load(std::memory_order_acquire);
+                return leaf != nullptr ? leaf[page & (kLeafSize - 1)] : 0;
+            }
+
+            /// Called with the central pool lock held.
+            void Set(uintptr_t address, uint8_t value)
+            {
+                const uintptr_t page = address >> kPageShift;
+                std::atomic<uint8_t*>& slot = root[page >> kLeafBits];
+                uint8_t* leaf = slot.load(std::memory_order_acquire);
+                if (leaf == nullptr)
+                {
+                    uint8_t* newLeaf = static_cast<uint8_t*>(calloc(kLeafSize, 1));
+                    ALIMER_ASSERT(newLeaf != nullptr);
+                    if (slot.compare_exchange_strong(leaf, newLeaf, std::memory_order_acq_rel))
+                    {
+                        leaf = newLeaf;
+                    }
+                    else
+                    {
+                        ::free(newLeaf);
+                    }
+                }
+
+                leaf[page & (kLeafSize - 1)] = value;
+            }
+
+        private:
+            std::atomic<uint8_t*> root[kRootSize];
+        };
+
+        struct CentralList
+        {
+            SpinLock lock;
+            FreeBlock* head = nullptr;
+            uint32_t count = 0;
+        };
+
+        PageMap s_pageMap;
+        CentralList s_central[SmallObjectAllocator::kSizeClassCount];
+        std::atomic<size_t> s_pageCount{0};
+
+        /// Carve a new page into blocks and push them into the central list. Called with the central lock held.
+        bool AllocatePage(uint32_t sizeClass, CentralList& central)
+        {
+            uint8_t* page = static_cast<uint8_t*>(alimer_aligned_alloc(SmallObjectAllocator::kPageSize, SmallObjectAllocator::kPageSize));
+            if (page == nullptr)
+                return false;
+
+            if (!s_pageMap.CanMap(reinterpret_cast<uintptr_t>(page)))
+            {
+                alimer_aligned_free(page);
+                return false;
+            }
+
+            s_pageMap.Set(reinterpret_cast<uintptr_t>(page), static_cast<uint8_t>(sizeClass + 1));
+            s_pageCount.fetch_add(1, std::memory_order_relaxed);
+
+            const size_t blockSize = kClassSizes[sizeClass];
+            const size_t blockCount = SmallObjectAllocator::kPageSize / blockSize;
+            for (size_t i = blockCount; i-- > 0;)
+            {
+                FreeBlock* block = reinterpret_cast<FreeBlock*>(page + i * blockSize);
+                block->next = central.head;
+                central.head = block;
+            }
+
+            central.count += static_cast<uint32_t>(blockCount);
+            return true;
+        }
+
+        /// Move up to count blocks from the central list to the given list. Returns the number of blocks moved.
+        uint32_t FetchFromCentral(uint32_t sizeClass, uint32_t count, FreeBlock*& head)
+        {
+            CentralList& central = s_central[sizeClass];
+            std::lock_guard<SpinLock> guard(central.lock);
+
+            if (central.head == nullptr && !AllocatePage(sizeClass, central))
+                return 0;
+
+            uint32_t moved = 0;
+            while (moved < count && central.head != nullptr)
+            {
+                FreeBlock* block = central.head;
+                central.head = block->next;
+                block->next = head;
+                head = block;
+                ++moved;
+            }
+
+            central.count -= moved;
+            return moved;
+        }
+
+        /// Return a linked list of blocks to the central list.
+        void ReleaseToCentral(uint32_t sizeClass, FreeBlock* first, FreeBlock* last, uint32_t count)
+        {
+            CentralList& central = s_central[sizeClass];
+            std::lock_guard<SpinLock> guard(central.lock);
+            last->next = central.head;
+            central.head = first;
+            central.count += count;
+        }
+
+        struct ThreadCacheList
+        {
+            FreeBlock* head;
+            uint32_t count;
+        };
+
+        /// Plain data so it stays usable while thread_local destructors run.
+        struct ThreadCache
+        {
+            ThreadCacheList lists[SmallObjectAllocator::kSizeClassCount];
+            bool registered;
+            bool destroyed;
+        };
+
+        ALIMER_THREADLOCAL ThreadCache t_cache;
+
+        void FlushList(uint32_t sizeClass, uint32_t count)
+        {
+            ThreadCacheList& list = t_cache.lists[sizeClass];
+            if (list.count == 0 || count == 0)
+                return;
+
+            count = Min(count, list.count);
+            FreeBlock* first = list.head;
+            FreeBlock* last = first;
+            for (uint32_t i = 1; i < count; ++i)
+            {
+                last = last->next;
+            }
+
+            list.head = last->next;
+            list.count -= count;
+            ReleaseToCentral(sizeClass, first, last, count);
+        }
+
+        /// Returns the cached blocks to the central pool when the thread exits.
+        struct ThreadCacheReleaser
+        {
+            ~ThreadCacheReleaser()
+            {
+                SmallObjectAllocator::FlushThreadCache();
+                t_cache.destroyed = true;
+            }
+        };
+
+        void RegisterThreadCache()
+        {
+            static thread_local ThreadCacheReleaser releaser;
+            ALIMER_UNUSED(releaser);
+            t_cache.registered = true;
+        }
+
+        uint32_t GetSizeClass(size_t size) { return kClassLookup[(size + 15) >> 4]; }
+    }
+
+    void* SmallObjectAllocator::Allocate(size_t size)
+    {
+        if (size > kMaxSize)
+            return malloc(size);
+
+        const uint32_t sizeClass = GetSizeClass(size);
+
+        if (ALIMER_UNLIKELY(t_cache.destroyed))
+        {
+            FreeBlock* head = nullptr;
+            return FetchFromCentral(sizeClass, 1, head) != 0 ? head : malloc(size);
+        }
+
+        ThreadCacheList& list = t_cache.lists[sizeClass];
+        if (ALIMER_UNLIKELY(list.head == nullptr))
+        {
+            if (!t_cache.registered)
+            {
+                RegisterThreadCache();
+            }
+
+            list.count += FetchFromCentral(sizeClass, GetBatchSize(sizeClass), list.head);
+            if (list.head == nullptr)
+                return malloc(size);
+        }
+
+        FreeBlock* block = list.head;
+        list.head = block->next;
+        list.count--;
+        return block;
+    }
+
+    void SmallObjectAllocator::Free(void* ptr)
+    {
+        if (ptr == nullptr)
+            return;
+
+        const uint8_t entry = s_pageMap.Get(reinterpret_cast<uintptr_t>(ptr));
+        if (entry == 0)
+        {
+            ::free(ptr);
+            return;
+        }
+
+        const uint32_t sizeClass = entry - 1u;
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+
+        if (ALIMER_UNLIKELY(t_cache.destroyed))
+        {
+            ReleaseToCentral(sizeClass, block, block, 1);
+            return;
+        }
+
+        ThreadCacheList& list = t_cache.lists[sizeClass];
+        block->next = list.head;
+        list.head = block;
+        list.count++;
+
+        if (ALIMER_UNLIKELY(!t_cache.registered))
+        {
+            RegisterThreadCache();
+        }
+
+        const uint32_t batchSize = GetBatchSize(sizeClass);
+        if (list.count > batchSize * 2)
+        {
+            FlushList(sizeClass, batchSize);
+        }
+    }
+
+    bool SmallObjectAllocator::Owns(const void* ptr) { return s_pageMap.Get(reinterpret_cast<uintptr_t>(ptr)) != 0; }
+
+    size_t SmallObjectAllocator::GetBlockSize(const void* ptr)
+    {
+        const uint8_t entry = s_pageMap.Get(reinterpret_cast<uintptr_t>(ptr));
+        return entry != 0 ? kClassSizes[entry - 1] : 0;
+    }
+
+    size_t SmallObjectAllocator::GetSizeClassSize(size_t size) { return size <= kMaxSize ? kClassSizes[GetSizeClass(size)] : 0; }
+
+    size_t SmallObjectAllocator::GetPageCount() { return s_pageCount.load(std::memory_order_relaxed); }
+
+    void SmallObjectAllocator::FlushThreadCache()
+    {
+        for (uint32_t sizeClass = 0; sizeClass < kSizeClassCount; ++sizeClass)
+        {
+            FlushList(sizeClass, t_cache.lists[sizeClass].count);
+        }
+    }
+
+    /* MemoryAllocator<SmallAlloc> */
+    void* MemoryAllocator<SmallAlloc>::allocate(size_t size)
+    {
+        void* ptr = SmallObjectAllocator::Allocate(size);
+        TrackAlloc(MemoryTag::Small, ptr);
+        return ptr;
+    }
+
+    void MemoryAllocator<SmallAlloc>::free(void* ptr)
+    {
+        TrackFree(MemoryTag::Small, ptr);
+        SmallObjectAllocator::Free(ptr);
+    }
+
+    void* MemoryAllocator<SmallAlloc>::allocate_aligned(size_t alignment, size_t size)
+    {
+        void* ptr = alimer_aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+        TrackAlignedAlloc(MemoryTag::Small, ptr);
+        return ptr;
+    }
+
+    void MemoryAllocator<SmallAlloc>::free_aligned(void* ptr)
+    {
+        TrackAlignedFree(MemoryTag::Small, ptr);
+        alimer_aligned_free(ptr);
+    }
+
+#if defined(ALIMER_SMALL_OBJECT_ALLOCATOR)
+    /* MemoryAllocator<GenAlloc> */
+    void* MemoryAllocator<GenAlloc>::allocate(size_t size)
+    {
+        void* ptr = SmallObjectAllocator::Allocate(size);
+        TrackAlloc(MemoryTag::General, ptr);
+        return ptr;
+    }
+
+    void MemoryAllocator<GenAlloc>::free(void* ptr)
+    {
+        TrackFree(MemoryTag::General, ptr);
+        SmallObjectAllocator::Free(ptr);
+    }
+
+    void* MemoryAllocator<GenAlloc>::allocate_aligned(size_t alignment, size_t size)
+    {
+        void* ptr = alimer_aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+        TrackAlignedAlloc(MemoryTag::General, ptr);
+        return ptr;
+    }
+
+    void MemoryAllocator<GenAlloc>::free_aligned(void* ptr)
+    {
+        TrackAlignedFree(MemoryTag::General, ptr);
+        alimer_aligned_free(ptr);
+    }
+#endif
+}
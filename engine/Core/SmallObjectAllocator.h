@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Core/Memory.h"
+
+namespace alimer
+{
+    /**
+     * Size-class allocator for small objects. Allocations up to kMaxSize bytes are rounded to one of kSizeClassCount
+     * classes and served from a thread-local free list. Thread caches refill from, and spill back to, a central pool
+     * per size class in batches; the central pool carves kPageSize pages that are never returned to the OS.
+     * Larger allocations fall through to malloc. Any thread can free any pointer.
+     */
+    class ALIMER_API SmallObjectAllocator final
+    {
+    public:
+        static constexpr size_t kMaxSize = 256;
+        static constexpr size_t kPageSize = 64 * 1024;
+        static constexpr uint32_t kSizeClassCount = 12;
+
+        /// Allocate memory, 16 byte aligned.
+        static void* Allocate(size_t size);
+
+        /// Free memory returned by Allocate. Null is ignored.
+        static void Free(void* ptr);
+
+        /// Return true if the pointer lives inside a page owned by the allocator.
+        static bool Owns(const void* ptr);
+
+        /// Return the size of the class the pointer belongs to, or zero if not owned by the allocator.
+        static size_t GetBlockSize(const void* ptr);
+
+        /// Return the block size used for the given allocation size, or zero if the size is served by malloc.
+        static size_t GetSizeClassSize(size_t size);
+
+        /// Return the number of pages carved so far.
+        static size_t GetPageCount();
+
+        /// Return all blocks cached by the calling thread to the central pool.
+        static void FlushThreadCache();
+    };
+}
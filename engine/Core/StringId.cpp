@@ -21,20 +21,77 @@
 //
 
 #include "Core/StringId.h"
-#include "Core/Hash.h"
+#include "Core/Concurrency.h"
+#include "Core/HashMap.h"
+#include "Core/Log.h"
 #include "Core/String.h"
+#include <mutex>
 
 namespace alimer
 {
     const StringId32 StringId32::Zero;
 
+#ifdef ALIMER_STRINGID_NAMES
+    namespace
+    {
+        struct NameTable
+        {
+            Mutex lock;
+            HashMap<uint32_t, std::string> names;
+        };
+
+        NameTable& GetNameTable()
+        {
+            static NameTable table;
+            return table;
+        }
+
+        void RecordName(StringId32 id, const char* str, size_t length)
+        {
+            NameTable& table = GetNameTable();
+            std::lock_guard<Mutex> guard(table.lock);
+            auto result = table.names.try_emplace(id.Value(), str, length);
+            if (!result.second && result.first->second.compare(0, std::string::npos, str, length) != 0)
+            {
+                LOGW("StringId32 collision: '{}' and '{}' both hash to {:08X}", result.first->second, std::string(str, length), id.Value());
+            }
+        }
+    }
+#endif
+
     /* StringId32 */
-    StringId32::StringId32(const char* str) noexcept { value = Murmur32(str, (uint32_t)strlen(str), 0); }
+    StringId32::StringId32(const std::string& str) noexcept
+        : value(Murmur32(str.c_str(), (uint32_t)str.length(), 0))
+    {
+#ifdef ALIMER_STRINGID_NAMES
+        RecordName(*this, str.c_str(), str.length());
+#endif
+    }
 
-    StringId32::StringId32(const std::string& str) noexcept { value = Murmur32(str.c_str(), (uint32_t)str.length(), 0); }
+    StringId32 StringId32::Intern(const char* str)
+    {
+        const size_t length = strlen(str);
+        const StringId32 id(str, length);
+#ifdef ALIMER_STRINGID_NAMES
+        RecordName(id, str, length);
+#endif
+        return id;
+    }
+
+    StringId32 StringId32::Intern(const std::string& str) { return StringId32(str); }
 
     std::string StringId32::ToString() const
     {
+#ifdef ALIMER_STRINGID_NAMES
+        {
+            NameTable& table = GetNameTable();
+            std::lock_guard<Mutex> guard(table.lock);
+            const std::string* name = table.names.TryGet(value);
+            if (name != nullptr)
+                return *name;
+        }
+#endif
+
         char tempBuffer[CONVERSION_BUFFER_LENGTH];
         sprintf(tempBuffer, "%08X", value);
         return std::string(tempBuffer);
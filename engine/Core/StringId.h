@@ -22,32 +22,43 @@
 
 #pragma once
 
+#include "Core/Hash.h"
 #include "Core/String.h"
 
 namespace alimer
 {
-    /// 32-bit hash value for a string.
+    /// 32-bit hash value for a string (MurmurHash2). Construction from a C string can be evaluated at compile time.
     class ALIMER_API StringId32
     {
     public:
         /// Construct with zero value.
-        StringId32() noexcept
+        constexpr StringId32() noexcept
             : value(0)
         {
         }
 
         /// Copy-construct from another hash.
-        StringId32(const StringId32& rhs) noexcept = default;
+        constexpr StringId32(const StringId32& rhs) noexcept = default;
 
         /// Construct with an initial value.
-        explicit StringId32(uint32_t value_) noexcept
+        constexpr explicit StringId32(uint32_t value_) noexcept
             : value(value_)
         {
         }
 
         /// Construct from a C string.
-        StringId32(const char* str) noexcept;
-        /// Construct from a string.
+        constexpr StringId32(const char* str) noexcept
+            : value(Murmur32Const(str, StringLength(str), 0))
+        {
+        }
+
+        /// Construct from a string with known length.
+        constexpr StringId32(const char* str, size_t length) noexcept
+            : value(Murmur32Const(str, static_cast<uint32_t>(length), 0))
+        {
+        }
+
+        /// Construct from a string. The string is recorded in the name table when ALIMER_STRINGID_NAMES is enabled.
         StringId32(const std::string& str) noexcept;
 
         /// Assign from another hash.
@@ -69,26 +80,31 @@ namespace alimer
         }
 
         /// Test for equality with another hash.
-        bool operator==(const StringId32& rhs) const { return value == rhs.value; }
+        constexpr bool operator==(const StringId32& rhs) const { return value == rhs.value; }
 
         /// Test for inequality with another hash.
-        bool operator!=(const StringId32& rhs) const { return value != rhs.value; }
+        constexpr bool operator!=(const StringId32& rhs) const { return value != rhs.value; }
 
         /// Test if less than another hash.
-        bool operator<(const StringId32& rhs) const { return value < rhs.value; }
+        constexpr bool operator<(const StringId32& rhs) const { return value < rhs.value; }
 
         /// Test if greater than another hash.
-        bool operator>(const StringId32& rhs) const { return value > rhs.value; }
+        constexpr bool operator>(const StringId32& rhs) const { return value > rhs.value; }
 
         /// Return true if nonzero hash value.
-        explicit operator bool() const { return value != 0; }
+        constexpr explicit operator bool() const { return value != 0; }
 
         /// Return hash value.
-        uint32_t Value() const { return value; }
+        constexpr uint32_t Value() const { return value; }
 
-        /// Return as string.
+        /// Return the original string if it was recorded in the name table, otherwise the hash as hex.
         std::string ToString() const;
 
+        /// Hash a string and record it in the name table when ALIMER_STRINGID_NAMES is enabled. Thread safe.
+        static StringId32 Intern(const char* str);
+        /// Hash a string and record it in the name table when ALIMER_STRINGID_NAMES is enabled. Thread safe.
+        static StringId32 Intern(const std::string& str);
+
         /// Zero hash.
         static const StringId32 Zero;
 
@@ -98,6 +114,9 @@ namespace alimer
     };
 
     static_assert(sizeof(StringId32) == sizeof(uint32_t), "Unexpected StringHash size.");
+
+    /// Compile time string id literal, "Graphics"_sid.
+    constexpr StringId32 operator"" _sid(const char* str, size_t length) { return StringId32(str, length); }
 }
 
 namespace std
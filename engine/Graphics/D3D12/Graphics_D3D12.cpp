@@ -861,7 +861,7 @@ namespace alimer
             {
                 auto item = destroyer_queries_occlusion.front();
                 destroyer_queries_occlusion.pop_front();
-                free_occlusionqueries.push_back(item.first);
+                free_occlusionqueries.Push(item.first);
             }
             else
             {
@@ -874,7 +874,7 @@ namespace alimer
             {
                 auto item = destroyer_queries_timestamp.front();
                 destroyer_queries_timestamp.pop_front();
-                free_timestampqueries.push_back(item.first);
+                free_timestampqueries.Push(item.first);
             }
             else
             {
@@ -1824,7 +1824,7 @@ namespace alimer
 
             for (uint32_t i = 0; i < timestamp_query_count; ++i)
             {
-                allocationhandler->free_timestampqueries.push_back(i);
+                allocationhandler->free_timestampqueries.Push(i);
             }
             queryheapdesc.Count = timestamp_query_count;
             queryheapdesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
@@ -1833,7 +1833,7 @@ namespace alimer
 
             for (uint32_t i = 0; i < occlusion_query_count; ++i)
             {
-                allocationhandler->free_occlusionqueries.push_back(i);
+                allocationhandler->free_occlusionqueries.Push(i);
             }
             queryheapdesc.Count = occlusion_query_count;
             queryheapdesc.Type = D3D12_QUERY_HEAP_TYPE_OCCLUSION;
@@ -2720,7 +2720,7 @@ namespace alimer
         switch (pDesc->Type)
         {
         case GPU_QUERY_TYPE_TIMESTAMP:
-            if (allocationhandler->free_timestampqueries.pop_front(internal_state->query_index))
+            if (allocationhandler->free_timestampqueries.Pop(internal_state->query_index))
             {
                 hr = S_OK;
             }
@@ -2735,7 +2735,7 @@ namespace alimer
             break;
         case GPU_QUERY_TYPE_OCCLUSION:
         case GPU_QUERY_TYPE_OCCLUSION_PREDICATE:
-            if (allocationhandler->free_occlusionqueries.pop_front(internal_state->query_index))
+            if (allocationhandler->free_occlusionqueries.Pop(internal_state->query_index))
             {
                 hr = S_OK;
             }
@@ -4789,6 +4789,10 @@ namespace alimer
         // GetFrameResources()!
         ThrowIfFailed(directQueue->Signal(frameFence, ++frameCount));
 
+        // Transient per-frame CPU allocations are released in bulk at the frame boundary.
+        alimer_frame_clear();
+        MemoryStats::EndFrame();
+
         // Wait for the GPU to catch up before we stomp an executing command buffer
         const uint64 gpuLag = frameCount - gpuFrameCount;
         ALIMER_ASSERT(gpuLag <= kMaxInflightFrames);
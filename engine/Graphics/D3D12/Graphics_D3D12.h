@@ -43,7 +43,7 @@ namespace alimer
         D3D12_FEATURE_DATA_D3D12_OPTIONS6 features_6;
         D3D12_FEATURE_DATA_D3D12_OPTIONS7 features_7;
 
-        std::mutex copyQueueLock;
+        Mutex copyQueueLock;
         bool copyQueueUse = false;
         ID3D12Fence* copyFence = nullptr; // GPU only
 
@@ -256,7 +256,7 @@ namespace alimer
             D3D12MA::Allocator* allocator = nullptr;
             ID3D12Device* device;
             uint64_t framecount = 0;
-            std::mutex destroylocker;
+            Mutex destroylocker;
             std::deque<std::pair<D3D12MA::Allocation*, uint64_t>> destroyer_allocations;
             std::deque<std::pair<Microsoft::WRL::ComPtr<ID3D12Resource>, uint64_t>> destroyer_resources;
             std::deque<std::pair<uint32_t, uint64_t>> destroyer_queries_timestamp;
@@ -266,8 +266,8 @@ namespace alimer
             std::deque<std::pair<Microsoft::WRL::ComPtr<ID3D12StateObject>, uint64_t>> destroyer_stateobjects;
             std::deque<std::pair<Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>, uint64_t>> destroyer_descriptorHeaps;
 
-            ThreadSafeRingBuffer<uint32_t, timestamp_query_count> free_timestampqueries;
-            ThreadSafeRingBuffer<uint32_t, occlusion_query_count> free_occlusionqueries;
+            MPMCQueue<uint32_t, timestamp_query_count> free_timestampqueries;
+            MPMCQueue<uint32_t, occlusion_query_count> free_occlusionqueries;
 
             // Deferred destroy of resources that the GPU is already finished with:
             void Update(uint64_t FRAMECOUNT, uint32_t BACKBUFFER_COUNT);
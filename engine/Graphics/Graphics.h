@@ -40,11 +40,23 @@ namespace alimer
             return desc;
         }
 
+        ~GraphicsBuffer() override
+        {
+            if (desc.Usage == USAGE_STAGING)
+            {
+                MemoryStats::RecordFree(MemoryTag::GpuStaging, desc.ByteWidth);
+            }
+        }
+
     protected:
         GraphicsBuffer(const GPUBufferDesc& desc)
             : GraphicsResource(Type::Buffer)
             , desc{desc}
         {
+            if (desc.Usage == USAGE_STAGING)
+            {
+                MemoryStats::RecordAlloc(MemoryTag::GpuStaging, desc.ByteWidth);
+            }
         }
 
         GPUBufferDesc desc;
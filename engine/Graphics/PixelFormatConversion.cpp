@@ -0,0 +1,804 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Graphics/PixelFormatConversion.h"
+#include "Math/PackedVector.h"
+#include "Math/Vector4.h"
+#include <algorithm>
+#include <limits>
+
+namespace alimer
+{
+    namespace
+    {
+        /// Pixels converted per step, the float rows of one step stay in the L1 cache.
+        constexpr size_t kChunkPixels = 256;
+
+        enum class ComponentType : uint8_t
+        {
+            UNorm8,
+            SNorm8,
+            UInt8,
+            SInt8,
+            UNorm16,
+            SNorm16,
+            UInt16,
+            SInt16,
+            Float16,
+            UInt32,
+            SInt32,
+            Float32
+        };
+
+        enum class PixelLayout : uint8_t
+        {
+            /// One to four channels of the same component type.
+            Components,
+            /// RGBA8 with sRGB encoded color.
+            Srgb8,
+            RGB10A2,
+            RG11B10,
+            RGB9E5
+        };
+
+        /// How a format is read and written, derived from its kFormatDesc entry. A channel count of zero marks
+        /// formats that cannot be converted.
+        struct FormatCodec
+        {
+            uint32_t channelCount = 0;
+            uint32_t bytesPerPixel = 0;
+            PixelLayout layout = PixelLayout::Components;
+            ComponentType componentType = ComponentType::UNorm8;
+            bool swapRedBlue = false;
+        };
+
+        inline uint32_t FloatBits(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline float BitsFloat(uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        double SrgbToLinear(double value) { return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4); }
+
+        double LinearToSrgb(double value) { return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055; }
+
+        /**
+         * Tables for 8 bit sRGB. Encoding picks the code whose interval of linear values holds the input, which is
+         * rounding the exact sRGB value to nearest. The intervals are found with a bucket per 1/128 of each binade from
+         * 2^-13 to 1: the bucket gives the code at its start and, since no bucket spans more than one code boundary, a
+         * single compare against the next threshold finishes. Values below 2^-13 encode to zero.
+         */
+        struct SrgbTables
+        {
+            static constexpr uint32_t kMinBits = (127u - 13u) << 23;
+            static constexpr uint32_t kBucketShift = 23 - 7;
+            static constexpr uint32_t kBucketCount = 13u << 7;
+
+            float decode[256];
+            /// Smallest linear value encoding to each code, the last entry is infinity.
+            float threshold[257];
+            uint8_t bucket[kBucketCount];
+            uint8_t linearToSrgb[256];
+            uint8_t srgbToLinear[256];
+
+            SrgbTables()
+            {
+                threshold[0] = 0.0f;
+                for (uint32_t code = 1; code < 256; ++code)
+                {
+                    const double midpoint = (code - 0.5) / 255.0;
+                    float value = static_cast<float>(SrgbToLinear(midpoint));
+                    while (LinearToSrgb(value) < midpoint)
+                    {
+                        value = std::nextafter(value, 2.0f);
+                    }
+                    while (LinearToSrgb(std::nextafter(value, 0.0f)) >= midpoint)
+                    {
+                        value = std::nextafter(value, 0.0f);
+                    }
+                    threshold[code] = value;
+                }
+                threshold[256] = std::numeric_limits<float>::infinity();
+
+                uint32_t code = 0;
+                for (uint32_t i = 0; i < kBucketCount; ++i)
+                {
+                    const float start = BitsFloat(kMinBits + (i << kBucketShift));
+                    while (start >= threshold[code + 1])
+                    {
+                        code++;
+                    }
+                    bucket[i] = static_cast<uint8_t>(code);
+                    ALIMER_ASSERT(code + 2 > 256 || threshold[code + 2] >= BitsFloat(kMinBits + ((i + 1) << kBucketShift)));
+                }
+
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    decode[i] = static_cast<float>(SrgbToLinear(i / 255.0));
+                    linearToSrgb[i] = Encode(static_cast<float>(i) / 255.0f);
+                }
+                PackedVector::PackUNorm8(decode, srgbToLinear, 256);
+            }
+
+            uint8_t Encode(float value) const
+            {
+                // Range checks on the bits so NaN, negatives and tiny values all encode to zero.
+                const uint32_t bits = FloatBits(value);
+                if (static_cast<int32_t>(bits) < static_cast<int32_t>(kMinBits))
+                    return 0;
+                if (bits >= 0x3F800000u)
+                    return bits <= 0x7F800000u ? 255 : 0;
+
+                const uint32_t code = bucket[(bits - kMinBits) >> kBucketShift];
+                return static_cast<uint8_t>(value >= threshold[code + 1] ? code + 1 : code);
+            }
+        };
+
+        const SrgbTables& GetSrgbTables()
+        {
+            static const SrgbTables tables;
+            return tables;
+        }
+
+        /// Pack a non negative float with a 5 bit exponent and the given mantissa bits, as in RG11B10Float. Rounds to
+        /// nearest even, negative values become zero and finite values too large become the largest finite one.
+        uint32_t PackSmallFloat(float value, uint32_t mantissaBits)
+        {
+            const uint32_t bits = FloatBits(value);
+            const uint32_t shift = 23 - mantissaBits;
+            const uint32_t infinity = 0x1Fu << mantissaBits;
+
+            if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+                return infinity | (1u << (mantissaBits - 1)) | ((bits & 0x7FFFFFu) >> shift);
+            if ((bits & 0x80000000u) != 0)
+                return 0;
+            if (bits == 0x7F800000u)
+                return infinity;
+
+            const uint32_t largest = ((15u + 127u) << 23) | (((1u << mantissaBits) - 1) << shift);
+            if (bits >= largest)
+                return infinity - 1;
+
+            if (bits < 0x38800000u)
+            {
+                const uint32_t denormalShift = 136u - mantissaBits - (bits >> 23);
+                if (denormalShift > 24)
+                    return 0;
+
+                const uint32_t mantissa = (bits & 0x7FFFFFu) | 0x800000u;
+                const uint32_t halfway = 1u << (denormalShift - 1);
+                const uint32_t remainder = mantissa & ((1u << denormalShift) - 1);
+                uint32_t result = mantissa >> denormalShift;
+                if (remainder > halfway || (remainder == halfway && (result & 1u) != 0))
+                    result++;
+
+                return result;
+            }
+
+            return (bits + 0xC8000000u + ((1u << (shift - 1)) - 1) + ((bits >> shift) & 1u)) >> shift;
+        }
+
+        float UnpackSmallFloat(uint32_t value, uint32_t mantissaBits)
+        {
+            const uint32_t mantissa = value & ((1u << mantissaBits) - 1);
+            const uint32_t exponent = value >> mantissaBits;
+            if (exponent == 0)
+                return std::ldexp(static_cast<float>(mantissa), -14 - static_cast<int>(mantissaBits));
+            if (exponent == 31)
+                return BitsFloat(0x7F800000u | (mantissa << (23 - mantissaBits)));
+
+            return BitsFloat(((exponent + 112u) << 23) | (mantissa << (23 - mantissaBits)));
+        }
+
+#if ALIMER_SSE_INTRINSICS
+        inline __m128i SelectBits(__m128i mask, __m128i a, __m128i b)
+        {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        }
+
+        /// Four lane PackSmallFloat, matching it bit for bit.
+        template <uint32_t MantissaBits> __m128i PackSmallFloat4(__m128 value)
+        {
+            constexpr uint32_t kShift = 23 - MantissaBits;
+            constexpr int32_t kInfinity = 0x1F << MantissaBits;
+            constexpr int32_t kLargest = ((15 + 127) << 23) | (((1 << MantissaBits) - 1) << kShift);
+
+            const __m128i bits = _mm_castps_si128(value);
+            const __m128i magnitude = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+
+            // Denormals are rounded by adding a value whose ulp is the smallest denormal, as PackedVector does for halves.
+            const __m128 denormalMagic = _mm_set1_ps(static_cast<float>(1u << (9 - MantissaBits)));
+            const __m128i denormal =
+                _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(magnitude), denormalMagic)), _mm_castps_si128(denormalMagic));
+            const __m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(magnitude, kShift), _mm_set1_epi32(1));
+            __m128i normal = _mm_add_epi32(magnitude, _mm_set1_epi32(static_cast<int32_t>(0xC8000000u + ((1u << (kShift - 1)) - 1))));
+            normal = _mm_srli_epi32(_mm_add_epi32(normal, mantissaOdd), kShift);
+
+            __m128i result = SelectBits(_mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x38800000)), denormal, normal);
+            result = SelectBits(_mm_cmpgt_epi32(magnitude, _mm_set1_epi32(kLargest - 1)), _mm_set1_epi32(kInfinity - 1), result);
+            result = SelectBits(_mm_cmpeq_epi32(magnitude, _mm_set1_epi32(0x7F800000)), _mm_set1_epi32(kInfinity), result);
+            result = _mm_andnot_si128(_mm_srai_epi32(bits, 31), result);
+
+            const __m128i nan = _mm_or_si128(_mm_set1_epi32(kInfinity | (1 << (MantissaBits - 1))),
+                                             _mm_srli_epi32(_mm_and_si128(magnitude, _mm_set1_epi32(0x7FFFFF)), kShift));
+            return SelectBits(_mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7F800000)), nan, result);
+        }
+
+        /// Four lane UnpackSmallFloat, matching it bit for bit.
+        template <uint32_t MantissaBits> __m128 UnpackSmallFloat4(__m128i value)
+        {
+            constexpr float kDenormalScale = 1.0f / static_cast<float>(1u << (14 + MantissaBits));
+            const __m128i rebias = _mm_set1_epi32(112 << 23);
+            const __m128i isInfNaN = _mm_cmpgt_epi32(value, _mm_set1_epi32((0x1F << MantissaBits) - 1));
+            __m128i normal = _mm_add_epi32(_mm_slli_epi32(value, 23 - MantissaBits), rebias);
+            normal = _mm_add_epi32(normal, _mm_and_si128(isInfNaN, rebias));
+
+            const __m128i denormal = _mm_castps_si128(_mm_mul_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(kDenormalScale)));
+            return _mm_castsi128_ps(SelectBits(_mm_cmplt_epi32(value, _mm_set1_epi32(1 << MantissaBits)), denormal, normal));
+        }
+#endif
+
+        /// Pack RGB to the shared exponent format following the EXT_texture_shared_exponent rules.
+        uint32_t PackRGB9E5(const float* rgb)
+        {
+            constexpr double kMaxValue = 65408.0;
+            double channels[3];
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                channels[i] = std::isnan(rgb[i]) ? 0.0 : std::min(std::max(static_cast<double>(rgb[i]), 0.0), kMaxValue);
+            }
+
+            const double maxChannel = std::max(std::max(channels[0], channels[1]), channels[2]);
+            if (maxChannel == 0.0)
+                return 0;
+
+            int exponent;
+            std::frexp(maxChannel, &exponent);
+            int sharedExponent = std::max(-16, exponent - 1) + 16;
+            double denominator = std::ldexp(1.0, sharedExponent - 24);
+            if (std::floor(maxChannel / denominator + 0.5) == 512.0)
+            {
+                denominator *= 2.0;
+                sharedExponent++;
+            }
+
+            uint32_t result = static_cast<uint32_t>(sharedExponent) << 27;
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                result |= static_cast<uint32_t>(std::floor(channels[i] / denominator + 0.5)) << (9 * i);
+            }
+            return result;
+        }
+
+        void UnpackRGB9E5(uint32_t value, float* rgb)
+        {
+            const float scale = std::ldexp(1.0f, static_cast<int>(value >> 27) - 24);
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                rgb[i] = static_cast<float>((value >> (9 * i)) & 0x1FFu) * scale;
+            }
+        }
+
+        template <typename T> void UnpackInteger(const T* source, float* destination, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                destination[i] = static_cast<float>(source[i]);
+            }
+        }
+
+        template <typename T> void PackInteger(const float* source, T* destination, size_t count)
+        {
+            constexpr double low = static_cast<double>(std::numeric_limits<T>::min());
+            constexpr double high = static_cast<double>(std::numeric_limits<T>::max());
+            for (size_t i = 0; i < count; ++i)
+            {
+                const double value = std::isnan(source[i]) ? 0.0 : std::min(std::max(static_cast<double>(source[i]), low), high);
+                destination[i] = static_cast<T>(std::nearbyint(value));
+            }
+        }
+
+        /// Swap red and blue of RGBA float pixels in place.
+        void SwapRedBlue(float* pixels, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                Vector4::Load(pixels + i * 4).Swizzle<2, 1, 0, 3>().Store(pixels + i * 4);
+            }
+        }
+
+        void DecodeComponents(ComponentType type, const uint8_t* source, float* destination, size_t count)
+        {
+            switch (type)
+            {
+            case ComponentType::UNorm8:
+                PackedVector::UnpackUNorm8(source, destination, count);
+                break;
+            case ComponentType::SNorm8:
+                PackedVector::UnpackSNorm8(reinterpret_cast<const int8_t*>(source), destination, count);
+                break;
+            case ComponentType::UInt8:
+                UnpackInteger(source, destination, count);
+                break;
+            case ComponentType::SInt8:
+                UnpackInteger(reinterpret_cast<const int8_t*>(source), destination, count);
+                break;
+            case ComponentType::UNorm16:
+                PackedVector::UnpackUNorm16(reinterpret_cast<const uint16_t*>(source), destination, count);
+                break;
+            case ComponentType::SNorm16:
+                PackedVector::UnpackSNorm16(reinterpret_cast<const int16_t*>(source), destination, count);
+                break;
+            case ComponentType::UInt16:
+                UnpackInteger(reinterpret_cast<const uint16_t*>(source), destination, count);
+                break;
+            case ComponentType::SInt16:
+                UnpackInteger(reinterpret_cast<const int16_t*>(source), destination, count);
+                break;
+            case ComponentType::Float16:
+                PackedVector::HalfToFloat(reinterpret_cast<const uint16_t*>(source), destination, count);
+                break;
+            case ComponentType::UInt32:
+                UnpackInteger(reinterpret_cast<const uint32_t*>(source), destination, count);
+                break;
+            case ComponentType::SInt32:
+                UnpackInteger(reinterpret_cast<const int32_t*>(source), destination, count);
+                break;
+            case ComponentType::Float32:
+                std::memcpy(destination, source, count * sizeof(float));
+                break;
+            }
+        }
+
+        void EncodeComponents(ComponentType type, const float* source, uint8_t* destination, size_t count)
+        {
+            switch (type)
+            {
+            case ComponentType::UNorm8:
+                PackedVector::PackUNorm8(source, destination, count);
+                break;
+            case ComponentType::SNorm8:
+                PackedVector::PackSNorm8(source, reinterpret_cast<int8_t*>(destination), count);
+                break;
+            case ComponentType::UInt8:
+                PackInteger(source, destination, count);
+                break;
+            case ComponentType::SInt8:
+                PackInteger(source, reinterpret_cast<int8_t*>(destination), count);
+                break;
+            case ComponentType::UNorm16:
+                PackedVector::PackUNorm16(source, reinterpret_cast<uint16_t*>(destination), count);
+                break;
+            case ComponentType::SNorm16:
+                PackedVector::PackSNorm16(source, reinterpret_cast<int16_t*>(destination), count);
+                break;
+            case ComponentType::UInt16:
+                PackInteger(source, reinterpret_cast<uint16_t*>(destination), count);
+                break;
+            case ComponentType::SInt16:
+                PackInteger(source, reinterpret_cast<int16_t*>(destination), count);
+                break;
+            case ComponentType::Float16:
+                PackedVector::FloatToHalf(source, reinterpret_cast<uint16_t*>(destination), count);
+                break;
+            case ComponentType::UInt32:
+                PackInteger(source, reinterpret_cast<uint32_t*>(destination), count);
+                break;
+            case ComponentType::SInt32:
+                PackInteger(source, reinterpret_cast<int32_t*>(destination), count);
+                break;
+            case ComponentType::Float32:
+                std::memcpy(destination, source, count * sizeof(float));
+                break;
+            }
+        }
+
+        /// Decode count pixels to channelCount floats each.
+        void Decode(const FormatCodec& codec, const uint8_t* source, float* destination, size_t count)
+        {
+            switch (codec.layout)
+            {
+            case PixelLayout::Components:
+                DecodeComponents(codec.componentType, source, destination, count * codec.channelCount);
+                break;
+
+            case PixelLayout::Srgb8:
+            {
+                const SrgbTables& tables = GetSrgbTables();
+                for (size_t i = 0; i < count * 4; i += 4)
+                {
+                    destination[i] = tables.decode[source[i]];
+                    destination[i + 1] = tables.decode[source[i + 1]];
+                    destination[i + 2] = tables.decode[source[i + 2]];
+                    destination[i + 3] = static_cast<float>(source[i + 3]) / 255.0f;
+                }
+                break;
+            }
+
+            case PixelLayout::RGB10A2:
+                PackedVector::UnpackRGB10A2(reinterpret_cast<const uint32_t*>(source), destination, count);
+                break;
+
+            case PixelLayout::RG11B10:
+            {
+                const uint32_t* words = reinterpret_cast<const uint32_t*>(source);
+                size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+                const __m128i mask = _mm_set1_epi32(0x7FF);
+                for (; i + 4 <= count; i += 4)
+                {
+                    const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+                    __m128 r = UnpackSmallFloat4<6>(_mm_and_si128(packed, mask));
+                    __m128 g = UnpackSmallFloat4<6>(_mm_and_si128(_mm_srli_epi32(packed, 11), mask));
+                    __m128 b = UnpackSmallFloat4<5>(_mm_srli_epi32(packed, 22));
+                    __m128 a = _mm_set1_ps(1.0f);
+                    _MM_TRANSPOSE4_PS(r, g, b, a);
+                    _mm_storeu_ps(destination + i * 4, r);
+                    _mm_storeu_ps(destination + i * 4 + 4, g);
+                    _mm_storeu_ps(destination + i * 4 + 8, b);
+                    _mm_storeu_ps(destination + i * 4 + 12, a);
+                }
+#endif
+                for (; i < count; ++i)
+                {
+                    destination[i * 4] = UnpackSmallFloat(words[i] & 0x7FFu, 6);
+                    destination[i * 4 + 1] = UnpackSmallFloat((words[i] >> 11) & 0x7FFu, 6);
+                    destination[i * 4 + 2] = UnpackSmallFloat(words[i] >> 22, 5);
+                    destination[i * 4 + 3] = 1.0f;
+                }
+                break;
+            }
+
+            case PixelLayout::RGB9E5:
+                for (size_t i = 0; i < count; ++i)
+                {
+                    UnpackRGB9E5(reinterpret_cast<const uint32_t*>(source)[i], destination + i * 3);
+                }
+                break;
+            }
+
+            if (codec.swapRedBlue)
+            {
+                SwapRedBlue(destination, count);
+            }
+        }
+
+        /// Encode count pixels from channelCount floats each, the source floats are used as scratch.
+        void Encode(const FormatCodec& codec, float* source, uint8_t* destination, size_t count)
+        {
+            if (codec.swapRedBlue)
+            {
+                SwapRedBlue(source, count);
+            }
+
+            switch (codec.layout)
+            {
+            case PixelLayout::Components:
+                EncodeComponents(codec.componentType, source, destination, count * codec.channelCount);
+                break;
+
+            case PixelLayout::Srgb8:
+            {
+                // Pack everything as linear for the alpha channel, then overwrite the color channels.
+                const SrgbTables& tables = GetSrgbTables();
+                PackedVector::PackUNorm8(source, destination, count * 4);
+                for (size_t i = 0; i < count * 4; i += 4)
+                {
+                    destination[i] = tables.Encode(source[i]);
+                    destination[i + 1] = tables.Encode(source[i + 1]);
+                    destination[i + 2] = tables.Encode(source[i + 2]);
+                }
+                break;
+            }
+
+            case PixelLayout::RGB10A2:
+                PackedVector::PackRGB10A2(source, reinterpret_cast<uint32_t*>(destination), count);
+                break;
+
+            case PixelLayout::RG11B10:
+            {
+                uint32_t* words = reinterpret_cast<uint32_t*>(destination);
+                size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128 r = _mm_loadu_ps(source + i * 4);
+                    __m128 g = _mm_loadu_ps(source + i * 4 + 4);
+                    __m128 b = _mm_loadu_ps(source + i * 4 + 8);
+                    __m128 a = _mm_loadu_ps(source + i * 4 + 12);
+                    _MM_TRANSPOSE4_PS(r, g, b, a);
+                    const __m128i green = _mm_slli_epi32(PackSmallFloat4<6>(g), 11);
+                    const __m128i blue = _mm_slli_epi32(PackSmallFloat4<5>(b), 22);
+                    const __m128i packed = _mm_or_si128(PackSmallFloat4<6>(r), _mm_or_si128(green, blue));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(words + i), packed);
+                }
+#endif
+                for (; i < count; ++i)
+                {
+                    const float* rgb = source + i * 4;
+                    words[i] = PackSmallFloat(rgb[0], 6) | (PackSmallFloat(rgb[1], 6) << 11) | (PackSmallFloat(rgb[2], 5) << 22);
+                }
+                break;
+            }
+
+            case PixelLayout::RGB9E5:
+                for (size_t i = 0; i < count; ++i)
+                {
+                    reinterpret_cast<uint32_t*>(destination)[i] = PackRGB9E5(source + i * 3);
+                }
+                break;
+            }
+        }
+
+        /// Copy pixels between channel counts, green and blue default to 0 and alpha to 1.
+        template <uint32_t SourceChannels, uint32_t DestinationChannels>
+        void AdaptChannels(const float* source, float* destination, size_t count)
+        {
+            static constexpr float kDefaults[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+            for (size_t i = 0; i < count; ++i)
+            {
+                for (uint32_t c = 0; c < DestinationChannels; ++c)
+                {
+                    destination[i * DestinationChannels + c] = c < SourceChannels ? source[i * SourceChannels + c] : kDefaults[c];
+                }
+            }
+        }
+
+        using AdaptChannelsFunction = void (*)(const float* source, float* destination, size_t count);
+
+        /// AdaptChannels indexed by source and destination channel count minus one.
+        constexpr AdaptChannelsFunction kAdaptChannels[4][4] = {
+            {AdaptChannels<1, 1>, AdaptChannels<1, 2>, AdaptChannels<1, 3>, AdaptChannels<1, 4>},
+            {AdaptChannels<2, 1>, AdaptChannels<2, 2>, AdaptChannels<2, 3>, AdaptChannels<2, 4>},
+            {AdaptChannels<3, 1>, AdaptChannels<3, 2>, AdaptChannels<3, 3>, AdaptChannels<3, 4>},
+            {AdaptChannels<4, 1>, AdaptChannels<4, 2>, AdaptChannels<4, 3>, AdaptChannels<4, 4>},
+        };
+
+        bool GetComponentType(PixelFormatType type, uint32_t bits, ComponentType* componentType)
+        {
+            switch (type)
+            {
+            case PixelFormatType::UNorm:
+                *componentType = bits == 8 ? ComponentType::UNorm8 : ComponentType::UNorm16;
+                return bits == 8 || bits == 16;
+            case PixelFormatType::SNorm:
+                *componentType = bits == 8 ? ComponentType::SNorm8 : ComponentType::SNorm16;
+                return bits == 8 || bits == 16;
+            case PixelFormatType::UInt:
+                *componentType = bits == 8 ? ComponentType::UInt8 : (bits == 16 ? ComponentType::UInt16 : ComponentType::UInt32);
+                return bits == 8 || bits == 16 || bits == 32;
+            case PixelFormatType::SInt:
+                *componentType = bits == 8 ? ComponentType::SInt8 : (bits == 16 ? ComponentType::SInt16 : ComponentType::SInt32);
+                return bits == 8 || bits == 16 || bits == 32;
+            case PixelFormatType::Float:
+                *componentType = bits == 16 ? ComponentType::Float16 : ComponentType::Float32;
+                return bits == 16 || bits == 32;
+            default:
+                return false;
+            }
+        }
+
+        FormatCodec GetCodec(PixelFormat format)
+        {
+            FormatCodec codec;
+            if (format == PixelFormat::Undefined || format >= PixelFormat::Count)
+                return codec;
+
+            const PixelFormatDesc& desc = kFormatDesc[static_cast<uint32_t>(format)];
+            ALIMER_ASSERT(desc.format == format);
+            if (desc.compression.blockWidth != 1 || desc.compression.blockHeight != 1 || desc.bits.stencil != 0)
+                return codec;
+
+            codec.bytesPerPixel = desc.bitsPerPixel / 8;
+            switch (format)
+            {
+            case PixelFormat::RGB10A2Unorm:
+                codec.channelCount = 4;
+                codec.layout = PixelLayout::RGB10A2;
+                return codec;
+            case PixelFormat::RG11B10Float:
+                // Decoded with an alpha of 1 so the SIMD path can transpose whole pixels.
+                codec.channelCount = 4;
+                codec.layout = PixelLayout::RG11B10;
+                return codec;
+            case PixelFormat::RGB9E5Float:
+                codec.channelCount = 3;
+                codec.layout = PixelLayout::RGB9E5;
+                return codec;
+            default:
+                break;
+            }
+
+            // The remaining formats have channels of one size, depth only formats convert as red.
+            uint32_t channelCount = 1;
+            uint32_t bits = desc.bits.depth;
+            if (bits == 0)
+            {
+                bits = desc.bits.red;
+                channelCount = (desc.bits.red != 0) + (desc.bits.green != 0) + (desc.bits.blue != 0) + (desc.bits.alpha != 0);
+            }
+
+            if (bits * channelCount != desc.bitsPerPixel)
+                return codec;
+
+            if (desc.type == PixelFormatType::UnormSrgb)
+            {
+                if (bits != 8 || channelCount != 4)
+                    return codec;
+
+                codec.layout = PixelLayout::Srgb8;
+            }
+            else if (!GetComponentType(desc.type, bits, &codec.componentType))
+            {
+                return codec;
+            }
+
+            codec.channelCount = channelCount;
+            codec.swapRedBlue = format == PixelFormat::BGRA8Unorm || format == PixelFormat::BGRA8UnormSrgb;
+            return codec;
+        }
+
+        bool IsRGBA8Format(PixelFormat format)
+        {
+            return format == PixelFormat::RGBA8Unorm || format == PixelFormat::RGBA8UnormSrgb || format == PixelFormat::BGRA8Unorm ||
+                   format == PixelFormat::BGRA8UnormSrgb;
+        }
+
+        /// Swap the red and blue bytes of 8 bit RGBA pixels.
+        void SwapRedBlue8(const uint8_t* source, uint8_t* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128i redBlueMask = _mm_set1_epi32(0x00FF00FF);
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+                const __m128i redBlue = _mm_and_si128(pixels, redBlueMask);
+                const __m128i swapped = _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16));
+                const __m128i result = _mm_or_si128(_mm_andnot_si128(redBlueMask, pixels), swapped);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), result);
+            }
+#elif ALIMER_NEON_INTRINSICS
+            for (; i + 16 <= count; i += 16)
+            {
+                uint8x16x4_t pixels = vld4q_u8(source + i * 4);
+                const uint8x16_t red = pixels.val[0];
+                pixels.val[0] = pixels.val[2];
+                pixels.val[2] = red;
+                vst4q_u8(destination + i * 4, pixels);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i * 4] = source[i * 4 + 2];
+                destination[i * 4 + 1] = source[i * 4 + 1];
+                destination[i * 4 + 2] = source[i * 4];
+                destination[i * 4 + 3] = source[i * 4 + 3];
+            }
+        }
+
+        /// Convert between the RGBA8 and BGRA8 formats without going through floats. The table maps color bytes between
+        /// linear and sRGB and gives the same results as the float path.
+        void ConvertRGBA8Row(const uint8_t* source, uint8_t* destination, size_t count, bool swapRedBlue, const uint8_t* table)
+        {
+            if (table == nullptr)
+            {
+                if (swapRedBlue)
+                {
+                    SwapRedBlue8(source, destination, count);
+                }
+                else
+                {
+                    std::memcpy(destination, source, count * 4);
+                }
+                return;
+            }
+
+            const size_t red = swapRedBlue ? 2 : 0;
+            for (size_t i = 0; i < count * 4; i += 4)
+            {
+                destination[i] = table[source[i + red]];
+                destination[i + 1] = table[source[i + 1]];
+                destination[i + 2] = table[source[i + 2 - red]];
+                destination[i + 3] = source[i + 3];
+            }
+        }
+    }
+
+    bool IsPixelConversionSupported(PixelFormat format) { return GetCodec(format).channelCount != 0; }
+
+    bool ConvertPixels(PixelFormat sourceFormat, const void* source, uint32_t sourceRowPitch, PixelFormat destinationFormat,
+                       void* destination, uint32_t destinationRowPitch, uint32_t width, uint32_t height)
+    {
+        const FormatCodec sourceCodec = GetCodec(sourceFormat);
+        const FormatCodec destinationCodec = GetCodec(destinationFormat);
+        if (sourceCodec.channelCount == 0 || destinationCodec.channelCount == 0)
+            return false;
+
+        if (width == 0 || height == 0)
+            return true;
+
+        ALIMER_ASSERT(source != nullptr && destination != nullptr);
+        const size_t sourcePitch = sourceRowPitch != 0 ? sourceRowPitch : static_cast<size_t>(width) * sourceCodec.bytesPerPixel;
+        const size_t destinationPitch =
+            destinationRowPitch != 0 ? destinationRowPitch : static_cast<size_t>(width) * destinationCodec.bytesPerPixel;
+        const uint8_t* sourceRow = static_cast<const uint8_t*>(source);
+        uint8_t* destinationRow = static_cast<uint8_t*>(destination);
+
+        if (sourceFormat == destinationFormat)
+        {
+            for (uint32_t y = 0; y < height; ++y, sourceRow += sourcePitch, destinationRow += destinationPitch)
+            {
+                std::memcpy(destinationRow, sourceRow, static_cast<size_t>(width) * sourceCodec.bytesPerPixel);
+            }
+            return true;
+        }
+
+        if (IsRGBA8Format(sourceFormat) && IsRGBA8Format(destinationFormat))
+        {
+            const bool swapRedBlue = sourceCodec.swapRedBlue != destinationCodec.swapRedBlue;
+            const bool sourceSrgb = sourceCodec.layout == PixelLayout::Srgb8;
+            const bool destinationSrgb = destinationCodec.layout == PixelLayout::Srgb8;
+            const uint8_t* table = nullptr;
+            if (sourceSrgb != destinationSrgb)
+            {
+                table = destinationSrgb ? GetSrgbTables().linearToSrgb : GetSrgbTables().srgbToLinear;
+            }
+
+            for (uint32_t y = 0; y < height; ++y, sourceRow += sourcePitch, destinationRow += destinationPitch)
+            {
+                ConvertRGBA8Row(sourceRow, destinationRow, width, swapRedBlue, table);
+            }
+            return true;
+        }
+
+        float decoded[kChunkPixels * 4];
+        float adapted[kChunkPixels * 4];
+        for (uint32_t y = 0; y < height; ++y, sourceRow += sourcePitch, destinationRow += destinationPitch)
+        {
+            for (uint32_t x = 0; x < width; x += kChunkPixels)
+            {
+                const size_t count = std::min<size_t>(kChunkPixels, width - x);
+                Decode(sourceCodec, sourceRow + x * sourceCodec.bytesPerPixel, decoded, count);
+
+                float* values = decoded;
+                if (sourceCodec.channelCount != destinationCodec.channelCount)
+                {
+                    kAdaptChannels[sourceCodec.channelCount - 1][destinationCodec.channelCount - 1](decoded, adapted, count);
+                    values = adapted;
+                }
+
+                Encode(destinationCodec, values, destinationRow + x * destinationCodec.bytesPerPixel, count);
+            }
+        }
+
+        return true;
+    }
+}
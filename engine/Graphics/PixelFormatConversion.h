@@ -0,0 +1,45 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Graphics/PixelFormat.h"
+
+namespace alimer
+{
+    /// Return true if ConvertPixels can read and write the format. That is every uncompressed color format plus
+    /// Depth16Unorm and Depth32Float, which convert as a red channel.
+    ALIMER_API bool IsPixelConversionSupported(PixelFormat format);
+
+    /**
+     * Convert a width x height region of pixels from one format to another. Row pitches are in bytes, zero means
+     * tightly packed rows. Rows must be aligned to the size of a component and the regions must not overlap.
+     *
+     * Pixels go through linear RGBA floats: sRGB formats are decoded and encoded with exact rounding, channels missing
+     * from the source read as 0 for green and blue and 1 for alpha, and values are converted as PackedVector does.
+     * Integer formats convert by value, saturating and rounding to nearest even, so 32 bit values beyond 2^24 lose
+     * precision unless the formats match, which copies rows. RGBA8 and BGRA8 pairs are swizzled and remapped without
+     * going through floats, with the same results. Returns false if either format is not supported.
+     */
+    ALIMER_API bool ConvertPixels(PixelFormat sourceFormat, const void* source, uint32_t sourceRowPitch, PixelFormat destinationFormat,
+                                  void* destination, uint32_t destinationRowPitch, uint32_t width, uint32_t height);
+}
@@ -90,11 +90,14 @@ namespace alimer
         VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
         uint32_t poolSize = 256;
 
-        std::vector<VkWriteDescriptorSet> descriptorWrites;
-        std::vector<VkDescriptorBufferInfo> bufferInfos;
-        std::vector<VkDescriptorImageInfo> imageInfos;
-        std::vector<VkBufferView> texelBufferViews;
-        std::vector<VkWriteDescriptorSetAccelerationStructureNV> accelerationStructureViews;
+        // Every layout binding produces at most one write, so the fixed capacity keeps the info pointers stable.
+        static constexpr size_t kMaxBindings = GPU_RESOURCE_HEAP_CBV_COUNT + GPU_RESOURCE_HEAP_SRV_COUNT + GPU_RESOURCE_HEAP_UAV_COUNT + GPU_SAMPLER_HEAP_COUNT;
+
+        FixedVector<VkWriteDescriptorSet, kMaxBindings> descriptorWrites;
+        FixedVector<VkDescriptorBufferInfo, kMaxBindings> bufferInfos;
+        FixedVector<VkDescriptorImageInfo, kMaxBindings> imageInfos;
+        FixedVector<VkBufferView, kMaxBindings> texelBufferViews;
+        FixedVector<VkWriteDescriptorSetAccelerationStructureNV, kMaxBindings> accelerationStructureViews;
         bool dirty = false;
 
         const GraphicsBuffer* CBV[GPU_RESOURCE_HEAP_CBV_COUNT];
@@ -284,7 +287,7 @@ namespace alimer
 
         void CreateBackBufferResources();
 
-        std::mutex copyQueueLock;
+        Mutex copyQueueLock;
         bool copyQueueUse = false;
         VkSemaphore copySemaphore = VK_NULL_HANDLE;
 
@@ -374,7 +377,7 @@ namespace alimer
             VkDevice device = VK_NULL_HANDLE;
             VkInstance instance;
             uint64_t framecount = 0;
-            std::mutex destroylocker;
+            Mutex destroylocker;
             std::deque<std::pair<std::pair<VkImage, VmaAllocation>, uint64_t>> destroyer_images;
             std::deque<std::pair<VkImageView, uint64_t>> destroyer_imageviews;
             std::deque<std::pair<std::pair<VkBuffer, VmaAllocation>, uint64_t>> destroyer_buffers;
@@ -392,8 +395,8 @@ namespace alimer
             std::deque<std::pair<uint32_t, uint64_t>> destroyer_queries_occlusion;
             std::deque<std::pair<uint32_t, uint64_t>> destroyer_queries_timestamp;
 
-            ThreadSafeRingBuffer<uint32_t, timestamp_query_count> free_timestampqueries;
-            ThreadSafeRingBuffer<uint32_t, occlusion_query_count> free_occlusionqueries;
+            MPMCQueue<uint32_t, timestamp_query_count> free_timestampqueries;
+            MPMCQueue<uint32_t, occlusion_query_count> free_occlusionqueries;
 
             ~AllocationHandler() {}
 
@@ -590,7 +593,7 @@ namespace alimer
                     {
                         auto item = destroyer_queries_occlusion.front();
                         destroyer_queries_occlusion.pop_front();
-                        free_occlusionqueries.push_back(item.first);
+                        free_occlusionqueries.Push(item.first);
                     }
                     else
                     {
@@ -603,7 +606,7 @@ namespace alimer
                     {
                         auto item = destroyer_queries_timestamp.front();
                         destroyer_queries_timestamp.pop_front();
-                        free_timestampqueries.push_back(item.first);
+                        free_timestampqueries.Push(item.first);
                     }
                     else
                     {
@@ -1763,13 +1766,6 @@ namespace alimer
     {
         device = device_;
 
-        // Important that these don't reallocate themselves during writing dexcriptors!
-        descriptorWrites.reserve(128);
-        bufferInfos.reserve(128);
-        imageInfos.reserve(128);
-        texelBufferViews.reserve(128);
-        accelerationStructureViews.reserve(128);
-
         VkResult res;
 
         // Create descriptor pool:
@@ -2863,7 +2859,7 @@ namespace alimer
 
             for (uint32_t i = 0; i < timestamp_query_count; ++i)
             {
-                allocationhandler->free_timestampqueries.push_back(i);
+                allocationhandler->free_timestampqueries.Push(i);
             }
             poolInfo.queryCount = timestamp_query_count;
             poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
@@ -2873,7 +2869,7 @@ namespace alimer
 
             for (uint32_t i = 0; i < occlusion_query_count; ++i)
             {
-                allocationhandler->free_occlusionqueries.push_back(i);
+                allocationhandler->free_occlusionqueries.Push(i);
             }
             poolInfo.queryCount = occlusion_query_count;
             poolInfo.queryType = VK_QUERY_TYPE_OCCLUSION;
@@ -3530,7 +3526,7 @@ namespace alimer
             void* pData = upload_allocation->GetMappedData();
             assert(pData != nullptr);
 
-            std::vector<VkBufferImageCopy> copyRegions;
+            SmallVector<VkBufferImageCopy, 16> copyRegions;
 
             size_t cpyoffset = 0;
             uint32_t initDataIdx = 0;
@@ -4116,7 +4112,7 @@ namespace alimer
         switch (pDesc->Type)
         {
         case GPU_QUERY_TYPE_TIMESTAMP:
-            if (allocationhandler->free_timestampqueries.pop_front(internal_state->query_index))
+            if (allocationhandler->free_timestampqueries.Pop(internal_state->query_index))
             {
                 hr = true;
             }
@@ -4131,7 +4127,7 @@ namespace alimer
             break;
         case GPU_QUERY_TYPE_OCCLUSION:
         case GPU_QUERY_TYPE_OCCLUSION_PREDICATE:
-            if (allocationhandler->free_occlusionqueries.pop_front(internal_state->query_index))
+            if (allocationhandler->free_occlusionqueries.Pop(internal_state->query_index))
             {
                 hr = true;
             }
@@ -4409,7 +4405,7 @@ namespace alimer
         depthStencilState.back.reference = ~0U; // runtime supplied
 
         // ColorBlendState
-        std::vector<VkPipelineColorBlendAttachmentState> colorBlendAttachments;
+        FixedVector<VkPipelineColorBlendAttachmentState, kMaxColorAttachments> colorBlendAttachments;
         for (uint32_t i = 0; i < kMaxColorAttachments; i++)
         {
             const ColorAttachmentDescriptor& colorAttachment = descriptor->colorAttachments[i];
@@ -6026,6 +6022,10 @@ namespace alimer
         frameCount++;
         frameIndex = frameCount % BACKBUFFER_COUNT;
 
+        // Transient per-frame CPU allocations are released in bulk at the frame boundary.
+        alimer_frame_clear();
+        MemoryStats::EndFrame();
+
         // Initiate stalling CPU when GPU is behind by more frames than would fit in the backbuffers:
         if (frameCount >= BACKBUFFER_COUNT)
         {
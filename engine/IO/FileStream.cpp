@@ -41,6 +41,10 @@ namespace alimer
         handle = fopen(path.c_str(), openModes[static_cast<uint32>(mode)]);
 #endif
 
+        length = 0;
+        if (handle == nullptr)
+            return;
+
         fseek((FILE*) handle, 0, SEEK_END);
         length = ftell((FILE*) handle);
         fseek((FILE*) handle, 0, SEEK_SET);
@@ -112,13 +116,13 @@ namespace alimer
 
     int64_t FileStream::Read(void* buffer, int64_t length)
     {
-        size_t ret = fread(buffer, length, 1, (FILE*) handle);
+        size_t ret = fread(buffer, 1, length, (FILE*) handle);
         return static_cast<int64_t>(ret);
     }
 
     uint64_t FileStream::Write(const void* buffer, uint64_t length)
     {
-        size_t ret = fwrite(buffer, length, 1, (FILE*) handle);
-        return static_cast<int64_t>(ret);
+        size_t ret = fwrite(buffer, 1, length, (FILE*) handle);
+        return static_cast<uint64_t>(ret);
     }
 }
@@ -0,0 +1,390 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Math/BatchMath.h"
+#include <cstring>
+
+namespace alimer
+{
+    namespace
+    {
+        // Each pack wraps one register width with the handful of operations the kernels need. The kernels are written once
+        // against this interface and run widest first, so the narrower packs only handle the remainder.
+
+        struct ScalarPack
+        {
+            using Value = float;
+            using Mask = bool;
+            static constexpr size_t kWidth = 1;
+
+            static Value Load(const float* data) { return *data; }
+            static void Store(float* data, Value value) { *data = value; }
+            static Value Splat(float value) { return value; }
+            static Value Add(Value a, Value b) { return a + b; }
+            static Value Multiply(Value a, Value b) { return a * b; }
+            static Value Abs(Value value) { return std::fabs(value); }
+            static Mask AllTrue() { return true; }
+            static Mask GreaterEqual(Value a, Value b) { return a >= b; }
+            static Mask And(Mask a, Mask b) { return a && b; }
+            static uint32_t GetBits(Mask mask) { return mask ? 1u : 0u; }
+        };
+
+#if ALIMER_SSE_INTRINSICS
+        struct SsePack
+        {
+            using Value = __m128;
+            using Mask = __m128;
+            static constexpr size_t kWidth = 4;
+
+            static Value Load(const float* data) { return _mm_loadu_ps(data); }
+            static void Store(float* data, Value value) { _mm_storeu_ps(data, value); }
+            static Value Splat(float value) { return _mm_set1_ps(value); }
+            static Value Add(Value a, Value b) { return _mm_add_ps(a, b); }
+            static Value Multiply(Value a, Value b) { return _mm_mul_ps(a, b); }
+            static Value Abs(Value value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+            static Mask AllTrue() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+            static Mask GreaterEqual(Value a, Value b) { return _mm_cmpge_ps(a, b); }
+            static Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+            static uint32_t GetBits(Mask mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+        };
+#elif ALIMER_NEON_INTRINSICS
+        struct NeonPack
+        {
+            using Value = float32x4_t;
+            using Mask = uint32x4_t;
+            static constexpr size_t kWidth = 4;
+
+            static Value Load(const float* data) { return vld1q_f32(data); }
+            static void Store(float* data, Value value) { vst1q_f32(data, value); }
+            static Value Splat(float value) { return vdupq_n_f32(value); }
+            static Value Add(Value a, Value b) { return vaddq_f32(a, b); }
+            static Value Multiply(Value a, Value b) { return vmulq_f32(a, b); }
+            static Value Abs(Value value) { return vabsq_f32(value); }
+            static Mask AllTrue() { return vdupq_n_u32(0xFFFFFFFFu); }
+            static Mask GreaterEqual(Value a, Value b) { return vcgeq_f32(a, b); }
+            static Mask And(Mask a, Mask b) { return vandq_u32(a, b); }
+            static uint32_t GetBits(Mask mask)
+            {
+                const uint32x4_t bits = vshrq_n_u32(mask, 31);
+                return vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) | (vgetq_lane_u32(bits, 2) << 2) |
+                       (vgetq_lane_u32(bits, 3) << 3);
+            }
+        };
+#endif
+
+#if ALIMER_AVX_INTRINSICS
+        struct AvxPack
+        {
+            using Value = __m256;
+            using Mask = __m256;
+            static constexpr size_t kWidth = 8;
+
+            static Value Load(const float* data) { return _mm256_loadu_ps(data); }
+            static void Store(float* data, Value value) { _mm256_storeu_ps(data, value); }
+            static Value Splat(float value) { return _mm256_set1_ps(value); }
+            static Value Add(Value a, Value b) { return _mm256_add_ps(a, b); }
+            static Value Multiply(Value a, Value b) { return _mm256_mul_ps(a, b); }
+            static Value Abs(Value value) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value); }
+            static Mask AllTrue() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+            static Mask GreaterEqual(Value a, Value b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+            static Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+            static uint32_t GetBits(Mask mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask)); }
+        };
+#endif
+
+        inline uint32_t CountBits(uint32_t value)
+        {
+            value = value - ((value >> 1) & 0x55555555u);
+            value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+            return (((value + (value >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+        }
+
+        /// Rows of the upper 3x3 of a matrix and its translation, splatted once per kernel call.
+        template <typename Pack> struct MatrixLanes
+        {
+            typename Pack::Value m[3][3];
+            typename Pack::Value translation[3];
+
+            explicit MatrixLanes(const Matrix4x4& matrix)
+            {
+                for (uint32_t row = 0; row < 3; ++row)
+                {
+                    for (uint32_t column = 0; column < 3; ++column)
+                    {
+                        m[row][column] = Pack::Splat(matrix.m[row][column]);
+                    }
+                    translation[row] = Pack::Splat(matrix.m[3][row]);
+                }
+            }
+
+            /// Return ((x * m0c + y * m1c) + z * m2c), column c of vector * matrix.
+            typename Pack::Value Transform(typename Pack::Value x, typename Pack::Value y, typename Pack::Value z, uint32_t column) const
+            {
+                return Pack::Add(Pack::Add(Pack::Multiply(x, m[0][column]), Pack::Multiply(y, m[1][column])), Pack::Multiply(z, m[2][column]));
+            }
+        };
+
+        template <typename Pack, bool Translate>
+        size_t TransformVectors(const Matrix4x4& matrix, const ConstFloat3SoA& input, const Float3SoA& output, size_t index, size_t count)
+        {
+            const MatrixLanes<Pack> lanes(matrix);
+            for (; index + Pack::kWidth <= count; index += Pack::kWidth)
+            {
+                const typename Pack::Value x = Pack::Load(input.x + index);
+                const typename Pack::Value y = Pack::Load(input.y + index);
+                const typename Pack::Value z = Pack::Load(input.z + index);
+
+                typename Pack::Value result[3];
+                for (uint32_t column = 0; column < 3; ++column)
+                {
+                    result[column] = lanes.Transform(x, y, z, column);
+                    if (Translate)
+                    {
+                        result[column] = Pack::Add(result[column], lanes.translation[column]);
+                    }
+                }
+
+                Pack::Store(output.x + index, result[0]);
+                Pack::Store(output.y + index, result[1]);
+                Pack::Store(output.z + index, result[2]);
+            }
+
+            return index;
+        }
+
+        template <typename Pack>
+        size_t TransformBoxesPack(const Matrix4x4& matrix, const ConstBoundingBoxSoA& boxes, const BoundingBoxSoA& output, size_t index, size_t count)
+        {
+            const MatrixLanes<Pack> lanes(matrix);
+
+            // Extents transform by the absolute matrix (Arvo), which encloses the rotated box.
+            Matrix4x4 absolute;
+            for (uint32_t row = 0; row < 3; ++row)
+            {
+                for (uint32_t column = 0; column < 3; ++column)
+                {
+                    absolute.m[row][column] = std::fabs(matrix.m[row][column]);
+                }
+            }
+            const MatrixLanes<Pack> absoluteLanes(absolute);
+
+            for (; index + Pack::kWidth <= count; index += Pack::kWidth)
+            {
+                const typename Pack::Value centerX = Pack::Load(boxes.center.x + index);
+                const typename Pack::Value centerY = Pack::Load(boxes.center.y + index);
+                const typename Pack::Value centerZ = Pack::Load(boxes.center.z + index);
+                const typename Pack::Value extentX = Pack::Load(boxes.extents.x + index);
+                const typename Pack::Value extentY = Pack::Load(boxes.extents.y + index);
+                const typename Pack::Value extentZ = Pack::Load(boxes.extents.z + index);
+
+                typename Pack::Value center[3];
+                typename Pack::Value extents[3];
+                for (uint32_t column = 0; column < 3; ++column)
+                {
+                    center[column] = Pack::Add(lanes.Transform(centerX, centerY, centerZ, column), lanes.translation[column]);
+                    extents[column] = absoluteLanes.Transform(extentX, extentY, extentZ, column);
+                }
+
+                Pack::Store(output.center.x + index, center[0]);
+                Pack::Store(output.center.y + index, center[1]);
+                Pack::Store(output.center.z + index, center[2]);
+                Pack::Store(output.extents.x + index, extents[0]);
+                Pack::Store(output.extents.y + index, extents[1]);
+                Pack::Store(output.extents.z + index, extents[2]);
+            }
+
+            return index;
+        }
+
+        /// Frustum planes splatted once per kernel call.
+        template <typename Pack> struct FrustumLanes
+        {
+            typename Pack::Value normal[Frustum::PlaneCount][3];
+            typename Pack::Value absNormal[Frustum::PlaneCount][3];
+            typename Pack::Value distance[Frustum::PlaneCount];
+
+            explicit FrustumLanes(const Frustum& frustum)
+            {
+                for (uint32_t i = 0; i < Frustum::PlaneCount; ++i)
+                {
+                    const Float4& plane = frustum.planes[i];
+                    normal[i][0] = Pack::Splat(plane.x);
+                    normal[i][1] = Pack::Splat(plane.y);
+                    normal[i][2] = Pack::Splat(plane.z);
+                    absNormal[i][0] = Pack::Splat(std::fabs(plane.x));
+                    absNormal[i][1] = Pack::Splat(std::fabs(plane.y));
+                    absNormal[i][2] = Pack::Splat(std::fabs(plane.z));
+                    distance[i] = Pack::Splat(plane.w);
+                }
+            }
+
+            typename Pack::Value Distance(uint32_t plane, typename Pack::Value x, typename Pack::Value y, typename Pack::Value z) const
+            {
+                const typename Pack::Value dot = Pack::Add(Pack::Add(Pack::Multiply(normal[plane][0], x), Pack::Multiply(normal[plane][1], y)),
+                                                           Pack::Multiply(normal[plane][2], z));
+                return Pack::Add(dot, distance[plane]);
+            }
+        };
+
+        /// Visible bits of one pack go to the current word, packs never straddle a word because indices stay multiples of the width.
+        inline void WriteVisibility(uint32_t* visibility, size_t index, uint32_t bits)
+        {
+            visibility[index / 32] |= bits << (index % 32);
+        }
+
+        template <typename Pack>
+        size_t CullSpheresPack(const FrustumLanes<Pack>& lanes, const BoundingSphereSoA& spheres, size_t index, size_t count, uint32_t* visibility, size_t& visibleCount)
+        {
+            const typename Pack::Value zero = Pack::Splat(0.0f);
+            for (; index + Pack::kWidth <= count; index += Pack::kWidth)
+            {
+                const typename Pack::Value x = Pack::Load(spheres.center.x + index);
+                const typename Pack::Value y = Pack::Load(spheres.center.y + index);
+                const typename Pack::Value z = Pack::Load(spheres.center.z + index);
+                const typename Pack::Value radius = Pack::Load(spheres.radius + index);
+
+                // distance >= -radius, written as distance + radius >= 0 to avoid a negate per lane.
+                typename Pack::Mask visible = Pack::AllTrue();
+                for (uint32_t plane = 0; plane < Frustum::PlaneCount; ++plane)
+                {
+                    visible = Pack::And(visible, Pack::GreaterEqual(Pack::Add(lanes.Distance(plane, x, y, z), radius), zero));
+                }
+
+                const uint32_t bits = Pack::GetBits(visible);
+                WriteVisibility(visibility, index, bits);
+                visibleCount += CountBits(bits);
+            }
+
+            return index;
+        }
+
+        template <typename Pack>
+        size_t CullBoxesPack(const FrustumLanes<Pack>& lanes, const ConstBoundingBoxSoA& boxes, size_t index, size_t count, uint32_t* visibility, size_t& visibleCount)
+        {
+            const typename Pack::Value zero = Pack::Splat(0.0f);
+            for (; index + Pack::kWidth <= count; index += Pack::kWidth)
+            {
+                const typename Pack::Value x = Pack::Load(boxes.center.x + index);
+                const typename Pack::Value y = Pack::Load(boxes.center.y + index);
+                const typename Pack::Value z = Pack::Load(boxes.center.z + index);
+                const typename Pack::Value extentX = Pack::Load(boxes.extents.x + index);
+                const typename Pack::Value extentY = Pack::Load(boxes.extents.y + index);
+                const typename Pack::Value extentZ = Pack::Load(boxes.extents.z + index);
+
+                typename Pack::Mask visible = Pack::AllTrue();
+                for (uint32_t plane = 0; plane < Frustum::PlaneCount; ++plane)
+                {
+                    // Projected radius of the box onto the plane normal.
+                    const typename Pack::Value radius =
+                        Pack::Add(Pack::Add(Pack::Multiply(lanes.absNormal[plane][0], extentX), Pack::Multiply(lanes.absNormal[plane][1], extentY)),
+                                  Pack::Multiply(lanes.absNormal[plane][2], extentZ));
+                    visible = Pack::And(visible, Pack::GreaterEqual(Pack::Add(lanes.Distance(plane, x, y, z), radius), zero));
+                }
+
+                const uint32_t bits = Pack::GetBits(visible);
+                WriteVisibility(visibility, index, bits);
+                visibleCount += CountBits(bits);
+            }
+
+            return index;
+        }
+
+        template <bool Translate> void TransformVectorsAll(const Matrix4x4& matrix, const ConstFloat3SoA& input, const Float3SoA& output, size_t count)
+        {
+            size_t index = 0;
+#if ALIMER_AVX_INTRINSICS
+            index = TransformVectors<AvxPack, Translate>(matrix, input, output, index, count);
+#endif
+#if ALIMER_SSE_INTRINSICS
+            index = TransformVectors<SsePack, Translate>(matrix, input, output, index, count);
+#elif ALIMER_NEON_INTRINSICS
+            index = TransformVectors<NeonPack, Translate>(matrix, input, output, index, count);
+#endif
+            TransformVectors<ScalarPack, Translate>(matrix, input, output, index, count);
+        }
+    }
+
+    namespace BatchMath
+    {
+        void TransformPoints(const Matrix4x4& matrix, const ConstFloat3SoA& points, const Float3SoA& output, size_t count)
+        {
+            TransformVectorsAll<true>(matrix, points, output, count);
+        }
+
+        void TransformNormals(const Matrix4x4& matrix, const ConstFloat3SoA& normals, const Float3SoA& output, size_t count)
+        {
+            TransformVectorsAll<false>(matrix, normals, output, count);
+        }
+
+        void TransformBoxes(const Matrix4x4& matrix, const ConstBoundingBoxSoA& boxes, const BoundingBoxSoA& output, size_t count)
+        {
+            size_t index = 0;
+#if ALIMER_AVX_INTRINSICS
+            index = TransformBoxesPack<AvxPack>(matrix, boxes, output, index, count);
+#endif
+#if ALIMER_SSE_INTRINSICS
+            index = TransformBoxesPack<SsePack>(matrix, boxes, output, index, count);
+#elif ALIMER_NEON_INTRINSICS
+            index = TransformBoxesPack<NeonPack>(matrix, boxes, output, index, count);
+#endif
+            TransformBoxesPack<ScalarPack>(matrix, boxes, output, index, count);
+        }
+
+        size_t CullSpheres(const Frustum& frustum, const BoundingSphereSoA& spheres, size_t count, uint32_t* visibility)
+        {
+            ALIMER_ASSERT(visibility != nullptr || count == 0);
+            std::memset(visibility, 0, GetVisibilityWordCount(count) * sizeof(uint32_t));
+
+            size_t index = 0;
+            size_t visibleCount = 0;
+#if ALIMER_AVX_INTRINSICS
+            index = CullSpheresPack(FrustumLanes<AvxPack>(frustum), spheres, index, count, visibility, visibleCount);
+#endif
+#if ALIMER_SSE_INTRINSICS
+            index = CullSpheresPack(FrustumLanes<SsePack>(frustum), spheres, index, count, visibility, visibleCount);
+#elif ALIMER_NEON_INTRINSICS
+            index = CullSpheresPack(FrustumLanes<NeonPack>(frustum), spheres, index, count, visibility, visibleCount);
+#endif
+            CullSpheresPack(FrustumLanes<ScalarPack>(frustum), spheres, index, count, visibility, visibleCount);
+            return visibleCount;
+        }
+
+        size_t CullBoxes(const Frustum& frustum, const ConstBoundingBoxSoA& boxes, size_t count, uint32_t* visibility)
+        {
+            ALIMER_ASSERT(visibility != nullptr || count == 0);
+            std::memset(visibility, 0, GetVisibilityWordCount(count) * sizeof(uint32_t));
+
+            size_t index = 0;
+            size_t visibleCount = 0;
+#if ALIMER_AVX_INTRINSICS
+            index = CullBoxesPack(FrustumLanes<AvxPack>(frustum), boxes, index, count, visibility, visibleCount);
+#endif
+#if ALIMER_SSE_INTRINSICS
+            index = CullBoxesPack(FrustumLanes<SsePack>(frustum), boxes, index, count, visibility, visibleCount);
+#elif ALIMER_NEON_INTRINSICS
+            index = CullBoxesPack(FrustumLanes<NeonPack>(frustum), boxes, index, count, visibility, visibleCount);
+#endif
+            CullBoxesPack(FrustumLanes<ScalarPack>(frustum), boxes, index, count, visibility, visibleCount);
+            return visibleCount;
+        }
+    }
+}
@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Math/Frustum.h"
+
+namespace alimer
+{
+    /// Structure-of-arrays view over 3D vectors, each component lives in its own array.
+    struct Float3SoA
+    {
+        float* x;
+        float* y;
+        float* z;
+    };
+
+    /// Read only structure-of-arrays view over 3D vectors.
+    struct ConstFloat3SoA
+    {
+        const float* x;
+        const float* y;
+        const float* z;
+
+        ConstFloat3SoA(const float* x_, const float* y_, const float* z_) noexcept
+            : x(x_)
+            , y(y_)
+            , z(z_)
+        {
+        }
+
+        ConstFloat3SoA(const Float3SoA& other) noexcept
+            : x(other.x)
+            , y(other.y)
+            , z(other.z)
+        {
+        }
+    };
+
+    /// Structure-of-arrays view over bounding spheres.
+    struct BoundingSphereSoA
+    {
+        ConstFloat3SoA center;
+        const float* radius;
+    };
+
+    /// Structure-of-arrays view over axis aligned boxes stored as center and half extents.
+    struct BoundingBoxSoA
+    {
+        Float3SoA center;
+        Float3SoA extents;
+    };
+
+    /// Read only structure-of-arrays view over axis aligned boxes.
+    struct ConstBoundingBoxSoA
+    {
+        ConstFloat3SoA center;
+        ConstFloat3SoA extents;
+
+        ConstBoundingBoxSoA(const ConstFloat3SoA& center_, const ConstFloat3SoA& extents_) noexcept
+            : center(center_)
+            , extents(extents_)
+        {
+        }
+
+        ConstBoundingBoxSoA(const BoundingBoxSoA& other) noexcept
+            : center(other.center)
+            , extents(other.extents)
+        {
+        }
+    };
+
+    /**
+     * Bulk geometry kernels over structure-of-arrays data. The arrays are processed 8 lanes at a time with AVX, 4 with
+     * SSE or NEON and the remainder one at a time; every lane uses the same operation order, so results do not depend
+     * on the path taken and match Matrix4x4::TransformPoint and the single object Frustum tests. Arrays need no special
+     * alignment and outputs may alias inputs element for element.
+     */
+    namespace BatchMath
+    {
+        /// Return the number of uint32_t words of a visibility mask for count objects.
+        constexpr size_t GetVisibilityWordCount(size_t count) { return (count + 31) / 32; }
+
+        /// Transform points with w = 1, output = point * matrix without perspective divide.
+        ALIMER_API void TransformPoints(const Matrix4x4& matrix, const ConstFloat3SoA& points, const Float3SoA& output, size_t count);
+
+        /// Transform directions with w = 0. Pass the inverse transpose for matrices with non uniform scale.
+        ALIMER_API void TransformNormals(const Matrix4x4& matrix, const ConstFloat3SoA& normals, const Float3SoA& output, size_t count);
+
+        /// Transform boxes and return the axis aligned boxes enclosing the results.
+        ALIMER_API void TransformBoxes(const Matrix4x4& matrix, const ConstBoundingBoxSoA& boxes, const BoundingBoxSoA& output, size_t count);
+
+        /// Test spheres against the frustum. Bit (i % 32) of visibility[i / 32] is set when sphere i is inside or intersects
+        /// it, the mask needs GetVisibilityWordCount(count) words. Returns the number of visible spheres.
+        ALIMER_API size_t CullSpheres(const Frustum& frustum, const BoundingSphereSoA& spheres, size_t count, uint32_t* visibility);
+
+        /// Test boxes against the frustum, the visibility mask is laid out as for CullSpheres. Returns the number of visible boxes.
+        ALIMER_API size_t CullBoxes(const Frustum& frustum, const ConstBoundingBoxSoA& boxes, size_t count, uint32_t* visibility);
+    }
+}
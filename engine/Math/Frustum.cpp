@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Math/Frustum.h"
+
+namespace alimer
+{
+    namespace
+    {
+        Float4 NormalizePlane(const Float4& plane)
+        {
+            const float length = Float3(plane.x, plane.y, plane.z).Length();
+            return length > 0.0f ? plane / length : plane;
+        }
+    }
+
+    Frustum Frustum::CreateFromMatrix(const Matrix4x4& viewProjection)
+    {
+        // Gribb/Hartmann extraction for row vectors, clip = p * M, so the planes are combinations of columns.
+        const Float4 column0 = viewProjection.Column(0);
+        const Float4 column1 = viewProjection.Column(1);
+        const Float4 column2 = viewProjection.Column(2);
+        const Float4 column3 = viewProjection.Column(3);
+
+        Frustum frustum;
+        frustum.planes[Left] = NormalizePlane(column3 + column0);
+        frustum.planes[Right] = NormalizePlane(column3 - column0);
+        frustum.planes[Bottom] = NormalizePlane(column3 + column1);
+        frustum.planes[Top] = NormalizePlane(column3 - column1);
+        frustum.planes[Near] = NormalizePlane(column2);
+        frustum.planes[Far] = NormalizePlane(column3 - column2);
+        return frustum;
+    }
+
+    // The single object tests add in the same order as the BatchMath kernels, so both agree bit for bit.
+    bool Frustum::IntersectsSphere(const Float3& center, float radius) const
+    {
+        for (const Float4& plane : planes)
+        {
+            const float distance = ((plane.x * center.x + plane.y * center.y) + plane.z * center.z) + plane.w;
+            if (!(distance + radius >= 0.0f))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool Frustum::IntersectsBox(const Float3& center, const Float3& extents) const
+    {
+        for (const Float4& plane : planes)
+        {
+            const float distance = ((plane.x * center.x + plane.y * center.y) + plane.z * center.z) + plane.w;
+            const float radius = (std::fabs(plane.x) * extents.x + std::fabs(plane.y) * extents.y) + std::fabs(plane.z) * extents.z;
+            if (!(distance + radius >= 0.0f))
+                return false;
+        }
+
+        return true;
+    }
+}
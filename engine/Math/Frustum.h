@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Math/Matrix4x4.h"
+
+namespace alimer
+{
+    /// View frustum as six planes (normal.x, normal.y, normal.z, distance). A point p is inside a plane when
+    /// dot(normal, p) + distance >= 0, normals are unit length and point into the frustum.
+    struct ALIMER_API Frustum
+    {
+        enum PlaneIndex : uint32_t
+        {
+            Left,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            PlaneCount
+        };
+
+        Float4 planes[PlaneCount];
+
+        /// Extract the planes from a view-projection matrix with clip depth in [0, 1], as created by Matrix4x4.
+        static Frustum CreateFromMatrix(const Matrix4x4& viewProjection);
+
+        /// Return true if the sphere is inside or intersects the frustum. Conservative near the corners.
+        bool IntersectsSphere(const Float3& center, float radius) const;
+
+        /// Return true if the box given by center and half extents is inside or intersects the frustum.
+        bool IntersectsBox(const Float3& center, const Float3& extents) const;
+    };
+}
@@ -0,0 +1,344 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Math/MathHelper.h"
+
+namespace alimer
+{
+    namespace
+    {
+        template <typename V> ALIMER_FORCE_INLINE V NegateIf(const V& value, const V& mask) { return V::Select(value, -value, mask); }
+
+        /// Return the magnitude of value with the sign bit of sign.
+        template <typename V> ALIMER_FORCE_INLINE V CopySign(const V& value, const V& sign)
+        {
+            const V signBit = V::Splat(-0.0f);
+            return V::Or(V::AndNot(value, signBit), V::And(sign, signBit));
+        }
+
+        template <typename V> ALIMER_FORCE_INLINE V Infinity() { return V::Splat(std::numeric_limits<float>::infinity()); }
+
+        /// Reduce to [-pi / 4, pi / 4] around the nearest multiple of pi / 2, in four steps (Cody-Waite) for the
+        /// accurate tier, and evaluate both polynomials.
+        template <MathPrecision Precision, typename V>
+        ALIMER_FORCE_INLINE void SinCosKernel(const V& value, V* sine, V* cosine)
+        {
+            const V one = V::Splat(1.0f);
+            const V quadrant = V::Round(value * V::Splat(0.636619772f));
+            V x;
+            if (Precision == MathPrecision::Accurate)
+            {
+                // The first three parts of pi / 2 have at most 11 mantissa bits, so their products with quadrants
+                // below 2^13 are exact. Near multiples of pi / 2 the remainder is tiny, only the last part is rounded.
+                x = value - quadrant * V::Splat(1.5703125f);
+                x = x - quadrant * V::Splat(4.837512969970703125e-4f);
+                x = x - quadrant * V::Splat(7.54953362047672271728515625e-8f);
+                x = x - quadrant * V::Splat(2.563344068e-12f);
+            }
+            else
+            {
+                x = value - quadrant * V::Splat(PiOver2);
+            }
+
+            // Polynomials on [-pi / 4, pi / 4], minimax from Cephes for the accurate tier and Taylor for the fast one.
+            const V x2 = x * x;
+            V s;
+            V c;
+            if (Precision == MathPrecision::Accurate)
+            {
+                s = ((V::Splat(-1.9515295891e-4f) * x2 + V::Splat(8.3321608736e-3f)) * x2 + V::Splat(-1.6666654611e-1f)) * x2 * x + x;
+                c = ((V::Splat(2.443315711809948e-5f) * x2 + V::Splat(-1.388731625493765e-3f)) * x2 + V::Splat(4.166664568298827e-2f)) * x2 * x2;
+                c = (c - x2 * V::Splat(0.5f)) + one;
+            }
+            else
+            {
+                s = (V::Splat(8.3333333e-3f) * x2 + V::Splat(-1.6666667e-1f)) * x2 * x + x;
+                c = ((V::Splat(-1.3888889e-3f) * x2 + V::Splat(4.1666667e-2f)) * x2 + V::Splat(-0.5f)) * x2 + one;
+            }
+
+            // The quadrant modulo 4 picks the polynomial and the sign.
+            const V q = quadrant - V::Floor(quadrant * V::Splat(0.25f)) * V::Splat(4.0f);
+            const V isOne = V::Equal(q, one);
+            const V isTwo = V::Equal(q, V::Splat(2.0f));
+            const V swap = V::Or(isOne, V::Equal(q, V::Splat(3.0f)));
+            *sine = NegateIf(V::Select(s, c, swap), V::GreaterEqual(q, V::Splat(2.0f)));
+            *sine = V::Select(*sine, value, V::Equal(value, V::Zero())); // Keep the sign of -0.
+            *cosine = NegateIf(V::Select(c, s, swap), V::Or(isOne, isTwo));
+        }
+
+        template <MathPrecision Precision, typename V> ALIMER_FORCE_INLINE V SinKernel(const V& value)
+        {
+            V sine;
+            V cosine;
+            SinCosKernel<Precision>(value, &sine, &cosine);
+            return sine;
+        }
+
+        template <MathPrecision Precision, typename V> ALIMER_FORCE_INLINE V CosKernel(const V& value)
+        {
+            V sine;
+            V cosine;
+            SinCosKernel<Precision>(value, &sine, &cosine);
+            return cosine;
+        }
+
+        template <MathPrecision Precision, typename V>
+        ALIMER_FORCE_INLINE V Atan2Kernel(const V& y, const V& x)
+        {
+            const V zero = V::Zero();
+            const V one = V::Splat(1.0f);
+            const V absX = V::Abs(x);
+            const V absY = V::Abs(y);
+
+            // Reduce to atan(t) with t in [0, 1]. Equal magnitudes give exactly 1 so two infinities work, the origin 0.
+            const V denominator = V::Max(absX, absY);
+            V t = V::Select(V::Min(absX, absY) / denominator, one, V::Equal(absX, absY));
+            t = V::Select(t, zero, V::Equal(denominator, zero));
+
+            V angle;
+            if (Precision == MathPrecision::Accurate)
+            {
+                // Above tan(pi / 8) use atan(t) = pi / 4 + atan((t - 1) / (t + 1)), then the Cephes polynomial.
+                const V reduce = V::Greater(t, V::Splat(0.4142135623730950f));
+                const V z = V::Select(t, (t - one) / (t + one), reduce);
+                const V z2 = z * z;
+                const V polynomial =
+                    ((V::Splat(8.05374449538e-2f) * z2 + V::Splat(-1.38776856032e-1f)) * z2 + V::Splat(1.99777106478e-1f)) * z2 + V::Splat(-3.33329491539e-1f);
+                angle = V::And(V::Splat(PiOver4), reduce) + (polynomial * z2 * z + z);
+            }
+            else
+            {
+                // Abramowitz and Stegun 4.4.49.
+                const V t2 = t * t;
+                const V polynomial = (((V::Splat(0.0208351f) * t2 + V::Splat(-0.0851330f)) * t2 + V::Splat(0.1801410f)) * t2 + V::Splat(-0.3302995f)) * t2;
+                angle = (polynomial + V::Splat(0.9998660f)) * t;
+            }
+
+            angle = V::Select(angle, V::Splat(PiOver2) - angle, V::Greater(absY, absX));
+
+            // Test the sign bit of x so -0 counts as negative.
+            const V xNegative = V::Less(V::Or(V::And(x, V::Splat(-0.0f)), one), zero);
+            angle = V::Select(angle, V::Splat(Pi) - angle, xNegative);
+            angle = CopySign(angle, y);
+
+            const V ordered = V::And(V::Equal(x, x), V::Equal(y, y));
+            return V::Select(x + y, angle, ordered);
+        }
+
+        template <MathPrecision Precision, typename V> ALIMER_FORCE_INLINE V ExpKernel(const V& value)
+        {
+            const V one = V::Splat(1.0f);
+
+            // Outside the clamp the result is 0 or infinity anyway, inside it 2^n splits into two representable factors.
+            const V x = V::Min(V::Max(value, V::Splat(-104.0f)), V::Splat(89.0f));
+            const V n = V::Round(x * V::Splat(1.44269504088896341f));
+
+            V polynomial;
+            if (Precision == MathPrecision::Accurate)
+            {
+                // ln 2 split in two like the sine reduction, then the Cephes expf polynomial.
+                const V r = (x - n * V::Splat(0.693359375f)) - n * V::Splat(-2.12194440e-4f);
+                polynomial = V::Splat(1.9875691500e-4f) * r + V::Splat(1.3981999507e-3f);
+                polynomial = polynomial * r + V::Splat(8.3334519073e-3f);
+                polynomial = polynomial * r + V::Splat(4.1665795894e-2f);
+                polynomial = polynomial * r + V::Splat(1.6666665459e-1f);
+                polynomial = polynomial * r + V::Splat(5.0000001201e-1f);
+                polynomial = (polynomial * (r * r) + r) + one;
+            }
+            else
+            {
+                const V r = x - n * V::Splat(0.693147181f);
+                polynomial = (((V::Splat(4.1666667e-2f) * r + V::Splat(1.6666667e-1f)) * r + V::Splat(0.5f)) * r + one) * r + one;
+            }
+
+            const V half = V::Round(n * V::Splat(0.5f));
+            const V result = polynomial * V::PowerOfTwo(half) * V::PowerOfTwo(n - half);
+            return V::Select(value, result, V::Equal(value, value));
+        }
+
+        template <MathPrecision Precision, typename V> ALIMER_FORCE_INLINE V LogKernel(const V& value)
+        {
+            const V zero = V::Zero();
+            const V one = V::Splat(1.0f);
+
+            // Frexp needs normal values, scale denormals up by 2^25 first.
+            const V denormal = V::Less(value, V::Splat(std::numeric_limits<float>::min()));
+            V exponent;
+            V mantissa = V::Frexp(V::Select(value, value * V::Splat(33554432.0f), denormal), &exponent);
+            exponent = exponent - V::And(V::Splat(25.0f), denormal);
+
+            // Move the mantissa to [sqrt(0.5), sqrt(2)) and subtract 1.
+            const V small = V::Less(mantissa, V::Splat(0.707106781186547524f));
+            exponent = exponent - V::And(one, small);
+            mantissa = V::Select(mantissa - one, (mantissa + mantissa) - one, small);
+
+            V result;
+            if (Precision == MathPrecision::Accurate)
+            {
+                // Cephes logf, ln 2 split in two.
+                const V m = mantissa;
+                const V z = m * m;
+                V y = V::Splat(7.0376836292e-2f) * m + V::Splat(-1.1514610310e-1f);
+                y = y * m + V::Splat(1.1676998740e-1f);
+                y = y * m + V::Splat(-1.2420140846e-1f);
+                y = y * m + V::Splat(1.4249322787e-1f);
+                y = y * m + V::Splat(-1.6668057665e-1f);
+                y = y * m + V::Splat(2.0000714765e-1f);
+                y = y * m + V::Splat(-2.4999993993e-1f);
+                y = y * m + V::Splat(3.3333331174e-1f);
+                y = y * m * z;
+                y = y + exponent * V::Splat(-2.12194440e-4f);
+                y = y - z * V::Splat(0.5f);
+                result = (m + y) + exponent * V::Splat(0.693359375f);
+            }
+            else
+            {
+                // ln(1 + m) = 2 atanh(s) with s = m / (2 + m), two terms of the series.
+                const V s = mantissa / (mantissa + V::Splat(2.0f));
+                result = s * (V::Splat(0.6666667f) * (s * s) + V::Splat(2.0f)) + exponent * V::Splat(0.693147181f);
+            }
+
+            result = V::Select(result, -Infinity<V>(), V::Equal(value, zero));
+            result = V::Select(result, value, V::Equal(value, Infinity<V>()));
+            return V::Select(V::Splat(std::numeric_limits<float>::quiet_NaN()), result, V::GreaterEqual(value, zero));
+        }
+
+        template <MathPrecision Precision, typename V>
+        ALIMER_FORCE_INLINE V PowKernel(const V& x, const V& y)
+        {
+            const V one = V::Splat(1.0f);
+            V result = ExpKernel<Precision>(y * LogKernel<Precision>(x));
+
+            // Like std::pow, x^0 and 1^y are 1 even for NaN.
+            result = V::Select(result, one, V::Equal(y, V::Zero()));
+            return V::Select(result, one, V::Equal(x, one));
+        }
+    }
+
+    namespace VectorMath
+    {
+        void SinCos(const Vector4& value, Vector4* sine, Vector4* cosine, MathPrecision precision)
+        {
+            if (precision == MathPrecision::Fast)
+            {
+                SinCosKernel<MathPrecision::Fast>(value, sine, cosine);
+            }
+            else
+            {
+                SinCosKernel<MathPrecision::Accurate>(value, sine, cosine);
+            }
+        }
+
+        Vector4 Sin(const Vector4& value, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? SinKernel<MathPrecision::Fast>(value) : SinKernel<MathPrecision::Accurate>(value);
+        }
+
+        Vector4 Cos(const Vector4& value, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? CosKernel<MathPrecision::Fast>(value) : CosKernel<MathPrecision::Accurate>(value);
+        }
+
+        Vector4 Exp(const Vector4& value, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? ExpKernel<MathPrecision::Fast>(value) : ExpKernel<MathPrecision::Accurate>(value);
+        }
+
+        Vector4 Log(const Vector4& value, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? LogKernel<MathPrecision::Fast>(value) : LogKernel<MathPrecision::Accurate>(value);
+        }
+
+        Vector4 Atan2(const Vector4& y, const Vector4& x, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? Atan2Kernel<MathPrecision::Fast>(y, x) : Atan2Kernel<MathPrecision::Accurate>(y, x);
+        }
+
+        Vector4 Pow(const Vector4& x, const Vector4& y, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? PowKernel<MathPrecision::Fast>(x, y) : PowKernel<MathPrecision::Accurate>(x, y);
+        }
+
+        void SinCos(const Vector8& value, Vector8* sine, Vector8* cosine, MathPrecision precision)
+        {
+            if (precision == MathPrecision::Fast)
+            {
+                SinCosKernel<MathPrecision::Fast>(value, sine, cosine);
+            }
+            else
+            {
+                SinCosKernel<MathPrecision::Accurate>(value, sine, cosine);
+            }
+        }
+
+        Vector8 Sin(const Vector8& value, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? SinKernel<MathPrecision::Fast>(value) : SinKernel<MathPrecision::Accurate>(value);
+        }
+
+        Vector8 Cos(const Vector8& value, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? CosKernel<MathPrecision::Fast>(value) : CosKernel<MathPrecision::Accurate>(value);
+        }
+
+        Vector8 Exp(const Vector8& value, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? ExpKernel<MathPrecision::Fast>(value) : ExpKernel<MathPrecision::Accurate>(value);
+        }
+
+        Vector8 Log(const Vector8& value, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? LogKernel<MathPrecision::Fast>(value) : LogKernel<MathPrecision::Accurate>(value);
+        }
+
+        Vector8 Atan2(const Vector8& y, const Vector8& x, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? Atan2Kernel<MathPrecision::Fast>(y, x) : Atan2Kernel<MathPrecision::Accurate>(y, x);
+        }
+
+        Vector8 Pow(const Vector8& x, const Vector8& y, MathPrecision precision)
+        {
+            return precision == MathPrecision::Fast ? PowKernel<MathPrecision::Fast>(x, y) : PowKernel<MathPrecision::Accurate>(x, y);
+        }
+
+        void SinCos(float value, float* sine, float* cosine, MathPrecision precision)
+        {
+            Vector4 sineVector;
+            Vector4 cosineVector;
+            SinCos(Vector4::Splat(value), &sineVector, &cosineVector, precision);
+            *sine = sineVector.GetX();
+            *cosine = cosineVector.GetX();
+        }
+
+        float Sin(float value, MathPrecision precision) { return Sin(Vector4::Splat(value), precision).GetX(); }
+
+        float Cos(float value, MathPrecision precision) { return Cos(Vector4::Splat(value), precision).GetX(); }
+
+        float Exp(float value, MathPrecision precision) { return Exp(Vector4::Splat(value), precision).GetX(); }
+
+        float Log(float value, MathPrecision precision) { return Log(Vector4::Splat(value), precision).GetX(); }
+
+        float Atan2(float y, float x, MathPrecision precision) { return Atan2(Vector4::Splat(y), Vector4::Splat(x), precision).GetX(); }
+
+        float Pow(float x, float y, MathPrecision precision) { return Pow(Vector4::Splat(x), Vector4::Splat(y), precision).GetX(); }
+    }
+}
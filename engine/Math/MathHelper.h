@@ -23,6 +23,7 @@
 #pragma once
 
 #include "Core/Assert.h"
+#include "Math/Vector8.h"
 #include <cmath>
 #include <cstdlib>
 #include <limits>
@@ -122,6 +123,61 @@ namespace alimer
         unsigned u = *((unsigned*)&value);
         return u;
     }
+
+    /// Precision tier of the VectorMath functions.
+    enum class MathPrecision : uint32_t
+    {
+        /// Error around 1e-4 with the fewest instructions, absolute for Sin, Cos, Atan2 and Log, relative for Exp and Pow.
+        Fast,
+        /// Within about three ulp of the correctly rounded result, see Pow for its exception.
+        Accurate
+    };
+
+    /**
+     * Vectorized transcendental functions on Vector4 and Vector8 lanes, with scalar wrappers. Only lane arithmetic,
+     * selects and exact division are used, so results are the same on every SIMD backend. The kernels live in
+     * MathHelper.cpp, which is built without fast-math because the argument reduction depends on evaluation order.
+     */
+    namespace VectorMath
+    {
+        /// Sine and cosine in radians, both come out of the same reduction. The accurate tier stays within two ulp up
+        /// to |x| of 100 and within 1e-7 absolute up to 8192, the fast tier is meant for angles within a few turns.
+        /// Beyond 2^23 the result is meaningless.
+        ALIMER_API void SinCos(const Vector4& value, Vector4* sine, Vector4* cosine, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API void SinCos(const Vector8& value, Vector8* sine, Vector8* cosine, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API void SinCos(float value, float* sine, float* cosine, MathPrecision precision = MathPrecision::Accurate);
+
+        ALIMER_API Vector4 Sin(const Vector4& value, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API Vector8 Sin(const Vector8& value, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API float Sin(float value, MathPrecision precision = MathPrecision::Accurate);
+
+        ALIMER_API Vector4 Cos(const Vector4& value, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API Vector8 Cos(const Vector8& value, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API float Cos(float value, MathPrecision precision = MathPrecision::Accurate);
+
+        /// Angle of (x, y) in [-pi, pi], with the std::atan2 results for zeros and infinities. The accurate tier stays
+        /// within 3.5 ulp, the worst cases are where |y / x| or |x / y| is a little above tan(pi / 8).
+        ALIMER_API Vector4 Atan2(const Vector4& y, const Vector4& x, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API Vector8 Atan2(const Vector8& y, const Vector8& x, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API float Atan2(float y, float x, MathPrecision precision = MathPrecision::Accurate);
+
+        /// Return e^x. Results below the normal range are denormal, above it infinity.
+        ALIMER_API Vector4 Exp(const Vector4& value, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API Vector8 Exp(const Vector8& value, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API float Exp(float value, MathPrecision precision = MathPrecision::Accurate);
+
+        /// Return the natural logarithm. Zero gives -infinity and negative values NaN.
+        ALIMER_API Vector4 Log(const Vector4& value, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API Vector8 Log(const Vector8& value, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API float Log(float value, MathPrecision precision = MathPrecision::Accurate);
+
+        /// Return x^y for x >= 0 as exp(y ln x), negative x gives NaN even for integral y. The logarithm is not carried in
+        /// extended precision, so the accurate tier is within (2 + 1.5 |y log2 x|) ulp and the relative error of the fast
+        /// tier is below 2e-4 (1 + |y ln x|).
+        ALIMER_API Vector4 Pow(const Vector4& x, const Vector4& y, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API Vector8 Pow(const Vector8& x, const Vector8& y, MathPrecision precision = MathPrecision::Accurate);
+        ALIMER_API float Pow(float x, float y, MathPrecision precision = MathPrecision::Accurate);
+    }
 }
 
 #ifdef _MSC_VER
@@ -24,6 +24,72 @@
 
 namespace alimer
 {
+    namespace
+    {
+        // The inverse works on 2x2 blocks stored row-major in one vector, (m00, m01, m10, m11).
+
+        /// Return lhs * rhs.
+        inline Vector4 Multiply2x2(const Vector4& lhs, const Vector4& rhs)
+        {
+            return lhs * rhs.Swizzle<0, 3, 0, 3>() + lhs.Swizzle<1, 0, 3, 2>() * rhs.Swizzle<2, 1, 2, 1>();
+        }
+
+        /// Return adjugate(lhs) * rhs.
+        inline Vector4 AdjugateMultiply2x2(const Vector4& lhs, const Vector4& rhs)
+        {
+            return lhs.Swizzle<3, 3, 0, 0>() * rhs - lhs.Swizzle<1, 1, 2, 2>() * rhs.Swizzle<2, 3, 0, 1>();
+        }
+
+        /// Return lhs * adjugate(rhs).
+        inline Vector4 MultiplyAdjugate2x2(const Vector4& lhs, const Vector4& rhs)
+        {
+            return lhs * rhs.Swizzle<3, 0, 3, 0>() - lhs.Swizzle<1, 0, 3, 2>() * rhs.Swizzle<2, 1, 2, 1>();
+        }
+
+        struct InverseBlocks
+        {
+            Vector4 x, y, z, w;
+            Vector4 determinant;
+        };
+
+        /// Block-wise adjugate and determinant of a 4x4 matrix split into the 2x2 blocks | A B |
+        ///                                                                              | C D |
+        InverseBlocks ComputeInverseBlocks(const Matrix4x4& matrix)
+        {
+            const Vector4 row0 = matrix.GetRow(0);
+            const Vector4 row1 = matrix.GetRow(1);
+            const Vector4 row2 = matrix.GetRow(2);
+            const Vector4 row3 = matrix.GetRow(3);
+
+            const Vector4 a = Vector4::Shuffle<0, 1, 0, 1>(row0, row1);
+            const Vector4 b = Vector4::Shuffle<2, 3, 2, 3>(row0, row1);
+            const Vector4 c = Vector4::Shuffle<0, 1, 0, 1>(row2, row3);
+            const Vector4 d = Vector4::Shuffle<2, 3, 2, 3>(row2, row3);
+
+            // (|A|, |B|, |C|, |D|)
+            const Vector4 blockDeterminants = Vector4::Shuffle<0, 2, 0, 2>(row0, row2) * Vector4::Shuffle<1, 3, 1, 3>(row1, row3) -
+                                              Vector4::Shuffle<1, 3, 1, 3>(row0, row2) * Vector4::Shuffle<0, 2, 0, 2>(row1, row3);
+            const Vector4 detA = blockDeterminants.SplatX();
+            const Vector4 detB = blockDeterminants.SplatY();
+            const Vector4 detC = blockDeterminants.SplatZ();
+            const Vector4 detD = blockDeterminants.SplatW();
+
+            const Vector4 dc = AdjugateMultiply2x2(d, c);
+            const Vector4 ab = AdjugateMultiply2x2(a, b);
+
+            InverseBlocks blocks;
+            blocks.x = detD * a - Multiply2x2(b, dc);
+            blocks.w = detA * d - Multiply2x2(c, ab);
+            blocks.y = detB * c - MultiplyAdjugate2x2(d, ab);
+            blocks.z = detC * b - MultiplyAdjugate2x2(a, dc);
+
+            // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+            const Vector4 trace = Vector4::Dot4(ab, dc.Swizzle<0, 2, 1, 3>());
+            blocks.determinant = (detA * detD + detB * detC) - trace;
+            return blocks;
+        }
+    }
+
     const Matrix4x4 Matrix4x4::Zero = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
                                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
     const Matrix4x4 Matrix4x4::Identity = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
@@ -132,6 +198,179 @@ namespace alimer
         result->m44 = 1.0f;
     }
 
+    bool Matrix4x4::Invert(const Matrix4x4& matrix, Matrix4x4* result)
+    {
+        ALIMER_ASSERT(result);
+        InverseBlocks blocks = ComputeInverseBlocks(matrix);
+        if (blocks.determinant.GetX() == 0.0f)
+        {
+            const Vector4 nan = Vector4::Splat(std::numeric_limits<float>::quiet_NaN());
+            for (size_t i = 0; i < 4; ++i)
+            {
+                result->SetRow(i, nan);
+            }
+            return false;
+        }
+
+        // The blocks hold adjugates, flip the signs of the off-diagonal elements while scaling.
+        const Vector4 scale = Vector4::Set(1.0f, -1.0f, -1.0f, 1.0f) / blocks.determinant;
+        blocks.x = blocks.x * scale;
+        blocks.y = blocks.y * scale;
+        blocks.z = blocks.z * scale;
+        blocks.w = blocks.w * scale;
+
+        result->SetRow(0, Vector4::Shuffle<3, 1, 3, 1>(blocks.x, blocks.y));
+        result->SetRow(1, Vector4::Shuffle<2, 0, 2, 0>(blocks.x, blocks.y));
+        result->SetRow(2, Vector4::Shuffle<3, 1, 3, 1>(blocks.z, blocks.w));
+        result->SetRow(3, Vector4::Shuffle<2, 0, 2, 0>(blocks.z, blocks.w));
+        return true;
+    }
+
+    float Matrix4x4::Determinant() const { return ComputeInverseBlocks(*this).determinant.GetX(); }
+
+    bool Matrix4x4::Decompose(Float3* scale, Quaternion* rotation, Float3* translation) const
+    {
+        ALIMER_ASSERT(scale);
+        ALIMER_ASSERT(rotation);
+        ALIMER_ASSERT(translation);
+
+        *translation = Float3(m41, m42, m43);
+
+        const Vector4 axisX = Vector4::Load3(m[0]);
+        const Vector4 axisY = Vector4::Load3(m[1]);
+        const Vector4 axisZ = Vector4::Load3(m[2]);
+        *scale = Float3(Vector4::Length3(axisX).GetX(), Vector4::Length3(axisY).GetX(), Vector4::Length3(axisZ).GetX());
+        if (scale->x == 0.0f || scale->y == 0.0f || scale->z == 0.0f)
+        {
+            *rotation = Quaternion::Identity;
+            return false;
+        }
+
+        // A mirrored basis is expressed as a negative x scale so the rotation stays proper.
+        if (Vector4::Dot3(axisX, Vector4::Cross3(axisY, axisZ)).GetX() < 0.0f)
+        {
+            scale->x = -scale->x;
+        }
+
+        Matrix4x4 rotationMatrix;
+        rotationMatrix.SetRow(0, axisX / scale->x);
+        rotationMatrix.SetRow(1, axisY / scale->y);
+        rotationMatrix.SetRow(2, axisZ / scale->z);
+        *rotation = Quaternion::CreateFromRotationMatrix(rotationMatrix);
+        return true;
+    }
+
+    void Matrix4x4::CreateTranslation(const Float3& position, Matrix4x4* result)
+    {
+        ALIMER_ASSERT(result);
+        *result = Identity;
+        result->m41 = position.x;
+        result->m42 = position.y;
+        result->m43 = position.z;
+    }
+
+    void Matrix4x4::CreateScale(const Float3& scale, Matrix4x4* result)
+    {
+        ALIMER_ASSERT(result);
+        *result = Identity;
+        result->m11 = scale.x;
+        result->m22 = scale.y;
+        result->m33 = scale.z;
+    }
+
+    void Matrix4x4::CreateRotationX(float radians, Matrix4x4* result)
+    {
+        ALIMER_ASSERT(result);
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+
+        *result = Identity;
+        result->m22 = c;
+        result->m23 = s;
+        result->m32 = -s;
+        result->m33 = c;
+    }
+
+    void Matrix4x4::CreateRotationY(float radians, Matrix4x4* result)
+    {
+        ALIMER_ASSERT(result);
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+
+        *result = Identity;
+        result->m11 = c;
+        result->m13 = -s;
+        result->m31 = s;
+        result->m33 = c;
+    }
+
+    void Matrix4x4::CreateRotationZ(float radians, Matrix4x4* result)
+    {
+        ALIMER_ASSERT(result);
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+
+        *result = Identity;
+        result->m11 = c;
+        result->m12 = s;
+        result->m21 = -s;
+        result->m22 = c;
+    }
+
+    void Matrix4x4::CreateFromQuaternion(const Quaternion& rotation, Matrix4x4* result)
+    {
+        ALIMER_ASSERT(result);
+        const float xx = rotation.x * rotation.x;
+        const float yy = rotation.y * rotation.y;
+        const float zz = rotation.z * rotation.z;
+        const float xy = rotation.x * rotation.y;
+        const float wz = rotation.z * rotation.w;
+        const float xz = rotation.z * rotation.x;
+        const float wy = rotation.y * rotation.w;
+        const float yz = rotation.y * rotation.z;
+        const float wx = rotation.x * rotation.w;
+
+        result->m11 = 1.0f - 2.0f * (yy + zz);
+        result->m12 = 2.0f * (xy + wz);
+        result->m13 = 2.0f * (xz - wy);
+        result->m14 = 0.0f;
+
+        result->m21 = 2.0f * (xy - wz);
+        result->m22 = 1.0f - 2.0f * (zz + xx);
+        result->m23 = 2.0f * (yz + wx);
+        result->m24 = 0.0f;
+
+        result->m31 = 2.0f * (xz + wy);
+        result->m32 = 2.0f * (yz - wx);
+        result->m33 = 1.0f - 2.0f * (yy + xx);
+        result->m34 = 0.0f;
+
+        result->m41 = 0.0f;
+        result->m42 = 0.0f;
+        result->m43 = 0.0f;
+        result->m44 = 1.0f;
+    }
+
+    void Matrix4x4::CreateLookAt(const Float3& cameraPosition, const Float3& cameraTarget, const Float3& cameraUpVector,
+                                 Matrix4x4* result)
+    {
+        ALIMER_ASSERT(result);
+        const Vector4 position = cameraPosition.ToVector();
+        const Vector4 zAxis = Vector4::Normalize3(position - cameraTarget.ToVector());
+        const Vector4 xAxis = Vector4::Normalize3(Vector4::Cross3(cameraUpVector.ToVector(), zAxis));
+        const Vector4 yAxis = Vector4::Cross3(zAxis, xAxis);
+
+        // The axes are the columns of the rotation, w of each axis is zero.
+        result->SetRow(0, xAxis);
+        result->SetRow(1, yAxis);
+        result->SetRow(2, zAxis);
+        result->SetRow(3, Vector4::Set(0.0f, 0.0f, 0.0f, 1.0f));
+        Transpose(*result, result);
+        result->m41 = -Vector4::Dot3(xAxis, position).GetX();
+        result->m42 = -Vector4::Dot3(yAxis, position).GetX();
+        result->m43 = -Vector4::Dot3(zAxis, position).GetX();
+    }
+
     std::string Matrix4x4::ToString() const
     {
         return fmt::format("{} {} {} {} {} {} {} {} {} {} {} {} {} {} {} {}", m11, m12, m13, m14, m21, m22, m23, m24,
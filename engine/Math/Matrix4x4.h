@@ -22,7 +22,7 @@
 
 #pragma once
 
-#include "Core/Math.h"
+#include "Math/Quaternion.h"
 
 namespace alimer
 {
@@ -95,6 +95,133 @@ namespace alimer
         static void CreateOrthographic(float width, float height, float zNearPlane, float zFarPlane, Matrix4x4* result);
         static void CreateOrthographicOffCenter(float left, float right, float bottom, float top, float zNearPlane, float zFarPlane,
                                                 Matrix4x4* result);
+        static void CreateTranslation(const Float3& position, Matrix4x4* result);
+        static void CreateScale(const Float3& scale, Matrix4x4* result);
+        static void CreateRotationX(float radians, Matrix4x4* result);
+        static void CreateRotationY(float radians, Matrix4x4* result);
+        static void CreateRotationZ(float radians, Matrix4x4* result);
+        static void CreateFromQuaternion(const Quaternion& rotation, Matrix4x4* result);
+        static void CreateLookAt(const Float3& cameraPosition, const Float3& cameraTarget, const Float3& cameraUpVector,
+                                 Matrix4x4* result);
+
+        /// Multiply two matrices, result may alias either input. Vectors are rows, so lhs is applied first.
+        static void Multiply(const Matrix4x4& lhs, const Matrix4x4& rhs, Matrix4x4* result)
+        {
+            ALIMER_ASSERT(result);
+#if ALIMER_AVX_INTRINSICS
+            // Two result rows per 256 bit register, the lane order of the additions is the same as the 128 bit path.
+            const __m256 lhs01 = _mm256_loadu_ps(lhs.m[0]);
+            const __m256 lhs23 = _mm256_loadu_ps(lhs.m[2]);
+            const auto broadcastRow = [&rhs](size_t i) {
+                const __m128 row = _mm_loadu_ps(rhs.m[i]);
+                return _mm256_insertf128_ps(_mm256_castps128_ps256(row), row, 1);
+            };
+            const __m256 row0 = broadcastRow(0);
+            const __m256 row1 = broadcastRow(1);
+            const __m256 row2 = broadcastRow(2);
+            const __m256 row3 = broadcastRow(3);
+
+            __m256 result01 = _mm256_mul_ps(_mm256_permute_ps(lhs01, _MM_SHUFFLE(0, 0, 0, 0)), row0);
+            __m256 result23 = _mm256_mul_ps(_mm256_permute_ps(lhs23, _MM_SHUFFLE(0, 0, 0, 0)), row0);
+            result01 = _mm256_add_ps(result01, _mm256_mul_ps(_mm256_permute_ps(lhs01, _MM_SHUFFLE(1, 1, 1, 1)), row1));
+            result23 = _mm256_add_ps(result23, _mm256_mul_ps(_mm256_permute_ps(lhs23, _MM_SHUFFLE(1, 1, 1, 1)), row1));
+            result01 = _mm256_add_ps(result01, _mm256_mul_ps(_mm256_permute_ps(lhs01, _MM_SHUFFLE(2, 2, 2, 2)), row2));
+            result23 = _mm256_add_ps(result23, _mm256_mul_ps(_mm256_permute_ps(lhs23, _MM_SHUFFLE(2, 2, 2, 2)), row2));
+            result01 = _mm256_add_ps(result01, _mm256_mul_ps(_mm256_permute_ps(lhs01, _MM_SHUFFLE(3, 3, 3, 3)), row3));
+            result23 = _mm256_add_ps(result23, _mm256_mul_ps(_mm256_permute_ps(lhs23, _MM_SHUFFLE(3, 3, 3, 3)), row3));
+            _mm256_storeu_ps(result->m[0], result01);
+            _mm256_storeu_ps(result->m[2], result23);
+#else
+            const Vector4 lhsRows[4] = {lhs.GetRow(0), lhs.GetRow(1), lhs.GetRow(2), lhs.GetRow(3)};
+            const Vector4 row0 = rhs.GetRow(0);
+            const Vector4 row1 = rhs.GetRow(1);
+            const Vector4 row2 = rhs.GetRow(2);
+            const Vector4 row3 = rhs.GetRow(3);
+            for (size_t i = 0; i < 4; ++i)
+            {
+                Vector4 row = lhsRows[i].SplatX() * row0;
+                row = row + lhsRows[i].SplatY() * row1;
+                row = row + lhsRows[i].SplatZ() * row2;
+                row = row + lhsRows[i].SplatW() * row3;
+                result->SetRow(i, row);
+            }
+#endif
+        }
+
+        /// Transpose a matrix, result may alias matrix.
+        static void Transpose(const Matrix4x4& matrix, Matrix4x4* result)
+        {
+            ALIMER_ASSERT(result);
+            Vector4 row0 = matrix.GetRow(0);
+            Vector4 row1 = matrix.GetRow(1);
+            Vector4 row2 = matrix.GetRow(2);
+            Vector4 row3 = matrix.GetRow(3);
+            Vector4::Transpose(row0, row1, row2, row3);
+            result->SetRow(0, row0);
+            result->SetRow(1, row1);
+            result->SetRow(2, row2);
+            result->SetRow(3, row3);
+        }
+
+        /// Invert a matrix, result may alias matrix. Returns false and fills result with NaN when it is singular.
+        static bool Invert(const Matrix4x4& matrix, Matrix4x4* result);
+
+        /// Transform a row vector, vector * matrix.
+        static Float4 Transform(const Float4& vector, const Matrix4x4& matrix)
+        {
+            const Vector4 value = vector.ToVector();
+            Vector4 result = value.SplatX() * matrix.GetRow(0);
+            result = result + value.SplatY() * matrix.GetRow(1);
+            result = result + value.SplatZ() * matrix.GetRow(2);
+            result = result + value.SplatW() * matrix.GetRow(3);
+            return Float4(result);
+        }
+
+        /// Transform a point with w = 1, without perspective divide.
+        static Float3 TransformPoint(const Float3& point, const Matrix4x4& matrix)
+        {
+            const Vector4 value = point.ToVector();
+            Vector4 result = value.SplatX() * matrix.GetRow(0);
+            result = result + value.SplatY() * matrix.GetRow(1);
+            result = result + value.SplatZ() * matrix.GetRow(2);
+            result = result + matrix.GetRow(3);
+            return Float3(result);
+        }
+
+        /// Transform a direction with w = 0, translation is ignored.
+        static Float3 TransformNormal(const Float3& normal, const Matrix4x4& matrix)
+        {
+            const Vector4 value = normal.ToVector();
+            Vector4 result = value.SplatX() * matrix.GetRow(0);
+            result = result + value.SplatY() * matrix.GetRow(1);
+            result = result + value.SplatZ() * matrix.GetRow(2);
+            return Float3(result);
+        }
+
+        /// Return the determinant.
+        float Determinant() const;
+
+        /// Split an affine matrix into scale, rotation and translation. Returns false when a scale axis is zero.
+        bool Decompose(Float3* scale, Quaternion* rotation, Float3* translation) const;
+
+        Matrix4x4 operator*(const Matrix4x4& rhs) const
+        {
+            Matrix4x4 result;
+            Multiply(*this, rhs, &result);
+            return result;
+        }
+
+        Matrix4x4& operator*=(const Matrix4x4& rhs)
+        {
+            Multiply(*this, rhs, this);
+            return *this;
+        }
+
+        /// Load matrix row into a SIMD vector.
+        Vector4 GetRow(size_t i) const { return Vector4::Load(m[i]); }
+
+        /// Store a SIMD vector into a matrix row.
+        void SetRow(size_t i, const Vector4& value) { value.Store(m[i]); }
 
         float  operator()(size_t row, size_t column) const noexcept { return m[row][column]; }
         float& operator()(size_t row, size_t column) noexcept { return m[row][column]; }
@@ -0,0 +1,518 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Math/PackedVector.h"
+#include "Math/Vector4.h"
+#include <algorithm>
+
+namespace alimer
+{
+    namespace
+    {
+        inline uint32_t FloatBits(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline float BitsFloat(uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        /// Scale a clamped value and round to nearest even. The product is formed in double where it is exact, a float
+        /// product would round first and turn values just below a midpoint into ties.
+        template <typename T> inline T ScaleRound(float value, double scale)
+        {
+            return static_cast<T>(std::nearbyint(static_cast<double>(value) * scale));
+        }
+
+        template <typename T> inline T PackUNorm(float value, double scale)
+        {
+            // Written so that NaN fails the first comparison and becomes zero.
+            value = value > 0.0f ? value : 0.0f;
+            return ScaleRound<T>(std::min(value, 1.0f), scale);
+        }
+
+        template <typename T> inline T PackSNorm(float value, double scale)
+        {
+            value = std::isnan(value) ? 0.0f : value;
+            return ScaleRound<T>(std::min(std::max(value, -1.0f), 1.0f), scale);
+        }
+
+        inline float UnpackSNorm(int32_t value, float scale) { return std::max(static_cast<float>(value) / scale, -1.0f); }
+
+#if ALIMER_SSE_INTRINSICS
+        /// Convert four floats to halves in the low 16 bits of each lane, matching FloatToHalf bit for bit.
+        inline __m128i FloatToHalf4(__m128 value)
+        {
+            const __m128i bits = _mm_castps_si128(value);
+            const __m128i sign = _mm_and_si128(bits, _mm_set1_epi32(static_cast<int32_t>(0x80000000u)));
+            const __m128i magnitude = _mm_xor_si128(bits, sign);
+
+            // Halves below the smallest normal come from adding 0.5, whose ulp is the smallest half denormal, so the
+            // addition does the rounding and the low mantissa bits are the result.
+            const __m128 denormalMagic = _mm_set1_ps(0.5f);
+            const __m128i denormal =
+                _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(magnitude), denormalMagic)), _mm_castps_si128(denormalMagic));
+
+            // Normals rebias the exponent and round the 13 dropped mantissa bits to nearest even.
+            const __m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(magnitude, 13), _mm_set1_epi32(1));
+            __m128i normal = _mm_add_epi32(magnitude, _mm_set1_epi32(static_cast<int32_t>(0xC8000FFFu)));
+            normal = _mm_srli_epi32(_mm_add_epi32(normal, mantissaOdd), 13);
+
+            const __m128i isNaN = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7F800000));
+            const __m128i nan = _mm_or_si128(_mm_set1_epi32(0x7E00), _mm_and_si128(_mm_srli_epi32(magnitude, 13), _mm_set1_epi32(0x3FF)));
+            const __m128i isDenormal = _mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x38800000));
+            const __m128i isOverflow = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x477FEFFF));
+
+            __m128i result = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+            result = _mm_or_si128(_mm_and_si128(isOverflow, _mm_set1_epi32(0x7C00)), _mm_andnot_si128(isOverflow, result));
+            result = _mm_or_si128(_mm_and_si128(isNaN, nan), _mm_andnot_si128(isNaN, result));
+            return _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+        }
+
+        /// Convert four halves in the low 16 bits of each lane to floats, matching HalfToFloat bit for bit.
+        inline __m128 HalfToFloat4(__m128i value)
+        {
+            const __m128i magnitude = _mm_and_si128(value, _mm_set1_epi32(0x7FFF));
+            const __m128i sign = _mm_slli_epi32(_mm_xor_si128(value, magnitude), 16);
+
+            // Rebias the exponent, twice for infinity and NaN so it ends up all ones, and make NaN quiet.
+            const __m128i rebias = _mm_set1_epi32((127 - 15) << 23);
+            const __m128i isInfNaN = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7BFF));
+            const __m128i isNaN = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7C00));
+            __m128i normal = _mm_add_epi32(_mm_slli_epi32(magnitude, 13), rebias);
+            normal = _mm_add_epi32(normal, _mm_and_si128(isInfNaN, rebias));
+            normal = _mm_or_si128(normal, _mm_and_si128(isNaN, _mm_set1_epi32(0x00400000)));
+
+            // Denormals convert as integers and scale by 2^-24, which never involves a denormal float.
+            const __m128i denormal = _mm_castps_si128(_mm_mul_ps(_mm_cvtepi32_ps(magnitude), _mm_set1_ps(5.9604644775390625e-8f)));
+            const __m128i isDenormal = _mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x0400));
+
+            const __m128i result = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+            return _mm_castsi128_ps(_mm_or_si128(result, sign));
+        }
+
+        /// Map NaN to zero and clamp to [low, 1].
+        inline __m128 ClampNormalized(__m128 value, __m128 low)
+        {
+            value = _mm_and_ps(value, _mm_cmpord_ps(value, value));
+            return _mm_min_ps(_mm_max_ps(value, low), _mm_set1_ps(1.0f));
+        }
+
+        /// Scale four clamped values in double and round to nearest even, see the scalar ScaleRound.
+#if ALIMER_AVX_INTRINSICS
+        using ScaleVector = __m256d;
+        inline ScaleVector SplatScale(double scale) { return _mm256_set1_pd(scale); }
+
+        inline __m128i ScaleRound(__m128 value, ScaleVector scale)
+        {
+            return _mm256_cvtpd_epi32(_mm256_mul_pd(_mm256_cvtps_pd(value), scale));
+        }
+#else
+        using ScaleVector = __m128d;
+        inline ScaleVector SplatScale(double scale) { return _mm_set1_pd(scale); }
+
+        inline __m128i ScaleRound(__m128 value, ScaleVector scale)
+        {
+            const __m128i low = _mm_cvtpd_epi32(_mm_mul_pd(_mm_cvtps_pd(value), scale));
+            const __m128i high = _mm_cvtpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(value, value)), scale));
+            return _mm_unpacklo_epi64(low, high);
+        }
+#endif
+
+        inline __m128 UnpackNormalized(__m128i value, __m128 scale) { return _mm_div_ps(_mm_cvtepi32_ps(value), scale); }
+
+        /// Sign extend the low (high) four 16 bit lanes to 32 bits.
+        inline __m128i ExtendLow16(__m128i value) { return _mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), value), 16); }
+        inline __m128i ExtendHigh16(__m128i value) { return _mm_srai_epi32(_mm_unpackhi_epi16(_mm_setzero_si128(), value), 16); }
+
+        /// Pack the low 16 bits of each 32 bit lane without saturation.
+        inline __m128i Narrow32To16(__m128i low, __m128i high)
+        {
+            low = _mm_srai_epi32(_mm_slli_epi32(low, 16), 16);
+            high = _mm_srai_epi32(_mm_slli_epi32(high, 16), 16);
+            return _mm_packs_epi32(low, high);
+        }
+#endif
+    }
+
+    namespace PackedVector
+    {
+        uint16_t FloatToHalf(float value)
+        {
+            uint32_t bits = FloatBits(value);
+            const uint32_t sign = (bits >> 16) & 0x8000u;
+            bits &= 0x7FFFFFFFu;
+
+            // Infinity stays infinity, NaN keeps the top of its payload and is made quiet.
+            if (bits >= 0x7F800000u)
+                return static_cast<uint16_t>(sign | (bits > 0x7F800000u ? 0x7E00u | ((bits >> 13) & 0x3FFu) : 0x7C00u));
+
+            // 65520 and up round to infinity.
+            if (bits >= 0x477FF000u)
+                return static_cast<uint16_t>(sign | 0x7C00u);
+
+            if (bits < 0x38800000u)
+            {
+                // Half of the smallest denormal and below round to zero.
+                if (bits <= 0x33000000u)
+                    return static_cast<uint16_t>(sign);
+
+                const uint32_t mantissa = (bits & 0x7FFFFFu) | 0x800000u;
+                const uint32_t shift = 126u - (bits >> 23);
+                const uint32_t halfway = 1u << (shift - 1);
+                const uint32_t remainder = mantissa & ((1u << shift) - 1);
+                uint32_t result = mantissa >> shift;
+                if (remainder > halfway || (remainder == halfway && (result & 1u) != 0))
+                    result++;
+
+                return static_cast<uint16_t>(sign | result);
+            }
+
+            // Rebias the exponent and round to nearest even, a mantissa carry moves into the exponent.
+            bits += 0xC8000FFFu + ((bits >> 13) & 1u);
+            return static_cast<uint16_t>(sign | (bits >> 13));
+        }
+
+        float HalfToFloat(uint16_t value)
+        {
+            const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+            const uint32_t magnitude = value & 0x7FFFu;
+
+            if (magnitude < 0x0400u)
+            {
+                const float denormal = static_cast<float>(magnitude) * 5.9604644775390625e-8f;
+                return BitsFloat(FloatBits(denormal) | sign);
+            }
+
+            uint32_t bits = (magnitude << 13) + ((127u - 15u) << 23);
+            if (magnitude >= 0x7C00u)
+                bits += (127u - 15u) << 23;
+            if (magnitude > 0x7C00u)
+                bits |= 0x00400000u;
+
+            return BitsFloat(bits | sign);
+        }
+
+        void FloatToHalf(const float* source, uint16_t* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_F16C_INTRINSICS
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), halves);
+            }
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i halves = _mm_cvtps_ph(_mm_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destination + i), halves);
+            }
+#elif ALIMER_SSE_INTRINSICS
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i low = FloatToHalf4(_mm_loadu_ps(source + i));
+                const __m128i high = FloatToHalf4(_mm_loadu_ps(source + i + 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), Narrow32To16(low, high));
+            }
+#elif ALIMER_NEON64_INTRINSICS
+            for (; i + 4 <= count; i += 4)
+            {
+                vst1_u16(destination + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(source + i))));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i] = FloatToHalf(source[i]);
+            }
+        }
+
+        void HalfToFloat(const uint16_t* source, float* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_F16C_INTRINSICS
+            for (; i + 8 <= count; i += 8)
+            {
+                _mm256_storeu_ps(destination + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i))));
+            }
+            for (; i + 4 <= count; i += 4)
+            {
+                _mm_storeu_ps(destination + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i))));
+            }
+#elif ALIMER_SSE_INTRINSICS
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                _mm_storeu_ps(destination + i, HalfToFloat4(_mm_unpacklo_epi16(halves, _mm_setzero_si128())));
+                _mm_storeu_ps(destination + i + 4, HalfToFloat4(_mm_unpackhi_epi16(halves, _mm_setzero_si128())));
+            }
+#elif ALIMER_NEON64_INTRINSICS
+            for (; i + 4 <= count; i += 4)
+            {
+                vst1q_f32(destination + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(source + i))));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i] = HalfToFloat(source[i]);
+            }
+        }
+
+        void PackUNorm8(const float* source, uint8_t* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128 low = _mm_setzero_ps();
+            const ScaleVector scale = SplatScale(255.0);
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m128i a = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i), low), scale);
+                const __m128i b = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i + 4), low), scale);
+                const __m128i c = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i + 8), low), scale);
+                const __m128i d = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i + 12), low), scale);
+                const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), packed);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i] = PackUNorm<uint8_t>(source[i], 255.0);
+            }
+        }
+
+        void UnpackUNorm8(const uint8_t* source, float* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128i zero = _mm_setzero_si128();
+            const __m128 scale = _mm_set1_ps(255.0f);
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+                const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+                _mm_storeu_ps(destination + i, UnpackNormalized(_mm_unpacklo_epi16(low, zero), scale));
+                _mm_storeu_ps(destination + i + 4, UnpackNormalized(_mm_unpackhi_epi16(low, zero), scale));
+                _mm_storeu_ps(destination + i + 8, UnpackNormalized(_mm_unpacklo_epi16(high, zero), scale));
+                _mm_storeu_ps(destination + i + 12, UnpackNormalized(_mm_unpackhi_epi16(high, zero), scale));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i] = static_cast<float>(source[i]) / 255.0f;
+            }
+        }
+
+        void PackSNorm8(const float* source, int8_t* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128 low = _mm_set1_ps(-1.0f);
+            const ScaleVector scale = SplatScale(127.0);
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m128i a = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i), low), scale);
+                const __m128i b = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i + 4), low), scale);
+                const __m128i c = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i + 8), low), scale);
+                const __m128i d = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i + 12), low), scale);
+                const __m128i packed = _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), packed);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i] = PackSNorm<int8_t>(source[i], 127.0);
+            }
+        }
+
+        void UnpackSNorm8(const int8_t* source, float* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128i zero = _mm_setzero_si128();
+            const __m128 scale = _mm_set1_ps(127.0f);
+            const __m128 minimum = _mm_set1_ps(-1.0f);
+            for (; i + 16 <= count; i += 16)
+            {
+                // Move each byte to the top of a 16 bit lane and shift it back down to sign extend.
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                const __m128i low = _mm_srai_epi16(_mm_unpacklo_epi8(zero, bytes), 8);
+                const __m128i high = _mm_srai_epi16(_mm_unpackhi_epi8(zero, bytes), 8);
+                _mm_storeu_ps(destination + i, _mm_max_ps(UnpackNormalized(ExtendLow16(low), scale), minimum));
+                _mm_storeu_ps(destination + i + 4, _mm_max_ps(UnpackNormalized(ExtendHigh16(low), scale), minimum));
+                _mm_storeu_ps(destination + i + 8, _mm_max_ps(UnpackNormalized(ExtendLow16(high), scale), minimum));
+                _mm_storeu_ps(destination + i + 12, _mm_max_ps(UnpackNormalized(ExtendHigh16(high), scale), minimum));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i] = UnpackSNorm(source[i], 127.0f);
+            }
+        }
+
+        void PackUNorm16(const float* source, uint16_t* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128 low = _mm_setzero_ps();
+            const ScaleVector scale = SplatScale(65535.0);
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i a = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i), low), scale);
+                const __m128i b = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i + 4), low), scale);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), Narrow32To16(a, b));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i] = PackUNorm<uint16_t>(source[i], 65535.0);
+            }
+        }
+
+        void UnpackUNorm16(const uint16_t* source, float* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128i zero = _mm_setzero_si128();
+            const __m128 scale = _mm_set1_ps(65535.0f);
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                _mm_storeu_ps(destination + i, UnpackNormalized(_mm_unpacklo_epi16(values, zero), scale));
+                _mm_storeu_ps(destination + i + 4, UnpackNormalized(_mm_unpackhi_epi16(values, zero), scale));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i] = static_cast<float>(source[i]) / 65535.0f;
+            }
+        }
+
+        void PackSNorm16(const float* source, int16_t* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128 low = _mm_set1_ps(-1.0f);
+            const ScaleVector scale = SplatScale(32767.0);
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i a = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i), low), scale);
+                const __m128i b = ScaleRound(ClampNormalized(_mm_loadu_ps(source + i + 4), low), scale);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packs_epi32(a, b));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i] = PackSNorm<int16_t>(source[i], 32767.0);
+            }
+        }
+
+        void UnpackSNorm16(const int16_t* source, float* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128 scale = _mm_set1_ps(32767.0f);
+            const __m128 minimum = _mm_set1_ps(-1.0f);
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                _mm_storeu_ps(destination + i, _mm_max_ps(UnpackNormalized(ExtendLow16(values), scale), minimum));
+                _mm_storeu_ps(destination + i + 4, _mm_max_ps(UnpackNormalized(ExtendHigh16(values), scale), minimum));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                destination[i] = UnpackSNorm(source[i], 32767.0f);
+            }
+        }
+
+        void PackRGB10A2(const float* source, uint32_t* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128 low = _mm_setzero_ps();
+            const ScaleVector colorScale = SplatScale(1023.0);
+            const ScaleVector alphaScale = SplatScale(3.0);
+            for (; i + 4 <= count; i += 4)
+            {
+                // Transpose four elements so each register holds one channel.
+                __m128 r = _mm_loadu_ps(source + i * 4);
+                __m128 g = _mm_loadu_ps(source + i * 4 + 4);
+                __m128 b = _mm_loadu_ps(source + i * 4 + 8);
+                __m128 a = _mm_loadu_ps(source + i * 4 + 12);
+                _MM_TRANSPOSE4_PS(r, g, b, a);
+
+                const __m128i red = ScaleRound(ClampNormalized(r, low), colorScale);
+                const __m128i green = _mm_slli_epi32(ScaleRound(ClampNormalized(g, low), colorScale), 10);
+                const __m128i blue = _mm_slli_epi32(ScaleRound(ClampNormalized(b, low), colorScale), 20);
+                const __m128i alpha = _mm_slli_epi32(ScaleRound(ClampNormalized(a, low), alphaScale), 30);
+                const __m128i words = _mm_or_si128(_mm_or_si128(red, green), _mm_or_si128(blue, alpha));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), words);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                const float* element = source + i * 4;
+                destination[i] = PackUNorm<uint32_t>(element[0], 1023.0) | (PackUNorm<uint32_t>(element[1], 1023.0) << 10) |
+                                 (PackUNorm<uint32_t>(element[2], 1023.0) << 20) | (PackUNorm<uint32_t>(element[3], 3.0) << 30);
+            }
+        }
+
+        void UnpackRGB10A2(const uint32_t* source, float* destination, size_t count)
+        {
+            size_t i = 0;
+#if ALIMER_SSE_INTRINSICS
+            const __m128i colorMask = _mm_set1_epi32(0x3FF);
+            const __m128 colorScale = _mm_set1_ps(1023.0f);
+            const __m128 alphaScale = _mm_set1_ps(3.0f);
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                __m128 r = UnpackNormalized(_mm_and_si128(words, colorMask), colorScale);
+                __m128 g = UnpackNormalized(_mm_and_si128(_mm_srli_epi32(words, 10), colorMask), colorScale);
+                __m128 b = UnpackNormalized(_mm_and_si128(_mm_srli_epi32(words, 20), colorMask), colorScale);
+                __m128 a = UnpackNormalized(_mm_srli_epi32(words, 30), alphaScale);
+                _MM_TRANSPOSE4_PS(r, g, b, a);
+
+                _mm_storeu_ps(destination + i * 4, r);
+                _mm_storeu_ps(destination + i * 4 + 4, g);
+                _mm_storeu_ps(destination + i * 4 + 8, b);
+                _mm_storeu_ps(destination + i * 4 + 12, a);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                const uint32_t word = source[i];
+                float* element = destination + i * 4;
+                element[0] = static_cast<float>(word & 0x3FFu) / 1023.0f;
+                element[1] = static_cast<float>((word >> 10) & 0x3FFu) / 1023.0f;
+                element[2] = static_cast<float>((word >> 20) & 0x3FFu) / 1023.0f;
+                element[3] = static_cast<float>(word >> 30) / 3.0f;
+            }
+        }
+    }
+}
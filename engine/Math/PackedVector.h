@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "PlatformDef.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace alimer
+{
+    /**
+     * Conversions between 32 bit floats and the compact encodings used by vertex and texel formats: IEEE half floats,
+     * 8 and 16 bit normalized integers and 10:10:10:2 unsigned normalized words.
+     *
+     * The bulk functions run with F16C or NEON for halves and SSE2 or AVX for the integer formats, the remainder and
+     * other targets go through the scalar conversion, which gives the same bits:
+     *  - Float to half rounds to nearest even, keeps denormals, overflows to infinity and makes NaN quiet
+     *    keeping the top of its payload. Half to float is exact apart from making NaN quiet.
+     *  - Float to normalized integer maps NaN to zero, clamps to [0, 1] or [-1, 1], scales by the largest code and
+     *    rounds the exact product to nearest even. Signed values are symmetric, the smallest code unpacks to -1 like
+     *    the one above it.
+     *  - Unpacking divides the code by the largest one, so every code round trips.
+     *
+     * Counts are in components, except for RGB10A2 where a count is a four component element. Arrays need no special
+     * alignment and must not overlap.
+     */
+    namespace PackedVector
+    {
+        /// Convert a float to a half float.
+        ALIMER_API uint16_t FloatToHalf(float value);
+
+        /// Convert a half float to a float.
+        ALIMER_API float HalfToFloat(uint16_t value);
+
+        /// Convert floats to half floats, for VertexFormat::Half2 and Half4 or 16 bit float textures.
+        ALIMER_API void FloatToHalf(const float* source, uint16_t* destination, size_t count);
+
+        /// Convert half floats to floats.
+        ALIMER_API void HalfToFloat(const uint16_t* source, float* destination, size_t count);
+
+        /// Pack floats to 8 bit unsigned normalized values, for VertexFormat::UChar2Norm and UChar4Norm.
+        ALIMER_API void PackUNorm8(const float* source, uint8_t* destination, size_t count);
+
+        /// Unpack 8 bit unsigned normalized values to [0, 1].
+        ALIMER_API void UnpackUNorm8(const uint8_t* source, float* destination, size_t count);
+
+        /// Pack floats to 8 bit signed normalized values, for VertexFormat::Char2Norm and Char4Norm.
+        ALIMER_API void PackSNorm8(const float* source, int8_t* destination, size_t count);
+
+        /// Unpack 8 bit signed normalized values to [-1, 1].
+        ALIMER_API void UnpackSNorm8(const int8_t* source, float* destination, size_t count);
+
+        /// Pack floats to 16 bit unsigned normalized values, for VertexFormat::UShort2Norm and UShort4Norm.
+        ALIMER_API void PackUNorm16(const float* source, uint16_t* destination, size_t count);
+
+        /// Unpack 16 bit unsigned normalized values to [0, 1].
+        ALIMER_API void UnpackUNorm16(const uint16_t* source, float* destination, size_t count);
+
+        /// Pack floats to 16 bit signed normalized values, for VertexFormat::Short2Norm and Short4Norm.
+        ALIMER_API void PackSNorm16(const float* source, int16_t* destination, size_t count);
+
+        /// Unpack 16 bit signed normalized values to [-1, 1].
+        ALIMER_API void UnpackSNorm16(const int16_t* source, float* destination, size_t count);
+
+        /// Pack RGBA float quadruples to PixelFormat::RGB10A2Unorm words, red in the low bits and alpha in the top two.
+        ALIMER_API void PackRGB10A2(const float* source, uint32_t* destination, size_t count);
+
+        /// Unpack PixelFormat::RGB10A2Unorm words to RGBA float quadruples.
+        ALIMER_API void UnpackRGB10A2(const uint32_t* source, float* destination, size_t count);
+    }
+}
@@ -21,11 +21,101 @@
 //
 
 #include "Math/Quaternion.h"
+#include "Math/Matrix4x4.h"
 
 namespace alimer
 {
     const Quaternion Quaternion::Zero     = {0.0f, 0.0f, 0.0f, 0.0f};
     const Quaternion Quaternion::Identity = {0.0f, 0.0f, 0.0f, 1.0f};
 
+    Quaternion Quaternion::Lerp(const Quaternion& lhs, const Quaternion& rhs, float t)
+    {
+        const Vector4 from = lhs.ToVector();
+        const Vector4 to = rhs.ToVector();
+        const float weight = Vector4::Dot4(from, to).GetX() >= 0.0f ? t : -t;
+        return Quaternion(Vector4::Normalize4(from * (1.0f - t) + to * weight));
+    }
+
+    Quaternion Quaternion::Slerp(const Quaternion& lhs, const Quaternion& rhs, float t)
+    {
+        constexpr float kEpsilon = 1e-6f;
+
+        const Vector4 from = lhs.ToVector();
+        const Vector4 to = rhs.ToVector();
+        float cosOmega = Vector4::Dot4(from, to).GetX();
+        const bool flip = cosOmega < 0.0f;
+        if (flip)
+        {
+            cosOmega = -cosOmega;
+        }
+
+        float fromWeight;
+        float toWeight;
+        if (cosOmega > 1.0f - kEpsilon)
+        {
+            // Too close for a stable sine, fall back to linear interpolation.
+            fromWeight = 1.0f - t;
+            toWeight = t;
+        }
+        else
+        {
+            const float omega = std::acos(cosOmega);
+            const float invSinOmega = 1.0f / std::sin(omega);
+            fromWeight = std::sin((1.0f - t) * omega) * invSinOmega;
+            toWeight = std::sin(t * omega) * invSinOmega;
+        }
+
+        return Quaternion(from * fromWeight + to * (flip ? -toWeight : toWeight));
+    }
+
+    Quaternion Quaternion::CreateFromAxisAngle(const Float3& axis, float angle)
+    {
+        const float halfAngle = angle * 0.5f;
+        const float s = std::sin(halfAngle);
+        const Vector4 vector = axis.ToVector() * s;
+        return Quaternion(vector.GetX(), vector.GetY(), vector.GetZ(), std::cos(halfAngle));
+    }
+
+    Quaternion Quaternion::CreateFromYawPitchRoll(float yaw, float pitch, float roll)
+    {
+        const float sr = std::sin(roll * 0.5f);
+        const float cr = std::cos(roll * 0.5f);
+        const float sp = std::sin(pitch * 0.5f);
+        const float cp = std::cos(pitch * 0.5f);
+        const float sy = std::sin(yaw * 0.5f);
+        const float cy = std::cos(yaw * 0.5f);
+
+        return Quaternion(cy * sp * cr + sy * cp * sr, sy * cp * cr - cy * sp * sr, cy * cp * sr - sy * sp * cr, cy * cp * cr + sy * sp * sr);
+    }
+
+    Quaternion Quaternion::CreateFromRotationMatrix(const Matrix4x4& matrix)
+    {
+        const float trace = matrix.m11 + matrix.m22 + matrix.m33;
+        if (trace > 0.0f)
+        {
+            const float s = std::sqrt(trace + 1.0f);
+            const float invS = 0.5f / s;
+            return Quaternion((matrix.m23 - matrix.m32) * invS, (matrix.m31 - matrix.m13) * invS, (matrix.m12 - matrix.m21) * invS, s * 0.5f);
+        }
+
+        if (matrix.m11 >= matrix.m22 && matrix.m11 >= matrix.m33)
+        {
+            const float s = std::sqrt(1.0f + matrix.m11 - matrix.m22 - matrix.m33);
+            const float invS = 0.5f / s;
+            return Quaternion(0.5f * s, (matrix.m12 + matrix.m21) * invS, (matrix.m13 + matrix.m31) * invS, (matrix.m23 - matrix.m32) * invS);
+        }
+
+        if (matrix.m22 > matrix.m33)
+        {
+            const float s = std::sqrt(1.0f + matrix.m22 - matrix.m11 - matrix.m33);
+            const float invS = 0.5f / s;
+            return Quaternion((matrix.m21 + matrix.m12) * invS, 0.5f * s, (matrix.m32 + matrix.m23) * invS, (matrix.m31 - matrix.m13) * invS);
+        }
+
+        const float s = std::sqrt(1.0f + matrix.m33 - matrix.m11 - matrix.m22);
+        const float invS = 0.5f / s;
+        return Quaternion((matrix.m31 + matrix.m13) * invS, (matrix.m32 + matrix.m23) * invS, 0.5f * s, (matrix.m12 - matrix.m21) * invS);
+    }
+
     std::string Quaternion::ToString() const { return fmt::format("{} {} {} {}", x, y, z, w); }
 }
@@ -26,6 +26,8 @@
 
 namespace alimer
 {
+    class Matrix4x4;
+
     /// Class specifying a four-dimensional quaternion.
     struct ALIMER_API Quaternion
     {
@@ -63,6 +65,8 @@ namespace alimer
         {
         }
 
+        explicit Quaternion(const Vector4& vector) noexcept { vector.Store(&x); }
+
         Quaternion(const Quaternion&) = default;
         Quaternion& operator=(const Quaternion&) = default;
 
@@ -73,12 +77,75 @@ namespace alimer
         bool operator==(const Quaternion& rhs) const noexcept { return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w; }
         bool operator!=(const Quaternion& rhs) const noexcept { return x != rhs.x || y != rhs.y || z != rhs.z || w != rhs.w; }
 
+        /// Hamilton product. When rotating vectors, rhs is applied first.
+        Quaternion operator*(const Quaternion& rhs) const
+        {
+            const Vector4 lhsVector = ToVector();
+            const Vector4 rhsVector = rhs.ToVector();
+            const Vector4 x = rhsVector.Swizzle<3, 2, 1, 0>() * Vector4::Set(1.0f, -1.0f, 1.0f, -1.0f);
+            const Vector4 y = rhsVector.Swizzle<2, 3, 0, 1>() * Vector4::Set(1.0f, 1.0f, -1.0f, -1.0f);
+            const Vector4 z = rhsVector.Swizzle<1, 0, 3, 2>() * Vector4::Set(-1.0f, 1.0f, 1.0f, -1.0f);
+            Vector4 result = lhsVector.SplatW() * rhsVector;
+            result = result + lhsVector.SplatX() * x;
+            result = result + lhsVector.SplatY() * y;
+            result = result + lhsVector.SplatZ() * z;
+            return Quaternion(result);
+        }
+
+        Quaternion& operator*=(const Quaternion& rhs) { return *this = *this * rhs; }
+
+        /// Rotate a vector, the equivalent of q * v * conjugate(q).
+        Float3 Rotate(const Float3& vector) const
+        {
+            const Vector4 q = ToVector();
+            const Vector4 value = vector.ToVector();
+            const Vector4 t = Vector4::Cross3(q, value) * 2.0f;
+            return Float3(value + q.SplatW() * t + Vector4::Cross3(q, t));
+        }
+
+        /// Load into a SIMD vector.
+        Vector4 ToVector() const { return Vector4::Load(&x); }
+
+        /// Return length.
+        float Length() const { return Vector4::Length4(ToVector()).GetX(); }
+
+        /// Return squared length.
+        float LengthSquared() const { return Vector4::Dot4(ToVector(), ToVector()).GetX(); }
+
         /// Return float data.
         const float* Data() const { return &x; }
 
         /// Return as string.
         std::string ToString() const;
 
+        static float Dot(const Quaternion& lhs, const Quaternion& rhs) { return Vector4::Dot4(lhs.ToVector(), rhs.ToVector()).GetX(); }
+
+        /// Return the unit quaternion, zero for a zero quaternion.
+        static Quaternion Normalize(const Quaternion& value) { return Quaternion(Vector4::Normalize4(value.ToVector())); }
+
+        static Quaternion Conjugate(const Quaternion& value)
+        {
+            return Quaternion(value.ToVector() * Vector4::Set(-1.0f, -1.0f, -1.0f, 1.0f));
+        }
+
+        static Quaternion Inverse(const Quaternion& value)
+        {
+            const Vector4 vector = value.ToVector();
+            return Quaternion(Conjugate(value).ToVector() / Vector4::Dot4(vector, vector));
+        }
+
+        /// Normalized linear interpolation along the shortest arc.
+        static Quaternion Lerp(const Quaternion& lhs, const Quaternion& rhs, float t);
+
+        /// Spherical linear interpolation along the shortest arc.
+        static Quaternion Slerp(const Quaternion& lhs, const Quaternion& rhs, float t);
+
+        static Quaternion CreateFromAxisAngle(const Float3& axis, float angle);
+        static Quaternion CreateFromYawPitchRoll(float yaw, float pitch, float roll);
+
+        /// Create from the rotation part of a matrix, which must be orthonormal.
+        static Quaternion CreateFromRotationMatrix(const Matrix4x4& matrix);
+
         // Constants
         static const Quaternion Zero;
         static const Quaternion Identity;
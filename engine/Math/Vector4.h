@@ -0,0 +1,763 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "PlatformDef.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if ALIMER_AVX_INTRINSICS
+#    include <immintrin.h>
+#elif ALIMER_SSE4_INTRINSICS
+#    include <smmintrin.h>
+#elif ALIMER_SSE_INTRINSICS
+#    include <emmintrin.h>
+#elif ALIMER_NEON_INTRINSICS
+#    include <arm_neon.h>
+#endif
+
+#if ALIMER_NEON_INTRINSICS && (defined(__aarch64__) || defined(_M_ARM64))
+#    define ALIMER_NEON64_INTRINSICS 1
+#else
+#    define ALIMER_NEON64_INTRINSICS 0
+#endif
+
+namespace alimer
+{
+#if ALIMER_SSE_INTRINSICS
+    using VectorRegister = __m128;
+#elif ALIMER_NEON_INTRINSICS
+    using VectorRegister = float32x4_t;
+#else
+    struct alignas(16) VectorRegister
+    {
+        float f[4];
+    };
+#endif
+
+    /**
+     * Four 32 bit float lanes held in a SIMD register, the building block of the vector, matrix and quaternion math.
+     * Every operation is a lane-wise IEEE single precision operation and reductions add in a fixed order, so the SSE,
+     * NEON and scalar (ALIMER_SIMD_DISABLED) backends produce bit identical results. This holds as long as the compiler
+     * may not contract or reassociate float math (-ffast-math, -ffp-contract=fast with FMA enabled, /fp:fast).
+     */
+    struct Vector4
+    {
+        /// Number of float lanes.
+        static constexpr size_t kWidth = 4;
+
+        VectorRegister v;
+
+        Vector4() = default;
+        ALIMER_FORCE_INLINE explicit Vector4(VectorRegister v_) noexcept
+            : v(v_)
+        {
+        }
+
+        /// Return a vector with all lanes set to zero.
+        static ALIMER_FORCE_INLINE Vector4 Zero()
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_setzero_ps());
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vdupq_n_f32(0.0f));
+#else
+            return Vector4(VectorRegister{{0.0f, 0.0f, 0.0f, 0.0f}});
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 Set(float x, float y, float z, float w)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_setr_ps(x, y, z, w));
+#elif ALIMER_NEON_INTRINSICS
+            const float values[4] = {x, y, z, w};
+            return Vector4(vld1q_f32(values));
+#else
+            return Vector4(VectorRegister{{x, y, z, w}});
+#endif
+        }
+
+        /// Return a vector with all lanes set to value.
+        static ALIMER_FORCE_INLINE Vector4 Splat(float value)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_set1_ps(value));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vdupq_n_f32(value));
+#else
+            return Vector4(VectorRegister{{value, value, value, value}});
+#endif
+        }
+
+        /// Load four floats, data does not need to be aligned.
+        static ALIMER_FORCE_INLINE Vector4 Load(const float* data)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_loadu_ps(data));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vld1q_f32(data));
+#else
+            return Vector4(VectorRegister{{data[0], data[1], data[2], data[3]}});
+#endif
+        }
+
+        /// Load three floats without reading past them, w is set to zero.
+        static ALIMER_FORCE_INLINE Vector4 Load3(const float* data)
+        {
+#if ALIMER_SSE_INTRINSICS
+            const __m128 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(data)));
+            const __m128 z = _mm_load_ss(data + 2);
+            return Vector4(_mm_movelh_ps(xy, z));
+#elif ALIMER_NEON_INTRINSICS
+            const float32x2_t xy = vld1_f32(data);
+            const float32x2_t z = vld1_lane_f32(data + 2, vdup_n_f32(0.0f), 0);
+            return Vector4(vcombine_f32(xy, z));
+#else
+            return Vector4(VectorRegister{{data[0], data[1], data[2], 0.0f}});
+#endif
+        }
+
+        /// Store four floats, data does not need to be aligned.
+        ALIMER_FORCE_INLINE void Store(float* data) const
+        {
+#if ALIMER_SSE_INTRINSICS
+            _mm_storeu_ps(data, v);
+#elif ALIMER_NEON_INTRINSICS
+            vst1q_f32(data, v);
+#else
+            data[0] = v.f[0];
+            data[1] = v.f[1];
+            data[2] = v.f[2];
+            data[3] = v.f[3];
+#endif
+        }
+
+        /// Store the x, y and z lanes without writing past them.
+        ALIMER_FORCE_INLINE void Store3(float* data) const
+        {
+#if ALIMER_SSE_INTRINSICS
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(data), _mm_castps_si128(v));
+            _mm_store_ss(data + 2, _mm_movehl_ps(v, v));
+#elif ALIMER_NEON_INTRINSICS
+            vst1_f32(data, vget_low_f32(v));
+            vst1q_lane_f32(data + 2, v, 2);
+#else
+            data[0] = v.f[0];
+            data[1] = v.f[1];
+            data[2] = v.f[2];
+#endif
+        }
+
+        /// Return the lanes (X, Y, Z, W) of this vector.
+        template <uint32_t X, uint32_t Y, uint32_t Z, uint32_t W> ALIMER_FORCE_INLINE Vector4 Swizzle() const
+        {
+            static_assert(X < 4 && Y < 4 && Z < 4 && W < 4, "Swizzle lane out of range");
+#if ALIMER_AVX_INTRINSICS
+            return Vector4(_mm_permute_ps(v, _MM_SHUFFLE(W, Z, Y, X)));
+#elif ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X)));
+#else
+            return Shuffle<X, Y, Z, W>(*this, *this);
+#endif
+        }
+
+        /// Return the lanes (a[X], a[Y], b[Z], b[W]), the equivalent of _mm_shuffle_ps.
+        template <uint32_t X, uint32_t Y, uint32_t Z, uint32_t W> static ALIMER_FORCE_INLINE Vector4 Shuffle(const Vector4& a, const Vector4& b)
+        {
+            static_assert(X < 4 && Y < 4 && Z < 4 && W < 4, "Shuffle lane out of range");
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(W, Z, Y, X)));
+#elif ALIMER_NEON_INTRINSICS && defined(__clang__)
+            return Vector4(__builtin_shufflevector(a.v, b.v, X, Y, Z + 4, W + 4));
+#elif ALIMER_NEON_INTRINSICS
+            float32x4_t result = vdupq_n_f32(vgetq_lane_f32(a.v, X));
+            result = vsetq_lane_f32(vgetq_lane_f32(a.v, Y), result, 1);
+            result = vsetq_lane_f32(vgetq_lane_f32(b.v, Z), result, 2);
+            result = vsetq_lane_f32(vgetq_lane_f32(b.v, W), result, 3);
+            return Vector4(result);
+#else
+            return Vector4(VectorRegister{{a.v.f[X], a.v.f[Y], b.v.f[Z], b.v.f[W]}});
+#endif
+        }
+
+        ALIMER_FORCE_INLINE Vector4 SplatX() const { return Swizzle<0, 0, 0, 0>(); }
+        ALIMER_FORCE_INLINE Vector4 SplatY() const { return Swizzle<1, 1, 1, 1>(); }
+        ALIMER_FORCE_INLINE Vector4 SplatZ() const { return Swizzle<2, 2, 2, 2>(); }
+        ALIMER_FORCE_INLINE Vector4 SplatW() const { return Swizzle<3, 3, 3, 3>(); }
+
+        ALIMER_FORCE_INLINE float GetX() const
+        {
+#if ALIMER_SSE_INTRINSICS
+            return _mm_cvtss_f32(v);
+#elif ALIMER_NEON_INTRINSICS
+            return vgetq_lane_f32(v, 0);
+#else
+            return v.f[0];
+#endif
+        }
+
+        ALIMER_FORCE_INLINE float GetY() const
+        {
+#if ALIMER_NEON_INTRINSICS
+            return vgetq_lane_f32(v, 1);
+#else
+            return SplatY().GetX();
+#endif
+        }
+
+        ALIMER_FORCE_INLINE float GetZ() const
+        {
+#if ALIMER_NEON_INTRINSICS
+            return vgetq_lane_f32(v, 2);
+#else
+            return SplatZ().GetX();
+#endif
+        }
+
+        ALIMER_FORCE_INLINE float GetW() const
+        {
+#if ALIMER_NEON_INTRINSICS
+            return vgetq_lane_f32(v, 3);
+#else
+            return SplatW().GetX();
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 Add(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_add_ps(a.v, b.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vaddq_f32(a.v, b.v));
+#else
+            return Vector4(VectorRegister{{a.v.f[0] + b.v.f[0], a.v.f[1] + b.v.f[1], a.v.f[2] + b.v.f[2], a.v.f[3] + b.v.f[3]}});
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 Subtract(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_sub_ps(a.v, b.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vsubq_f32(a.v, b.v));
+#else
+            return Vector4(VectorRegister{{a.v.f[0] - b.v.f[0], a.v.f[1] - b.v.f[1], a.v.f[2] - b.v.f[2], a.v.f[3] - b.v.f[3]}});
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 Multiply(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_mul_ps(a.v, b.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vmulq_f32(a.v, b.v));
+#else
+            return Vector4(VectorRegister{{a.v.f[0] * b.v.f[0], a.v.f[1] * b.v.f[1], a.v.f[2] * b.v.f[2], a.v.f[3] * b.v.f[3]}});
+#endif
+        }
+
+        /// Correctly rounded division, never a reciprocal estimate.
+        static ALIMER_FORCE_INLINE Vector4 Divide(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_div_ps(a.v, b.v));
+#elif ALIMER_NEON64_INTRINSICS
+            return Vector4(vdivq_f32(a.v, b.v));
+#else
+            float lhs[4], rhs[4];
+            Vector4(a).Store(lhs);
+            Vector4(b).Store(rhs);
+            return Set(lhs[0] / rhs[0], lhs[1] / rhs[1], lhs[2] / rhs[2], lhs[3] / rhs[3]);
+#endif
+        }
+
+        /// Return a * b + c with two roundings, matching the separate multiply and add of the other backends.
+        static ALIMER_FORCE_INLINE Vector4 MultiplyAdd(const Vector4& a, const Vector4& b, const Vector4& c)
+        {
+            return Add(Multiply(a, b), c);
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 Negate(const Vector4& value)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_xor_ps(value.v, _mm_set1_ps(-0.0f)));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vnegq_f32(value.v));
+#else
+            return Vector4(VectorRegister{{-value.v.f[0], -value.v.f[1], -value.v.f[2], -value.v.f[3]}});
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 Abs(const Vector4& value)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_andnot_ps(_mm_set1_ps(-0.0f), value.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vabsq_f32(value.v));
+#else
+            return Vector4(VectorRegister{{std::fabs(value.v.f[0]), std::fabs(value.v.f[1]), std::fabs(value.v.f[2]), std::fabs(value.v.f[3])}});
+#endif
+        }
+
+        /// Lane-wise a < b ? a : b, so b is returned when either lane is NaN.
+        static ALIMER_FORCE_INLINE Vector4 Min(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_min_ps(a.v, b.v));
+#elif ALIMER_NEON_INTRINSICS
+            // vminq_f32 orders -0 below +0 and propagates NaN, select explicitly to match the other backends.
+            return Vector4(vbslq_f32(vcltq_f32(a.v, b.v), a.v, b.v));
+#else
+            VectorRegister result;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                result.f[i] = a.v.f[i] < b.v.f[i] ? a.v.f[i] : b.v.f[i];
+            }
+            return Vector4(result);
+#endif
+        }
+
+        /// Lane-wise a > b ? a : b, so b is returned when either lane is NaN.
+        static ALIMER_FORCE_INLINE Vector4 Max(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_max_ps(a.v, b.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vbslq_f32(vcgtq_f32(a.v, b.v), a.v, b.v));
+#else
+            VectorRegister result;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                result.f[i] = a.v.f[i] > b.v.f[i] ? a.v.f[i] : b.v.f[i];
+            }
+            return Vector4(result);
+#endif
+        }
+
+        /// Correctly rounded square root, never a reciprocal square root estimate.
+        static ALIMER_FORCE_INLINE Vector4 Sqrt(const Vector4& value)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_sqrt_ps(value.v));
+#elif ALIMER_NEON64_INTRINSICS
+            return Vector4(vsqrtq_f32(value.v));
+#else
+            float lanes[4];
+            value.Store(lanes);
+            return Set(std::sqrt(lanes[0]), std::sqrt(lanes[1]), std::sqrt(lanes[2]), std::sqrt(lanes[3]));
+#endif
+        }
+
+        /// Round to the nearest integer, ties to even.
+        static ALIMER_FORCE_INLINE Vector4 Round(const Vector4& value)
+        {
+#if ALIMER_SSE4_INTRINSICS
+            return Vector4(_mm_round_ps(value.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+#elif ALIMER_SSE_INTRINSICS
+            // The conversion only covers the int32 range, larger values and NaN are already integral. OR-ing the sign
+            // back keeps -0.0 for small negative values like roundps does.
+            const __m128 sign = _mm_set1_ps(-0.0f);
+            const __m128 rounded = _mm_or_ps(_mm_cvtepi32_ps(_mm_cvtps_epi32(value.v)), _mm_and_ps(value.v, sign));
+            const __m128 inRange = _mm_cmplt_ps(_mm_andnot_ps(sign, value.v), _mm_set1_ps(8388608.0f));
+            return Vector4(_mm_or_ps(_mm_and_ps(inRange, rounded), _mm_andnot_ps(inRange, value.v)));
+#elif ALIMER_NEON64_INTRINSICS
+            return Vector4(vrndnq_f32(value.v));
+#else
+            float lanes[4];
+            value.Store(lanes);
+            return Set(std::nearbyint(lanes[0]), std::nearbyint(lanes[1]), std::nearbyint(lanes[2]), std::nearbyint(lanes[3]));
+#endif
+        }
+
+        /// Round towards negative infinity.
+        static ALIMER_FORCE_INLINE Vector4 Floor(const Vector4& value)
+        {
+#if ALIMER_SSE4_INTRINSICS
+            return Vector4(_mm_floor_ps(value.v));
+#elif ALIMER_SSE_INTRINSICS
+            const __m128 rounded = Round(value).v;
+            return Vector4(_mm_sub_ps(rounded, _mm_and_ps(_mm_cmpgt_ps(rounded, value.v), _mm_set1_ps(1.0f))));
+#elif ALIMER_NEON64_INTRINSICS
+            return Vector4(vrndmq_f32(value.v));
+#else
+            float lanes[4];
+            value.Store(lanes);
+            return Set(std::floor(lanes[0]), std::floor(lanes[1]), std::floor(lanes[2]), std::floor(lanes[3]));
+#endif
+        }
+
+        /// Return 2^n for integral lanes n in [-126, 127], built directly from the exponent bits.
+        static ALIMER_FORCE_INLINE Vector4 PowerOfTwo(const Vector4& n)
+        {
+#if ALIMER_SSE_INTRINSICS
+            const __m128i exponent = _mm_add_epi32(_mm_cvtps_epi32(n.v), _mm_set1_epi32(127));
+            return Vector4(_mm_castsi128_ps(_mm_slli_epi32(exponent, 23)));
+#elif ALIMER_NEON_INTRINSICS
+            const int32x4_t exponent = vaddq_s32(vcvtq_s32_f32(n.v), vdupq_n_s32(127));
+            return Vector4(vreinterpretq_f32_s32(vshlq_n_s32(exponent, 23)));
+#else
+            VectorRegister result;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                const uint32_t bits = static_cast<uint32_t>(static_cast<int32_t>(n.v.f[i]) + 127) << 23;
+                std::memcpy(&result.f[i], &bits, sizeof(bits));
+            }
+            return Vector4(result);
+#endif
+        }
+
+        /// Split positive normal values into a mantissa in [0.5, 1) and an integral exponent, like std::frexp.
+        static ALIMER_FORCE_INLINE Vector4 Frexp(const Vector4& value, Vector4* exponent)
+        {
+            const Vector4 mantissa = Or(And(value, SplatBits(0x807fffffu)), Splat(0.5f));
+#if ALIMER_SSE_INTRINSICS
+            const __m128i biased = _mm_srli_epi32(_mm_castps_si128(value.v), 23);
+            exponent->v = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_and_si128(biased, _mm_set1_epi32(0xff)), _mm_set1_epi32(126)));
+#elif ALIMER_NEON_INTRINSICS
+            const uint32x4_t biased = vandq_u32(vshrq_n_u32(vreinterpretq_u32_f32(value.v), 23), vdupq_n_u32(0xff));
+            exponent->v = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(biased), vdupq_n_s32(126)));
+#else
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                uint32_t bits;
+                std::memcpy(&bits, &value.v.f[i], sizeof(bits));
+                exponent->v.f[i] = static_cast<float>(static_cast<int32_t>((bits >> 23) & 0xff) - 126);
+            }
+#endif
+            return mantissa;
+        }
+
+        /// Splat a raw bit pattern, for masks and sign manipulation.
+        static ALIMER_FORCE_INLINE Vector4 SplatBits(uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return Splat(value);
+        }
+
+        // Comparisons return a mask with all bits of a lane set where the comparison is true.
+        static ALIMER_FORCE_INLINE Vector4 Equal(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_cmpeq_ps(a.v, b.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vreinterpretq_f32_u32(vceqq_f32(a.v, b.v)));
+#else
+            return CompareScalar(a, b, [](float lhs, float rhs) { return lhs == rhs; });
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 Less(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_cmplt_ps(a.v, b.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vreinterpretq_f32_u32(vcltq_f32(a.v, b.v)));
+#else
+            return CompareScalar(a, b, [](float lhs, float rhs) { return lhs < rhs; });
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 LessEqual(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_cmple_ps(a.v, b.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vreinterpretq_f32_u32(vcleq_f32(a.v, b.v)));
+#else
+            return CompareScalar(a, b, [](float lhs, float rhs) { return lhs <= rhs; });
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 Greater(const Vector4& a, const Vector4& b) { return Less(b, a); }
+        static ALIMER_FORCE_INLINE Vector4 GreaterEqual(const Vector4& a, const Vector4& b) { return LessEqual(b, a); }
+
+        /// Pick the lanes of b where mask is set and the lanes of a elsewhere. The mask must come from a comparison.
+        static ALIMER_FORCE_INLINE Vector4 Select(const Vector4& a, const Vector4& b, const Vector4& mask)
+        {
+#if ALIMER_SSE4_INTRINSICS
+            return Vector4(_mm_blendv_ps(a.v, b.v, mask.v));
+#elif ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_or_ps(_mm_andnot_ps(mask.v, a.v), _mm_and_ps(mask.v, b.v)));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vbslq_f32(vreinterpretq_u32_f32(mask.v), b.v, a.v));
+#else
+            VectorRegister result;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                uint32_t maskBits;
+                std::memcpy(&maskBits, &mask.v.f[i], sizeof(maskBits));
+                result.f[i] = maskBits != 0 ? b.v.f[i] : a.v.f[i];
+            }
+            return Vector4(result);
+#endif
+        }
+
+        // Bitwise operations on comparison masks.
+        static ALIMER_FORCE_INLINE Vector4 And(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_and_ps(a.v, b.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))));
+#else
+            return BitwiseScalar(a, b, [](uint32_t lhs, uint32_t rhs) { return lhs & rhs; });
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 Or(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_or_ps(a.v, b.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))));
+#else
+            return BitwiseScalar(a, b, [](uint32_t lhs, uint32_t rhs) { return lhs | rhs; });
+#endif
+        }
+
+        /// Return a & ~b.
+        static ALIMER_FORCE_INLINE Vector4 AndNot(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_andnot_ps(b.v, a.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))));
+#else
+            return BitwiseScalar(a, b, [](uint32_t lhs, uint32_t rhs) { return lhs & ~rhs; });
+#endif
+        }
+
+        /// Return the sign bits of the four lanes packed in the low bits, lane x in bit 0.
+        static ALIMER_FORCE_INLINE uint32_t MoveMask(const Vector4& mask)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return static_cast<uint32_t>(_mm_movemask_ps(mask.v));
+#elif ALIMER_NEON_INTRINSICS
+            const uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(mask.v), 31);
+            return vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) | (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3);
+#else
+            uint32_t result = 0;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                uint32_t bits;
+                std::memcpy(&bits, &mask.v.f[i], sizeof(bits));
+                result |= (bits >> 31) << i;
+            }
+            return result;
+#endif
+        }
+
+        /// Return (a.x * b.x + a.y * b.y) + a.z * b.z in all lanes.
+        static ALIMER_FORCE_INLINE Vector4 Dot3(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            const __m128 product = _mm_mul_ps(a.v, b.v);
+            __m128 sum = _mm_add_ss(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 1, 1, 1)));
+            sum = _mm_add_ss(sum, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 2, 2, 2)));
+            return Vector4(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(0, 0, 0, 0)));
+#elif ALIMER_NEON_INTRINSICS
+            const float32x4_t product = vmulq_f32(a.v, b.v);
+            const float32x2_t xy = vget_low_f32(product);
+            float32x2_t sum = vpadd_f32(xy, xy);
+            sum = vadd_f32(sum, vdup_lane_f32(vget_high_f32(product), 0));
+            return Vector4(vcombine_f32(sum, sum));
+#else
+            return Splat((a.v.f[0] * b.v.f[0] + a.v.f[1] * b.v.f[1]) + a.v.f[2] * b.v.f[2]);
+#endif
+        }
+
+        /// Return (a.x * b.x + a.y * b.y) + (a.z * b.z + a.w * b.w) in all lanes.
+        static ALIMER_FORCE_INLINE Vector4 Dot4(const Vector4& a, const Vector4& b)
+        {
+#if ALIMER_SSE_INTRINSICS
+            const __m128 product = _mm_mul_ps(a.v, b.v);
+            // Addition is commutative bit for bit, so every lane ends up with the same pairwise sum.
+            __m128 sum = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+            sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+            return Vector4(sum);
+#elif ALIMER_NEON_INTRINSICS
+            const float32x4_t product = vmulq_f32(a.v, b.v);
+            float32x2_t sum = vpadd_f32(vget_low_f32(product), vget_high_f32(product));
+            sum = vpadd_f32(sum, sum);
+            return Vector4(vcombine_f32(sum, sum));
+#else
+            return Splat((a.v.f[0] * b.v.f[0] + a.v.f[1] * b.v.f[1]) + (a.v.f[2] * b.v.f[2] + a.v.f[3] * b.v.f[3]));
+#endif
+        }
+
+        /// Return the cross product of the x, y and z lanes, w is zero for finite input.
+        static ALIMER_FORCE_INLINE Vector4 Cross3(const Vector4& a, const Vector4& b)
+        {
+            const Vector4 lhs = Multiply(a.Swizzle<1, 2, 0, 3>(), b.Swizzle<2, 0, 1, 3>());
+            const Vector4 rhs = Multiply(a.Swizzle<2, 0, 1, 3>(), b.Swizzle<1, 2, 0, 3>());
+            return Subtract(lhs, rhs);
+        }
+
+        static ALIMER_FORCE_INLINE Vector4 Length3(const Vector4& value) { return Sqrt(Dot3(value, value)); }
+        static ALIMER_FORCE_INLINE Vector4 Length4(const Vector4& value) { return Sqrt(Dot4(value, value)); }
+
+        /// Normalize the x, y and z lanes, a zero length vector returns zero.
+        static ALIMER_FORCE_INLINE Vector4 Normalize3(const Vector4& value)
+        {
+            const Vector4 length = Length3(value);
+            return Select(Zero(), Divide(value, length), Greater(length, Zero()));
+        }
+
+        /// Normalize all four lanes, a zero length vector returns zero.
+        static ALIMER_FORCE_INLINE Vector4 Normalize4(const Vector4& value)
+        {
+            const Vector4 length = Length4(value);
+            return Select(Zero(), Divide(value, length), Greater(length, Zero()));
+        }
+
+        /// Return (x + y) + (z + w), the same order as Dot4.
+        static ALIMER_FORCE_INLINE float ReduceAdd(const Vector4& value) { return Dot4(value, Splat(1.0f)).GetX(); }
+
+        /// Return the smallest lane.
+        static ALIMER_FORCE_INLINE float ReduceMin(const Vector4& value)
+        {
+            const Vector4 pairs = Min(value, value.Swizzle<2, 3, 0, 1>());
+            return Min(pairs, pairs.SplatY()).GetX();
+        }
+
+        /// Return the largest lane.
+        static ALIMER_FORCE_INLINE float ReduceMax(const Vector4& value)
+        {
+            const Vector4 pairs = Max(value, value.Swizzle<2, 3, 0, 1>());
+            return Max(pairs, pairs.SplatY()).GetX();
+        }
+
+        /// Hardware reciprocal estimate, about 12 bits on SSE and 8 bits on NEON. Exact on the scalar backend.
+        static ALIMER_FORCE_INLINE Vector4 ReciprocalEstimate(const Vector4& value)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_rcp_ps(value.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vrecpeq_f32(value.v));
+#else
+            return Divide(Splat(1.0f), value);
+#endif
+        }
+
+        /// Hardware reciprocal square root estimate, about 12 bits on SSE and 8 bits on NEON. Exact on the scalar backend.
+        static ALIMER_FORCE_INLINE Vector4 ReciprocalSqrtEstimate(const Vector4& value)
+        {
+#if ALIMER_SSE_INTRINSICS
+            return Vector4(_mm_rsqrt_ps(value.v));
+#elif ALIMER_NEON_INTRINSICS
+            return Vector4(vrsqrteq_f32(value.v));
+#else
+            return Divide(Splat(1.0f), Sqrt(value));
+#endif
+        }
+
+        /// Fast 1 / value refined with Newton-Raphson to about 22 bits. Unlike the other operations the result depends on
+        /// the hardware estimate, so it is not bit identical across backends.
+        static ALIMER_FORCE_INLINE Vector4 ReciprocalFast(const Vector4& value)
+        {
+#if ALIMER_NEON_INTRINSICS
+            float32x4_t estimate = vrecpeq_f32(value.v);
+            estimate = vmulq_f32(estimate, vrecpsq_f32(value.v, estimate));
+            estimate = vmulq_f32(estimate, vrecpsq_f32(value.v, estimate));
+            return Vector4(estimate);
+#else
+            // r' = r * (2 - x * r)
+            const Vector4 estimate = ReciprocalEstimate(value);
+            return Multiply(estimate, Subtract(Splat(2.0f), Multiply(value, estimate)));
+#endif
+        }
+
+        /// Fast 1 / sqrt(value) refined with Newton-Raphson to about 22 bits, not bit identical across backends.
+        static ALIMER_FORCE_INLINE Vector4 ReciprocalSqrtFast(const Vector4& value)
+        {
+#if ALIMER_NEON_INTRINSICS
+            float32x4_t estimate = vrsqrteq_f32(value.v);
+            estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(value.v, estimate), estimate));
+            estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(value.v, estimate), estimate));
+            return Vector4(estimate);
+#else
+            // r' = r * (1.5 - 0.5 * x * r * r)
+            const Vector4 estimate = ReciprocalSqrtEstimate(value);
+            return Multiply(estimate, Subtract(Splat(1.5f), Multiply(Multiply(value, Splat(0.5f)), Multiply(estimate, estimate))));
+#endif
+        }
+
+        /// Transpose four rows in place, row i lane j becomes row j lane i.
+        static ALIMER_FORCE_INLINE void Transpose(Vector4& row0, Vector4& row1, Vector4& row2, Vector4& row3)
+        {
+            const Vector4 low01 = Shuffle<0, 1, 0, 1>(row0, row1);
+            const Vector4 high01 = Shuffle<2, 3, 2, 3>(row0, row1);
+            const Vector4 low23 = Shuffle<0, 1, 0, 1>(row2, row3);
+            const Vector4 high23 = Shuffle<2, 3, 2, 3>(row2, row3);
+            row0 = Shuffle<0, 2, 0, 2>(low01, low23);
+            row1 = Shuffle<1, 3, 1, 3>(low01, low23);
+            row2 = Shuffle<0, 2, 0, 2>(high01, high23);
+            row3 = Shuffle<1, 3, 1, 3>(high01, high23);
+        }
+
+        /// Return a + (b - a) * t.
+        static ALIMER_FORCE_INLINE Vector4 Lerp(const Vector4& a, const Vector4& b, float t)
+        {
+            return Add(a, Multiply(Subtract(b, a), Splat(t)));
+        }
+
+    private:
+#if !ALIMER_SSE_INTRINSICS && !ALIMER_NEON_INTRINSICS
+        template <typename Operation> static Vector4 BitwiseScalar(const Vector4& a, const Vector4& b, Operation operation)
+        {
+            VectorRegister result;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                uint32_t lhs, rhs;
+                std::memcpy(&lhs, &a.v.f[i], sizeof(lhs));
+                std::memcpy(&rhs, &b.v.f[i], sizeof(rhs));
+                const uint32_t bits = operation(lhs, rhs);
+                std::memcpy(&result.f[i], &bits, sizeof(bits));
+            }
+            return Vector4(result);
+        }
+
+        template <typename Compare> static Vector4 CompareScalar(const Vector4& a, const Vector4& b, Compare compare)
+        {
+            VectorRegister result;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                const uint32_t bits = compare(a.v.f[i], b.v.f[i]) ? 0xFFFFFFFFu : 0u;
+                std::memcpy(&result.f[i], &bits, sizeof(bits));
+            }
+            return Vector4(result);
+        }
+#endif
+    };
+
+    ALIMER_FORCE_INLINE Vector4 operator+(const Vector4& lhs, const Vector4& rhs) { return Vector4::Add(lhs, rhs); }
+    ALIMER_FORCE_INLINE Vector4 operator-(const Vector4& lhs, const Vector4& rhs) { return Vector4::Subtract(lhs, rhs); }
+    ALIMER_FORCE_INLINE Vector4 operator*(const Vector4& lhs, const Vector4& rhs) { return Vector4::Multiply(lhs, rhs); }
+    ALIMER_FORCE_INLINE Vector4 operator*(const Vector4& lhs, float rhs) { return Vector4::Multiply(lhs, Vector4::Splat(rhs)); }
+    ALIMER_FORCE_INLINE Vector4 operator/(const Vector4& lhs, const Vector4& rhs) { return Vector4::Divide(lhs, rhs); }
+    ALIMER_FORCE_INLINE Vector4 operator/(const Vector4& lhs, float rhs) { return Vector4::Divide(lhs, Vector4::Splat(rhs)); }
+    ALIMER_FORCE_INLINE Vector4 operator-(const Vector4& value) { return Vector4::Negate(value); }
+}
@@ -0,0 +1,296 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Math/Vector4.h"
+
+namespace alimer
+{
+    /**
+     * Eight 32 bit float lanes, one AVX register or a pair of Vector4 without AVX. The interface mirrors Vector4 so the
+     * wide math types can be written once for both widths, and the lane results are the same on every backend.
+     */
+    struct Vector8
+    {
+        /// Number of float lanes.
+        static constexpr size_t kWidth = 8;
+
+#if ALIMER_AVX_INTRINSICS
+        __m256 v;
+
+        Vector8() = default;
+        ALIMER_FORCE_INLINE explicit Vector8(__m256 v_) noexcept
+            : v(v_)
+        {
+        }
+
+        ALIMER_FORCE_INLINE Vector8(const Vector4& low, const Vector4& high) noexcept
+            : v(_mm256_insertf128_ps(_mm256_castps128_ps256(low.v), high.v, 1))
+        {
+        }
+
+        ALIMER_FORCE_INLINE Vector4 GetLow() const { return Vector4(_mm256_castps256_ps128(v)); }
+        ALIMER_FORCE_INLINE Vector4 GetHigh() const { return Vector4(_mm256_extractf128_ps(v, 1)); }
+#else
+        Vector4 low;
+        Vector4 high;
+
+        Vector8() = default;
+        ALIMER_FORCE_INLINE Vector8(const Vector4& low_, const Vector4& high_) noexcept
+            : low(low_)
+            , high(high_)
+        {
+        }
+
+        ALIMER_FORCE_INLINE Vector4 GetLow() const { return low; }
+        ALIMER_FORCE_INLINE Vector4 GetHigh() const { return high; }
+#endif
+
+        static ALIMER_FORCE_INLINE Vector8 Zero()
+        {
+#if ALIMER_AVX_INTRINSICS
+            return Vector8(_mm256_setzero_ps());
+#else
+            return Vector8(Vector4::Zero(), Vector4::Zero());
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector8 Splat(float value)
+        {
+#if ALIMER_AVX_INTRINSICS
+            return Vector8(_mm256_set1_ps(value));
+#else
+            return Vector8(Vector4::Splat(value), Vector4::Splat(value));
+#endif
+        }
+
+        /// Load eight floats, data does not need to be aligned.
+        static ALIMER_FORCE_INLINE Vector8 Load(const float* data)
+        {
+#if ALIMER_AVX_INTRINSICS
+            return Vector8(_mm256_loadu_ps(data));
+#else
+            return Vector8(Vector4::Load(data), Vector4::Load(data + 4));
+#endif
+        }
+
+        /// Store eight floats, data does not need to be aligned.
+        ALIMER_FORCE_INLINE void Store(float* data) const
+        {
+#if ALIMER_AVX_INTRINSICS
+            _mm256_storeu_ps(data, v);
+#else
+            low.Store(data);
+            high.Store(data + 4);
+#endif
+        }
+
+#if ALIMER_AVX_INTRINSICS
+#    define ALIMER_VECTOR8_BINARY(name, avx, fallback) \
+        static ALIMER_FORCE_INLINE Vector8 name(const Vector8& a, const Vector8& b) { return Vector8(avx(a.v, b.v)); }
+#    define ALIMER_VECTOR8_UNARY(name, avx, fallback) \
+        static ALIMER_FORCE_INLINE Vector8 name(const Vector8& value) { return Vector8(avx); }
+#else
+#    define ALIMER_VECTOR8_BINARY(name, avx, fallback)                                    \
+        static ALIMER_FORCE_INLINE Vector8 name(const Vector8& a, const Vector8& b)       \
+        {                                                                                 \
+            return Vector8(Vector4::fallback(a.low, b.low), Vector4::fallback(a.high, b.high)); \
+        }
+#    define ALIMER_VECTOR8_UNARY(name, avx, fallback) \
+        static ALIMER_FORCE_INLINE Vector8 name(const Vector8& value) { return Vector8(Vector4::fallback(value.low), Vector4::fallback(value.high)); }
+#endif
+
+        ALIMER_VECTOR8_BINARY(Add, _mm256_add_ps, Add)
+        ALIMER_VECTOR8_BINARY(Subtract, _mm256_sub_ps, Subtract)
+        ALIMER_VECTOR8_BINARY(Multiply, _mm256_mul_ps, Multiply)
+        ALIMER_VECTOR8_BINARY(Divide, _mm256_div_ps, Divide)
+        ALIMER_VECTOR8_BINARY(Min, _mm256_min_ps, Min)
+        ALIMER_VECTOR8_BINARY(Max, _mm256_max_ps, Max)
+        ALIMER_VECTOR8_BINARY(And, _mm256_and_ps, And)
+        ALIMER_VECTOR8_BINARY(Or, _mm256_or_ps, Or)
+        ALIMER_VECTOR8_UNARY(Negate, _mm256_xor_ps(value.v, _mm256_set1_ps(-0.0f)), Negate)
+        ALIMER_VECTOR8_UNARY(Abs, _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value.v), Abs)
+        ALIMER_VECTOR8_UNARY(Sqrt, _mm256_sqrt_ps(value.v), Sqrt)
+
+#undef ALIMER_VECTOR8_BINARY
+#undef ALIMER_VECTOR8_UNARY
+
+        /// Round to the nearest integer, ties to even.
+        static ALIMER_FORCE_INLINE Vector8 Round(const Vector8& value)
+        {
+#if ALIMER_AVX_INTRINSICS
+            return Vector8(_mm256_round_ps(value.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+#else
+            return Vector8(Vector4::Round(value.low), Vector4::Round(value.high));
+#endif
+        }
+
+        /// Round towards negative infinity.
+        static ALIMER_FORCE_INLINE Vector8 Floor(const Vector8& value)
+        {
+#if ALIMER_AVX_INTRINSICS
+            return Vector8(_mm256_floor_ps(value.v));
+#else
+            return Vector8(Vector4::Floor(value.low), Vector4::Floor(value.high));
+#endif
+        }
+
+        /// Return 2^n for integral lanes n in [-126, 127].
+        static ALIMER_FORCE_INLINE Vector8 PowerOfTwo(const Vector8& n)
+        {
+#if ALIMER_AVX2_INTRINSICS
+            const __m256i exponent = _mm256_add_epi32(_mm256_cvtps_epi32(n.v), _mm256_set1_epi32(127));
+            return Vector8(_mm256_castsi256_ps(_mm256_slli_epi32(exponent, 23)));
+#else
+            return Vector8(Vector4::PowerOfTwo(n.GetLow()), Vector4::PowerOfTwo(n.GetHigh()));
+#endif
+        }
+
+        /// Split positive normal values into a mantissa in [0.5, 1) and an integral exponent, like std::frexp.
+        static ALIMER_FORCE_INLINE Vector8 Frexp(const Vector8& value, Vector8* exponent)
+        {
+#if ALIMER_AVX2_INTRINSICS
+            const __m256i biased = _mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(value.v), 23), _mm256_set1_epi32(0xff));
+            exponent->v = _mm256_cvtepi32_ps(_mm256_sub_epi32(biased, _mm256_set1_epi32(126)));
+            return Or(And(value, SplatBits(0x807fffffu)), Splat(0.5f));
+#else
+            Vector4 low;
+            Vector4 high;
+            const Vector8 mantissa(Vector4::Frexp(value.GetLow(), &low), Vector4::Frexp(value.GetHigh(), &high));
+            *exponent = Vector8(low, high);
+            return mantissa;
+#endif
+        }
+
+        /// Splat a raw bit pattern, for masks and sign manipulation.
+        static ALIMER_FORCE_INLINE Vector8 SplatBits(uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return Splat(value);
+        }
+
+        static ALIMER_FORCE_INLINE Vector8 MultiplyAdd(const Vector8& a, const Vector8& b, const Vector8& c) { return Add(Multiply(a, b), c); }
+
+        /// Return a & ~b.
+        static ALIMER_FORCE_INLINE Vector8 AndNot(const Vector8& a, const Vector8& b)
+        {
+#if ALIMER_AVX_INTRINSICS
+            return Vector8(_mm256_andnot_ps(b.v, a.v));
+#else
+            return Vector8(Vector4::AndNot(a.low, b.low), Vector4::AndNot(a.high, b.high));
+#endif
+        }
+
+        // Comparisons return a mask with all bits of a lane set where the comparison is true.
+        static ALIMER_FORCE_INLINE Vector8 Equal(const Vector8& a, const Vector8& b)
+        {
+#if ALIMER_AVX_INTRINSICS
+            return Vector8(_mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ));
+#else
+            return Vector8(Vector4::Equal(a.low, b.low), Vector4::Equal(a.high, b.high));
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector8 Less(const Vector8& a, const Vector8& b)
+        {
+#if ALIMER_AVX_INTRINSICS
+            return Vector8(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ));
+#else
+            return Vector8(Vector4::Less(a.low, b.low), Vector4::Less(a.high, b.high));
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector8 LessEqual(const Vector8& a, const Vector8& b)
+        {
+#if ALIMER_AVX_INTRINSICS
+            return Vector8(_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ));
+#else
+            return Vector8(Vector4::LessEqual(a.low, b.low), Vector4::LessEqual(a.high, b.high));
+#endif
+        }
+
+        static ALIMER_FORCE_INLINE Vector8 Greater(const Vector8& a, const Vector8& b) { return Less(b, a); }
+        static ALIMER_FORCE_INLINE Vector8 GreaterEqual(const Vector8& a, const Vector8& b) { return LessEqual(b, a); }
+
+        /// Pick the lanes of b where mask is set and the lanes of a elsewhere. The mask must come from a comparison.
+        static ALIMER_FORCE_INLINE Vector8 Select(const Vector8& a, const Vector8& b, const Vector8& mask)
+        {
+#if ALIMER_AVX_INTRINSICS
+            return Vector8(_mm256_blendv_ps(a.v, b.v, mask.v));
+#else
+            return Vector8(Vector4::Select(a.low, b.low, mask.low), Vector4::Select(a.high, b.high, mask.high));
+#endif
+        }
+
+        /// Return the sign bits of the eight lanes packed in the low bits, lane 0 in bit 0.
+        static ALIMER_FORCE_INLINE uint32_t MoveMask(const Vector8& mask)
+        {
+#if ALIMER_AVX_INTRINSICS
+            return static_cast<uint32_t>(_mm256_movemask_ps(mask.v));
+#else
+            return Vector4::MoveMask(mask.low) | (Vector4::MoveMask(mask.high) << 4);
+#endif
+        }
+
+        /// Return the sum of the lanes, each half is reduced as by Vector4::ReduceAdd and the halves added last.
+        static ALIMER_FORCE_INLINE float ReduceAdd(const Vector8& value)
+        {
+            return Vector4::ReduceAdd(value.GetLow()) + Vector4::ReduceAdd(value.GetHigh());
+        }
+
+        static ALIMER_FORCE_INLINE float ReduceMin(const Vector8& value) { return Vector4::ReduceMin(Vector4::Min(value.GetLow(), value.GetHigh())); }
+        static ALIMER_FORCE_INLINE float ReduceMax(const Vector8& value) { return Vector4::ReduceMax(Vector4::Max(value.GetLow(), value.GetHigh())); }
+
+        /// Fast 1 / value refined with Newton-Raphson, see Vector4::ReciprocalFast.
+        static ALIMER_FORCE_INLINE Vector8 ReciprocalFast(const Vector8& value)
+        {
+#if ALIMER_AVX_INTRINSICS
+            const __m256 estimate = _mm256_rcp_ps(value.v);
+            return Vector8(_mm256_mul_ps(estimate, _mm256_sub_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(value.v, estimate))));
+#else
+            return Vector8(Vector4::ReciprocalFast(value.low), Vector4::ReciprocalFast(value.high));
+#endif
+        }
+
+        /// Fast 1 / sqrt(value) refined with Newton-Raphson, see Vector4::ReciprocalSqrtFast.
+        static ALIMER_FORCE_INLINE Vector8 ReciprocalSqrtFast(const Vector8& value)
+        {
+#if ALIMER_AVX_INTRINSICS
+            const __m256 estimate = _mm256_rsqrt_ps(value.v);
+            const __m256 halfValue = _mm256_mul_ps(value.v, _mm256_set1_ps(0.5f));
+            return Vector8(_mm256_mul_ps(estimate, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(halfValue, _mm256_mul_ps(estimate, estimate)))));
+#else
+            return Vector8(Vector4::ReciprocalSqrtFast(value.low), Vector4::ReciprocalSqrtFast(value.high));
+#endif
+        }
+    };
+
+    ALIMER_FORCE_INLINE Vector8 operator+(const Vector8& lhs, const Vector8& rhs) { return Vector8::Add(lhs, rhs); }
+    ALIMER_FORCE_INLINE Vector8 operator-(const Vector8& lhs, const Vector8& rhs) { return Vector8::Subtract(lhs, rhs); }
+    ALIMER_FORCE_INLINE Vector8 operator*(const Vector8& lhs, const Vector8& rhs) { return Vector8::Multiply(lhs, rhs); }
+    ALIMER_FORCE_INLINE Vector8 operator*(const Vector8& lhs, float rhs) { return Vector8::Multiply(lhs, Vector8::Splat(rhs)); }
+    ALIMER_FORCE_INLINE Vector8 operator/(const Vector8& lhs, const Vector8& rhs) { return Vector8::Divide(lhs, rhs); }
+    ALIMER_FORCE_INLINE Vector8 operator/(const Vector8& lhs, float rhs) { return Vector8::Divide(lhs, Vector8::Splat(rhs)); }
+    ALIMER_FORCE_INLINE Vector8 operator-(const Vector8& value) { return Vector8::Negate(value); }
+}
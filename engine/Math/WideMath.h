@@ -0,0 +1,519 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Math/Matrix4x4.h"
+#include "Math/Vector8.h"
+
+namespace alimer
+{
+    namespace details
+    {
+        /// Transpose Count consecutive floats from each of four sources into Count lane vectors. Count is 3 or a
+        /// multiple of 4, a source of 3 floats is never read past its end.
+        template <size_t Count, typename Source> ALIMER_FORCE_INLINE void GatherLanes(Vector4* result, Source source)
+        {
+            for (size_t first = 0; first < Count; first += 4)
+            {
+                Vector4 rows[4];
+                for (size_t lane = 0; lane < 4; ++lane)
+                {
+                    rows[lane] = Count - first >= 4 ? Vector4::Load(source(lane) + first) : Vector4::Load3(source(lane) + first);
+                }
+
+                Vector4::Transpose(rows[0], rows[1], rows[2], rows[3]);
+                for (size_t i = 0; i < 4 && first + i < Count; ++i)
+                {
+                    result[first + i] = rows[i];
+                }
+            }
+        }
+
+        /// Gather the low four lanes and the high four lanes separately and combine them.
+        template <size_t Count, typename Source> ALIMER_FORCE_INLINE void GatherLanes(Vector8* result, Source source)
+        {
+            Vector4 low[Count];
+            Vector4 high[Count];
+            GatherLanes<Count>(low, source);
+            GatherLanes<Count>(high, [&source](size_t lane) { return source(lane + 4); });
+            for (size_t i = 0; i < Count; ++i)
+            {
+                result[i] = Vector8(low[i], high[i]);
+            }
+        }
+
+        /// Load four consecutive 3D vectors as x, y and z lane vectors with three loads instead of a transpose.
+        ALIMER_FORCE_INLINE void LoadFloat3Lanes(Vector4* result, const float* data)
+        {
+            // x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+            const Vector4 v0 = Vector4::Load(data);
+            const Vector4 v1 = Vector4::Load(data + 4);
+            const Vector4 v2 = Vector4::Load(data + 8);
+            result[0] = Vector4::Shuffle<0, 3, 0, 2>(v0, Vector4::Shuffle<2, 2, 1, 1>(v1, v2));
+            result[1] = Vector4::Shuffle<0, 2, 0, 2>(Vector4::Shuffle<1, 1, 0, 0>(v0, v1), Vector4::Shuffle<3, 3, 2, 2>(v1, v2));
+            result[2] = Vector4::Shuffle<0, 2, 0, 3>(Vector4::Shuffle<2, 2, 1, 1>(v0, v1), v2);
+        }
+
+        ALIMER_FORCE_INLINE void LoadFloat3Lanes(Vector8* result, const float* data)
+        {
+            Vector4 low[3];
+            Vector4 high[3];
+            LoadFloat3Lanes(low, data);
+            LoadFloat3Lanes(high, data + 12);
+            for (size_t i = 0; i < 3; ++i)
+            {
+                result[i] = Vector8(low[i], high[i]);
+            }
+        }
+
+        /// Inverse of LoadFloat3Lanes.
+        ALIMER_FORCE_INLINE void StoreFloat3Lanes(const Vector4* values, float* data)
+        {
+            const Vector4& x = values[0];
+            const Vector4& y = values[1];
+            const Vector4& z = values[2];
+            Vector4::Shuffle<0, 2, 0, 2>(Vector4::Shuffle<0, 0, 0, 0>(x, y), Vector4::Shuffle<0, 0, 1, 1>(z, x)).Store(data);
+            Vector4::Shuffle<0, 2, 0, 2>(Vector4::Shuffle<1, 1, 1, 1>(y, z), Vector4::Shuffle<2, 2, 2, 2>(x, y)).Store(data + 4);
+            Vector4::Shuffle<0, 2, 0, 2>(Vector4::Shuffle<2, 2, 3, 3>(z, x), Vector4::Shuffle<3, 3, 3, 3>(y, z)).Store(data + 8);
+        }
+
+        ALIMER_FORCE_INLINE void StoreFloat3Lanes(const Vector8* values, float* data)
+        {
+            const Vector4 low[3] = {values[0].GetLow(), values[1].GetLow(), values[2].GetLow()};
+            const Vector4 high[3] = {values[0].GetHigh(), values[1].GetHigh(), values[2].GetHigh()};
+            StoreFloat3Lanes(low, data);
+            StoreFloat3Lanes(high, data + 12);
+        }
+
+        /// Inverse of GatherLanes.
+        template <size_t Count, typename Destination> ALIMER_FORCE_INLINE void ScatterLanes(const Vector4* values, Destination destination)
+        {
+            for (size_t first = 0; first < Count; first += 4)
+            {
+                Vector4 rows[4];
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    rows[i] = first + i < Count ? values[first + i] : Vector4::Zero();
+                }
+
+                Vector4::Transpose(rows[0], rows[1], rows[2], rows[3]);
+                for (size_t lane = 0; lane < 4; ++lane)
+                {
+                    if (Count - first >= 4)
+                    {
+                        rows[lane].Store(destination(lane) + first);
+                    }
+                    else
+                    {
+                        rows[lane].Store3(destination(lane) + first);
+                    }
+                }
+            }
+        }
+
+        template <size_t Count, typename Destination> ALIMER_FORCE_INLINE void ScatterLanes(const Vector8* values, Destination destination)
+        {
+            Vector4 low[Count];
+            Vector4 high[Count];
+            for (size_t i = 0; i < Count; ++i)
+            {
+                low[i] = values[i].GetLow();
+                high[i] = values[i].GetHigh();
+            }
+
+            ScatterLanes<Count>(low, destination);
+            ScatterLanes<Count>(high, [&destination](size_t lane) { return destination(lane + 4); });
+        }
+    }
+
+    /**
+     * V::kWidth 3D vectors with one lane vector per component, for systems that run the same math over many elements.
+     * Every lane produces the same bits as the matching Float3 operation.
+     */
+    template <typename V> struct Float3Wide
+    {
+        static constexpr size_t kWidth = V::kWidth;
+
+        V x;
+        V y;
+        V z;
+
+        Float3Wide() = default;
+        ALIMER_FORCE_INLINE Float3Wide(const V& x_, const V& y_, const V& z_) noexcept
+            : x(x_)
+            , y(y_)
+            , z(z_)
+        {
+        }
+
+        static ALIMER_FORCE_INLINE Float3Wide Splat(const Float3& value) { return Float3Wide(V::Splat(value.x), V::Splat(value.y), V::Splat(value.z)); }
+
+        /// Load kWidth consecutive vectors.
+        static ALIMER_FORCE_INLINE Float3Wide Load(const Float3* data)
+        {
+            V components[3];
+            details::LoadFloat3Lanes(components, &data->x);
+            return Float3Wide(components[0], components[1], components[2]);
+        }
+
+        /// Load kWidth vectors from separate component arrays.
+        static ALIMER_FORCE_INLINE Float3Wide Load(const float* xs, const float* ys, const float* zs) { return Float3Wide(V::Load(xs), V::Load(ys), V::Load(zs)); }
+
+        /// Load data[indices[0]] .. data[indices[kWidth - 1]].
+        static ALIMER_FORCE_INLINE Float3Wide Gather(const Float3* data, const uint32_t* indices)
+        {
+            return Gather([data, indices](size_t lane) { return &data[indices[lane]].x; });
+        }
+
+        /// Store to kWidth consecutive vectors.
+        ALIMER_FORCE_INLINE void Store(Float3* data) const
+        {
+            const V components[3] = {x, y, z};
+            details::StoreFloat3Lanes(components, &data->x);
+        }
+
+        ALIMER_FORCE_INLINE void Store(float* xs, float* ys, float* zs) const
+        {
+            x.Store(xs);
+            y.Store(ys);
+            z.Store(zs);
+        }
+
+        /// Store lane i to data[indices[i]]. With repeated indices the highest lane wins.
+        ALIMER_FORCE_INLINE void Scatter(Float3* data, const uint32_t* indices) const
+        {
+            Scatter([data, indices](size_t lane) { return &data[indices[lane]].x; });
+        }
+
+        ALIMER_FORCE_INLINE Float3Wide& operator+=(const Float3Wide& rhs) { return *this = *this + rhs; }
+        ALIMER_FORCE_INLINE Float3Wide& operator-=(const Float3Wide& rhs) { return *this = *this - rhs; }
+        ALIMER_FORCE_INLINE Float3Wide& operator*=(const V& rhs) { return *this = *this * rhs; }
+
+        friend ALIMER_FORCE_INLINE Float3Wide operator+(const Float3Wide& lhs, const Float3Wide& rhs) { return Float3Wide(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z); }
+        friend ALIMER_FORCE_INLINE Float3Wide operator-(const Float3Wide& lhs, const Float3Wide& rhs) { return Float3Wide(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z); }
+        friend ALIMER_FORCE_INLINE Float3Wide operator*(const Float3Wide& lhs, const Float3Wide& rhs) { return Float3Wide(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z); }
+        friend ALIMER_FORCE_INLINE Float3Wide operator*(const Float3Wide& lhs, const V& rhs) { return Float3Wide(lhs.x * rhs, lhs.y * rhs, lhs.z * rhs); }
+        friend ALIMER_FORCE_INLINE Float3Wide operator*(const Float3Wide& lhs, float rhs) { return lhs * V::Splat(rhs); }
+        friend ALIMER_FORCE_INLINE Float3Wide operator/(const Float3Wide& lhs, const Float3Wide& rhs) { return Float3Wide(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z); }
+        friend ALIMER_FORCE_INLINE Float3Wide operator/(const Float3Wide& lhs, const V& rhs) { return Float3Wide(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs); }
+        friend ALIMER_FORCE_INLINE Float3Wide operator-(const Float3Wide& value) { return Float3Wide(-value.x, -value.y, -value.z); }
+
+        static ALIMER_FORCE_INLINE V Dot(const Float3Wide& lhs, const Float3Wide& rhs) { return (lhs.x * rhs.x + lhs.y * rhs.y) + lhs.z * rhs.z; }
+
+        static ALIMER_FORCE_INLINE Float3Wide Cross(const Float3Wide& lhs, const Float3Wide& rhs)
+        {
+            return Float3Wide(lhs.y * rhs.z - lhs.z * rhs.y, lhs.z * rhs.x - lhs.x * rhs.z, lhs.x * rhs.y - lhs.y * rhs.x);
+        }
+
+        ALIMER_FORCE_INLINE V LengthSquared() const { return Dot(*this, *this); }
+        ALIMER_FORCE_INLINE V Length() const { return V::Sqrt(Dot(*this, *this)); }
+
+        /// Return the unit vectors, zero for zero length lanes.
+        static ALIMER_FORCE_INLINE Float3Wide Normalize(const Float3Wide& value)
+        {
+            const V length = value.Length();
+            return Select(Float3Wide(V::Zero(), V::Zero(), V::Zero()), value / length, V::Greater(length, V::Zero()));
+        }
+
+        /// Normalize with the refined reciprocal square root, about 22 bits and not bit identical across backends. Zero
+        /// length lanes return zero.
+        static ALIMER_FORCE_INLINE Float3Wide NormalizeFast(const Float3Wide& value)
+        {
+            const V lengthSquared = value.LengthSquared();
+            const V scale = V::And(V::ReciprocalSqrtFast(lengthSquared), V::Greater(lengthSquared, V::Zero()));
+            return value * scale;
+        }
+
+        static ALIMER_FORCE_INLINE Float3Wide Lerp(const Float3Wide& lhs, const Float3Wide& rhs, const V& t) { return lhs + (rhs - lhs) * t; }
+
+        static ALIMER_FORCE_INLINE Float3Wide Min(const Float3Wide& lhs, const Float3Wide& rhs)
+        {
+            return Float3Wide(V::Min(lhs.x, rhs.x), V::Min(lhs.y, rhs.y), V::Min(lhs.z, rhs.z));
+        }
+
+        static ALIMER_FORCE_INLINE Float3Wide Max(const Float3Wide& lhs, const Float3Wide& rhs)
+        {
+            return Float3Wide(V::Max(lhs.x, rhs.x), V::Max(lhs.y, rhs.y), V::Max(lhs.z, rhs.z));
+        }
+
+        /// Pick the lanes of rhs where mask is set and the lanes of lhs elsewhere.
+        static ALIMER_FORCE_INLINE Float3Wide Select(const Float3Wide& lhs, const Float3Wide& rhs, const V& mask)
+        {
+            return Float3Wide(V::Select(lhs.x, rhs.x, mask), V::Select(lhs.y, rhs.y, mask), V::Select(lhs.z, rhs.z, mask));
+        }
+
+        /// Return the sum of all lanes.
+        static ALIMER_FORCE_INLINE Float3 ReduceAdd(const Float3Wide& value) { return Float3(V::ReduceAdd(value.x), V::ReduceAdd(value.y), V::ReduceAdd(value.z)); }
+
+        /// Return the component-wise minimum of all lanes.
+        static ALIMER_FORCE_INLINE Float3 ReduceMin(const Float3Wide& value) { return Float3(V::ReduceMin(value.x), V::ReduceMin(value.y), V::ReduceMin(value.z)); }
+
+        /// Return the component-wise maximum of all lanes.
+        static ALIMER_FORCE_INLINE Float3 ReduceMax(const Float3Wide& value) { return Float3(V::ReduceMax(value.x), V::ReduceMax(value.y), V::ReduceMax(value.z)); }
+
+    private:
+        template <typename Source> static ALIMER_FORCE_INLINE Float3Wide Gather(Source source)
+        {
+            V components[3];
+            details::GatherLanes<3>(components, source);
+            return Float3Wide(components[0], components[1], components[2]);
+        }
+
+        template <typename Destination> ALIMER_FORCE_INLINE void Scatter(Destination destination) const
+        {
+            const V components[3] = {x, y, z};
+            details::ScatterLanes<3>(components, destination);
+        }
+    };
+
+    /// V::kWidth quaternions with one lane vector per component. Every lane matches the Quaternion operation bit for bit.
+    template <typename V> struct QuaternionWide
+    {
+        static constexpr size_t kWidth = V::kWidth;
+
+        V x;
+        V y;
+        V z;
+        V w;
+
+        QuaternionWide() = default;
+        ALIMER_FORCE_INLINE QuaternionWide(const V& x_, const V& y_, const V& z_, const V& w_) noexcept
+            : x(x_)
+            , y(y_)
+            , z(z_)
+            , w(w_)
+        {
+        }
+
+        static ALIMER_FORCE_INLINE QuaternionWide Splat(const Quaternion& value)
+        {
+            return QuaternionWide(V::Splat(value.x), V::Splat(value.y), V::Splat(value.z), V::Splat(value.w));
+        }
+
+        static ALIMER_FORCE_INLINE QuaternionWide Identity() { return QuaternionWide(V::Zero(), V::Zero(), V::Zero(), V::Splat(1.0f)); }
+
+        /// Load kWidth consecutive quaternions.
+        static ALIMER_FORCE_INLINE QuaternionWide Load(const Quaternion* data)
+        {
+            return Gather([data](size_t lane) { return &data[lane].x; });
+        }
+
+        /// Load data[indices[0]] .. data[indices[kWidth - 1]].
+        static ALIMER_FORCE_INLINE QuaternionWide Gather(const Quaternion* data, const uint32_t* indices)
+        {
+            return Gather([data, indices](size_t lane) { return &data[indices[lane]].x; });
+        }
+
+        /// Store to kWidth consecutive quaternions.
+        ALIMER_FORCE_INLINE void Store(Quaternion* data) const
+        {
+            Scatter([data](size_t lane) { return &data[lane].x; });
+        }
+
+        /// Store lane i to data[indices[i]]. With repeated indices the highest lane wins.
+        ALIMER_FORCE_INLINE void Scatter(Quaternion* data, const uint32_t* indices) const
+        {
+            Scatter([data, indices](size_t lane) { return &data[indices[lane]].x; });
+        }
+
+        /// Hamilton product. When rotating vectors, rhs is applied first.
+        friend ALIMER_FORCE_INLINE QuaternionWide operator*(const QuaternionWide& lhs, const QuaternionWide& rhs)
+        {
+            // Same term order as Quaternion::operator*, which sums w, x, y and z of lhs in turn.
+            return QuaternionWide(((lhs.w * rhs.x + lhs.x * rhs.w) + lhs.y * rhs.z) + lhs.z * -rhs.y,
+                                  ((lhs.w * rhs.y + lhs.x * -rhs.z) + lhs.y * rhs.w) + lhs.z * rhs.x,
+                                  ((lhs.w * rhs.z + lhs.x * rhs.y) + lhs.y * -rhs.x) + lhs.z * rhs.w,
+                                  ((lhs.w * rhs.w + lhs.x * -rhs.x) + lhs.y * -rhs.y) + lhs.z * -rhs.z);
+        }
+
+        ALIMER_FORCE_INLINE QuaternionWide& operator*=(const QuaternionWide& rhs) { return *this = *this * rhs; }
+
+        /// Rotate vectors, the equivalent of q * v * conjugate(q).
+        ALIMER_FORCE_INLINE Float3Wide<V> Rotate(const Float3Wide<V>& vector) const
+        {
+            const Float3Wide<V> axis(x, y, z);
+            const Float3Wide<V> t = Float3Wide<V>::Cross(axis, vector) * 2.0f;
+            return vector + t * w + Float3Wide<V>::Cross(axis, t);
+        }
+
+        static ALIMER_FORCE_INLINE V Dot(const QuaternionWide& lhs, const QuaternionWide& rhs)
+        {
+            return (lhs.x * rhs.x + lhs.y * rhs.y) + (lhs.z * rhs.z + lhs.w * rhs.w);
+        }
+
+        ALIMER_FORCE_INLINE V LengthSquared() const { return Dot(*this, *this); }
+        ALIMER_FORCE_INLINE V Length() const { return V::Sqrt(Dot(*this, *this)); }
+
+        /// Return the unit quaternions, zero for zero length lanes.
+        static ALIMER_FORCE_INLINE QuaternionWide Normalize(const QuaternionWide& value)
+        {
+            const V length = value.Length();
+            const V mask = V::Greater(length, V::Zero());
+            return QuaternionWide(V::And(value.x / length, mask), V::And(value.y / length, mask), V::And(value.z / length, mask),
+                                  V::And(value.w / length, mask));
+        }
+
+        /// Normalize with the refined reciprocal square root, not bit identical across backends.
+        static ALIMER_FORCE_INLINE QuaternionWide NormalizeFast(const QuaternionWide& value)
+        {
+            const V lengthSquared = value.LengthSquared();
+            const V scale = V::And(V::ReciprocalSqrtFast(lengthSquared), V::Greater(lengthSquared, V::Zero()));
+            return QuaternionWide(value.x * scale, value.y * scale, value.z * scale, value.w * scale);
+        }
+
+        static ALIMER_FORCE_INLINE QuaternionWide Conjugate(const QuaternionWide& value) { return QuaternionWide(-value.x, -value.y, -value.z, value.w); }
+
+        /// Normalized linear interpolation along the shortest arc, the wide Quaternion::Lerp.
+        static ALIMER_FORCE_INLINE QuaternionWide Lerp(const QuaternionWide& lhs, const QuaternionWide& rhs, const V& t)
+        {
+            const V weight = V::Select(-t, t, V::GreaterEqual(Dot(lhs, rhs), V::Zero()));
+            const V inverse = V::Splat(1.0f) - t;
+            return Normalize(QuaternionWide(lhs.x * inverse + rhs.x * weight, lhs.y * inverse + rhs.y * weight, lhs.z * inverse + rhs.z * weight,
+                                            lhs.w * inverse + rhs.w * weight));
+        }
+
+        /// Pick the lanes of rhs where mask is set and the lanes of lhs elsewhere.
+        static ALIMER_FORCE_INLINE QuaternionWide Select(const QuaternionWide& lhs, const QuaternionWide& rhs, const V& mask)
+        {
+            return QuaternionWide(V::Select(lhs.x, rhs.x, mask), V::Select(lhs.y, rhs.y, mask), V::Select(lhs.z, rhs.z, mask),
+                                  V::Select(lhs.w, rhs.w, mask));
+        }
+
+    private:
+        template <typename Source> static ALIMER_FORCE_INLINE QuaternionWide Gather(Source source)
+        {
+            V components[4];
+            details::GatherLanes<4>(components, source);
+            return QuaternionWide(components[0], components[1], components[2], components[3]);
+        }
+
+        template <typename Destination> ALIMER_FORCE_INLINE void Scatter(Destination destination) const
+        {
+            const V components[4] = {x, y, z, w};
+            details::ScatterLanes<4>(components, destination);
+        }
+    };
+
+    /// V::kWidth matrices with one lane vector per element. Every lane matches the Matrix4x4 operation bit for bit.
+    template <typename V> struct Matrix4x4Wide
+    {
+        static constexpr size_t kWidth = V::kWidth;
+
+        V m[4][4];
+
+        static ALIMER_FORCE_INLINE Matrix4x4Wide Splat(const Matrix4x4& value)
+        {
+            Matrix4x4Wide result;
+            for (size_t row = 0; row < 4; ++row)
+            {
+                for (size_t column = 0; column < 4; ++column)
+                {
+                    result.m[row][column] = V::Splat(value.m[row][column]);
+                }
+            }
+            return result;
+        }
+
+        /// Load kWidth consecutive matrices.
+        static ALIMER_FORCE_INLINE Matrix4x4Wide Load(const Matrix4x4* data)
+        {
+            Matrix4x4Wide result;
+            details::GatherLanes<16>(&result.m[0][0], [data](size_t lane) { return &data[lane].m11; });
+            return result;
+        }
+
+        /// Load data[indices[0]] .. data[indices[kWidth - 1]].
+        static ALIMER_FORCE_INLINE Matrix4x4Wide Gather(const Matrix4x4* data, const uint32_t* indices)
+        {
+            Matrix4x4Wide result;
+            details::GatherLanes<16>(&result.m[0][0], [data, indices](size_t lane) { return &data[indices[lane]].m11; });
+            return result;
+        }
+
+        /// Store to kWidth consecutive matrices.
+        ALIMER_FORCE_INLINE void Store(Matrix4x4* data) const
+        {
+            details::ScatterLanes<16>(&m[0][0], [data](size_t lane) { return &data[lane].m11; });
+        }
+
+        /// Store lane i to data[indices[i]]. With repeated indices the highest lane wins.
+        ALIMER_FORCE_INLINE void Scatter(Matrix4x4* data, const uint32_t* indices) const
+        {
+            details::ScatterLanes<16>(&m[0][0], [data, indices](size_t lane) { return &data[indices[lane]].m11; });
+        }
+
+        /// Return lhs * rhs, the wide Matrix4x4::Multiply.
+        static ALIMER_FORCE_INLINE Matrix4x4Wide Multiply(const Matrix4x4Wide& lhs, const Matrix4x4Wide& rhs)
+        {
+            Matrix4x4Wide result;
+            for (size_t row = 0; row < 4; ++row)
+            {
+                for (size_t column = 0; column < 4; ++column)
+                {
+                    result.m[row][column] = ((lhs.m[row][0] * rhs.m[0][column] + lhs.m[row][1] * rhs.m[1][column]) + lhs.m[row][2] * rhs.m[2][column]) +
+                                            lhs.m[row][3] * rhs.m[3][column];
+                }
+            }
+            return result;
+        }
+
+        friend ALIMER_FORCE_INLINE Matrix4x4Wide operator*(const Matrix4x4Wide& lhs, const Matrix4x4Wide& rhs) { return Multiply(lhs, rhs); }
+
+        /// Transform points with w = 1.
+        static ALIMER_FORCE_INLINE Float3Wide<V> TransformPoint(const Float3Wide<V>& point, const Matrix4x4Wide& matrix)
+        {
+            return Float3Wide<V>(((point.x * matrix.m[0][0] + point.y * matrix.m[1][0]) + point.z * matrix.m[2][0]) + matrix.m[3][0],
+                                 ((point.x * matrix.m[0][1] + point.y * matrix.m[1][1]) + point.z * matrix.m[2][1]) + matrix.m[3][1],
+                                 ((point.x * matrix.m[0][2] + point.y * matrix.m[1][2]) + point.z * matrix.m[2][2]) + matrix.m[3][2]);
+        }
+
+        /// Transform directions with w = 0, translation is ignored.
+        static ALIMER_FORCE_INLINE Float3Wide<V> TransformNormal(const Float3Wide<V>& normal, const Matrix4x4Wide& matrix)
+        {
+            return Float3Wide<V>((normal.x * matrix.m[0][0] + normal.y * matrix.m[1][0]) + normal.z * matrix.m[2][0],
+                                 (normal.x * matrix.m[0][1] + normal.y * matrix.m[1][1]) + normal.z * matrix.m[2][1],
+                                 (normal.x * matrix.m[0][2] + normal.y * matrix.m[1][2]) + normal.z * matrix.m[2][2]);
+        }
+
+        /// Pick the lanes of rhs where mask is set and the lanes of lhs elsewhere.
+        static ALIMER_FORCE_INLINE Matrix4x4Wide Select(const Matrix4x4Wide& lhs, const Matrix4x4Wide& rhs, const V& mask)
+        {
+            Matrix4x4Wide result;
+            for (size_t row = 0; row < 4; ++row)
+            {
+                for (size_t column = 0; column < 4; ++column)
+                {
+                    result.m[row][column] = V::Select(lhs.m[row][column], rhs.m[row][column], mask);
+                }
+            }
+            return result;
+        }
+    };
+
+    using Float3x4 = Float3Wide<Vector4>;
+    using Float3x8 = Float3Wide<Vector8>;
+    using Quaternionx4 = QuaternionWide<Vector4>;
+    using Quaternionx8 = QuaternionWide<Vector8>;
+    using Matrix4x4x4 = Matrix4x4Wide<Vector4>;
+    using Matrix4x4x8 = Matrix4x4Wide<Vector8>;
+}
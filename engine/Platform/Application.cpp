@@ -22,7 +22,9 @@
 
 #include "Platform/Application.h"
 #include "AlimerConfig.h"
+#include "Core/JobSystem.h"
 #include "Core/Log.h"
+#include "Core/Profiler.h"
 #include "Graphics/CommandBuffer.h"
 #include "Graphics/Graphics.h"
 #include "IO/FileSystem.h"
@@ -77,8 +79,12 @@ namespace alimer
 
         logger->set_pattern(LOGGER_FORMAT);
         spdlog::set_default_logger(logger);
+        Log::Initialize();
 
         LOGI("Logger initialized");
+        ALIMER_PROFILE_THREAD("Main");
+
+        JobSystem::Initialize();
 
         s_appCurrent = this;
     }
@@ -91,6 +97,8 @@ namespace alimer
         RemoveSubsystem<Input>();
         RemoveSubsystem<Graphics>();
         graphics.Reset();
+        JobSystem::Shutdown();
+        Log::Shutdown();
         s_appCurrent = nullptr;
     }
 
@@ -146,27 +154,48 @@ namespace alimer
         state = State::Running;
         while (state == State::Running)
         {
-            Event evt{};
-            while (PollEvent(evt))
+            frameStats.BeginFrame();
+
             {
-                if (evt.type == EventType::Quit)
+                FrameStats::PhaseScope phase(frameStats, FramePhase::PollEvents);
+                Event evt{};
+                while (PollEvent(evt))
                 {
-                    state = State::Uninitialized;
-                    break;
+                    if (evt.type == EventType::Quit)
+                    {
+                        state = State::Uninitialized;
+                        break;
+                    }
                 }
             }
 
             Tick();
+            frameStats.EndFrame();
         }
     }
 
     void Application::Tick()
     {
+        ALIMER_PROFILE_FRAME();
+        ALIMER_PROFILE_SCOPE("Application::Tick");
+
         auto graphics = GetSubsystem<Graphics>();
-        auto& commandBuffer = graphics->BeginCommandBuffer();
-        commandBuffer.PresentBegin();
-        OnDraw(commandBuffer);
-        commandBuffer.PresentEnd();
+        CommandBuffer* commandBuffer;
+        {
+            FrameStats::PhaseScope phase(frameStats, FramePhase::BeginCommandBuffer);
+            commandBuffer = &graphics->BeginCommandBuffer();
+            commandBuffer->PresentBegin();
+        }
+        {
+            ALIMER_PROFILE_SCOPE("Application::OnDraw");
+            FrameStats::PhaseScope phase(frameStats, FramePhase::Draw);
+            OnDraw(*commandBuffer);
+        }
+        {
+            ALIMER_PROFILE_SCOPE("Present");
+            FrameStats::PhaseScope phase(frameStats, FramePhase::Present);
+            commandBuffer->PresentEnd();
+        }
     }
 
     const Config* Application::GetConfig()
@@ -24,6 +24,7 @@
 
 #include "Assets/AssetManager.h"
 #include "Core/Containers.h"
+#include "Core/FrameStats.h"
 #include "Graphics/Types.h"
 #include "Platform/Window.h"
 #include <memory>
@@ -96,6 +97,17 @@ namespace alimer
             return assets;
         }
 
+        /// Get the frame time statistics gathered by Run.
+        FrameStats& GetFrameStats()
+        {
+            return frameStats;
+        }
+
+        const FrameStats& GetFrameStats() const
+        {
+            return frameStats;
+        }
+
     protected:
         virtual void Initialize() {}
         virtual void OnDraw(CommandBuffer& commandBuffer) {}
@@ -109,6 +121,7 @@ namespace alimer
     protected:
         State state;
         AssetManager assets;
+        FrameStats frameStats;
         bool headless = false;
         std::unique_ptr<Window> window{nullptr};
         RefPtr<Graphics> graphics;
@@ -84,7 +84,7 @@ int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR lpCmdLin
     }
     catch (const std::exception& e)
     {
-        LOGE(e.what());
+        LOGE("{}", e.what());
         return EXIT_FAILURE;
     }
 #    endif
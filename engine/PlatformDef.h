@@ -225,16 +225,19 @@ Architecture defines, see http://sourceforge.net/apps/mediawiki/predef/index.php
 #        define ALIMER_AVX2_INTRINSICS 1
 #    endif
 
-#    if ALIMER_AVX2_INTRINSICS
-#        undef ALIMER_FMA3_INTRINSICS 0
-#        define ALIMER_FMA3_INTRINSICS
-#    endif
-
-#    if ALIMER_AVX2_INTRINSICS_
+// MSVC has no separate FMA3 and F16C switches, /arch:AVX2 enables both. GCC and Clang need -mfma and -mf16c.
+#    if ALIMER_AVX2_INTRINSICS && defined(_MSC_VER)
+#        undef ALIMER_FMA3_INTRINSICS
+#        define ALIMER_FMA3_INTRINSICS 1
 #        undef ALIMER_F16C_INTRINSICS
 #        define ALIMER_F16C_INTRINSICS 1
 #    endif
 
+#    if !ALIMER_FMA3_INTRINSICS && defined(__FMA__)
+#        undef ALIMER_FMA3_INTRINSICS
+#        define ALIMER_FMA3_INTRINSICS 1
+#    endif
+
 #    if !ALIMER_F16C_INTRINSICS && defined(__F16C__)
 #        undef ALIMER_F16C_INTRINSICS
 #        define ALIMER_F16C_INTRINSICS 1
@@ -286,11 +289,11 @@ Architecture defines, see http://sourceforge.net/apps/mediawiki/predef/index.php
 #if defined(__clang__)
 #    define ALIMER_RESTRICT __restrict
 #    define ALIMER_THREADLOCAL _Thread_local
-#    define ALIMER_DEPRECATED __attribute__(deprecated)
-#    define ALIMER_FORCE_INLINE inline __attribute__(always_inline)
-#    define ALIMER_NOINLINE __attribute__(noinline)
-#    define ALIMER_PURECALL __attribute__(pure)
-#    define ALIMER_CONSTCALL __attribute__(const)
+#    define ALIMER_DEPRECATED __attribute__((deprecated))
+#    define ALIMER_FORCE_INLINE inline __attribute__((always_inline))
+#    define ALIMER_NOINLINE __attribute__((noinline))
+#    define ALIMER_PURECALL __attribute__((pure))
+#    define ALIMER_CONSTCALL __attribute__((const))
 #    define ALIMER_LIKELY(x) __builtin_expect(!!(x), 1)
 #    define ALIMER_UNLIKELY(x) __builtin_expect(!!(x), 0)
 #    define ALIMER_UNREACHABLE() __builtin_unreachable()
@@ -298,11 +301,11 @@ Architecture defines, see http://sourceforge.net/apps/mediawiki/predef/index.php
 #elif defined(__GNUC__)
 #    define ALIMER_RESTRICT __restrict
 #    define ALIMER_THREADLOCAL __thread
-#    define ALIMER_DEPRECATED __attribute__(deprecated)
-#    define ALIMER_FORCE_INLINE inline __attribute__(always_inline)
-#    define ALIMER_NOINLINE __attribute__(noinline)
-#    define ALIMER_PURECALL __attribute__(pure)
-#    define ALIMER_CONSTCALL __attribute__(const)
+#    define ALIMER_DEPRECATED __attribute__((deprecated))
+#    define ALIMER_FORCE_INLINE inline __attribute__((always_inline))
+#    define ALIMER_NOINLINE __attribute__((noinline))
+#    define ALIMER_PURECALL __attribute__((pure))
+#    define ALIMER_CONSTCALL __attribute__((const))
 #    define ALIMER_LIKELY(x) __builtin_expect(!!(x), 1)
 #    define ALIMER_UNLIKELY(x) __builtin_expect(!!(x), 0)
 #    define ALIMER_UNREACHABLE() __builtin_unreachable()
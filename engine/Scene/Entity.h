@@ -32,7 +32,7 @@ namespace alimer
 
     class ALIMER_API Entity final : public Object
     {
-        ALIMER_OBJECT(Entity, Object);
+        ALIMER_POOLED_OBJECT(Entity, Object);
 
         friend class EntityManager;
 
@@ -22,8 +22,8 @@
 
 #pragma once
 
+#include "Core/HashMap.h"
 #include "Scene/Entity.h"
-#include <unordered_set>
 
 namespace alimer
 {
@@ -40,6 +40,6 @@ namespace alimer
         void Add(Entity* entity);
         void Remove(Entity* entity);
 
-        std::unordered_set<Entity*> entities;
+        HashSet<Entity*> entities;
     };
 }
@@ -0,0 +1,324 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Test.h"
+#include "Core/HashMap.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace alimer;
+
+namespace
+{
+    /// Every key lands in the same home slot with the same tag, so lookups rely on the probe sequence and key compare.
+    struct CollidingHash
+    {
+        size_t operator()(uint64_t) const { return 42; }
+    };
+
+    /// Identity hash, the home slot is then computed the same way as in the table to place keys on purpose.
+    struct IdentityHash
+    {
+        size_t operator()(uint64_t key) const { return static_cast<size_t>(key); }
+    };
+
+    /// Counts live instances to catch entries leaked or destroyed twice by backward shifts and rehashes.
+    struct TrackedValue
+    {
+        static int liveCount;
+
+        TrackedValue(uint64_t value_ = 0)
+            : value(value_)
+        {
+            liveCount++;
+        }
+        TrackedValue(const TrackedValue& rhs)
+            : value(rhs.value)
+        {
+            liveCount++;
+        }
+        TrackedValue(TrackedValue&& rhs) noexcept
+            : value(rhs.value)
+        {
+            liveCount++;
+        }
+        ~TrackedValue() { liveCount--; }
+        TrackedValue& operator=(const TrackedValue& rhs) = default;
+        TrackedValue& operator=(TrackedValue&& rhs) noexcept = default;
+
+        uint64_t value;
+    };
+
+    int TrackedValue::liveCount = 0;
+
+    size_t GetHomeSlot(uint64_t key, size_t bucketCount)
+    {
+        size_t bits = 0;
+        while ((size_t(1) << bits) < bucketCount)
+        {
+            bits++;
+        }
+        return static_cast<size_t>(details::MixHash(key) >> (64 - bits));
+    }
+
+    template <typename Map> void CheckMatches(const Map& map, const std::unordered_map<uint64_t, uint64_t>& reference)
+    {
+        ALIMER_CHECK_MSG(map.size() == reference.size(), "size %zu, expected %zu", map.size(), reference.size());
+
+        size_t iterated = 0;
+        for (const auto& entry : map)
+        {
+            auto it = reference.find(entry.first);
+            ALIMER_CHECK_MSG(it != reference.end() && it->second == entry.second.value, "unexpected entry %llu",
+                             static_cast<unsigned long long>(entry.first));
+            iterated++;
+        }
+        ALIMER_CHECK_MSG(iterated == reference.size(), "iterated %zu entries, expected %zu", iterated, reference.size());
+
+        for (const auto& entry : reference)
+        {
+            auto it = map.find(entry.first);
+            ALIMER_CHECK_MSG(it != map.end() && it->second.value == entry.second, "key %llu not found",
+                             static_cast<unsigned long long>(entry.first));
+        }
+    }
+
+    /// Random inserts and erases against std::unordered_map while the table grows through several capacities.
+    template <typename Hasher> void RunRandomOperations(uint32_t keyRange, uint32_t operationCount)
+    {
+        const int liveBefore = TrackedValue::liveCount;
+        {
+            HashMap<uint64_t, TrackedValue, Hasher> map;
+            std::unordered_map<uint64_t, uint64_t> reference;
+            std::mt19937 random(1234);
+
+            for (uint32_t i = 0; i < operationCount; ++i)
+            {
+                const uint64_t key = random() % keyRange;
+                // Inserting twice as often as erasing makes the table grow over the run.
+                if (random() % 3 != 0)
+                {
+                    const bool inserted = map.try_emplace(key, i).second;
+                    const bool expected = reference.emplace(key, i).second;
+                    ALIMER_CHECK_MSG(inserted == expected, "insert of %llu returned %d", static_cast<unsigned long long>(key), inserted);
+                }
+                else
+                {
+                    const size_t erased = map.erase(key);
+                    const size_t expected = reference.erase(key);
+                    ALIMER_CHECK_MSG(erased == expected, "erase of %llu returned %zu", static_cast<unsigned long long>(key), erased);
+                }
+
+                const bool present = map.contains(key);
+                ALIMER_CHECK_MSG(present == (reference.count(key) != 0), "contains(%llu) is %d after operation %u",
+                                 static_cast<unsigned long long>(key), present, i);
+            }
+
+            CheckMatches(map, reference);
+            ALIMER_CHECK(static_cast<size_t>(TrackedValue::liveCount - liveBefore) == map.size());
+
+            map.clear();
+            ALIMER_CHECK(map.empty() && map.begin() == map.end());
+        }
+
+        ALIMER_CHECK_MSG(TrackedValue::liveCount == liveBefore, "%d values leaked", TrackedValue::liveCount - liveBefore);
+    }
+
+    void HashMapInsertFindEraseAcrossResize()
+    {
+        HashMap<uint64_t, TrackedValue, IdentityHash> map;
+        size_t bucketCount = map.bucket_count();
+        uint32_t resizes = 0;
+        for (uint64_t key = 0; key < 5000; ++key)
+        {
+            map[key * 7919] = TrackedValue(key);
+            if (map.bucket_count() != bucketCount)
+            {
+                bucketCount = map.bucket_count();
+                resizes++;
+
+                // Every key inserted so far must survive the rehash.
+                for (uint64_t check = 0; check <= key; ++check)
+                {
+                    const TrackedValue* value = map.TryGet(check * 7919);
+                    ALIMER_CHECK_MSG(value != nullptr && value->value == check, "key %llu lost growing to %zu buckets",
+                                     static_cast<unsigned long long>(check), bucketCount);
+                }
+            }
+        }
+        ALIMER_CHECK_MSG(resizes >= 8, "only %u resizes", resizes);
+
+        // Erase every other key, the rest must still be found and the erased ones not.
+        for (uint64_t key = 0; key < 5000; key += 2)
+        {
+            ALIMER_CHECK(map.erase(key * 7919) == 1);
+        }
+        ALIMER_CHECK(map.size() == 2500);
+        for (uint64_t key = 0; key < 5000; ++key)
+        {
+            const TrackedValue* value = map.TryGet(key * 7919);
+            ALIMER_CHECK_MSG((value != nullptr) == (key % 2 != 0), "key %llu found %d after erasing even keys",
+                             static_cast<unsigned long long>(key), value != nullptr);
+        }
+
+        RunRandomOperations<HashType<uint64_t>>(4096, 200000);
+        RunRandomOperations<IdentityHash>(100000, 200000);
+    }
+
+    void HashMapEraseAtTableEnd()
+    {
+        // Keys homed in the last slot spill into the extra slots past the home range, where probes end instead of
+        // wrapping. Erasing them shifts the tail back across that boundary.
+        HashMap<uint64_t, TrackedValue, IdentityHash> map;
+        map.reserve(100);
+        const size_t bucketCount = map.bucket_count();
+
+        std::vector<uint64_t> lastSlotKeys;
+        std::vector<uint64_t> neighbourKeys;
+        for (uint64_t key = 1; lastSlotKeys.size() < 12 || neighbourKeys.size() < 4; ++key)
+        {
+            const size_t home = GetHomeSlot(key, bucketCount);
+            if (home == bucketCount - 1 && lastSlotKeys.size() < 12)
+                lastSlotKeys.push_back(key);
+            else if (home == bucketCount - 2 && neighbourKeys.size() < 4)
+                neighbourKeys.push_back(key);
+        }
+
+        std::unordered_map<uint64_t, uint64_t> reference;
+        for (uint64_t key : neighbourKeys)
+        {
+            map.try_emplace(key, key);
+            reference.emplace(key, key);
+        }
+        for (uint64_t key : lastSlotKeys)
+        {
+            map.try_emplace(key, key);
+            reference.emplace(key, key);
+        }
+        ALIMER_CHECK(map.bucket_count() == bucketCount);
+        CheckMatches(map, reference);
+
+        // Erase from the front of the spilled cluster, one key at a time, checking everything after each shift.
+        for (size_t i = 0; i < lastSlotKeys.size(); i += 2)
+        {
+            ALIMER_CHECK(map.erase(lastSlotKeys[i]) == 1);
+            reference.erase(lastSlotKeys[i]);
+            CheckMatches(map, reference);
+        }
+
+        // Erasing through iterators while walking the table must visit every remaining entry exactly once.
+        size_t visited = 0;
+        for (auto it = map.begin(); it != map.end();)
+        {
+            visited++;
+            if (it->first % 2 == 0)
+            {
+                reference.erase(it->first);
+                it = map.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        ALIMER_CHECK_MSG(visited == neighbourKeys.size() + lastSlotKeys.size() / 2, "visited %zu entries", visited);
+        CheckMatches(map, reference);
+    }
+
+    void HashMapLongProbeSequence()
+    {
+        // 40 colliding keys make a probe sequence spanning three 16 slot groups.
+        HashMap<uint64_t, TrackedValue, CollidingHash> map;
+        std::unordered_map<uint64_t, uint64_t> reference;
+        for (uint64_t key = 0; key < 40; ++key)
+        {
+            map.try_emplace(key, key + 1000);
+            reference.emplace(key, key + 1000);
+        }
+        CheckMatches(map, reference);
+
+        // Absent keys with the same hash walk the whole sequence before giving up.
+        for (uint64_t key = 40; key < 60; ++key)
+        {
+            ALIMER_CHECK(map.find(key) == map.end());
+        }
+
+        // Erase entries from the first and second group, later entries shift back across group boundaries.
+        for (uint64_t key : {0ull, 5ull, 15ull, 16ull, 17ull, 31ull, 39ull})
+        {
+            ALIMER_CHECK(map.erase(key) == 1);
+            reference.erase(key);
+            CheckMatches(map, reference);
+        }
+
+        RunRandomOperations<CollidingHash>(48, 5000);
+    }
+
+    void HashMapReuseKeyAfterErase()
+    {
+        HashMap<std::string, TrackedValue> map;
+        for (uint32_t i = 0; i < 50; ++i)
+        {
+            map.try_emplace("other" + std::to_string(i), i);
+        }
+
+        for (uint32_t round = 0; round < 100; ++round)
+        {
+            const std::string key = "key" + std::to_string(round % 10);
+            ALIMER_CHECK(map.try_emplace(key, round).second);
+            ALIMER_CHECK(!map.try_emplace(key, round + 1000).second);
+            ALIMER_CHECK(map.TryGet(key) != nullptr && map.TryGet(key)->value == round);
+
+            ALIMER_CHECK(map.erase(key) == 1);
+            ALIMER_CHECK(map.erase(key) == 0);
+            ALIMER_CHECK(!map.contains(key) && map.TryGet(key) == nullptr);
+
+            // Reinserted keys take the new value, not a stale one left in the slot.
+            map[key] = TrackedValue(round + 2000);
+            ALIMER_CHECK(map.TryGet(key)->value == round + 2000);
+            ALIMER_CHECK(map.erase(key) == 1);
+        }
+        ALIMER_CHECK(map.size() == 50);
+
+        HashMap<uint64_t, TrackedValue, CollidingHash> colliding;
+        for (uint64_t key = 0; key < 20; ++key)
+        {
+            colliding.try_emplace(key, key);
+        }
+        for (uint32_t round = 0; round < 200; ++round)
+        {
+            const uint64_t key = (round * 7) % 20;
+            ALIMER_CHECK(colliding.erase(key) == 1);
+            ALIMER_CHECK(colliding.find(key) == colliding.end());
+            ALIMER_CHECK(colliding.try_emplace(key, round).second);
+            ALIMER_CHECK(colliding.TryGet(key)->value == round);
+        }
+        ALIMER_CHECK(colliding.size() == 20);
+    }
+}
+
+ALIMER_TEST(HashMapInsertFindEraseAcrossResize);
+ALIMER_TEST(HashMapEraseAtTableEnd);
+ALIMER_TEST(HashMapLongProbeSequence);
+ALIMER_TEST(HashMapReuseKeyAfterErase);
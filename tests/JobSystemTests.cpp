@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Test.h"
+#include "AlimerConfig.h"
+#include "Core/JobSystem.h"
+#include <memory>
+#include <string>
+
+using namespace alimer;
+
+namespace
+{
+    constexpr uint32 kThreadCount = 4;
+
+    /// Run every index range through ParallelFor and require exactly one call per index, none outside the range.
+    void CheckParallelForCoverage()
+    {
+        for (uint32 count : {0u, 1u, 3u, 15u, 16u, 17u, 1000u, 65537u})
+        {
+            for (uint32 grainSize : {0u, 1u, 16u, 64u, 1024u})
+            {
+                constexpr uint32 begin = 7;
+                std::unique_ptr<std::atomic<uint32>[]> hits(new std::atomic<uint32>[count + 2 * begin]);
+                for (uint32 i = 0; i < count + 2 * begin; ++i)
+                {
+                    hits[i].store(0, std::memory_order_relaxed);
+                }
+
+                ParallelFor(begin, begin + count, grainSize, [&hits](uint32 index) { hits[index].fetch_add(1, std::memory_order_relaxed); });
+
+                for (uint32 i = 0; i < count + 2 * begin; ++i)
+                {
+                    const uint32 expected = i >= begin && i < begin + count ? 1 : 0;
+                    ALIMER_CHECK_MSG(hits[i].load() == expected, "index %u of [%u, %u) grain %u ran %u times", i, begin, begin + count,
+                                     grainSize, hits[i].load());
+                }
+            }
+        }
+    }
+
+    void JobSystemParallelForCoversEachIndex()
+    {
+        // Without Initialize the groups run inline on the calling thread.
+        CheckParallelForCoverage();
+
+        JobSystem::Initialize(kThreadCount);
+        CheckParallelForCoverage();
+        JobSystem::Shutdown();
+    }
+
+    void JobSystemParallelReduceMatchesSerial()
+    {
+        JobSystem::Initialize(kThreadCount);
+
+        auto map = [](uint32 index) { return static_cast<uint64>(index) * index % 1000003u; };
+        auto add = [](uint64 a, uint64 b) { return a + b; };
+        for (uint32 count : {1u, 5u, 64u, 1000u, 100000u})
+        {
+            uint64 serial = 0;
+            for (uint32 index = 3; index < 3 + count; ++index)
+            {
+                serial += map(index);
+            }
+
+            for (uint32 grainSize : {1u, 7u, 64u, 4096u})
+            {
+                const uint64 parallel = ParallelReduce<uint64>(3, 3 + count, grainSize, uint64(0), map, add);
+                ALIMER_CHECK_MSG(parallel == serial, "sum of %u values with grain %u is %llu, expected %llu", count, grainSize,
+                                 static_cast<unsigned long long>(parallel), static_cast<unsigned long long>(serial));
+            }
+        }
+
+        // Concatenation is associative but not commutative, so it also checks that partials are combined in order.
+        std::string serial;
+        for (uint32 index = 0; index < 300; ++index)
+        {
+            serial += std::to_string(index) + ",";
+        }
+        const std::string parallel = ParallelReduce<std::string>(
+            0, 300, 16, std::string(), [](uint32 index) { return std::to_string(index) + ","; },
+            [](const std::string& a, const std::string& b) { return a + b; });
+        ALIMER_CHECK(parallel == serial);
+        ALIMER_CHECK(ParallelReduce<uint64>(10, 10, 4, uint64(42), map, add) == 42);
+
+        JobSystem::Shutdown();
+    }
+
+    void JobSystemNestedWaits()
+    {
+        JobSystem::Initialize(kThreadCount);
+
+        // Every outer job dispatches inner jobs and waits for them on its worker, which runs pending jobs meanwhile.
+        constexpr uint32 kOuterJobs = 32;
+        constexpr uint32 kInnerJobs = 16;
+        std::atomic<uint32> innerRuns{0};
+        std::atomic<uint32> outerDone{0};
+        JobCounter outer;
+        JobSystem::Dispatch(outer, kOuterJobs, 1, [&](JobArgs) {
+            JobCounter inner;
+            JobSystem::Dispatch(inner, kInnerJobs, 3, [&](JobArgs) { innerRuns.fetch_add(1, std::memory_order_relaxed); });
+            JobSystem::Wait(inner);
+            ALIMER_CHECK(!JobSystem::IsBusy(inner));
+            outerDone.fetch_add(1, std::memory_order_relaxed);
+        });
+        JobSystem::Wait(outer);
+
+        ALIMER_CHECK_MSG(innerRuns.load() == kOuterJobs * kInnerJobs, "%u inner jobs ran", innerRuns.load());
+        ALIMER_CHECK_MSG(outerDone.load() == kOuterJobs, "%u outer jobs finished", outerDone.load());
+
+        // Three levels of single jobs, each waiting for its child, on a counter reused after it reached zero.
+        std::atomic<uint32> depth{0};
+        for (uint32 repeat = 0; repeat < 2; ++repeat)
+        {
+            JobSystem::Execute(outer, [&](JobArgs) {
+                JobCounter second;
+                JobSystem::Execute(second, [&](JobArgs) {
+                    JobCounter third;
+                    JobSystem::Execute(third, [&](JobArgs) { depth.fetch_add(1, std::memory_order_relaxed); });
+                    JobSystem::Wait(third);
+                    depth.fetch_add(1, std::memory_order_relaxed);
+                });
+                JobSystem::Wait(second);
+                depth.fetch_add(1, std::memory_order_relaxed);
+            });
+            JobSystem::Wait(outer);
+        }
+        ALIMER_CHECK_MSG(depth.load() == 6, "nested jobs ran %u times", depth.load());
+
+        JobSystem::Shutdown();
+    }
+
+    void JobSystemDispatchAllocatesOnce()
+    {
+        JobSystem::Initialize(kThreadCount);
+
+        auto CountAllocations = [] {
+            return MemoryStats::Get(MemoryTag::General).totalCount + MemoryStats::Get(MemoryTag::Small).totalCount;
+        };
+
+        // The dispatch data and the jobs of all its groups share one block. Without threading the groups run inline.
+#if defined(ALIMER_THREADING)
+        constexpr uint64_t kExpectedAllocations = 1;
+#else
+        constexpr uint64_t kExpectedAllocations = 0;
+#endif
+        for (uint32 groupCount : {1u, 4u, 64u})
+        {
+            std::atomic<uint32> runs{0};
+            JobCounter counter;
+            const uint64_t before = CountAllocations();
+            JobSystem::Dispatch(counter, groupCount * 2, 2, [&runs](JobArgs) { runs.fetch_add(1, std::memory_order_relaxed); });
+            const uint64_t allocations = CountAllocations() - before;
+            JobSystem::Wait(counter);
+
+            ALIMER_CHECK_MSG(allocations == kExpectedAllocations, "dispatch of %u groups made %llu allocations", groupCount,
+                             static_cast<unsigned long long>(allocations));
+            ALIMER_CHECK(runs.load() == groupCount * 2);
+        }
+
+        JobSystem::Shutdown();
+    }
+}
+
+ALIMER_TEST(JobSystemParallelForCoversEachIndex);
+ALIMER_TEST(JobSystemParallelReduceMatchesSerial);
+ALIMER_TEST(JobSystemNestedWaits);
+ALIMER_TEST(JobSystemDispatchAllocatesOnce);
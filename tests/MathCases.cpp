@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "MathCases.h"
+#include "Math/Matrix4x4.h"
+#include <cstring>
+
+namespace alimer
+{
+    namespace
+    {
+        constexpr uint32_t kCaseCount = 64;
+
+        /// Deterministic inputs, the same sequence on every platform and with any float flags.
+        class Inputs
+        {
+        public:
+            /// Uniform in [low, high). The fraction has 16 bits and the ranges used here in 8 or fewer, so the product is
+            /// exact and contracting it with the addition makes no difference.
+            float Next(float low, float high)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                return low + (high - low) * (static_cast<float>(seed >> 16) / 65536.0f);
+            }
+
+            Float3 NextFloat3(float low, float high) { return Float3(Next(low, high), Next(low, high), Next(low, high)); }
+            Float4 NextFloat4(float low, float high) { return Float4(Next(low, high), Next(low, high), Next(low, high), Next(low, high)); }
+
+            Quaternion NextRotation()
+            {
+                const Float3 axis = Float3::Normalize(NextFloat3(-1.0f, 1.0f) + Float3(0.0f, 0.0f, 0.01f));
+                return Quaternion::CreateFromAxisAngle(axis, Next(-3.0f, 3.0f));
+            }
+
+            Matrix4x4 NextMatrix()
+            {
+                Matrix4x4 result;
+                for (uint32_t row = 0; row < 4; ++row)
+                {
+                    for (uint32_t column = 0; column < 4; ++column)
+                        result.m[row][column] = Next(-4.0f, 4.0f);
+                }
+                return result;
+            }
+
+            /// Scale, rotation and translation, the matrices Decompose is meant for.
+            Matrix4x4 NextTransform()
+            {
+                Matrix4x4 scale, rotation, translation;
+                Matrix4x4::CreateScale(NextFloat3(0.25f, 4.0f), &scale);
+                Matrix4x4::CreateFromQuaternion(NextRotation(), &rotation);
+                Matrix4x4::CreateTranslation(NextFloat3(-100.0f, 100.0f), &translation);
+                return scale * rotation * translation;
+            }
+
+        private:
+            uint32_t seed = 1;
+        };
+
+        class Recorder
+        {
+        public:
+            explicit Recorder(std::vector<MathCaseResult>& results_)
+                : results(results_)
+            {
+            }
+
+            void Begin(const char* name, uint32_t index)
+            {
+                results.push_back({std::string(name) + "/" + std::to_string(index), {}});
+            }
+
+            void Add(const float* values, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    uint32_t bits;
+                    memcpy(&bits, &values[i], sizeof(bits));
+                    results.back().bits.push_back(bits);
+                }
+            }
+
+            void Add(float value) { Add(&value, 1); }
+            void Add(bool value) { results.back().bits.push_back(value ? 1u : 0u); }
+            void Add(const Float3& value) { Add(&value.x, 3); }
+            void Add(const Float4& value) { Add(&value.x, 4); }
+            void Add(const Quaternion& value) { Add(&value.x, 4); }
+            void Add(const Matrix4x4& value) { Add(&value.m[0][0], 16); }
+
+            template <typename... Values> void Record(const char* name, uint32_t index, const Values&... values)
+            {
+                Begin(name, index);
+                int expand[] = {(Add(values), 0)...};
+                (void)expand;
+            }
+
+        private:
+            std::vector<MathCaseResult>& results;
+        };
+    }
+
+    std::vector<MathCaseResult> RunMathCases()
+    {
+        std::vector<MathCaseResult> results;
+        Recorder recorder(results);
+        Inputs inputs;
+
+        for (uint32_t i = 0; i < kCaseCount; ++i)
+        {
+            const Float3 a = inputs.NextFloat3(-10.0f, 10.0f);
+            const Float3 b = inputs.NextFloat3(-10.0f, 10.0f);
+            const Float4 c = inputs.NextFloat4(-10.0f, 10.0f);
+            const Float4 d = inputs.NextFloat4(-10.0f, 10.0f);
+            const float t = inputs.Next(0.0f, 1.0f);
+
+            recorder.Record("Float3::Dot", i, Float3::Dot(a, b));
+            recorder.Record("Float3::Cross", i, Float3::Cross(a, b));
+            recorder.Record("Float3::Length", i, a.Length());
+            recorder.Record("Float3::Distance", i, Float3::Distance(a, b));
+            recorder.Record("Float3::Normalize", i, Float3::Normalize(a));
+            recorder.Record("Float3::Lerp", i, Float3::Lerp(a, b, t));
+            recorder.Record("Float4::Dot", i, Float4::Dot(c, d));
+            recorder.Record("Float4::Length", i, c.Length());
+            recorder.Record("Float4::Normalize", i, Float4::Normalize(c));
+            recorder.Record("Float4::Lerp", i, Float4::Lerp(c, d, t));
+        }
+
+        for (uint32_t i = 0; i < kCaseCount; ++i)
+        {
+            const Matrix4x4 general = inputs.NextMatrix();
+            const Matrix4x4 other = inputs.NextMatrix();
+            const Matrix4x4 transform = inputs.NextTransform();
+            const Float3 point = inputs.NextFloat3(-10.0f, 10.0f);
+            const Float4 vector = inputs.NextFloat4(-10.0f, 10.0f);
+
+            Matrix4x4 result;
+            Matrix4x4::Multiply(general, other, &result);
+            recorder.Record("Matrix4x4::Multiply", i, result);
+            Matrix4x4::Transpose(general, &result);
+            recorder.Record("Matrix4x4::Transpose", i, result);
+            const bool inverted = Matrix4x4::Invert(general, &result);
+            recorder.Record("Matrix4x4::Invert", i, inverted, result);
+            const bool transformInverted = Matrix4x4::Invert(transform, &result);
+            recorder.Record("Matrix4x4::InvertTransform", i, transformInverted, result);
+            recorder.Record("Matrix4x4::Determinant", i, general.Determinant());
+
+            Float3 scale, translation;
+            Quaternion rotation;
+            const bool decomposed = transform.Decompose(&scale, &rotation, &translation);
+            recorder.Record("Matrix4x4::Decompose", i, decomposed, scale, rotation, translation);
+
+            recorder.Record("Matrix4x4::Transform", i, Matrix4x4::Transform(vector, general));
+            recorder.Record("Matrix4x4::TransformPoint", i, Matrix4x4::TransformPoint(point, transform));
+            recorder.Record("Matrix4x4::TransformNormal", i, Matrix4x4::TransformNormal(point, transform));
+        }
+
+        for (uint32_t i = 0; i < kCaseCount; ++i)
+        {
+            const Float3 position = inputs.NextFloat3(-100.0f, 100.0f);
+            const Float3 target = inputs.NextFloat3(-100.0f, 100.0f);
+            const float angle = inputs.Next(-7.0f, 7.0f);
+            const float width = inputs.Next(1.0f, 100.0f);
+            const float height = inputs.Next(1.0f, 100.0f);
+            const float zNear = inputs.Next(0.0625f, 1.0f);
+            const float zFar = inputs.Next(8.0f, 1000.0f);
+
+            Matrix4x4 result;
+            Matrix4x4::CreateTranslation(position, &result);
+            recorder.Record("Matrix4x4::CreateTranslation", i, result);
+            Matrix4x4::CreateScale(target, &result);
+            recorder.Record("Matrix4x4::CreateScale", i, result);
+            Matrix4x4::CreateRotationX(angle, &result);
+            recorder.Record("Matrix4x4::CreateRotationX", i, result);
+            Matrix4x4::CreateRotationY(angle, &result);
+            recorder.Record("Matrix4x4::CreateRotationY", i, result);
+            Matrix4x4::CreateRotationZ(angle, &result);
+            recorder.Record("Matrix4x4::CreateRotationZ", i, result);
+            Matrix4x4::CreateFromQuaternion(inputs.NextRotation(), &result);
+            recorder.Record("Matrix4x4::CreateFromQuaternion", i, result);
+            Matrix4x4::CreateLookAt(position, target, Float3(0.0f, 1.0f, 0.0f), &result);
+            recorder.Record("Matrix4x4::CreateLookAt", i, result);
+            Matrix4x4::CreatePerspectiveFieldOfView(inputs.Next(0.125f, 3.0f), width / height, zNear, zFar, &result);
+            recorder.Record("Matrix4x4::CreatePerspectiveFieldOfView", i, result);
+            Matrix4x4::CreateOrthographic(width, height, zNear, zFar, &result);
+            recorder.Record("Matrix4x4::CreateOrthographic", i, result);
+            Matrix4x4::CreateOrthographicOffCenter(-width, height, -height, width, zNear, zFar, &result);
+            recorder.Record("Matrix4x4::CreateOrthographicOffCenter", i, result);
+        }
+
+        for (uint32_t i = 0; i < kCaseCount; ++i)
+        {
+            const Quaternion a = inputs.NextRotation();
+            const Quaternion b = inputs.NextRotation();
+            const Quaternion general(inputs.Next(-2.0f, 2.0f), inputs.Next(-2.0f, 2.0f), inputs.Next(-2.0f, 2.0f), inputs.Next(-2.0f, 2.0f));
+            const Float3 vector = inputs.NextFloat3(-10.0f, 10.0f);
+            const Float3 angles = inputs.NextFloat3(-7.0f, 7.0f);
+            const float t = inputs.Next(0.0f, 1.0f);
+
+            recorder.Record("Quaternion::Multiply", i, a * b);
+            recorder.Record("Quaternion::Rotate", i, a.Rotate(vector));
+            recorder.Record("Quaternion::Length", i, general.Length());
+            recorder.Record("Quaternion::Dot", i, Quaternion::Dot(a, general));
+            recorder.Record("Quaternion::Normalize", i, Quaternion::Normalize(general));
+            recorder.Record("Quaternion::Conjugate", i, Quaternion::Conjugate(general));
+            recorder.Record("Quaternion::Inverse", i, Quaternion::Inverse(general));
+            recorder.Record("Quaternion::Lerp", i, Quaternion::Lerp(a, b, t));
+            recorder.Record("Quaternion::Slerp", i, Quaternion::Slerp(a, b, t));
+            recorder.Record("Quaternion::CreateFromAxisAngle", i, Quaternion::CreateFromAxisAngle(Float3::Normalize(vector), angles.x));
+            recorder.Record("Quaternion::CreateFromYawPitchRoll", i, Quaternion::CreateFromYawPitchRoll(angles.x, angles.y, angles.z));
+
+            Matrix4x4 rotation;
+            Matrix4x4::CreateFromQuaternion(a, &rotation);
+            recorder.Record("Quaternion::CreateFromRotationMatrix", i, Quaternion::CreateFromRotationMatrix(rotation));
+        }
+
+        return results;
+    }
+}
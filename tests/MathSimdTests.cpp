@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Test.h"
+#include "MathCases.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+using namespace alimer;
+
+namespace
+{
+    /// Read the file written by alimer_math_reference.
+    bool ReadReference(const char* path, std::map<std::string, std::vector<uint32_t>>& reference)
+    {
+        FILE* file = fopen(path, "r");
+        if (file == nullptr)
+            return false;
+
+        char line[1024];
+        while (fgets(line, sizeof(line), file) != nullptr)
+        {
+            char* token = strtok(line, " \r\n");
+            if (token == nullptr)
+                continue;
+
+            std::vector<uint32_t>& bits = reference[token];
+            while ((token = strtok(nullptr, " \r\n")) != nullptr)
+                bits.push_back(static_cast<uint32_t>(strtoul(token, nullptr, 16)));
+        }
+
+        fclose(file);
+        return true;
+    }
+
+    float FromBits(uint32_t bits)
+    {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /// Largest difference between the floats of two results, relative to the largest magnitude in the reference.
+    double RelativeDifference(const std::vector<uint32_t>& result, const std::vector<uint32_t>& reference)
+    {
+        double scale = 0.0;
+        double difference = 0.0;
+        for (size_t i = 0; i < reference.size(); ++i)
+        {
+            scale = std::max(scale, std::fabs(static_cast<double>(FromBits(reference[i]))));
+            difference = std::max(difference, std::fabs(static_cast<double>(FromBits(result[i])) - static_cast<double>(FromBits(reference[i]))));
+        }
+        return scale != 0.0 ? difference / scale : difference;
+    }
+
+    /**
+     * Compare the configured SIMD backend against the ALIMER_SIMD_DISABLED build of the same cases. Matrix4x4.cpp and
+     * Quaternion.cpp are built with precise float semantics in every configuration, so all results must match bit for
+     * bit. The inline operations are compiled with the flags of this file, if those allow reassociation the cases that
+     * still match are listed and the others only have to be close.
+     */
+    void MathSimdMatchesScalar()
+    {
+        const char* path = GetTestOption("math-reference");
+        if (path == nullptr)
+        {
+            printf("    skipped, needs --math-reference=<file written by alimer_math_reference>\n");
+            return;
+        }
+
+        std::map<std::string, std::vector<uint32_t>> reference;
+        ALIMER_CHECK_MSG(ReadReference(path, reference), "failed to read '%s'", path);
+
+#if defined(__FAST_MATH__) || defined(_M_FP_FAST)
+        constexpr bool exact = false;
+#else
+        constexpr bool exact = true;
+#endif
+
+        // Operation name without the case index, and whether all its cases matched bit for bit.
+        std::map<std::string, bool> identical;
+        const std::vector<MathCaseResult> results = RunMathCases();
+        ALIMER_CHECK_MSG(results.size() == reference.size(), "%zu cases but %zu in the reference", results.size(), reference.size());
+        for (const MathCaseResult& result : results)
+        {
+            const auto expected = reference.find(result.name);
+            if (expected == reference.end() || expected->second.size() != result.bits.size())
+            {
+                ALIMER_CHECK_MSG(false, "%s is missing from the reference or has a different size", result.name.c_str());
+                continue;
+            }
+
+            const bool same = expected->second == result.bits;
+            const std::string operation = result.name.substr(0, result.name.find('/'));
+            identical.emplace(operation, true).first->second &= same;
+
+            if (exact)
+            {
+                ALIMER_CHECK_MSG(same, "%s differs from the scalar backend", result.name.c_str());
+            }
+            else
+            {
+                const double difference = RelativeDifference(result.bits, expected->second);
+                ALIMER_CHECK_MSG(difference <= 1e-4, "%s differs from the scalar backend by %.3g", result.name.c_str(), difference);
+            }
+        }
+
+        if (!exact)
+        {
+            for (const auto& operation : identical)
+                printf("    %-40s %s\n", operation.first.c_str(), operation.second ? "bit identical" : "close");
+        }
+    }
+}
+
+ALIMER_TEST(MathSimdMatchesScalar);
@@ -0,0 +1,218 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Test.h"
+#include "Assets/MipGenerator.h"
+#include "Core/JobSystem.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace alimer;
+
+namespace
+{
+    constexpr MipFilter kFilters[] = {MipFilter::Box, MipFilter::Kaiser, MipFilter::Lanczos};
+
+    const char* GetFilterName(MipFilter filter)
+    {
+        switch (filter)
+        {
+            case MipFilter::Box:
+                return "Box";
+            case MipFilter::Kaiser:
+                return "Kaiser";
+            default:
+                return "Lanczos";
+        }
+    }
+
+    /// Fraction of the texels of an 8 bit RGBA level whose alpha is above the reference.
+    double MeasureCoverage(const MipChain& chain, uint32_t level, float alphaReference)
+    {
+        const MipLevel& mip = chain.levels[level];
+        size_t covered = 0;
+        for (uint32_t y = 0; y < mip.height; ++y)
+        {
+            const uint8_t* row = chain.data.data() + mip.offset + static_cast<size_t>(y) * mip.rowPitch;
+            for (uint32_t x = 0; x < mip.width; ++x)
+            {
+                covered += row[x * 4 + 3] / 255.0f > alphaReference ? 1 : 0;
+            }
+        }
+        return static_cast<double>(covered) / (static_cast<double>(mip.width) * mip.height);
+    }
+
+    void MipGeneratorConstantImage()
+    {
+        // Filter weights must sum to one at every fractional footprint, including the clamped edges of odd sizes.
+        const uint32_t sizes[][2] = {{5, 3}, {3, 5}, {7, 1}, {1, 9}, {13, 11}};
+        for (MipFilter filter : kFilters)
+        {
+            MipGenerationOptions options;
+            options.filter = filter;
+
+            for (const auto& size : sizes)
+            {
+                const uint32_t width = size[0];
+                const uint32_t height = size[1];
+
+                const float color[4] = {0.25f, 0.5f, 0.75f, 1.0f};
+                std::vector<float> image(static_cast<size_t>(width) * height * 4);
+                for (size_t i = 0; i < image.size(); ++i)
+                {
+                    image[i] = color[i % 4];
+                }
+
+                MipChain chain;
+                ALIMER_CHECK(GenerateMipChain(PixelFormat::RGBA32Float, image.data(), 0, width, height, options, chain));
+                ALIMER_CHECK(chain.levels.size() == GetMipLevelCount(width, height));
+                ALIMER_CHECK(chain.levels.back().width == 1 && chain.levels.back().height == 1);
+                for (uint32_t level = 1; level < chain.levels.size(); ++level)
+                {
+                    const MipLevel& mip = chain.levels[level];
+                    const float* texels = reinterpret_cast<const float*>(chain.data.data() + mip.offset);
+                    float maxError = 0.0f;
+                    for (size_t i = 0; i < static_cast<size_t>(mip.width) * mip.height * 4; ++i)
+                    {
+                        maxError = std::max(maxError, std::fabs(texels[i] - color[i % 4]));
+                    }
+                    ALIMER_CHECK_MSG(maxError <= 1e-6f, "%s %ux%u level %u (%ux%u) is off by %g", GetFilterName(filter), width, height, level,
+                                     mip.width, mip.height, maxError);
+                }
+
+                // 8 bit formats must come back byte for byte, sRGB after a round trip through linear.
+                for (PixelFormat format : {PixelFormat::RGBA8Unorm, PixelFormat::RGBA8UnormSrgb})
+                {
+                    const uint8_t bytes[4] = {37, 128, 201, 255};
+                    std::vector<uint8_t> byteImage(static_cast<size_t>(width) * height * 4);
+                    for (size_t i = 0; i < byteImage.size(); ++i)
+                    {
+                        byteImage[i] = bytes[i % 4];
+                    }
+
+                    ALIMER_CHECK(GenerateMipChain(format, byteImage.data(), 0, width, height, options, chain));
+                    for (uint32_t level = 1; level < chain.levels.size(); ++level)
+                    {
+                        const MipLevel& mip = chain.levels[level];
+                        for (size_t i = 0; i < static_cast<size_t>(mip.width) * mip.height * 4; ++i)
+                        {
+                            const uint8_t value = chain.data[mip.offset + i];
+                            if (value != bytes[i % 4])
+                            {
+                                ALIMER_CHECK_MSG(false, "%s %s %ux%u level %u byte %zu is %u, expected %u", GetFilterName(filter),
+                                                 ToString(format).c_str(), width, height, level, i, value, bytes[i % 4]);
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void MipGeneratorSrgbBoxAverage()
+    {
+        // Black and white average to linear 0.5, which is sRGB 188. Filtering the stored values would give 128.
+        const uint8_t image[] = {0, 0, 0, 255, 255, 255, 255, 255};
+        MipGenerationOptions options;
+        options.filter = MipFilter::Box;
+
+        for (PixelFormat format : {PixelFormat::RGBA8UnormSrgb, PixelFormat::BGRA8UnormSrgb, PixelFormat::RGBA8Unorm})
+        {
+            MipChain chain;
+            ALIMER_CHECK(GenerateMipChain(format, image, 0, 2, 1, options, chain));
+            ALIMER_CHECK(chain.levels.size() == 2 && chain.levels[1].width == 1 && chain.levels[1].height == 1);
+            ALIMER_CHECK(memcmp(chain.data.data(), image, sizeof(image)) == 0);
+
+            const uint8_t expected = IsSrgbFormat(format) ? 188 : 128;
+            const uint8_t* texel = chain.data.data() + chain.levels[1].offset;
+            ALIMER_CHECK_MSG(texel[0] == expected && texel[1] == expected && texel[2] == expected && texel[3] == 255,
+                             "%s averages to %u %u %u %u, expected %u", ToString(format).c_str(), texel[0], texel[1], texel[2], texel[3],
+                             expected);
+        }
+    }
+
+    void MipGeneratorAlphaCoverage()
+    {
+        // Scattered opaque texels over a mostly transparent background, like foliage. Filtering averages them below the
+        // reference, so coverage drops quickly without scaling.
+        constexpr uint32_t kWidth = 128;
+        constexpr uint32_t kHeight = 96;
+        constexpr uint32_t kLevels = 4;
+        constexpr double kTolerance = 0.02;
+        std::mt19937 random(5);
+        std::vector<uint8_t> image(kWidth * kHeight * 4);
+        for (uint32_t y = 0; y < kHeight; ++y)
+        {
+            for (uint32_t x = 0; x < kWidth; ++x)
+            {
+                uint8_t* texel = &image[(y * kWidth + x) * 4];
+                texel[0] = 60;
+                texel[1] = 140;
+                texel[2] = 40;
+                texel[3] = random() % 4 == 0 ? 255 : static_cast<uint8_t>(random() % 64);
+            }
+        }
+
+        for (MipFilter filter : kFilters)
+        {
+            MipGenerationOptions options;
+            options.filter = filter;
+            options.mipLevels = kLevels;
+            options.alphaReference = 0.5f;
+
+            MipChain plain;
+            ALIMER_CHECK(GenerateMipChain(PixelFormat::RGBA8UnormSrgb, image.data(), 0, kWidth, kHeight, options, plain));
+
+            options.preserveAlphaCoverage = true;
+            MipChain preserved;
+            ALIMER_CHECK(GenerateMipChain(PixelFormat::RGBA8UnormSrgb, image.data(), 0, kWidth, kHeight, options, preserved));
+            ALIMER_CHECK(preserved.levels.size() == kLevels);
+
+            const double baseCoverage = MeasureCoverage(preserved, 0, options.alphaReference);
+            for (uint32_t level = 1; level < preserved.levels.size(); ++level)
+            {
+                const double coverage = MeasureCoverage(preserved, level, options.alphaReference);
+                ALIMER_CHECK_MSG(std::fabs(coverage - baseCoverage) <= kTolerance, "%s level %u coverage %.4f, level 0 has %.4f",
+                                 GetFilterName(filter), level, coverage, baseCoverage);
+            }
+
+            // Without the option the last level loses coverage, otherwise the check above proves nothing.
+            const double plainCoverage = MeasureCoverage(plain, kLevels - 1, options.alphaReference);
+            ALIMER_CHECK_MSG(baseCoverage - plainCoverage > 2 * kTolerance, "%s coverage without scaling %.4f, level 0 has %.4f",
+                             GetFilterName(filter), plainCoverage, baseCoverage);
+
+            // Splitting the rows and the coverage search across the job system must not change a single byte.
+            JobSystem::Initialize(4);
+            MipChain threaded;
+            ALIMER_CHECK(GenerateMipChain(PixelFormat::RGBA8UnormSrgb, image.data(), 0, kWidth, kHeight, options, threaded));
+            JobSystem::Shutdown();
+            ALIMER_CHECK_MSG(threaded.data == preserved.data, "%s differs when run on the job system", GetFilterName(filter));
+        }
+    }
+}
+
+ALIMER_TEST(MipGeneratorConstantImage);
+ALIMER_TEST(MipGeneratorSrgbBoxAverage);
+ALIMER_TEST(MipGeneratorAlphaCoverage);
@@ -0,0 +1,404 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Test.h"
+#include "Core/Containers.h"
+#include "Math/PackedVector.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace alimer;
+
+namespace
+{
+    float FromBits(uint32_t bits)
+    {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    uint32_t ToBits(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    /// Half to float from the definition of the format, with NaN made quiet.
+    float ReferenceHalfToFloat(uint16_t half)
+    {
+        const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+        const uint32_t exponent = (half >> 10) & 0x1Fu;
+        const uint32_t mantissa = half & 0x3FFu;
+        if (exponent == 0x1Fu)
+            return FromBits(sign | 0x7F800000u | (mantissa != 0 ? 0x00400000u | (mantissa << 13) : 0u));
+
+        const double magnitude = exponent == 0 ? std::ldexp(static_cast<double>(mantissa), -24)
+                                               : std::ldexp(1.0 + static_cast<double>(mantissa) / 1024.0, static_cast<int>(exponent) - 15);
+        return FromBits(sign | ToBits(static_cast<float>(magnitude)));
+    }
+
+    /// Float to half rounding the exact value to nearest even in double, see the rules in PackedVector.h.
+    uint16_t ReferenceFloatToHalf(float value)
+    {
+        const uint32_t bits = ToBits(value);
+        const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+        if (std::isnan(value))
+            return static_cast<uint16_t>(sign | 0x7E00u | ((bits >> 13) & 0x3FFu));
+
+        // The spacing of halves at this magnitude, the denormal spacing below the normal range.
+        const double magnitude = std::fabs(static_cast<double>(value));
+        int exponent = 0;
+        std::frexp(magnitude, &exponent);
+        const double quantum = std::ldexp(1.0, std::max(exponent - 11, -24));
+        const double rounded = std::nearbyint(magnitude / quantum) * quantum;
+        if (rounded >= 65536.0)
+            return static_cast<uint16_t>(sign | 0x7C00u);
+        if (rounded < std::ldexp(1.0, -14))
+            return static_cast<uint16_t>(sign | static_cast<uint16_t>(rounded / std::ldexp(1.0, -24)));
+
+        std::frexp(rounded, &exponent);
+        const uint32_t mantissa = static_cast<uint32_t>((std::ldexp(rounded, 1 - exponent) - 1.0) * 1024.0);
+        return static_cast<uint16_t>(sign | ((exponent + 14) << 10) | mantissa);
+    }
+
+    /// Expected half for a float that came from a half: the same bits, with NaN made quiet.
+    uint16_t QuietHalf(uint16_t half) { return (half & 0x7FFFu) > 0x7C00u ? static_cast<uint16_t>(half | 0x0200u) : half; }
+
+    void PackedVectorHalfToFloat()
+    {
+        Vector<uint16_t> halves(65536);
+        for (uint32_t i = 0; i < 65536; ++i)
+            halves[i] = static_cast<uint16_t>(i);
+
+        Vector<float> floats(halves.size());
+        PackedVector::HalfToFloat(halves.data(), floats.data(), halves.size());
+
+        Vector<uint16_t> roundTrip(halves.size());
+        PackedVector::FloatToHalf(floats.data(), roundTrip.data(), floats.size());
+
+        for (uint32_t i = 0; i < 65536; ++i)
+        {
+            const uint16_t half = halves[i];
+            const uint32_t expected = ToBits(ReferenceHalfToFloat(half));
+            ALIMER_CHECK_MSG(ToBits(PackedVector::HalfToFloat(half)) == expected, "HalfToFloat(0x%04x) is 0x%08x, expected 0x%08x", half,
+                             ToBits(PackedVector::HalfToFloat(half)), expected);
+            ALIMER_CHECK_MSG(ToBits(floats[i]) == expected, "bulk HalfToFloat(0x%04x) is 0x%08x, expected 0x%08x", half, ToBits(floats[i]),
+                             expected);
+            ALIMER_CHECK_MSG(PackedVector::FloatToHalf(floats[i]) == QuietHalf(half), "0x%04x does not round trip, gives 0x%04x", half,
+                             PackedVector::FloatToHalf(floats[i]));
+            ALIMER_CHECK_MSG(roundTrip[i] == QuietHalf(half), "0x%04x does not round trip in bulk, gives 0x%04x", half, roundTrip[i]);
+        }
+    }
+
+    /// Compare scalar and bulk FloatToHalf with the reference.
+    void CheckFloatToHalf(const float* inputs, size_t count)
+    {
+        constexpr size_t kBlockSize = 1 << 12;
+        uint16_t halves[kBlockSize];
+        for (size_t begin = 0; begin < count; begin += kBlockSize)
+        {
+            const size_t blockCount = std::min(kBlockSize, count - begin);
+            PackedVector::FloatToHalf(inputs + begin, halves, blockCount);
+            for (size_t i = 0; i < blockCount; ++i)
+            {
+                const float value = inputs[begin + i];
+                const uint16_t expected = ReferenceFloatToHalf(value);
+                const uint16_t scalar = PackedVector::FloatToHalf(value);
+                ALIMER_CHECK_MSG(scalar == expected, "FloatToHalf(%.9g, 0x%08x) is 0x%04x, expected 0x%04x", value, ToBits(value), scalar, expected);
+                ALIMER_CHECK_MSG(halves[i] == expected, "bulk FloatToHalf(%.9g, 0x%08x) is 0x%04x, expected 0x%04x", value, ToBits(value),
+                                 halves[i], expected);
+            }
+        }
+    }
+
+    void PackedVectorFloatToHalf()
+    {
+        // Every float next to the midpoint between two adjacent halves, where the ties and the rounding live.
+        Vector<float> inputs;
+        for (uint32_t half = 0; half < 0x7C00u; ++half)
+        {
+            const double low = static_cast<double>(ReferenceHalfToFloat(static_cast<uint16_t>(half)));
+            const double high = static_cast<double>(ReferenceHalfToFloat(static_cast<uint16_t>(half + 1)));
+            const uint32_t midpoint = ToBits(static_cast<float>(0.5 * (low + high)));
+            for (uint32_t bits = midpoint - 2; bits <= midpoint + 2; ++bits)
+            {
+                inputs.push_back(FromBits(bits));
+                inputs.push_back(-FromBits(bits));
+            }
+        }
+        for (const uint32_t bits : {0x7F800000u, 0xFF800000u, 0x7F800001u, 0xFFBFFFFFu, 0x7FC00000u, 0x7FFFE000u})
+            inputs.push_back(FromBits(bits));
+        CheckFloatToHalf(inputs.data(), inputs.size());
+
+        // Sampled bit patterns across the whole float range, converted in chunks so the exhaustive sweep fits in memory.
+        const uint64_t stride = IsExhaustive() ? 1 : 4099;
+        inputs.clear();
+        for (uint64_t bits = 0; bits <= 0xFFFFFFFFu; bits += stride)
+        {
+            inputs.push_back(FromBits(static_cast<uint32_t>(bits)));
+            if (inputs.size() == (1 << 20))
+            {
+                CheckFloatToHalf(inputs.data(), inputs.size());
+                inputs.clear();
+            }
+        }
+        CheckFloatToHalf(inputs.data(), inputs.size());
+    }
+
+    /// A normalized integer format, its bulk functions and the largest code.
+    template <typename T> struct NormalizedFormat
+    {
+        const char* name;
+        void (*pack)(const float*, T*, size_t);
+        void (*unpack)(const T*, float*, size_t);
+        double scale;
+    };
+
+    const NormalizedFormat<uint8_t> kUNorm8 = {"UNorm8", PackedVector::PackUNorm8, PackedVector::UnpackUNorm8, 255.0};
+    const NormalizedFormat<int8_t> kSNorm8 = {"SNorm8", PackedVector::PackSNorm8, PackedVector::UnpackSNorm8, 127.0};
+    const NormalizedFormat<uint16_t> kUNorm16 = {"UNorm16", PackedVector::PackUNorm16, PackedVector::UnpackUNorm16, 65535.0};
+    const NormalizedFormat<int16_t> kSNorm16 = {"SNorm16", PackedVector::PackSNorm16, PackedVector::UnpackSNorm16, 32767.0};
+
+    /// Map NaN to zero, clamp, scale and round to nearest even, all exact in double.
+    template <typename T> T ReferencePack(float value, double scale)
+    {
+        const double low = std::numeric_limits<T>::is_signed ? -1.0 : 0.0;
+        const double clamped = std::isnan(value) ? 0.0 : std::min(std::max(static_cast<double>(value), low), 1.0);
+        return static_cast<T>(std::nearbyint(clamped * scale));
+    }
+
+    template <typename T> float ReferenceUnpack(T code, double scale)
+    {
+        return std::max(static_cast<float>(code) / static_cast<float>(scale), -1.0f);
+    }
+
+    template <typename T> void CheckNormalizedRounding(const NormalizedFormat<T>& format)
+    {
+        // The floats around every midpoint between two codes and around every code, then a sweep of [-2, 2].
+        Vector<float> inputs;
+        const int64_t lowest = std::numeric_limits<T>::is_signed ? -static_cast<int64_t>(format.scale) : 0;
+        for (int64_t code = lowest; code <= static_cast<int64_t>(format.scale); ++code)
+        {
+            for (const double point : {static_cast<double>(code) / format.scale, (static_cast<double>(code) + 0.5) / format.scale})
+            {
+                const uint32_t center = ToBits(static_cast<float>(point));
+                for (uint32_t bits = center - std::min(center, 2u); bits <= center + 2; ++bits)
+                    inputs.push_back(FromBits(bits));
+            }
+        }
+
+        const uint32_t stride = IsExhaustive() ? 1 : 509;
+        for (uint32_t bits = 0; bits <= ToBits(2.0f); bits += stride)
+        {
+            inputs.push_back(FromBits(bits));
+            inputs.push_back(-FromBits(bits));
+        }
+        for (const float special : {std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                                    std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::quiet_NaN(), FromBits(0x7F800001u),
+                                    std::numeric_limits<float>::denorm_min(), -std::numeric_limits<float>::denorm_min()})
+        {
+            inputs.push_back(special);
+        }
+
+        Vector<T> packed(inputs.size());
+        format.pack(inputs.data(), packed.data(), inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            const T expected = ReferencePack<T>(inputs[i], format.scale);
+            ALIMER_CHECK_MSG(packed[i] == expected, "Pack%s(%.9g, 0x%08x) is %d, expected %d", format.name, inputs[i], ToBits(inputs[i]),
+                             static_cast<int>(packed[i]), static_cast<int>(expected));
+        }
+    }
+
+    void PackedVectorNormalizedRounding()
+    {
+        CheckNormalizedRounding(kUNorm8);
+        CheckNormalizedRounding(kSNorm8);
+        CheckNormalizedRounding(kUNorm16);
+        CheckNormalizedRounding(kSNorm16);
+    }
+
+    template <typename T> void CheckNormalizedRoundTrip(const NormalizedFormat<T>& format)
+    {
+        Vector<T> codes;
+        for (int64_t code = std::numeric_limits<T>::min(); code <= std::numeric_limits<T>::max(); ++code)
+            codes.push_back(static_cast<T>(code));
+
+        Vector<float> values(codes.size());
+        format.unpack(codes.data(), values.data(), codes.size());
+        Vector<T> packed(codes.size());
+        format.pack(values.data(), packed.data(), values.size());
+
+        for (size_t i = 0; i < codes.size(); ++i)
+        {
+            const float expected = ReferenceUnpack(codes[i], format.scale);
+            ALIMER_CHECK_MSG(ToBits(values[i]) == ToBits(expected), "Unpack%s(%d) is %.9g, expected %.9g", format.name, static_cast<int>(codes[i]),
+                             values[i], expected);
+
+            // The smallest signed code unpacks to -1 like the one above it.
+            const T code = codes[i] == std::numeric_limits<T>::min() && std::numeric_limits<T>::is_signed ? static_cast<T>(codes[i] + 1) : codes[i];
+            ALIMER_CHECK_MSG(packed[i] == code, "%s code %d round trips to %d", format.name, static_cast<int>(codes[i]), static_cast<int>(packed[i]));
+        }
+    }
+
+    void PackedVectorNormalizedRoundTrip()
+    {
+        CheckNormalizedRoundTrip(kUNorm8);
+        CheckNormalizedRoundTrip(kSNorm8);
+        CheckNormalizedRoundTrip(kUNorm16);
+        CheckNormalizedRoundTrip(kSNorm16);
+    }
+
+    void PackedVectorRGB10A2()
+    {
+        uint32_t seed = 1;
+        const auto next = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return seed;
+        };
+
+        constexpr size_t kCount = 4096;
+        Vector<uint32_t> words(kCount);
+        for (uint32_t& word : words)
+            word = next();
+
+        Vector<float> values(kCount * 4);
+        PackedVector::UnpackRGB10A2(words.data(), values.data(), kCount);
+        Vector<uint32_t> packed(kCount);
+        PackedVector::PackRGB10A2(values.data(), packed.data(), kCount);
+
+        for (size_t i = 0; i < kCount; ++i)
+        {
+            const uint32_t word = words[i];
+            const uint32_t codes[] = {word & 0x3FFu, (word >> 10) & 0x3FFu, (word >> 20) & 0x3FFu, word >> 30};
+            for (size_t channel = 0; channel < 4; ++channel)
+            {
+                const float expected = ReferenceUnpack(codes[channel], channel < 3 ? 1023.0 : 3.0);
+                ALIMER_CHECK_MSG(ToBits(values[i * 4 + channel]) == ToBits(expected), "UnpackRGB10A2(0x%08x) channel %zu is %.9g, expected %.9g",
+                                 word, channel, values[i * 4 + channel], expected);
+            }
+            ALIMER_CHECK_MSG(packed[i] == word, "RGB10A2 0x%08x round trips to 0x%08x", word, packed[i]);
+        }
+
+        // Rounding and clamping per channel, with out of range and NaN inputs.
+        for (float& value : values)
+            value = (static_cast<float>(next() >> 8) / 16777216.0f) * 1.5f - 0.25f;
+        values[0] = std::numeric_limits<float>::quiet_NaN();
+        values[5] = -std::numeric_limits<float>::infinity();
+        values[7] = std::numeric_limits<float>::infinity();
+
+        PackedVector::PackRGB10A2(values.data(), packed.data(), kCount);
+        for (size_t i = 0; i < kCount; ++i)
+        {
+            const float* element = values.data() + i * 4;
+            const uint32_t expected = ReferencePack<uint32_t>(element[0], 1023.0) | (ReferencePack<uint32_t>(element[1], 1023.0) << 10) |
+                                      (ReferencePack<uint32_t>(element[2], 1023.0) << 20) | (ReferencePack<uint32_t>(element[3], 3.0) << 30);
+            ALIMER_CHECK_MSG(packed[i] == expected, "PackRGB10A2 element %zu is 0x%08x, expected 0x%08x", i, packed[i], expected);
+        }
+    }
+
+    /**
+     * Run a bulk conversion on every count up to a few SIMD blocks and at every alignment, and compare it with
+     * converting one element at a time, which always takes the scalar path. Nothing after the last element may change.
+     */
+    template <typename Source, typename Destination, size_t SourceComponents = 1, size_t DestinationComponents = 1>
+    void CheckBulkMatchesScalar(const char* name, void (*convert)(const Source*, Destination*, size_t), const Vector<Source>& inputs)
+    {
+        constexpr size_t kMaxCount = 67;
+        constexpr size_t kMaxOffset = 4;
+        for (size_t offset = 0; offset < kMaxOffset; ++offset)
+        {
+            for (size_t count = 0; count <= kMaxCount; ++count)
+            {
+                Destination bulk[(kMaxCount + 1) * DestinationComponents];
+                Destination single[(kMaxCount + 1) * DestinationComponents];
+                memset(bulk, 0xCD, sizeof(bulk));
+                memset(single, 0xCD, sizeof(single));
+
+                const Source* source = inputs.data() + offset * SourceComponents;
+                convert(source, bulk, count);
+                for (size_t i = 0; i < count; ++i)
+                    convert(source + i * SourceComponents, single + i * DestinationComponents, 1);
+
+                ALIMER_CHECK_MSG(memcmp(bulk, single, sizeof(bulk)) == 0, "bulk %s differs from the scalar path for count %zu at offset %zu", name,
+                                 count, offset);
+            }
+        }
+    }
+
+    void PackedVectorBulkMatchesScalar()
+    {
+        // Values around the rounding and clamping edges, specials and denormals, in an order that mixes them per block.
+        Vector<float> floats;
+        uint32_t seed = 7;
+        for (size_t i = 0; i < 4 * 72; ++i)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            switch (i % 6)
+            {
+            case 0: floats.push_back(FromBits(seed)); break;
+            case 1: floats.push_back(static_cast<float>(seed >> 8) / 16777216.0f * 2.5f - 1.25f); break;
+            case 2: floats.push_back((static_cast<float>(seed % 255) + 0.5f) / 255.0f); break;
+            case 3: floats.push_back(FromBits(0x33000000u + (seed % 0x05800000u))); break;
+            case 4: floats.push_back(FromBits(0x477FE000u + (seed % 0x4000u))); break;
+            default: floats.push_back(i % 12 == 5 ? std::numeric_limits<float>::quiet_NaN() : -std::numeric_limits<float>::infinity()); break;
+            }
+        }
+
+        Vector<uint16_t> halves(floats.size());
+        Vector<uint8_t> bytes(floats.size());
+        Vector<uint32_t> words(floats.size());
+        for (size_t i = 0; i < floats.size(); ++i)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            halves[i] = static_cast<uint16_t>(seed >> 16);
+            bytes[i] = static_cast<uint8_t>(seed >> 24);
+            words[i] = seed;
+        }
+        const Vector<int8_t> signedBytes(bytes.begin(), bytes.end());
+        const Vector<int16_t> signedHalves(halves.begin(), halves.end());
+
+        CheckBulkMatchesScalar<float, uint16_t>("FloatToHalf", PackedVector::FloatToHalf, floats);
+        CheckBulkMatchesScalar<uint16_t, float>("HalfToFloat", PackedVector::HalfToFloat, halves);
+        CheckBulkMatchesScalar<float, uint8_t>("PackUNorm8", PackedVector::PackUNorm8, floats);
+        CheckBulkMatchesScalar<uint8_t, float>("UnpackUNorm8", PackedVector::UnpackUNorm8, bytes);
+        CheckBulkMatchesScalar<float, int8_t>("PackSNorm8", PackedVector::PackSNorm8, floats);
+        CheckBulkMatchesScalar<int8_t, float>("UnpackSNorm8", PackedVector::UnpackSNorm8, signedBytes);
+        CheckBulkMatchesScalar<float, uint16_t>("PackUNorm16", PackedVector::PackUNorm16, floats);
+        CheckBulkMatchesScalar<uint16_t, float>("UnpackUNorm16", PackedVector::UnpackUNorm16, halves);
+        CheckBulkMatchesScalar<float, int16_t>("PackSNorm16", PackedVector::PackSNorm16, floats);
+        CheckBulkMatchesScalar<int16_t, float>("UnpackSNorm16", PackedVector::UnpackSNorm16, signedHalves);
+        CheckBulkMatchesScalar<float, uint32_t, 4, 1>("PackRGB10A2", PackedVector::PackRGB10A2, floats);
+        CheckBulkMatchesScalar<uint32_t, float, 1, 4>("UnpackRGB10A2", PackedVector::UnpackRGB10A2, words);
+    }
+}
+
+ALIMER_TEST(PackedVectorHalfToFloat);
+ALIMER_TEST(PackedVectorFloatToHalf);
+ALIMER_TEST(PackedVectorNormalizedRounding);
+ALIMER_TEST(PackedVectorNormalizedRoundTrip);
+ALIMER_TEST(PackedVectorRGB10A2);
+ALIMER_TEST(PackedVectorBulkMatchesScalar);
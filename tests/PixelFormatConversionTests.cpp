@@ -0,0 +1,224 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Test.h"
+#include "Graphics/PixelFormatConversion.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace alimer;
+
+namespace
+{
+    uint32_t GetBytesPerPixel(PixelFormat format) { return GetFormatBitsPerPixel(format) / 8; }
+
+    std::vector<PixelFormat> GetSupportedFormats()
+    {
+        std::vector<PixelFormat> formats;
+        for (uint32_t i = 1; i < static_cast<uint32_t>(PixelFormat::Count); ++i)
+        {
+            if (IsPixelConversionSupported(static_cast<PixelFormat>(i)))
+                formats.push_back(static_cast<PixelFormat>(i));
+        }
+        return formats;
+    }
+
+    std::vector<uint8_t> Convert(PixelFormat sourceFormat, const std::vector<uint8_t>& source, PixelFormat destinationFormat, uint32_t width,
+                                 uint32_t height)
+    {
+        std::vector<uint8_t> destination(static_cast<size_t>(width) * height * GetBytesPerPixel(destinationFormat), 0);
+        const bool converted = ConvertPixels(sourceFormat, source.data(), 0, destinationFormat, destination.data(), 0, width, height);
+        ALIMER_CHECK_MSG(converted, "%s to %s failed", ToString(sourceFormat).c_str(), ToString(destinationFormat).c_str());
+        return destination;
+    }
+
+    /// Return the index of the first differing pixel, or -1 if the buffers match.
+    int64_t FindMismatch(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, uint32_t bytesPerPixel)
+    {
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i] != b[i])
+                return static_cast<int64_t>(i / bytesPerPixel);
+        }
+        return -1;
+    }
+
+    void PixelConversionPathsAgree()
+    {
+        // Wider than one conversion chunk and not a multiple of the SIMD width, so chunk ends and scalar tails are hit.
+        constexpr uint32_t kWidth = 261;
+        constexpr uint32_t kHeight = 2;
+        const std::vector<PixelFormat> formats = GetSupportedFormats();
+        ALIMER_CHECK(formats.size() >= 40);
+
+        std::mt19937 random(7);
+        for (PixelFormat sourceFormat : formats)
+        {
+            const uint32_t sourceSize = GetBytesPerPixel(sourceFormat);
+            std::vector<uint8_t> source(static_cast<size_t>(kWidth) * kHeight * sourceSize);
+            for (uint8_t& byte : source)
+            {
+                byte = static_cast<uint8_t>(random());
+            }
+
+            // Every source format through the generic float path, RGBA32Float stores the decoded values exactly.
+            const std::vector<uint8_t> decoded = Convert(sourceFormat, source, PixelFormat::RGBA32Float, kWidth, kHeight);
+
+            for (PixelFormat destinationFormat : formats)
+            {
+                const uint32_t destinationSize = GetBytesPerPixel(destinationFormat);
+                const std::vector<uint8_t> direct = Convert(sourceFormat, source, destinationFormat, kWidth, kHeight);
+
+                // Matching formats copy rows, keeping the bits the float path would not (SNorm -128, NaN payloads, large integers).
+                const std::vector<uint8_t> expected =
+                    sourceFormat == destinationFormat ? source : Convert(PixelFormat::RGBA32Float, decoded, destinationFormat, kWidth, kHeight);
+                const int64_t mismatch = FindMismatch(direct, expected, destinationSize);
+                ALIMER_CHECK_MSG(mismatch < 0, "%s to %s differs from the float path at pixel %lld", ToString(sourceFormat).c_str(),
+                                 ToString(destinationFormat).c_str(), static_cast<long long>(mismatch));
+
+                // One pixel at a time only runs the scalar code of every stage.
+                std::vector<uint8_t> single(direct.size());
+                for (uint32_t pixel = 0; pixel < kWidth * kHeight; ++pixel)
+                {
+                    ConvertPixels(sourceFormat, source.data() + pixel * sourceSize, 0, destinationFormat,
+                                  single.data() + pixel * destinationSize, 0, 1, 1);
+                }
+
+                const int64_t scalarMismatch = FindMismatch(direct, single, destinationSize);
+                ALIMER_CHECK_MSG(scalarMismatch < 0, "%s to %s differs from single pixel conversion at pixel %lld",
+                                 ToString(sourceFormat).c_str(), ToString(destinationFormat).c_str(), static_cast<long long>(scalarMismatch));
+            }
+        }
+
+        uint8_t pixel[16] = {};
+        ALIMER_CHECK(!ConvertPixels(PixelFormat::BC1RGBAUnorm, pixel, 0, PixelFormat::RGBA8Unorm, pixel, 0, 1, 1));
+        ALIMER_CHECK(!ConvertPixels(PixelFormat::RGBA8Unorm, pixel, 0, PixelFormat::Depth24UnormStencil8, pixel, 0, 1, 1));
+        ALIMER_CHECK(ConvertPixels(PixelFormat::RGBA8Unorm, nullptr, 0, PixelFormat::R32Float, nullptr, 0, 0, 4));
+    }
+
+    void PixelConversionSrgbRoundTrip()
+    {
+        std::vector<uint8_t> codes(256 * 4);
+        for (uint32_t code = 0; code < 256; ++code)
+        {
+            codes[code * 4] = static_cast<uint8_t>(code);
+            codes[code * 4 + 1] = static_cast<uint8_t>(255 - code);
+            codes[code * 4 + 2] = static_cast<uint8_t>(code ^ 0x5A);
+            codes[code * 4 + 3] = static_cast<uint8_t>(code * 7);
+        }
+
+        // Each of these holds every decoded sRGB value precisely enough to encode back to the same code.
+        for (PixelFormat format : {PixelFormat::RGBA32Float, PixelFormat::RGBA16Float, PixelFormat::RGBA16Unorm, PixelFormat::BGRA8UnormSrgb})
+        {
+            const std::vector<uint8_t> linear = Convert(PixelFormat::RGBA8UnormSrgb, codes, format, 256, 1);
+            const std::vector<uint8_t> roundTrip = Convert(format, linear, PixelFormat::RGBA8UnormSrgb, 256, 1);
+            const int64_t mismatch = FindMismatch(codes, roundTrip, 4);
+            ALIMER_CHECK_MSG(mismatch < 0, "sRGB code %lld changed going through %s", static_cast<long long>(mismatch), ToString(format).c_str());
+        }
+
+        // Decoding matches the sRGB transfer function, alpha stays linear.
+        const std::vector<uint8_t> linear = Convert(PixelFormat::RGBA8UnormSrgb, codes, PixelFormat::RGBA32Float, 256, 1);
+        for (uint32_t code = 0; code < 256; ++code)
+        {
+            float red, alpha;
+            memcpy(&red, linear.data() + code * 16, sizeof(float));
+            memcpy(&alpha, linear.data() + code * 16 + 12, sizeof(float));
+
+            const double value = code / 255.0;
+            const double expected = value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+            ALIMER_CHECK_MSG(std::fabs(red - expected) <= 1e-7 * expected + 1e-12, "sRGB code %u decodes to %.9g, expected %.9g", code, red,
+                             expected);
+            ALIMER_CHECK_MSG(alpha == codes[code * 4 + 3] / 255.0f, "alpha %u decodes to %.9g", codes[code * 4 + 3], alpha);
+        }
+
+        // Linear middle grey is sRGB 188, on both the float path and the RGBA8 table path.
+        const float grey[4] = {0.5f, 0.5f, 0.5f, 0.5f};
+        uint8_t encoded[4] = {};
+        ALIMER_CHECK(ConvertPixels(PixelFormat::RGBA32Float, grey, 0, PixelFormat::RGBA8UnormSrgb, encoded, 0, 1, 1));
+        ALIMER_CHECK_MSG(encoded[0] == 188 && encoded[3] == 128, "0.5 encodes to %u, alpha %u", encoded[0], encoded[3]);
+
+        const uint8_t unorm[4] = {128, 128, 128, 128};
+        ALIMER_CHECK(ConvertPixels(PixelFormat::RGBA8Unorm, unorm, 0, PixelFormat::BGRA8UnormSrgb, encoded, 0, 1, 1));
+        ALIMER_CHECK_MSG(encoded[0] == 188 && encoded[2] == 188 && encoded[3] == 128, "128 / 255 encodes to %u", encoded[0]);
+    }
+
+    void PixelConversionPaddedRowPitch()
+    {
+        constexpr uint32_t kWidth = 5;
+        constexpr uint32_t kHeight = 4;
+        constexpr uint32_t kSourcePadding = 12;
+        constexpr uint32_t kDestinationPadding = 20;
+        constexpr uint8_t kGuard = 0xCD;
+
+        const std::pair<PixelFormat, PixelFormat> pairs[] = {
+            {PixelFormat::RGBA8Unorm, PixelFormat::RGBA8UnormSrgb}, {PixelFormat::BGRA8Unorm, PixelFormat::RGBA8Unorm},
+            {PixelFormat::RG16Uint, PixelFormat::RG16Uint},         {PixelFormat::R16Float, PixelFormat::RGBA8Unorm},
+            {PixelFormat::RGB10A2Unorm, PixelFormat::RGBA16Float},  {PixelFormat::RGBA32Float, PixelFormat::RG11B10Float},
+            {PixelFormat::R8Unorm, PixelFormat::RGBA32Float},
+        };
+
+        std::mt19937 random(11);
+        for (const auto& pair : pairs)
+        {
+            const uint32_t sourceRowSize = kWidth * GetBytesPerPixel(pair.first);
+            const uint32_t destinationRowSize = kWidth * GetBytesPerPixel(pair.second);
+            const uint32_t sourcePitch = sourceRowSize + kSourcePadding;
+            const uint32_t destinationPitch = destinationRowSize + kDestinationPadding;
+
+            std::vector<uint8_t> tight(static_cast<size_t>(sourceRowSize) * kHeight);
+            std::vector<uint8_t> padded(static_cast<size_t>(sourcePitch) * kHeight);
+            for (uint8_t& byte : padded)
+            {
+                byte = static_cast<uint8_t>(random());
+            }
+            for (uint32_t y = 0; y < kHeight; ++y)
+            {
+                memcpy(tight.data() + y * sourceRowSize, padded.data() + y * sourcePitch, sourceRowSize);
+            }
+
+            const std::vector<uint8_t> expected = Convert(pair.first, tight, pair.second, kWidth, kHeight);
+            std::vector<uint8_t> destination(static_cast<size_t>(destinationPitch) * kHeight, kGuard);
+            ALIMER_CHECK(ConvertPixels(pair.first, padded.data(), sourcePitch, pair.second, destination.data(), destinationPitch, kWidth, kHeight));
+
+            for (uint32_t y = 0; y < kHeight; ++y)
+            {
+                const uint8_t* row = destination.data() + y * destinationPitch;
+                ALIMER_CHECK_MSG(memcmp(row, expected.data() + y * destinationRowSize, destinationRowSize) == 0, "%s to %s row %u differs",
+                                 ToString(pair.first).c_str(), ToString(pair.second).c_str(), y);
+
+                bool paddingKept = true;
+                for (uint32_t i = destinationRowSize; i < destinationPitch; ++i)
+                {
+                    paddingKept = paddingKept && row[i] == kGuard;
+                }
+                ALIMER_CHECK_MSG(paddingKept, "%s to %s wrote into the padding of row %u", ToString(pair.first).c_str(),
+                                 ToString(pair.second).c_str(), y);
+            }
+        }
+    }
+}
+
+ALIMER_TEST(PixelConversionPathsAgree);
+ALIMER_TEST(PixelConversionSrgbRoundTrip);
+ALIMER_TEST(PixelConversionPaddedRowPitch);
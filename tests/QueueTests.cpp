@@ -0,0 +1,276 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Test.h"
+#include "Core/Containers.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace alimer;
+
+namespace
+{
+    constexpr uint32_t kProducerCount = 4;
+    constexpr uint32_t kConsumerCount = 4;
+    constexpr uint64_t kItemsPerProducer = 100000;
+    constexpr size_t kMaxBatch = 8;
+    /// A producer that can't push for this long reports the queue as stuck instead of hanging the test run.
+    constexpr std::chrono::seconds kStallTimeout(30);
+
+    /// Items carry their producer in the high bits and a per-producer sequence number in the low bits.
+    uint64_t MakeItem(uint32_t producer, uint64_t sequence) { return (static_cast<uint64_t>(producer) << 32) | sequence; }
+
+    /// Pushed items come back in order on one thread, fills to capacity, then refuses until popped.
+    template <typename Queue> void CheckSingleThreadEdges(Queue& queue)
+    {
+        constexpr size_t capacity = Queue::GetCapacity();
+        uint64_t item = 0;
+        ALIMER_CHECK(!queue.Pop(item));
+        ALIMER_CHECK(queue.PopBatch(&item, 1) == 0);
+        ALIMER_CHECK(queue.GetSizeApprox() == 0);
+
+        // Several laps around the ring, each filling it exactly to capacity.
+        uint64_t next = 0;
+        uint64_t expected = 0;
+        for (uint32_t lap = 0; lap < 5; ++lap)
+        {
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                ALIMER_CHECK_MSG(queue.Push(next++), "push %zu of %zu failed on lap %u", i, capacity, lap);
+            }
+            ALIMER_CHECK(queue.GetSizeApprox() == capacity);
+            ALIMER_CHECK(!queue.Push(uint64_t(999)));
+
+            const uint64_t batch[kMaxBatch] = {};
+            ALIMER_CHECK(queue.PushBatch(batch, kMaxBatch) == 0);
+
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                ALIMER_CHECK(queue.Pop(item) && item == expected);
+                expected++;
+            }
+            ALIMER_CHECK(!queue.Pop(item));
+        }
+
+        // A batch larger than the free space pushes what fits, a batch pop returns what is there.
+        uint64_t values[capacity + kMaxBatch];
+        for (size_t i = 0; i < capacity + kMaxBatch; ++i)
+        {
+            values[i] = next++;
+        }
+        ALIMER_CHECK(queue.Push(values[0]));
+        const size_t pushed = queue.PushBatch(values + 1, capacity + kMaxBatch - 1);
+        ALIMER_CHECK_MSG(pushed == capacity - 1, "batch pushed %zu items into %zu free slots", pushed, capacity - 1);
+
+        uint64_t popped[capacity + kMaxBatch];
+        const size_t first = capacity / 2;
+        ALIMER_CHECK(queue.PopBatch(popped, first) == first);
+        const size_t rest = queue.PopBatch(popped + first, capacity + kMaxBatch);
+        ALIMER_CHECK_MSG(rest == capacity - first, "batch popped %zu of %zu items", rest, capacity - first);
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            ALIMER_CHECK_MSG(popped[i] == values[i], "item %zu is %llu", i, static_cast<unsigned long long>(popped[i]));
+        }
+        ALIMER_CHECK(queue.PopBatch(popped, kMaxBatch) == 0);
+        ALIMER_CHECK(queue.GetSizeApprox() == 0);
+    }
+
+    /// Push every item of the producer, half of them through PushBatch. Retries while the queue is full.
+    template <typename Queue> void Produce(Queue& queue, uint32_t producer, uint64_t itemCount)
+    {
+        std::mt19937 random(producer + 1);
+        uint64_t batch[kMaxBatch];
+        uint64_t sequence = 0;
+        auto lastProgress = std::chrono::steady_clock::now();
+        while (sequence < itemCount)
+        {
+            const uint64_t previous = sequence;
+            if (random() % 2 == 0)
+            {
+                if (queue.Push(MakeItem(producer, sequence)))
+                {
+                    sequence++;
+                }
+            }
+            else
+            {
+                const size_t count = static_cast<size_t>(Min<uint64_t>(1 + random() % kMaxBatch, itemCount - sequence));
+                for (size_t i = 0; i < count; ++i)
+                {
+                    batch[i] = MakeItem(producer, sequence + i);
+                }
+
+                sequence += queue.PushBatch(batch, count);
+            }
+
+            if (sequence != previous)
+            {
+                lastProgress = std::chrono::steady_clock::now();
+            }
+            else if (std::chrono::steady_clock::now() - lastProgress > kStallTimeout)
+            {
+                ALIMER_CHECK_MSG(false, "producer %u stalled at item %llu", producer, static_cast<unsigned long long>(sequence));
+                return;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /// Pop until the producers are done and the queue is drained, mixing Pop and PopBatch. Lost items end the loop
+    /// too and show up as missing instead of hanging the test.
+    template <typename Queue> void Consume(Queue& queue, uint32_t consumer, const std::atomic<bool>& producersDone, std::vector<uint64_t>& received)
+    {
+        std::mt19937 random(consumer + 100);
+        uint64_t batch[kMaxBatch];
+        for (;;)
+        {
+            // Read before popping, an empty queue after every push has completed means there is nothing left.
+            const bool done = producersDone.load(std::memory_order_acquire);
+            size_t count = 0;
+            if (random() % 2 == 0)
+                count = queue.Pop(batch[0]) ? 1 : 0;
+            else
+                count = queue.PopBatch(batch, 1 + random() % kMaxBatch);
+
+            if (count == 0)
+            {
+                if (done)
+                    return;
+
+                std::this_thread::yield();
+                continue;
+            }
+
+            received.insert(received.end(), batch, batch + count);
+        }
+    }
+
+    /// Every item must arrive exactly once, and in producer order as seen by any single consumer.
+    void CheckReceived(const std::vector<std::vector<uint64_t>>& received, uint32_t producerCount, uint64_t itemsPerProducer)
+    {
+        std::vector<uint8_t> seen(producerCount * itemsPerProducer, 0);
+        for (size_t consumer = 0; consumer < received.size(); ++consumer)
+        {
+            std::vector<int64_t> last(producerCount, -1);
+            for (uint64_t item : received[consumer])
+            {
+                const uint32_t producer = static_cast<uint32_t>(item >> 32);
+                const uint64_t sequence = item & 0xFFFFFFFFu;
+                if (producer >= producerCount || sequence >= itemsPerProducer)
+                {
+                    ALIMER_CHECK_MSG(false, "consumer %zu received invalid item %llx", consumer, static_cast<unsigned long long>(item));
+                    continue;
+                }
+
+                ALIMER_CHECK_MSG(static_cast<int64_t>(sequence) > last[producer], "consumer %zu received item %llu of producer %u after %lld",
+                                 consumer, static_cast<unsigned long long>(sequence), producer, static_cast<long long>(last[producer]));
+                last[producer] = static_cast<int64_t>(sequence);
+                seen[producer * itemsPerProducer + sequence]++;
+            }
+        }
+
+        for (size_t i = 0; i < seen.size(); ++i)
+        {
+            ALIMER_CHECK_MSG(seen[i] == 1, "item %llu of producer %zu arrived %u times", static_cast<unsigned long long>(i % itemsPerProducer),
+                             static_cast<size_t>(i / itemsPerProducer), seen[i]);
+        }
+    }
+
+    void MPMCQueueSingleThread()
+    {
+        auto queue = std::make_unique<MPMCQueue<uint64_t, 64>>();
+        CheckSingleThreadEdges(*queue);
+
+        auto smallest = std::make_unique<MPMCQueue<uint64_t, 2>>();
+        CheckSingleThreadEdges(*smallest);
+    }
+
+    void MPMCQueueStress()
+    {
+        // A small queue keeps both the full and the empty paths busy.
+        auto queue = std::make_unique<MPMCQueue<uint64_t, 64>>();
+        std::atomic<bool> producersDone{false};
+        std::vector<std::vector<uint64_t>> received(kConsumerCount);
+
+        std::vector<std::thread> consumers;
+        for (uint32_t consumer = 0; consumer < kConsumerCount; ++consumer)
+        {
+            consumers.emplace_back([&, consumer] { Consume(*queue, consumer, producersDone, received[consumer]); });
+        }
+
+        std::vector<std::thread> producers;
+        for (uint32_t producer = 0; producer < kProducerCount; ++producer)
+        {
+            producers.emplace_back([&, producer] { Produce(*queue, producer, kItemsPerProducer); });
+        }
+        for (std::thread& thread : producers)
+        {
+            thread.join();
+        }
+
+        producersDone.store(true, std::memory_order_release);
+        for (std::thread& thread : consumers)
+        {
+            thread.join();
+        }
+
+        uint64_t item;
+        ALIMER_CHECK(!queue->Pop(item));
+        CheckReceived(received, kProducerCount, kItemsPerProducer);
+    }
+
+    void SPSCQueueSingleThread()
+    {
+        auto queue = std::make_unique<SPSCQueue<uint64_t, 64>>();
+        CheckSingleThreadEdges(*queue);
+
+        auto smallest = std::make_unique<SPSCQueue<uint64_t, 2>>();
+        CheckSingleThreadEdges(*smallest);
+    }
+
+    void SPSCQueueStress()
+    {
+        auto queue = std::make_unique<SPSCQueue<uint64_t, 64>>();
+        const uint64_t totalCount = 4 * kItemsPerProducer;
+        std::atomic<bool> producerDone{false};
+        std::vector<std::vector<uint64_t>> received(1);
+
+        std::thread consumer([&] { Consume(*queue, 0, producerDone, received[0]); });
+        Produce(*queue, 0, totalCount);
+        producerDone.store(true, std::memory_order_release);
+        consumer.join();
+
+        CheckReceived(received, 1, totalCount);
+    }
+}
+
+ALIMER_TEST(MPMCQueueSingleThread);
+ALIMER_TEST(MPMCQueueStress);
+ALIMER_TEST(SPSCQueueSingleThread);
+ALIMER_TEST(SPSCQueueStress);
@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Test.h"
+#include "Core/SmallObjectAllocator.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace alimer;
+
+namespace
+{
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kRounds = 200;
+    constexpr uint32_t kBlocksPerSize = 16;
+
+    /// Allocation handed from the thread that made it to the thread that frees it.
+    struct Handoff
+    {
+        void* ptr;
+        size_t size;
+        size_t blockSize;
+        uint8_t fill;
+    };
+
+    /// Batches posted to a thread by its neighbour.
+    struct Mailbox
+    {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::vector<std::vector<Handoff>> batches;
+    };
+
+    /// Smallest and largest request of every size class, with the block size each one must land in.
+    std::vector<Handoff> GetSizeClassRequests()
+    {
+        std::vector<Handoff> requests;
+        size_t previous = 0;
+        for (size_t size = 1; size <= SmallObjectAllocator::kMaxSize; ++size)
+        {
+            const size_t blockSize = SmallObjectAllocator::GetSizeClassSize(size);
+            if (blockSize != previous)
+            {
+                requests.push_back({nullptr, size, blockSize, 0});
+                if (blockSize != size)
+                    requests.push_back({nullptr, blockSize, blockSize, 0});
+                previous = blockSize;
+            }
+        }
+        return requests;
+    }
+
+    /// Check the page map knows the block and that the allocation is aligned and large enough.
+    bool CheckOwned(const Handoff& handoff)
+    {
+        return SmallObjectAllocator::Owns(handoff.ptr) && SmallObjectAllocator::GetBlockSize(handoff.ptr) == handoff.blockSize &&
+               (reinterpret_cast<uintptr_t>(handoff.ptr) & 15) == 0 && handoff.blockSize >= handoff.size;
+    }
+
+    /// Every size up to kMaxSize maps to one of the kSizeClassCount classes, none above it.
+    void SmallObjectAllocatorSizeClasses()
+    {
+        const std::vector<Handoff> requests = GetSizeClassRequests();
+        size_t classCount = 0;
+        size_t previous = 0;
+        for (const Handoff& request : requests)
+        {
+            ALIMER_CHECK(request.blockSize >= request.size && request.blockSize % 16 == 0);
+            if (request.blockSize != previous)
+                classCount++;
+            previous = request.blockSize;
+        }
+        ALIMER_CHECK(classCount == SmallObjectAllocator::kSizeClassCount);
+        ALIMER_CHECK(SmallObjectAllocator::GetSizeClassSize(0) == 16);
+        ALIMER_CHECK(SmallObjectAllocator::GetSizeClassSize(SmallObjectAllocator::kMaxSize) == SmallObjectAllocator::kMaxSize);
+        ALIMER_CHECK(SmallObjectAllocator::GetSizeClassSize(SmallObjectAllocator::kMaxSize + 1) == 0);
+    }
+
+    /// Threads in a ring allocate blocks of every size class and hand them to the next thread, which checks the contents
+    /// and the page map before freeing them. Blocks freed by a foreign thread must come back intact on later rounds.
+    void SmallObjectAllocatorCrossThreadFree()
+    {
+        const std::vector<Handoff> requests = GetSizeClassRequests();
+        std::vector<Mailbox> mailboxes(kThreadCount);
+        std::atomic<uint32_t> failures{0};
+
+        auto Run = [&](uint32_t index) {
+            Mailbox& outbox = mailboxes[(index + 1) % kThreadCount];
+            Mailbox& inbox = mailboxes[index];
+            for (uint32_t round = 0; round < kRounds; ++round)
+            {
+                std::vector<Handoff> batch;
+                batch.reserve(requests.size() * kBlocksPerSize);
+                for (const Handoff& request : requests)
+                {
+                    for (uint32_t i = 0; i < kBlocksPerSize; ++i)
+                    {
+                        Handoff handoff = request;
+                        handoff.ptr = SmallObjectAllocator::Allocate(request.size);
+                        handoff.fill = static_cast<uint8_t>(index * 61 + round * 7 + i);
+                        if (handoff.ptr == nullptr || !CheckOwned(handoff))
+                        {
+                            failures++;
+                            continue;
+                        }
+                        memset(handoff.ptr, handoff.fill, handoff.size);
+                        batch.push_back(handoff);
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(outbox.mutex);
+                    outbox.batches.push_back(std::move(batch));
+                }
+                outbox.ready.notify_one();
+
+                std::vector<Handoff> received;
+                {
+                    std::unique_lock<std::mutex> lock(inbox.mutex);
+                    inbox.ready.wait(lock, [&] { return !inbox.batches.empty(); });
+                    received = std::move(inbox.batches.front());
+                    inbox.batches.erase(inbox.batches.begin());
+                }
+
+                for (const Handoff& handoff : received)
+                {
+                    const uint8_t* bytes = static_cast<const uint8_t*>(handoff.ptr);
+                    bool intact = CheckOwned(handoff);
+                    for (size_t i = 0; i < handoff.size && intact; ++i)
+                        intact = bytes[i] == handoff.fill;
+                    if (!intact)
+                        failures++;
+                    SmallObjectAllocator::Free(handoff.ptr);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < kThreadCount; ++i)
+            threads.emplace_back(Run, i);
+        for (std::thread& thread : threads)
+            thread.join();
+
+        ALIMER_CHECK_MSG(failures == 0, "%u blocks were corrupted or missing from the page map", failures.load());
+        for (Mailbox& mailbox : mailboxes)
+            ALIMER_CHECK(mailbox.batches.empty());
+    }
+
+    /// Requests past kMaxSize go to the general allocator and never enter the page map, the boundary size still does.
+    void SmallObjectAllocatorLargeFallsThrough()
+    {
+        for (size_t size : {size_t(257), size_t(300), size_t(4096), SmallObjectAllocator::kPageSize + 1})
+        {
+            ALIMER_CHECK(SmallObjectAllocator::GetSizeClassSize(size) == 0);
+
+            const size_t pageCount = SmallObjectAllocator::GetPageCount();
+            void* direct = SmallObjectAllocator::Allocate(size);
+            void* tracked = alimer_alloc<SmallAlloc>(size);
+            ALIMER_CHECK(direct != nullptr && tracked != nullptr);
+            ALIMER_CHECK(!SmallObjectAllocator::Owns(direct) && SmallObjectAllocator::GetBlockSize(direct) == 0);
+            ALIMER_CHECK(!SmallObjectAllocator::Owns(tracked) && SmallObjectAllocator::GetBlockSize(tracked) == 0);
+            ALIMER_CHECK(SmallObjectAllocator::GetPageCount() == pageCount);
+
+            // The whole request must be usable, not just a size class worth of it.
+            memset(direct, 0xAB, size);
+            memset(tracked, 0xCD, size);
+            SmallObjectAllocator::Free(direct);
+            alimer_free<SmallAlloc>(tracked);
+        }
+
+        void* boundary = alimer_alloc<SmallAlloc>(SmallObjectAllocator::kMaxSize);
+        ALIMER_CHECK(SmallObjectAllocator::Owns(boundary));
+        ALIMER_CHECK(SmallObjectAllocator::GetBlockSize(boundary) == SmallObjectAllocator::kMaxSize);
+        alimer_free<SmallAlloc>(boundary);
+    }
+}
+
+ALIMER_TEST(SmallObjectAllocatorSizeClasses);
+ALIMER_TEST(SmallObjectAllocatorCrossThreadFree);
+ALIMER_TEST(SmallObjectAllocatorLargeFallsThrough);
@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Test.h"
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace alimer
+{
+    namespace
+    {
+        struct TestEntry
+        {
+            std::string name;
+            TestFunction function;
+        };
+
+        /// Failures printed per test, the rest are only counted.
+        constexpr uint32_t kMaxPrintedFailures = 16;
+
+        std::vector<TestEntry>& GetRegistry()
+        {
+            static std::vector<TestEntry> registry;
+            return registry;
+        }
+
+        std::vector<std::pair<std::string, std::string>>& GetOptions()
+        {
+            static std::vector<std::pair<std::string, std::string>> options;
+            return options;
+        }
+
+        std::atomic<uint32_t> s_failureCount{0};
+    }
+
+    bool RegisterTest(const char* name, TestFunction function)
+    {
+        GetRegistry().push_back({name, function});
+        return true;
+    }
+
+    void ReportTestFailure(const char* file, int line, const char* format, ...)
+    {
+        if (s_failureCount++ >= kMaxPrintedFailures)
+            return;
+
+        // One write per failure so reports from worker threads don't interleave.
+        char message[1024];
+        const int prefix = snprintf(message, sizeof(message), "%s(%d): ", file, line);
+        va_list args;
+        va_start(args, format);
+        vsnprintf(message + prefix, sizeof(message) - static_cast<size_t>(prefix), format, args);
+        va_end(args);
+        fprintf(stderr, "%s\n", message);
+    }
+
+    const char* GetTestOption(const char* name)
+    {
+        for (const auto& option : GetOptions())
+        {
+            if (option.first == name)
+                return option.second.c_str();
+        }
+        return nullptr;
+    }
+
+    bool IsExhaustive()
+    {
+        const char* exhaustive = GetTestOption("exhaustive");
+        return exhaustive != nullptr && atoi(exhaustive) != 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace alimer;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const char* equals = strchr(arg, '=');
+        if (strncmp(arg, "--", 2) != 0 || equals == nullptr)
+        {
+            printf("Usage: alimer_tests [--filter=<text>] [--<option>=<value>...]\n"
+                   "  --filter=<text>      Run tests whose name contains text\n"
+                   "  --exhaustive=1       Sweep every input where a test would sample\n");
+            return EXIT_FAILURE;
+        }
+        GetOptions().emplace_back(std::string(arg + 2, equals), std::string(equals + 1));
+    }
+
+    const char* filter = GetTestOption("filter");
+    uint32_t failedTests = 0;
+    uint32_t runTests = 0;
+    for (const TestEntry& entry : GetRegistry())
+    {
+        if (filter != nullptr && entry.name.find(filter) == std::string::npos)
+            continue;
+
+        printf("[ RUN    ] %s\n", entry.name.c_str());
+        fflush(stdout);
+
+        s_failureCount = 0;
+        entry.function();
+        ++runTests;
+
+        if (s_failureCount != 0)
+        {
+            printf("[ FAILED ] %s (%u failed checks)\n", entry.name.c_str(), s_failureCount.load());
+            ++failedTests;
+        }
+        else
+        {
+            printf("[     OK ] %s\n", entry.name.c_str());
+        }
+        fflush(stdout);
+    }
+
+    printf("%u of %u tests passed\n", runTests - failedTests, runTests);
+    return failedTests == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
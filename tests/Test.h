@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "PlatformDef.h"
+
+namespace alimer
+{
+    using TestFunction = void (*)();
+
+    /// Register a test, run by alimer_tests in registration order.
+    bool RegisterTest(const char* name, TestFunction function);
+
+    /// Mark the running test as failed and print the message. The test keeps running, only the first few failures of
+    /// a test are printed. May be called from threads started by the test.
+    void ReportTestFailure(const char* file, int line, const char* format, ...);
+
+    /// Value of a --name=value command line option, nullptr when it was not given.
+    const char* GetTestOption(const char* name);
+
+    /// Return whether --exhaustive=1 asks the tests to sweep every input where they would sample.
+    bool IsExhaustive();
+}
+
+#define ALIMER_TEST(function) static const bool ALIMER_CONCAT(s_test, __LINE__) = alimer::RegisterTest(#function, function)
+
+#define ALIMER_CHECK(condition)                                                                                                            \
+    do                                                                                                                                     \
+    {                                                                                                                                      \
+        if (!(condition))                                                                                                                  \
+            alimer::ReportTestFailure(__FILE__, __LINE__, "%s", #condition);                                                               \
+    } while (0)
+
+#define ALIMER_CHECK_MSG(condition, ...)                                                                                                   \
+    do                                                                                                                                     \
+    {                                                                                                                                      \
+        if (!(condition))                                                                                                                  \
+            alimer::ReportTestFailure(__FILE__, __LINE__, __VA_ARGS__);                                                                    \
+    } while (0)
@@ -0,0 +1,369 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Test.h"
+#include "Core/Containers.h"
+#include "Math/MathHelper.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+using namespace alimer;
+
+namespace
+{
+    /// Largest error seen by a sweep and the input that produced it.
+    struct MaxError
+    {
+        double error = 0.0;
+        float x = 0.0f;
+        float y = 0.0f;
+
+        void Add(double value, float x_, float y_ = 0.0f)
+        {
+            // A NaN error must not hide behind a comparison.
+            if (!(value <= error))
+            {
+                error = value;
+                x = x_;
+                y = y_;
+            }
+        }
+    };
+
+    float FromBits(uint32_t bits)
+    {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    uint32_t ToBits(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    /// Error of result in units in the last place of the float closest to reference. Special values must match exactly.
+    double UlpError(float result, double reference)
+    {
+        const float rounded = static_cast<float>(reference);
+        if (std::isnan(reference) || std::isinf(rounded))
+            return (std::isnan(result) && std::isnan(reference)) || result == rounded ? 0.0 : std::numeric_limits<double>::infinity();
+
+        int exponent;
+        std::frexp(reference, &exponent);
+        const double ulp = std::ldexp(1.0, std::max(exponent - 24, -149));
+        return std::fabs(static_cast<double>(result) - reference) / ulp;
+    }
+
+    double AbsoluteError(float result, double reference) { return std::fabs(static_cast<double>(result) - reference); }
+
+    double RelativeError(float result, double reference)
+    {
+        return reference == 0.0 ? std::fabs(static_cast<double>(result)) : std::fabs(static_cast<double>(result) - reference) / std::fabs(reference);
+    }
+
+    /// Distance between the bit patterns of sampled floats.
+    uint32_t GetStride(uint32_t stride) { return IsExhaustive() ? 1 : stride; }
+
+    /// Call batch on eight inputs at a time for the positive floats with bit patterns in [begin, end) and their negations.
+    template <typename Batch> void SweepFloats(uint32_t begin, uint32_t end, uint32_t stride, Batch batch)
+    {
+        float x[Vector8::kWidth];
+        size_t count = 0;
+        for (uint64_t bits = begin; bits < end; bits += stride)
+        {
+            x[count++] = FromBits(static_cast<uint32_t>(bits));
+            x[count++] = -FromBits(static_cast<uint32_t>(bits));
+            if (count == Vector8::kWidth)
+            {
+                batch(x, count);
+                count = 0;
+            }
+        }
+
+        if (count != 0)
+        {
+            std::fill(x + count, x + Vector8::kWidth, x[0]);
+            batch(x, count);
+        }
+    }
+
+    /// Sweep the floats in [low, high] and the neighbours of every multiple of pi / 2 in it.
+    template <typename Batch> void SweepAngles(float low, float high, uint32_t stride, Batch batch)
+    {
+        SweepFloats(ToBits(low), ToBits(high) + 1, stride, batch);
+        for (double multiple = std::ceil(low / 1.5707963267948966); multiple * 1.5707963267948966 <= high; multiple += 1.0)
+        {
+            const uint32_t center = ToBits(static_cast<float>(multiple * 1.5707963267948966));
+            SweepFloats(center - std::min(center, 2048u), center + 2048u, 1, batch);
+        }
+    }
+
+    void CheckError(const char* name, const MaxError& maxError, double bound, const char* unit)
+    {
+        printf("    %-24s max error %.3g %s at (%.9g, %.9g)\n", name, maxError.error, unit, maxError.x, maxError.y);
+        ALIMER_CHECK_MSG(maxError.error <= bound, "%s: error %.3g %s at (%.9g, %.9g) is above %.3g", name, maxError.error, unit, maxError.x,
+                         maxError.y, bound);
+    }
+
+    template <MathPrecision Precision> void MeasureSinCos(float low, float high, uint32_t stride, double (*error)(float, double), MaxError& sine,
+                                                         MaxError& cosine)
+    {
+        SweepAngles(low, high, stride, [&](const float* x, size_t count) {
+            Vector8 s, c;
+            VectorMath::SinCos(Vector8::Load(x), &s, &c, Precision);
+            float sines[Vector8::kWidth], cosines[Vector8::kWidth];
+            s.Store(sines);
+            c.Store(cosines);
+            for (size_t i = 0; i < count; ++i)
+            {
+                sine.Add(error(sines[i], std::sin(static_cast<double>(x[i]))), x[i]);
+                cosine.Add(error(cosines[i], std::cos(static_cast<double>(x[i]))), x[i]);
+            }
+        });
+    }
+
+    void VectorMathSinCosAccuracy()
+    {
+        MaxError sine, cosine;
+        MeasureSinCos<MathPrecision::Accurate>(0.0f, 100.0f, GetStride(509), UlpError, sine, cosine);
+        CheckError("Sin up to 100", sine, 2.0, "ulp");
+        CheckError("Cos up to 100", cosine, 2.0, "ulp");
+
+        sine = MaxError();
+        cosine = MaxError();
+        MeasureSinCos<MathPrecision::Accurate>(100.0f, 8192.0f, GetStride(509), AbsoluteError, sine, cosine);
+        CheckError("Sin up to 8192", sine, 1e-7, "absolute");
+        CheckError("Cos up to 8192", cosine, 1e-7, "absolute");
+
+        sine = MaxError();
+        cosine = MaxError();
+        MeasureSinCos<MathPrecision::Fast>(0.0f, 4.0f * Pi, GetStride(509), AbsoluteError, sine, cosine);
+        CheckError("Fast Sin up to 4 pi", sine, 1e-4, "absolute");
+        CheckError("Fast Cos up to 4 pi", cosine, 1e-4, "absolute");
+    }
+
+    /// Sweep a one argument function over the floats in [low, high] against its double precision libm counterpart.
+    template <typename Function>
+    MaxError MeasureUnary(float low, float high, uint32_t stride, Function function, double (*reference)(double), double (*error)(float, double))
+    {
+        MaxError maxError;
+        const auto batch = [&](const float* x, size_t count) {
+            float results[Vector8::kWidth];
+            function(Vector8::Load(x)).Store(results);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (x[i] >= low && x[i] <= high)
+                    maxError.Add(error(results[i], reference(static_cast<double>(x[i]))), x[i]);
+            }
+        };
+
+        // The sweep covers both signs, inputs outside the range are skipped.
+        SweepFloats(0u, ToBits(std::max(std::fabs(low), std::fabs(high))) + 1, stride, batch);
+        return maxError;
+    }
+
+    double ExpReference(double x) { return std::exp(x); }
+    double LogReference(double x) { return std::log(x); }
+
+    void VectorMathExpAccuracy()
+    {
+        const auto accurate = [](const Vector8& x) { return VectorMath::Exp(x, MathPrecision::Accurate); };
+        const auto fast = [](const Vector8& x) { return VectorMath::Exp(x, MathPrecision::Fast); };
+        CheckError("Exp", MeasureUnary(-104.0f, 89.0f, GetStride(1021), accurate, ExpReference, UlpError), 3.0, "ulp");
+        CheckError("Fast Exp", MeasureUnary(-87.0f, 88.0f, GetStride(1021), fast, ExpReference, RelativeError), 1e-4, "relative");
+    }
+
+    void VectorMathLogAccuracy()
+    {
+        const float max = std::numeric_limits<float>::max();
+        const auto accurate = [](const Vector8& x) { return VectorMath::Log(x, MathPrecision::Accurate); };
+        const auto fast = [](const Vector8& x) { return VectorMath::Log(x, MathPrecision::Fast); };
+        CheckError("Log", MeasureUnary(0.0f, max, GetStride(1021), accurate, LogReference, UlpError), 3.0, "ulp");
+        CheckError("Fast Log", MeasureUnary(0.0f, max, GetStride(1021), fast, LogReference, AbsoluteError), 1e-4, "absolute");
+    }
+
+    /// Run a two argument function over a grid of x and y and track the error against reference.
+    template <typename Function, typename Reference, typename Error>
+    MaxError MeasureBinary(const float* xs, size_t xCount, const float* ys, size_t yCount, Function function, Reference reference, Error error)
+    {
+        MaxError maxError;
+        float x[Vector8::kWidth];
+        float y[Vector8::kWidth];
+        float results[Vector8::kWidth];
+        size_t count = 0;
+        const auto flush = [&]() {
+            function(Vector8::Load(x), Vector8::Load(y)).Store(results);
+            for (size_t i = 0; i < count; ++i)
+                maxError.Add(error(results[i], reference(static_cast<double>(x[i]), static_cast<double>(y[i])), x[i], y[i]), x[i], y[i]);
+            count = 0;
+        };
+
+        for (size_t i = 0; i < xCount; ++i)
+        {
+            for (size_t j = 0; j < yCount; ++j)
+            {
+                x[count] = xs[i];
+                y[count] = ys[j];
+                if (++count == Vector8::kWidth)
+                    flush();
+            }
+        }
+
+        if (count != 0)
+        {
+            std::fill(x + count, x + Vector8::kWidth, x[0]);
+            std::fill(y + count, y + Vector8::kWidth, y[0]);
+            flush();
+        }
+        return maxError;
+    }
+
+    /// Floats spread logarithmically over [low, high] with both signs when negative is set, plus zero.
+    Vector<float> MakeGrid(float low, float high, size_t count, bool negative)
+    {
+        Vector<float> values;
+        values.push_back(0.0f);
+        const uint32_t begin = ToBits(low);
+        const uint32_t end = ToBits(high);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float value = FromBits(begin + static_cast<uint32_t>(static_cast<uint64_t>(end - begin) * i / (count - 1)));
+            values.push_back(value);
+            if (negative)
+                values.push_back(-value);
+        }
+        return values;
+    }
+
+    void VectorMathAtan2Accuracy()
+    {
+        const size_t count = IsExhaustive() ? 4096 : 1024;
+        const Vector<float> grid = MakeGrid(1e-6f, 1e6f, count, true);
+        const auto reference = [](double y, double x) { return std::atan2(y, x); };
+        const auto ulp = [](float result, double expected, float, float) { return UlpError(result, expected); };
+        const auto absolute = [](float result, double expected, float, float) { return AbsoluteError(result, expected); };
+
+        const auto accurate = [](const Vector8& y, const Vector8& x) { return VectorMath::Atan2(y, x, MathPrecision::Accurate); };
+        const auto fast = [](const Vector8& y, const Vector8& x) { return VectorMath::Atan2(y, x, MathPrecision::Fast); };
+        CheckError("Atan2", MeasureBinary(grid.data(), grid.size(), grid.data(), grid.size(), accurate, reference, ulp), 3.5, "ulp");
+        CheckError("Fast Atan2", MeasureBinary(grid.data(), grid.size(), grid.data(), grid.size(), fast, reference, absolute), 1e-4, "absolute");
+    }
+
+    void VectorMathPowAccuracy()
+    {
+        const size_t count = IsExhaustive() ? 4096 : 1024;
+        const Vector<float> xs = MakeGrid(1e-4f, 1e4f, count, false);
+        const Vector<float> ys = MakeGrid(1e-3f, 8.0f, count / 4, true);
+        const auto reference = [](double x, double y) { return std::pow(x, y); };
+
+        // The documented bounds grow with the magnitude of y ln x, the errors are reported relative to them.
+        const auto ulp = [](float result, double expected, float x, float y) {
+            return UlpError(result, expected) / (2.0 + 1.5 * std::fabs(static_cast<double>(y) * std::log2(static_cast<double>(x))));
+        };
+        const auto relative = [](float result, double expected, float x, float y) {
+            return RelativeError(result, expected) / (2e-4 * (1.0 + std::fabs(static_cast<double>(y) * std::log(static_cast<double>(x)))));
+        };
+
+        const auto accurate = [](const Vector8& x, const Vector8& y) { return VectorMath::Pow(x, y, MathPrecision::Accurate); };
+        const auto fast = [](const Vector8& x, const Vector8& y) { return VectorMath::Pow(x, y, MathPrecision::Fast); };
+        CheckError("Pow", MeasureBinary(xs.data(), xs.size(), ys.data(), ys.size(), accurate, reference, ulp), 1.0, "of the bound");
+        CheckError("Fast Pow", MeasureBinary(xs.data(), xs.size(), ys.data(), ys.size(), fast, reference, relative), 1.0, "of the bound");
+    }
+
+    /// The Vector4 and scalar entry points share the kernels with Vector8 and must give the same bits.
+    void VectorMathWidthsAgree()
+    {
+        constexpr size_t kFunctionCount = 6;
+        const auto wide = [](const Vector8& x, const Vector8& y, Vector8* results) {
+            results[0] = VectorMath::Sin(x);
+            results[1] = VectorMath::Cos(x);
+            results[2] = VectorMath::Atan2(y, x);
+            results[3] = VectorMath::Exp(x);
+            results[4] = VectorMath::Log(Vector8::Abs(x));
+            results[5] = VectorMath::Pow(Vector8::Abs(x), y);
+        };
+        const auto narrow = [](const Vector4& x, const Vector4& y, Vector4* results) {
+            results[0] = VectorMath::Sin(x);
+            results[1] = VectorMath::Cos(x);
+            results[2] = VectorMath::Atan2(y, x);
+            results[3] = VectorMath::Exp(x);
+            results[4] = VectorMath::Log(Vector4::Abs(x));
+            results[5] = VectorMath::Pow(Vector4::Abs(x), y);
+        };
+        const auto scalar = [](float x, float y, float* results) {
+            results[0] = VectorMath::Sin(x);
+            results[1] = VectorMath::Cos(x);
+            results[2] = VectorMath::Atan2(y, x);
+            results[3] = VectorMath::Exp(x);
+            results[4] = VectorMath::Log(std::fabs(x));
+            results[5] = VectorMath::Pow(std::fabs(x), y);
+        };
+
+        for (uint32_t i = 0; i < 4096; i += Vector8::kWidth)
+        {
+            float x[Vector8::kWidth];
+            float y[Vector8::kWidth];
+            for (uint32_t lane = 0; lane < Vector8::kWidth; ++lane)
+            {
+                x[lane] = (static_cast<float>(i + lane) - 2048.0f) * 0.0371f;
+                y[lane] = static_cast<float>((i + lane) % 67) * 0.73f - 20.0f;
+            }
+
+            Vector8 wideResults[kFunctionCount];
+            Vector4 lowResults[kFunctionCount];
+            Vector4 highResults[kFunctionCount];
+            wide(Vector8::Load(x), Vector8::Load(y), wideResults);
+            narrow(Vector4::Load(x), Vector4::Load(y), lowResults);
+            narrow(Vector4::Load(x + 4), Vector4::Load(y + 4), highResults);
+
+            for (size_t function = 0; function < kFunctionCount; ++function)
+            {
+                float wideLanes[Vector8::kWidth];
+                float narrowLanes[Vector8::kWidth];
+                wideResults[function].Store(wideLanes);
+                lowResults[function].Store(narrowLanes);
+                highResults[function].Store(narrowLanes + 4);
+
+                for (uint32_t lane = 0; lane < Vector8::kWidth; ++lane)
+                {
+                    float scalarResults[kFunctionCount];
+                    scalar(x[lane], y[lane], scalarResults);
+                    ALIMER_CHECK_MSG(ToBits(narrowLanes[lane]) == ToBits(wideLanes[lane]) && ToBits(scalarResults[function]) == ToBits(wideLanes[lane]),
+                                     "function %zu differs between widths at (%.9g, %.9g)", function, x[lane], y[lane]);
+                }
+            }
+        }
+    }
+}
+
+ALIMER_TEST(VectorMathSinCosAccuracy);
+ALIMER_TEST(VectorMathExpAccuracy);
+ALIMER_TEST(VectorMathLogAccuracy);
+ALIMER_TEST(VectorMathAtan2Accuracy);
+ALIMER_TEST(VectorMathPowAccuracy);
+ALIMER_TEST(VectorMathWidthsAgree);
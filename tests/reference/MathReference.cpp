@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2020 Amer Koleci and contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "MathCases.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Write the math case results of the scalar backend, one case per line: the name and then the result bits in hex.
+int main(int argc, char* argv[])
+{
+    using namespace alimer;
+
+    if (argc != 2)
+    {
+        printf("Usage: alimer_math_reference <output file>\n");
+        return EXIT_FAILURE;
+    }
+
+    FILE* file = fopen(argv[1], "w");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "Failed to open '%s'\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    for (const MathCaseResult& result : RunMathCases())
+    {
+        fprintf(file, "%s", result.name.c_str());
+        for (uint32_t bits : result.bits)
+            fprintf(file, " %08x", bits);
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    return EXIT_SUCCESS;
+}